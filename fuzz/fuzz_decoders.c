@@ -0,0 +1,287 @@
+/**
+ * Fuzz target for the length-checked decoders of Ruuvi Endpoints.
+ *
+ * Every decoder is run on the same input, decoders must neither read outside of
+ * the input nor take more than bounded time on it.
+ *
+ * Build and run with libFuzzer:
+ *     make fuzz && ./build_fuzz/fuzz_decoders -max_total_time=60
+ *
+ * Compilers without libFuzzer can build a standalone driver which runs given
+ * input files or a fixed number of pseudo-random inputs:
+ *     make fuzz_standalone && ./build_fuzz/fuzz_decoders_standalone 1000000
+ *
+ * License: BSD-3
+ */
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_8.h"
+#include "ruuvi_endpoint_c5.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_endpoint_e0.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_f0.h"
+#include "ruuvi_endpoint_fa.h"
+#include "ruuvi_endpoint_ibeacon.h"
+#include "ruuvi_endpoint_imu.h"
+#include "ruuvi_endpoint_log_delta.h"
+#include "ruuvi_endpoints_capture.h"
+#include "ruuvi_endpoints_dedup.h"
+#include "ruuvi_endpoints_series.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size);
+
+/** Identity "cipher" so that fuzzed bytes reach DF8/FA integrity checks and field decode. */
+static uint32_t fuzz_decrypt (const uint8_t * const ciphertext, uint8_t * const cleartext,
+                              const size_t data_size, const uint8_t * const key,
+                              const size_t key_size)
+{
+    (void) key;
+    (void) key_size;
+    memcpy (cleartext, ciphertext, data_size);
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput (const uint8_t * data, size_t size)
+{
+    re_3_data_t data_3;
+    re_5_data_t data_5;
+    re_6_data_t data_6;
+    re_7_data_t data_7;
+    re_8_data_t data_8;
+    re_c5_data_t data_c5;
+    re_e0_data_t data_e0;
+    re_e1_data_t data_e1;
+    re_f0_data_t data_f0;
+    re_fa_data_t data_fa;
+    re_ibeacon_data_t data_ibeacon;
+    re_ca_uart_payload_t payload;
+    re_log_multi_t log_multi;
+    re_log_delta_decoder_t log_delta;
+    re_imu_stream_t imu_stream;
+    re_capture_reader_t capture;
+    uint8_t dedup_format;
+    uint32_t dedup_counter;
+    static re_float imu_x[RE_IMU_MAX_SAMPLES];
+    static re_float imu_y[RE_IMU_MAX_SAMPLES];
+    static re_float imu_z[RE_IMU_MAX_SAMPLES];
+    static uint32_t log_timestamps[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static re_float log_values[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static re_log_env_t log_env[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static uint64_t log_timestamps_ms[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static const uint8_t * capture_frames[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static size_t capture_lens[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    static re_stats_t stats;
+    size_t num_samples = 0;
+    size_t stream_pos = 0;
+    // Copy to exactly sized heap buffer so that sanitizers catch reads past the end.
+    uint8_t * const p_input = malloc ( (0U == size) ? 1U : size);
+
+    if (NULL != p_input)
+    {
+        memcpy (p_input, data, size);
+        (void) re_3_decode_checked (p_input, size, &data_3);
+        (void) re_5_decode_checked (p_input, size, &data_5);
+        (void) re_6_decode_checked (p_input, size, &data_6);
+        (void) re_7_decode_checked (p_input, size, &data_7);
+        (void) re_8_decode_checked (p_input, size, &data_8, &fuzz_decrypt, p_input, 0U);
+        (void) re_c5_decode_checked (p_input, size, &data_c5);
+        (void) re_e0_decode_checked (p_input, size, &data_e0);
+        (void) re_e1_decode_checked (p_input, size, &data_e1);
+        (void) re_f0_decode_checked (p_input, size, &data_f0);
+        (void) re_fa_decode_checked (p_input, size, &data_fa, &fuzz_decrypt, p_input, 0U);
+        (void) re_ibeacon_decode_checked (p_input, size, &data_ibeacon);
+        (void) re_ca_uart_decode_checked (p_input, size, &payload);
+
+        // Input as a received byte stream.
+        while (stream_pos < size)
+        {
+            size_t frame_len = 0;
+            stream_pos += re_ca_uart_resync (&p_input[stream_pos], size - stream_pos,
+                                             &frame_len, &stats);
+
+            if ( (0U != frame_len)
+                    && (RE_SUCCESS == re_ca_uart_decode_stats (&p_input[stream_pos], frame_len,
+                            &payload, &stats)))
+            {
+                stream_pos += frame_len;
+            }
+            else if (stream_pos < size)
+            {
+                stream_pos++;
+            }
+            else
+            {
+                // End of stream.
+            }
+        }
+
+        (void) re_dedup_counter_read (p_input, size, &dedup_format, &dedup_counter);
+
+        if (RE_SUCCESS == re_log_multi_decode (p_input, size, &log_multi))
+        {
+            (void) re_log_multi_decode_values (&log_multi, log_timestamps, log_values);
+            (void) re_log_multi_decode_env (&log_multi, log_timestamps, log_env);
+        }
+
+        if (RE_SUCCESS == re_log_multi_ms_decode (p_input, size, &log_multi))
+        {
+            (void) re_log_multi_decode_values_ms (&log_multi, log_timestamps_ms, log_values);
+        }
+
+        if (RE_SUCCESS == re_log_delta_decode_start (&log_delta, p_input, size))
+        {
+            while ( (0U != log_delta.remaining)
+                    && (RE_SUCCESS == re_log_delta_decode_next (&log_delta, log_timestamps,
+                            log_values)))
+            {
+            }
+        }
+
+        (void) re_imu_stream_decode (p_input, size, &imu_stream, imu_x, imu_y, imu_z);
+        (void) re_series_decode (p_input, size, log_timestamps, log_values,
+                                 RE_LOG_WRITE_MULTI_MAX_RECORDS, &num_samples);
+
+        if ( (RE_SUCCESS == re_capture_open (&capture, p_input, size))
+                && (RE_SUCCESS == re_capture_seek (&capture, size)))
+        {
+            while ( (RE_SUCCESS == re_capture_read (&capture, capture_frames, capture_lens,
+                                                    log_timestamps_ms,
+                                                    RE_LOG_WRITE_MULTI_MAX_RECORDS,
+                                                    &num_samples))
+                    && (0U != num_samples))
+            {
+                for (size_t ii = 0; ii < num_samples; ii++)
+                {
+                    (void) re_ca_uart_decode_checked (capture_frames[ii], capture_lens[ii],
+                                                      &payload);
+                }
+            }
+        }
+
+        free (p_input);
+    }
+
+    return 0;
+}
+
+#ifdef RE_FUZZ_STANDALONE
+#include <stdio.h>
+
+#define RE_FUZZ_MAX_INPUT   (300U)     //!< Longer than any valid frame.
+#define RE_FUZZ_DEFAULT_RUNS (100000UL)
+
+/** @brief xorshift32, deterministic so that failures are reproducible. */
+static uint32_t fuzz_rand (uint32_t * const p_state)
+{
+    uint32_t x = *p_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *p_state = x;
+    return x;
+}
+
+/** @brief CRC-CCITT (0xFFFF) as used by CA UART, lets random frames reach command decoders. */
+static uint16_t fuzz_crc16 (const uint8_t * const p_data, const size_t size)
+{
+    uint16_t crc = 0xFFFFU;
+
+    for (size_t ii = 0; ii < size; ii++)
+    {
+        crc  = (uint16_t) ( (uint8_t) (crc >> 8U) | (crc << 8U));
+        crc ^= p_data[ii];
+        crc ^= (uint8_t) (crc & 0xFFU) >> 4U;
+        crc ^= (uint16_t) ( (crc << 8U) << 4U);
+        crc ^= (uint16_t) ( ( (crc & 0xFFU) << 4U) << 1U);
+    }
+
+    return crc;
+}
+
+static int fuzz_file (const char * const p_path)
+{
+    static uint8_t buffer[1U << 16U];
+    int err_code = 0;
+    FILE * const p_file = fopen (p_path, "rb");
+
+    if (NULL == p_file)
+    {
+        perror (p_path);
+        err_code = 1;
+    }
+    else
+    {
+        const size_t size = fread (buffer, 1U, sizeof (buffer), p_file);
+        fclose (p_file);
+        (void) LLVMFuzzerTestOneInput (buffer, size);
+    }
+
+    return err_code;
+}
+
+static void fuzz_random (const unsigned long runs)
+{
+    uint8_t buffer[RE_FUZZ_MAX_INPUT];
+    uint32_t state = 0x5275U;
+
+    for (unsigned long run = 0; run < runs; run++)
+    {
+        const size_t size = fuzz_rand (&state) % (RE_FUZZ_MAX_INPUT + 1U);
+
+        for (size_t ii = 0; ii < size; ii++)
+        {
+            buffer[ii] = (uint8_t) fuzz_rand (&state);
+        }
+
+        // Make every other input a well-framed UART message with random contents.
+        if ( (0U != (run & 1U)) && (size >= RE_CA_UART_FRAME_OVERHEAD))
+        {
+            const size_t max_len = size - RE_CA_UART_FRAME_OVERHEAD;
+            const size_t len = buffer[RE_CA_UART_LEN_INDEX] % (max_len + 1U);
+            const size_t crc_index = len + RE_CA_UART_HEADER_SIZE;
+            buffer[RE_CA_UART_STX_INDEX] = RE_CA_UART_STX;
+            buffer[RE_CA_UART_LEN_INDEX] = (uint8_t) len;
+            const uint16_t crc = fuzz_crc16 (&buffer[RE_CA_UART_LEN_INDEX],
+                                             crc_index - RE_CA_UART_LEN_INDEX);
+            buffer[crc_index] = (uint8_t) (crc & 0xFFU);
+            buffer[crc_index + 1U] = (uint8_t) (crc >> 8U);
+            buffer[crc_index + RE_CA_UART_CRC_SIZE] = RE_CA_UART_ETX;
+        }
+
+        (void) LLVMFuzzerTestOneInput (buffer, size);
+    }
+}
+
+int main (int argc, char ** argv)
+{
+    int err_code = 0;
+    char * p_end = NULL;
+    const unsigned long runs = (2 == argc) ? strtoul (argv[1], &p_end, 10) : 0UL;
+
+    if (1 == argc)
+    {
+        fuzz_random (RE_FUZZ_DEFAULT_RUNS);
+    }
+    else if ( (NULL != p_end) && ('\0' == *p_end))
+    {
+        fuzz_random (runs);
+    }
+    else
+    {
+        for (int ii = 1; ii < argc; ii++)
+        {
+            err_code |= fuzz_file (argv[ii]);
+        }
+    }
+
+    return err_code;
+}
+#endif
@@ -1,7 +1,9 @@
 #include "ruuvi_endpoint_3.h"
 #include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_internal.h"
 #include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 #include <math.h>
 
 #if RE_3_ENABLED
@@ -18,6 +20,19 @@
 #define RE_3_BYTE_SIGN_OFFSET               7
 #define RE_3_BYTE_OFFSET                    8
 #define RE_3_BYTE_MASK                      0xFF
+#define RE_3_TEMP_DECIMAL_MASK              0x7F
+
+#define RE_3_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET    (0U)
+#define RE_3_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL       (2U)
+#define RE_3_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET  (1U)
+#define RE_3_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL     (1U)
+#define RE_3_RAW_PACKET_LENGTH_OFFSET               (3U)
+#define RE_3_RAW_PACKET_LENGTH_VAL                  (17U)
+#define RE_3_RAW_PACKET_TYPE_OFFSET                 (4U)
+#define RE_3_RAW_PACKET_TYPE_VAL                    (0xFFU)
+#define RE_3_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO   (5U)
+#define RE_3_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
+#define RE_3_RAW_PACKET_MANUFACTURER_ID_VAL         (0x499U)
 
 static re_float re_3_encode_check_invalid (const re_float data,
         const re_float invalid)
@@ -187,4 +202,142 @@ re_status_t re_3_encode (uint8_t * const buffer,
     return result;
 }
 
+static uint16_t re_3_decode_u16 (const uint8_t * const p_msb)
+{
+    return (uint16_t) ( ( (uint16_t) p_msb[0] << RE_3_BYTE_OFFSET) | p_msb[1]);
+}
+
+static re_float re_3_decode_temperature (const uint8_t * const p_payload)
+{
+    const uint8_t decimal = p_payload[RE_3_OFFSET_TEMPERATURE_DECIMAL];
+    re_float temperature = (re_float) (decimal & RE_3_TEMP_DECIMAL_MASK)
+                           + ( (re_float) p_payload[RE_3_OFFSET_TEMPERATURE_FRACTION]
+                               / RE_3_ENCODE_TEMP_CONVERT_RATIO);
+
+    if (0U != (decimal >> RE_3_BYTE_SIGN_OFFSET))
+    {
+        temperature = 0 - temperature;
+    }
+
+    return temperature;
+}
+
+static re_float re_3_decode_acceleration (const uint8_t * const p_msb)
+{
+    return (re_float) (int16_t) re_3_decode_u16 (p_msb) / RE_3_ENCODE_ACC_CONVERT_RATIO;
+}
+
+void re_3_decode_fields (const uint8_t * const p_payload, re_3_data_t * const p_data)
+{
+    p_data->humidity_rh = (re_float) p_payload[RE_3_OFFSET_HUMIDITY]
+                          / RE_3_ENCODE_HUMIDITY_CONVERT_RATIO;
+    p_data->temperature_c = re_3_decode_temperature (p_payload);
+    p_data->pressure_pa = (re_float) re_3_decode_u16 (&p_payload[RE_3_OFFSET_PRESSURE_MSB])
+                          + RE_3_ENCODE_PRESSURE_INIT_OFFSET;
+    p_data->accelerationx_g =
+        re_3_decode_acceleration (&p_payload[RE_3_OFFSET_ACCELERATIONX_MSB]);
+    p_data->accelerationy_g =
+        re_3_decode_acceleration (&p_payload[RE_3_OFFSET_ACCELERATIONY_MSB]);
+    p_data->accelerationz_g =
+        re_3_decode_acceleration (&p_payload[RE_3_OFFSET_ACCELERATIONZ_MSB]);
+    p_data->battery_v = (re_float) re_3_decode_u16 (&p_payload[RE_3_OFFSET_VOLTAGE_MSB])
+                        / RE_3_ENCODE_BATTERY_CONVERT_RATIO;
+}
+
+bool re_3_check_format (const uint8_t * const p_buffer)
+{
+    if (NULL == p_buffer)
+    {
+        return false;
+    }
+
+    if (RE_3_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL !=
+            p_buffer[RE_3_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_3_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL !=
+            p_buffer[RE_3_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_3_RAW_PACKET_LENGTH_VAL != p_buffer[RE_3_RAW_PACKET_LENGTH_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_3_RAW_PACKET_TYPE_VAL != p_buffer[RE_3_RAW_PACKET_TYPE_OFFSET])
+    {
+        return false;
+    }
+
+    const uint16_t manufacturer_id = (uint16_t) ( (uint16_t)
+                                     p_buffer[RE_3_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI] << RE_3_BYTE_OFFSET)
+                                     + p_buffer[RE_3_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO];
+
+    if (RE_3_RAW_PACKET_MANUFACTURER_ID_VAL != manufacturer_id)
+    {
+        return false;
+    }
+
+    if (RE_3_DESTINATION != p_buffer[RE_3_OFFSET_PAYLOAD + RE_3_OFFSET_HEADER])
+    {
+        return false;
+    }
+
+    return true;
+}
+
+re_status_t re_3_decode (const uint8_t * const p_buffer, re_3_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    const uint8_t * const p_payload = &p_buffer[RE_3_OFFSET_PAYLOAD];
+    memset (p_data, 0, sizeof (*p_data));
+
+    if (RE_3_DESTINATION != p_payload[RE_3_OFFSET_HEADER])
+    {
+        return RE_ERROR_INVALID_PARAM;
+    }
+
+    re_3_decode_fields (p_payload, p_data);
+    return RE_SUCCESS;
+}
+
+re_status_t re_3_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                 re_3_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_3_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_3_decode (p_buffer, p_data);
+}
+
+static re_status_t re_3_decode_frame (const uint8_t * const p_buffer,
+        void * const p_data)
+{
+    return re_3_decode (p_buffer, (re_3_data_t *) p_data);
+}
+
+re_status_t re_3_decode_batch (const uint8_t * const * const pp_buffers,
+                               const size_t num_buffers,
+                               re_3_data_t * const p_data,
+                               re_status_t * const p_status)
+{
+    return re_decode_batch (pp_buffers, num_buffers, p_data, sizeof (re_3_data_t),
+                            &re_3_decode_frame, p_status);
+}
+
 #endif
@@ -9,11 +9,17 @@
 #ifndef RUUVI_ENDPOINT_3_H
 #define RUUVI_ENDPOINT_3_H
 #include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stddef.h>
 
 #define RE_3_DESTINATION 0x03
 #define RE_3_INVALID_DATA 0
 #define RE_3_DATA_LENGTH 14
 
+#define RE_3_OFFSET_PAYLOAD (7U)
+
+#define RE_3_RAW_MIN_LEN (RE_3_OFFSET_PAYLOAD + RE_3_DATA_LENGTH) //!< Shortest decodable buffer.
+
 #define RE_3_OFFSET_HEADER               0
 #define RE_3_OFFSET_HUMIDITY             1
 #define RE_3_OFFSET_TEMPERATURE_DECIMAL  2
@@ -59,5 +65,73 @@ typedef struct
 re_status_t re_3_encode (uint8_t * const buffer,
                          const re_3_data_t * const data, const re_float invalid);
 
+/**
+ * @brief Decode sensor fields of a payload in DF3 layout.
+ *
+ * Header is not checked. Shared with formats which reuse the DF3 field layout,
+ * such as FA after decryption.
+ *
+ * @param[in]  p_payload Pointer to RE_3_DATA_LENGTH bytes of payload, header first.
+ * @param[out] p_data Decoded data.
+ */
+void re_3_decode_fields (const uint8_t * const p_payload, re_3_data_t * const p_data);
+
+/**
+ * @brief Checks if the provided buffer conforms to the Ruuvi DF3 format.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 31 bytes to be checked.
+ * @return Returns 'true' if the buffer format is Ruuvi DF3, 'false' otherwise.
+ */
+bool re_3_check_format (const uint8_t * const p_buffer);
+
+/**
+ * @brief Decodes a given buffer using the Ruuvi DF3 format.
+ *
+ * DF3 has no dedicated values for unavailable data, fields which were encoded
+ * as invalid are decoded as their zero-value, e.g. 50000 Pa.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 31 bytes
+ *  representing a Bluetooth frame with Ruuvi DF3 formatted payload.
+ * @param[out] p_data Pointer to a re_3_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DF3.
+ */
+re_status_t re_3_decode (const uint8_t * const p_buffer, re_3_data_t * const p_data);
+
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DF3 format.
+ *
+ * Length-checked variant of @ref re_3_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DF3 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_3_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_3_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DF3.
+ */
+re_status_t re_3_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                 re_3_data_t * const p_data);
+
+/**
+ * @brief Decodes an array of Bluetooth frames using the Ruuvi DF3 format.
+ *
+ * @param[in] pp_buffers Array of num_buffers pointers to frames as in @ref re_3_decode.
+ * @param[in] num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers re_3_data_t structs.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers or p_data is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+re_status_t re_3_decode_batch (const uint8_t * const * const pp_buffers,
+                               const size_t num_buffers,
+                               re_3_data_t * const p_data,
+                               re_status_t * const p_status);
+
 
 #endif
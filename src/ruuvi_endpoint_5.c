@@ -48,22 +48,6 @@
 #define RE_5_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
 #define RE_5_RAW_PACKET_MANUFACTURER_ID_VAL         (0x499U)
 
-// Avoid mocking simple function
-#ifdef TEST
-void re_clip (re_float * const value, const re_float min, const re_float max)
-{
-    if (*value > max)
-    {
-        *value = max;
-    }
-
-    if (*value < min)
-    {
-        *value = min;
-    }
-}
-#endif
-
 static void re_5_encode_acceleration (uint8_t * const acceleration_slot,
                                       re_float acceleration)
 {
@@ -450,4 +434,20 @@ re_status_t re_5_decode (const uint8_t * const p_buffer, re_5_data_t * const p_d
     return result;
 }
 
+re_status_t re_5_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                 re_5_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_5_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_5_decode (p_buffer, p_data);
+}
+
 #endif
@@ -10,6 +10,7 @@
 #define RUUVI_ENDPOINT_5_H
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_5_DESTINATION          (0x05U)
 #define RE_5_INVALID_TEMPERATURE  (0x8000U)
@@ -42,6 +43,8 @@
 
 #define RE_5_OFFSET_PAYLOAD    (7U)
 
+#define RE_5_RAW_MIN_LEN (RE_5_OFFSET_PAYLOAD + RE_5_DATA_LENGTH) //!< Shortest decodable buffer.
+
 #define RE_5_OFFSET_HEADER     (0U)
 #define RE_5_OFFSET_TEMP_MSB   (1U)
 #define RE_5_OFFSET_TEMP_LSB   (2U)
@@ -127,4 +130,22 @@ bool re_5_check_format (const uint8_t * const p_buffer);
  */
 re_status_t re_5_decode (const uint8_t * const p_buffer, re_5_data_t * const p_data);
 
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DF5 format.
+ *
+ * Length-checked variant of @ref re_5_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DF5 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_5_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_5_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DF5.
+ */
+re_status_t re_5_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                 re_5_data_t * const p_data);
+
 #endif
@@ -455,6 +455,23 @@ re_6_decode (const uint8_t * const p_buffer, re_6_data_t * const p_data)
     return result;
 }
 
+re_status_t
+re_6_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                     re_6_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_6_RAW_BUF_SIZE)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_6_decode (p_buffer, p_data);
+}
+
 re_6_data_t
 re_6_data_invalid (const uint16_t measurement_cnt, const uint64_t radio_mac)
 {
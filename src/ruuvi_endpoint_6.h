@@ -10,6 +10,7 @@
 #define RUUVI_ENDPOINT_6_H
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_6_DESTINATION (0x06U)
 
@@ -189,6 +190,25 @@ re_6_check_format (const uint8_t * const p_buffer);
 re_status_t
 re_6_decode (const uint8_t * const p_buffer, re_6_data_t * const p_data);
 
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DF6 format.
+ *
+ * Length-checked variant of @ref re_6_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DF6 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_6_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_6_RAW_BUF_SIZE.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DF6.
+ */
+re_status_t
+re_6_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                     re_6_data_t * const p_data);
+
 /**
  * @brief Create invalid Ruuvi DF6 data.
  * @param measurement_cnt Running counter of measurement.
@@ -528,4 +528,21 @@ re_7_decode (const uint8_t * const p_buffer, re_7_data_t * const p_data)
     return result;
 }
 
+re_status_t
+re_7_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                     re_7_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_7_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_7_decode (p_buffer, p_data);
+}
+
 #endif
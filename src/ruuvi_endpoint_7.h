@@ -11,6 +11,7 @@
 #define RUUVI_ENDPOINT_7_H
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_7_DESTINATION          (0x07U)
 #define RE_7_INVALID_SEQUENCE     (0xFFU)
@@ -72,6 +73,8 @@
 /** Payload offset in raw BLE advertisement (after company ID and header) */
 #define RE_7_OFFSET_PAYLOAD (7U)
 
+#define RE_7_RAW_MIN_LEN (RE_7_OFFSET_PAYLOAD + RE_7_DATA_LENGTH) //!< Shortest decodable buffer.
+
 /** Payload offsets within manufacturer data (22 bytes total) */
 #define RE_7_OFFSET_HEADER      (0U)  /**< Format header 0x07 */
 #define RE_7_OFFSET_SEQ         (1U)  /**< Message counter */
@@ -181,4 +184,24 @@ re_7_check_format (const uint8_t * const p_buffer);
 re_status_t
 re_7_decode (const uint8_t * const p_buffer, re_7_data_t * const p_data);
 
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DF7 format.
+ *
+ * Length-checked variant of @ref re_7_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DF7 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_7_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_7_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DF7.
+ * @retval RE_ERROR_DECODING_CRC if the payload checksum does not match.
+ */
+re_status_t
+re_7_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                     re_7_data_t * const p_data);
+
 #endif
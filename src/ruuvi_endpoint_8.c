@@ -1,5 +1,6 @@
 #include "ruuvi_endpoints.h"
 #include "ruuvi_endpoint_8.h"
+#include "ruuvi_endpoints_internal.h"
 #include <math.h>
 #include <string.h>
 
@@ -19,6 +20,20 @@
 #define RE_8_TXPWR_RATIO         (2)
 #define RE_8_TXPWR_OFFSET        (40)
 #define RE_8_BYTE_VOLTAGE_OFFSET (5U)
+#define RE_8_BYTE_VOLTAGE_MASK   (0x7FFU)
+#define RE_8_BYTE_TX_POWER_MASK  (0x1FU)
+
+#define RE_8_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET    (0U)
+#define RE_8_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL       (2U)
+#define RE_8_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET  (1U)
+#define RE_8_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL     (1U)
+#define RE_8_RAW_PACKET_LENGTH_OFFSET               (3U)
+#define RE_8_RAW_PACKET_LENGTH_VAL                  (27U)
+#define RE_8_RAW_PACKET_TYPE_OFFSET                 (4U)
+#define RE_8_RAW_PACKET_TYPE_VAL                    (0xFFU)
+#define RE_8_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO   (5U)
+#define RE_8_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
+#define RE_8_RAW_PACKET_MANUFACTURER_ID_VAL         (0x499U)
 
 static void re_8_encode_set_address (uint8_t * const buffer,
                                      const re_8_data_t * data)
@@ -200,4 +215,242 @@ re_status_t re_8_encode (uint8_t * const buffer,
     return result;
 }
 
+static uint16_t re_8_decode_u16 (const uint8_t * const p_msb)
+{
+    return (uint16_t) ( ( (uint16_t) p_msb[0] << 8U) | p_msb[1]);
+}
+
+static float re_8_decode_temperature (const uint8_t * const buffer)
+{
+    const uint16_t coded_temperature = re_8_decode_u16 (&buffer[RE_8_OFFSET_TEMP_MSB]);
+
+    if (RE_8_INVALID_TEMPERATURE == coded_temperature)
+    {
+        return NAN;
+    }
+
+    return (float) (int16_t) coded_temperature / RE_8_TEMP_RATIO;
+}
+
+static float re_8_decode_humidity (const uint8_t * const buffer)
+{
+    const uint16_t coded_humidity = re_8_decode_u16 (&buffer[RE_8_OFFSET_HUMI_MSB]);
+
+    if (RE_8_INVALID_HUMIDITY == coded_humidity)
+    {
+        return NAN;
+    }
+
+    return (float) coded_humidity / RE_8_HUMI_RATIO;
+}
+
+static float re_8_decode_pressure (const uint8_t * const buffer)
+{
+    const uint16_t coded_pressure = re_8_decode_u16 (&buffer[RE_8_OFFSET_PRES_MSB]);
+
+    if (RE_8_INVALID_PRESSURE == coded_pressure)
+    {
+        return NAN;
+    }
+
+    return ( (float) coded_pressure - RE_8_PRES_OFFSET) / RE_8_PRES_RATIO;
+}
+
+static void re_8_decode_pwr (const uint8_t * const buffer, re_8_data_t * const p_data)
+{
+    const uint16_t power_info = re_8_decode_u16 (&buffer[RE_8_OFFSET_POWER_MSB]);
+    const uint16_t coded_voltage = (power_info >> RE_8_BYTE_VOLTAGE_OFFSET)
+                                   & RE_8_BYTE_VOLTAGE_MASK;
+    const uint16_t coded_tx_power = power_info & RE_8_BYTE_TX_POWER_MASK;
+
+    if (RE_8_INVALID_VOLTAGE == coded_voltage)
+    {
+        p_data->battery_v = NAN;
+    }
+    else
+    {
+        p_data->battery_v = (float) (RE_8_BATT_OFFSET + coded_voltage) / RE_8_BATT_RATIO;
+    }
+
+    if (RE_8_INVALID_POWER == coded_tx_power)
+    {
+        p_data->tx_power = RE_8_INVALID_POWER;
+    }
+    else
+    {
+        p_data->tx_power = (int8_t) ( (coded_tx_power * RE_8_TXPWR_RATIO) - RE_8_TXPWR_OFFSET);
+    }
+}
+
+static uint64_t re_8_decode_address (const uint8_t * const buffer)
+{
+    uint64_t mac = 0;
+
+    for (uint8_t offset = RE_8_OFFSET_ADDR_MSB; offset <= RE_8_OFFSET_ADDR_LSB; offset++)
+    {
+        mac = (mac << 8U) | buffer[offset];
+    }
+
+    return mac;
+}
+
+/**
+ * @brief Verify CRC8 of decrypted data and decode fields.
+ *
+ * @param[in]  p_payload DF8 payload as received.
+ * @param[in]  p_cleartext Decrypted RE_8_CIPHERTEXT_LENGTH bytes of payload.
+ * @param[out] p_data Decoded data.
+ */
+static re_status_t re_8_decode_cleartext (const uint8_t * const p_payload,
+        const uint8_t * const p_cleartext,
+        re_8_data_t * const p_data)
+{
+    uint8_t frame[RE_8_DATA_LENGTH];
+
+    if (re_calc_crc8 (p_cleartext, RE_8_CIPHERTEXT_LENGTH) != p_payload[RE_8_OFFSET_CRC8])
+    {
+        return RE_ERROR_DECODING_CRC;
+    }
+
+    // Decode from a cleartext copy of the payload to use the same offsets as encoder.
+    memcpy (frame, p_payload, RE_8_DATA_LENGTH);
+    memcpy (&frame[RE_8_OFFSET_CIPHER], p_cleartext, RE_8_CIPHERTEXT_LENGTH);
+    p_data->temperature_c = re_8_decode_temperature (frame);
+    p_data->humidity_rh = re_8_decode_humidity (frame);
+    p_data->pressure_pa = re_8_decode_pressure (frame);
+    re_8_decode_pwr (frame, p_data);
+    p_data->movement_count = re_8_decode_u16 (&frame[RE_8_OFFSET_MVTCTR_MSB]);
+    p_data->message_counter = re_8_decode_u16 (&frame[RE_8_OFFSET_SEQCTR_MSB]);
+    p_data->address = re_8_decode_address (frame);
+    return RE_SUCCESS;
+}
+
+bool re_8_check_format (const uint8_t * const p_buffer)
+{
+    if (NULL == p_buffer)
+    {
+        return false;
+    }
+
+    if (RE_8_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL !=
+            p_buffer[RE_8_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_8_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL !=
+            p_buffer[RE_8_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_8_RAW_PACKET_LENGTH_VAL != p_buffer[RE_8_RAW_PACKET_LENGTH_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_8_RAW_PACKET_TYPE_VAL != p_buffer[RE_8_RAW_PACKET_TYPE_OFFSET])
+    {
+        return false;
+    }
+
+    const uint16_t manufacturer_id = (uint16_t) ( (uint16_t)
+                                     p_buffer[RE_8_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI] << 8U)
+                                     + p_buffer[RE_8_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO];
+
+    if (RE_8_RAW_PACKET_MANUFACTURER_ID_VAL != manufacturer_id)
+    {
+        return false;
+    }
+
+    if (RE_8_DESTINATION != p_buffer[RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_HEADER])
+    {
+        return false;
+    }
+
+    return true;
+}
+
+re_status_t re_8_decode (const uint8_t * const p_buffer,
+                         re_8_data_t * const p_data,
+                         re_8_decrypt_fp decipher,
+                         const uint8_t * const key,
+                         const size_t key_size)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data) || (NULL == decipher) || (NULL == key))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    const uint8_t * const p_payload = &p_buffer[RE_8_OFFSET_PAYLOAD];
+    uint8_t cleartext[RE_8_CIPHERTEXT_LENGTH] = {0};
+    memset (p_data, 0, sizeof (*p_data));
+
+    if (RE_8_DESTINATION != p_payload[RE_8_OFFSET_HEADER])
+    {
+        return RE_ERROR_INVALID_PARAM;
+    }
+
+    if (0 != decipher (&p_payload[RE_8_OFFSET_CIPHER], cleartext, RE_8_CIPHERTEXT_LENGTH,
+                       key, key_size))
+    {
+        return RE_ERROR_DECODING;
+    }
+
+    return re_8_decode_cleartext (p_payload, cleartext, p_data);
+}
+
+re_status_t re_8_decode_checked (const uint8_t * const p_buffer,
+                                 const size_t buf_len,
+                                 re_8_data_t * const p_data,
+                                 re_8_decrypt_fp decipher,
+                                 const uint8_t * const key,
+                                 const size_t key_size)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_8_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_8_decode (p_buffer, p_data, decipher, key, key_size);
+}
+
+static re_status_t re_8_decode_block (const uint8_t * const p_payload,
+        const uint8_t * const p_cleartext,
+        void * const p_data)
+{
+    return re_8_decode_cleartext (p_payload, p_cleartext, (re_8_data_t *) p_data);
+}
+
+_Static_assert (RE_8_CIPHERTEXT_LENGTH <= RE_CIPHER_BLOCK_SIZE,
+                "Ciphertext does not fit batch decode buffer");
+
+static const re_cipher_format_t re_8_cipher_format =
+{
+    .destination = RE_8_DESTINATION,
+    .offset_payload = RE_8_OFFSET_PAYLOAD,
+    .offset_header = RE_8_OFFSET_HEADER,
+    .offset_cipher = RE_8_OFFSET_CIPHER,
+    .cipher_length = RE_8_CIPHERTEXT_LENGTH,
+    .data_size = sizeof (re_8_data_t),
+    .decode_cleartext = &re_8_decode_block,
+};
+
+re_status_t re_8_decode_batch (const uint8_t * const * const pp_buffers,
+                               const uint8_t * const * const pp_keys,
+                               const size_t key_size,
+                               const size_t num_buffers,
+                               re_8_data_t * const p_data,
+                               re_status_t * const p_status,
+                               re_cipher_batch_fp cipher)
+{
+    return re_cipher_decode_batch (&re_8_cipher_format, pp_buffers, pp_keys, key_size,
+                                   num_buffers, p_data, p_status, cipher);
+}
+
 #endif
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "ruuvi_endpoint_c5.h"
 #include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_internal.h"
 #include <stddef.h>
 #include <stdbool.h>
 #include <string.h>
@@ -34,21 +35,17 @@
 #define RE_C5_BYTE_TX_POWER_OFFSET (0U)
 #define RE_C5_BYTE_TX_POWER_MASK   (0x1FU)
 
-// Avoid mocking simple function
-#ifdef TEST
-void re_clip (re_float * const value, const re_float min, const re_float max)
-{
-    if (*value > max)
-    {
-        *value = max;
-    }
-
-    if (*value < min)
-    {
-        *value = min;
-    }
-}
-#endif
+#define RE_C5_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET    (0U)
+#define RE_C5_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL       (2U)
+#define RE_C5_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET  (1U)
+#define RE_C5_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL     (1U)
+#define RE_C5_RAW_PACKET_LENGTH_OFFSET               (3U)
+#define RE_C5_RAW_PACKET_LENGTH_VAL                  (21U)
+#define RE_C5_RAW_PACKET_TYPE_OFFSET                 (4U)
+#define RE_C5_RAW_PACKET_TYPE_VAL                    (0xFFU)
+#define RE_C5_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO   (5U)
+#define RE_C5_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
+#define RE_C5_RAW_PACKET_MANUFACTURER_ID_VAL         (0x499U)
 
 static void re_c5_encode_set_address (uint8_t * const buffer, const re_c5_data_t * data)
 {
@@ -83,6 +80,30 @@ static void re_c5_encode_set_address (uint8_t * const buffer, const re_c5_data_t
     buffer[addr_offset] = (mac >> 0) & RE_C5_BYTE_MASK;
 }
 
+static uint64_t re_c5_decode_address (const uint8_t * const p_buffer)
+{
+    // Address is 64 bits, skip 2 first bytes
+    uint8_t addr_offset = RE_C5_OFFSET_ADDR_MSB;
+    uint64_t mac = 0;
+    mac |= p_buffer[addr_offset];
+    mac <<= RE_C5_BYTE_1_SHIFT;
+    addr_offset++;
+    mac |= p_buffer[addr_offset];
+    mac <<= RE_C5_BYTE_1_SHIFT;
+    addr_offset++;
+    mac |= p_buffer[addr_offset];
+    mac <<= RE_C5_BYTE_1_SHIFT;
+    addr_offset++;
+    mac |= p_buffer[addr_offset];
+    mac <<= RE_C5_BYTE_1_SHIFT;
+    addr_offset++;
+    mac |= p_buffer[addr_offset];
+    mac <<= RE_C5_BYTE_1_SHIFT;
+    addr_offset++;
+    mac |= p_buffer[addr_offset];
+    return mac;
+}
+
 static void re_c5_encode_humidity (uint8_t * const buffer, const re_c5_data_t * data)
 {
     uint16_t coded_humidity = RE_C5_INVALID_HUMIDITY;
@@ -98,6 +119,21 @@ static void re_c5_encode_humidity (uint8_t * const buffer, const re_c5_data_t *
     buffer[RE_C5_OFFSET_HUMI_LSB] = coded_humidity & RE_C5_BYTE_MASK;
 }
 
+static re_float re_c5_decode_humidity (const uint8_t * const buffer)
+{
+    uint16_t coded_humidity = 0;
+    coded_humidity |= buffer[RE_C5_OFFSET_HUMI_LSB] & RE_C5_BYTE_MASK;
+    coded_humidity |= ( (uint16_t) buffer[RE_C5_OFFSET_HUMI_MSB] & RE_C5_BYTE_MASK) <<
+                      RE_C5_BYTE_1_SHIFT;
+
+    if (RE_C5_INVALID_HUMIDITY == coded_humidity)
+    {
+        return NAN;
+    }
+
+    return (re_float) coded_humidity / RE_C5_HUMI_RATIO;
+}
+
 static void re_c5_encode_temperature (uint8_t * const buffer, const re_c5_data_t * data)
 {
     uint16_t coded_temperature = RE_C5_INVALID_TEMPERATURE;
@@ -115,6 +151,21 @@ static void re_c5_encode_temperature (uint8_t * const buffer, const re_c5_data_t
     buffer[RE_C5_OFFSET_TEMP_LSB] = coded_temperature & RE_C5_BYTE_MASK;
 }
 
+static re_float re_c5_decode_temperature (const uint8_t * const buffer)
+{
+    uint16_t coded_temperature = 0;
+    coded_temperature |= buffer[RE_C5_OFFSET_TEMP_LSB] & RE_C5_BYTE_MASK;
+    coded_temperature |= ( (uint16_t) buffer[RE_C5_OFFSET_TEMP_MSB] & RE_C5_BYTE_MASK) <<
+                         RE_C5_BYTE_1_SHIFT;
+
+    if (RE_C5_INVALID_TEMPERATURE == coded_temperature)
+    {
+        return NAN;
+    }
+
+    return (re_float) (int16_t) coded_temperature / RE_C5_TEMP_RATIO;
+}
+
 static void re_c5_encode_pressure (uint8_t * const buffer, const re_c5_data_t * data)
 {
     uint16_t coded_pressure = RE_C5_INVALID_PRESSURE;
@@ -131,6 +182,21 @@ static void re_c5_encode_pressure (uint8_t * const buffer, const re_c5_data_t *
     buffer[RE_C5_OFFSET_PRES_LSB] = coded_pressure & RE_C5_BYTE_MASK;
 }
 
+static re_float re_c5_decode_pressure (const uint8_t * const buffer)
+{
+    uint16_t coded_pressure = 0;
+    coded_pressure |= buffer[RE_C5_OFFSET_PRES_LSB] & RE_C5_BYTE_MASK;
+    coded_pressure |= ( (uint16_t) buffer[RE_C5_OFFSET_PRES_MSB] & RE_C5_BYTE_MASK) <<
+                      RE_C5_BYTE_1_SHIFT;
+
+    if (RE_C5_INVALID_PRESSURE == coded_pressure)
+    {
+        return NAN;
+    }
+
+    return ( (re_float) coded_pressure - RE_C5_PRES_OFFSET) / RE_C5_PRES_RATIO;
+}
+
 
 static void re_c5_encode_pwr (uint8_t * const buffer, const re_c5_data_t * data)
 {
@@ -161,6 +227,39 @@ static void re_c5_encode_pwr (uint8_t * const buffer, const re_c5_data_t * data)
     buffer[RE_C5_OFFSET_POWER_LSB] = (power_info & RE_C5_BYTE_MASK);
 }
 
+static void re_c5_decode_pwr (const uint8_t * const buffer, re_float * const p_battery_v,
+                              int8_t * const p_tx_power)
+{
+    uint16_t power_info = 0;
+    power_info |= buffer[RE_C5_OFFSET_POWER_LSB] & RE_C5_BYTE_MASK;
+    power_info |= ( (uint16_t) buffer[RE_C5_OFFSET_POWER_MSB] & RE_C5_BYTE_MASK) <<
+                  RE_C5_BYTE_1_SHIFT;
+    uint16_t coded_voltage = ( (uint32_t) power_info >> RE_C5_BYTE_VOLTAGE_OFFSET) &
+                             RE_C5_BYTE_VOLTAGE_MASK;
+    uint16_t coded_tx_power = ( (uint32_t) power_info >> RE_C5_BYTE_TX_POWER_OFFSET) &
+                              RE_C5_BYTE_TX_POWER_MASK;
+
+    if (RE_C5_INVALID_VOLTAGE == coded_voltage)
+    {
+        *p_battery_v = NAN;
+    }
+    else
+    {
+        const re_float voltage = RE_C5_BATT_OFFSET + coded_voltage;
+        *p_battery_v = voltage / RE_C5_BATT_RATIO;
+    }
+
+    if (RE_C5_INVALID_POWER == coded_tx_power)
+    {
+        *p_tx_power = RE_C5_INVALID_POWER;
+    }
+    else
+    {
+        *p_tx_power = (int8_t) lrintf ( (re_float) coded_tx_power * RE_C5_TXPWR_RATIO -
+                                        RE_C5_TXPWR_OFFSET);
+    }
+}
+
 static void re_c5_encode_movement (uint8_t * const buffer, const re_c5_data_t * data)
 {
     uint8_t movement_count = RE_C5_INVALID_MOVEMENT;
@@ -186,6 +285,15 @@ static void re_c5_encode_sequence (uint8_t * const buffer, const re_c5_data_t *
     buffer[RE_C5_OFFSET_SEQCTR_LSB] = (measurement_seq & RE_C5_BYTE_MASK);
 }
 
+static uint16_t re_c5_decode_sequence (const uint8_t * const p_buffer)
+{
+    uint16_t measurement_seq = 0;
+    measurement_seq |= p_buffer[RE_C5_OFFSET_SEQCTR_LSB] & RE_C5_BYTE_MASK;
+    measurement_seq |= (p_buffer[RE_C5_OFFSET_SEQCTR_MSB] & RE_C5_BYTE_MASK) <<
+                       RE_C5_BYTE_1_SHIFT;
+    return measurement_seq;
+}
+
 re_status_t re_c5_encode (uint8_t * const buffer, const re_c5_data_t * data)
 {
     re_status_t result = RE_SUCCESS;
@@ -209,4 +317,106 @@ re_status_t re_c5_encode (uint8_t * const buffer, const re_c5_data_t * data)
     return result;
 }
 
+bool re_c5_check_format (const uint8_t * const p_buffer)
+{
+    if (NULL == p_buffer)
+    {
+        return false;
+    }
+
+    if (RE_C5_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL !=
+            p_buffer[RE_C5_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_C5_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL !=
+            p_buffer[RE_C5_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_C5_RAW_PACKET_LENGTH_VAL != p_buffer[RE_C5_RAW_PACKET_LENGTH_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_C5_RAW_PACKET_TYPE_VAL != p_buffer[RE_C5_RAW_PACKET_TYPE_OFFSET])
+    {
+        return false;
+    }
+
+    const uint16_t manufacturer_id = (uint16_t) ( (uint16_t)
+                                     p_buffer[RE_C5_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI] << RE_C5_BYTE_1_SHIFT)
+                                     + p_buffer[RE_C5_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO];
+
+    if (RE_C5_RAW_PACKET_MANUFACTURER_ID_VAL != manufacturer_id)
+    {
+        return false;
+    }
+
+    if (RE_C5_DESTINATION != p_buffer[RE_C5_OFFSET_PAYLOAD + RE_C5_OFFSET_HEADER])
+    {
+        return false;
+    }
+
+    return true;
+}
+
+re_status_t re_c5_decode (const uint8_t * const p_buffer, re_c5_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    const uint8_t * const p_payload = &p_buffer[RE_C5_OFFSET_PAYLOAD];
+    memset (p_data, 0, sizeof (*p_data));
+
+    if (RE_C5_DESTINATION != p_payload[RE_C5_OFFSET_HEADER])
+    {
+        return RE_ERROR_INVALID_PARAM;
+    }
+
+    p_data->humidity_rh = re_c5_decode_humidity (p_payload);
+    p_data->temperature_c = re_c5_decode_temperature (p_payload);
+    p_data->pressure_pa = re_c5_decode_pressure (p_payload);
+    p_data->movement_count = p_payload[RE_C5_OFFSET_MVTCTR];
+    p_data->measurement_count = re_c5_decode_sequence (p_payload);
+    re_c5_decode_pwr (p_payload, &p_data->battery_v, &p_data->tx_power);
+    p_data->address = re_c5_decode_address (p_payload);
+    return RE_SUCCESS;
+}
+
+re_status_t re_c5_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_c5_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_C5_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_c5_decode (p_buffer, p_data);
+}
+
+static re_status_t re_c5_decode_frame (const uint8_t * const p_buffer,
+        void * const p_data)
+{
+    return re_c5_decode (p_buffer, (re_c5_data_t *) p_data);
+}
+
+re_status_t re_c5_decode_batch (const uint8_t * const * const pp_buffers,
+                                const size_t num_buffers,
+                                re_c5_data_t * const p_data,
+                                re_status_t * const p_status)
+{
+    return re_decode_batch (pp_buffers, num_buffers, p_data, sizeof (re_c5_data_t),
+                            &re_c5_decode_frame, p_status);
+}
+
 #endif
@@ -11,6 +11,7 @@
 #define RUUVI_ENDPOINT_C5_H
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_C5_DESTINATION          (0xC5U)
 #define RE_C5_INVALID_TEMPERATURE  (0x8000U)
@@ -41,6 +42,8 @@
 
 #define RE_C5_OFFSET_PAYLOAD    (7U)
 
+#define RE_C5_RAW_MIN_LEN (RE_C5_OFFSET_PAYLOAD + RE_C5_DATA_LENGTH) //!< Shortest decodable buffer.
+
 #define RE_C5_OFFSET_HEADER     (0U)
 #define RE_C5_OFFSET_TEMP_MSB   (1U)
 #define RE_C5_OFFSET_TEMP_LSB   (2U)
@@ -88,4 +91,61 @@ typedef struct
  */
 re_status_t re_c5_encode (uint8_t * const buffer, const re_c5_data_t * data);
 
+/**
+ * @brief Checks if the provided buffer conforms to the Ruuvi C5 format.
+ *
+ * Service UUID field, if any, is expected after the manufacturer specific data
+ * and is not checked.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 31 bytes to be checked.
+ * @return Returns 'true' if the buffer format is Ruuvi C5, 'false' otherwise.
+ */
+bool re_c5_check_format (const uint8_t * const p_buffer);
+
+/**
+ * @brief Decodes a given buffer using the Ruuvi C5 format.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 31 bytes
+ *  representing a Bluetooth frame with Ruuvi C5 formatted payload.
+ * @param[out] p_data Pointer to a re_c5_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not C5.
+ */
+re_status_t re_c5_decode (const uint8_t * const p_buffer, re_c5_data_t * const p_data);
+
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi C5 format.
+ *
+ * Length-checked variant of @ref re_c5_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi C5 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_c5_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_C5_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not C5.
+ */
+re_status_t re_c5_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_c5_data_t * const p_data);
+
+/**
+ * @brief Decodes an array of Bluetooth frames using the Ruuvi C5 format.
+ *
+ * @param[in] pp_buffers Array of num_buffers pointers to frames as in @ref re_c5_decode.
+ * @param[in] num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers re_c5_data_t structs.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers or p_data is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+re_status_t re_c5_decode_batch (const uint8_t * const * const pp_buffers,
+                                const size_t num_buffers,
+                                re_c5_data_t * const p_data,
+                                re_status_t * const p_status);
+
 #endif
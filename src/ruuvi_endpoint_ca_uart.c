@@ -99,7 +99,9 @@ static bool check_crc (const uint8_t * const buffer,
 {
     uint16_t crc16 = RE_CA_CRC_INVALID;
     uint16_t p_crc = RE_CA_CRC_DEFAULT;
-    uint16_t in_crc = * ( (uint16_t *) &buffer[written]);
+    // CRC is serialized LSB first, assemble bytewise to avoid unaligned access.
+    const uint16_t in_crc = (uint16_t) (buffer[written]
+                                        | (buffer[written + 1U] << U16_MSB_OFFSET));
     crc16 = calculate_crc16 (buffer + RE_CA_UART_STX_ETX_LEN,
                              written - RE_CA_UART_STX_ETX_LEN, &p_crc);
 
@@ -260,7 +262,8 @@ static re_status_t re_ca_uart_decode_fltr_id (const uint8_t * const buffer,
     else
     {
         payload->cmd = buffer[RE_CA_UART_CMD_INDEX];
-        payload->params.fltr_id_param.id = * ( (uint16_t *) &buffer[RE_CA_UART_PAYLOAD_INDEX]);
+        memcpy (&payload->params.fltr_id_param.id, &buffer[RE_CA_UART_PAYLOAD_INDEX],
+                sizeof (payload->params.fltr_id_param.id));
     }
 
     return err_code;
@@ -278,8 +281,9 @@ static re_status_t re_ca_uart_decode_led_ctrl (const uint8_t * const buffer,
     else
     {
         payload->cmd = buffer[RE_CA_UART_CMD_INDEX];
-        payload->params.led_ctrl_param.time_interval_ms = * ( (uint16_t *)
-                &buffer[RE_CA_UART_PAYLOAD_INDEX]);
+        memcpy (&payload->params.led_ctrl_param.time_interval_ms,
+                &buffer[RE_CA_UART_PAYLOAD_INDEX],
+                sizeof (payload->params.led_ctrl_param.time_interval_ms));
     }
 
     return err_code;
@@ -297,8 +301,7 @@ static re_status_t re_ca_uart_decode_ack (const uint8_t * const buffer,
     else
     {
         payload->cmd = buffer[RE_CA_UART_CMD_INDEX];
-        payload->params.ack.cmd = (* ( (re_ca_uart_cmd_t *) &buffer[RE_CA_UART_PAYLOAD_INDEX])) &
-                                  CMD_ACK_MASK;
+        payload->params.ack.cmd = buffer[RE_CA_UART_PAYLOAD_INDEX] & CMD_ACK_MASK;
         payload->params.ack.ack_state.state =
             ( (* ( (uint8_t *) &buffer[RE_CA_UART_PAYLOAD_INDEX
                                        + RE_CA_UART_DELIMITER_LEN
@@ -380,8 +383,8 @@ static re_status_t re_ca_uart_decode_set_all_params (
     else
     {
         payload->cmd = buffer[RE_CA_UART_CMD_INDEX];
-        payload->params.all_params.fltr_id.id = * ( (uint16_t *)
-                                                &buffer[RE_CA_UART_PAYLOAD_INDEX]);
+        memcpy (&payload->params.all_params.fltr_id.id, &buffer[RE_CA_UART_PAYLOAD_INDEX],
+                sizeof (payload->params.all_params.fltr_id.id));
         const uint8_t flags = buffer[RE_CA_UART_PAYLOAD_INDEX
                                      + RE_CA_UART_DELIMITER_LEN
                                      + RE_CA_UART_CMD_FLTR_ID_LEN];
@@ -656,6 +659,89 @@ re_status_t re_ca_uart_decode (const uint8_t * const buffer,
     return err_code;
 }
 
+re_status_t re_ca_uart_decode_checked (const uint8_t * const buffer,
+                                       const size_t buf_len,
+                                       re_ca_uart_payload_t * const payload)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == buffer) || (NULL == payload))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if ( (buf_len < RE_CA_UART_FRAME_OVERHEAD)
+              || (buf_len < (buffer[RE_CA_UART_LEN_INDEX] + RE_CA_UART_FRAME_OVERHEAD)))
+    {
+        err_code |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        // Every read of decoder is within declared frame length from here on.
+        err_code |= re_ca_uart_decode (buffer, payload);
+    }
+
+    return err_code;
+}
+
+re_status_t re_ca_uart_decode_stats (const uint8_t * const buffer,
+                                     const size_t buf_len,
+                                     re_ca_uart_payload_t * const payload,
+                                     re_stats_t * const p_stats)
+{
+    const re_status_t err_code = re_ca_uart_decode_checked (buffer, buf_len, payload);
+    uint8_t cmd = 0U;
+
+    // Command byte is meaningless if it was not received or frame did not start with STX.
+    if ( (NULL != buffer) && (RE_CA_UART_CMD_INDEX < buf_len)
+            && (RE_CA_UART_STX == buffer[RE_CA_UART_STX_INDEX]))
+    {
+        cmd = buffer[RE_CA_UART_CMD_INDEX];
+    }
+
+    re_stats_record_frame (p_stats, cmd, err_code);
+    return err_code;
+}
+
+size_t re_ca_uart_resync (const uint8_t * const buffer, const size_t buf_len,
+                          size_t * const p_frame_len, re_stats_t * const p_stats)
+{
+    size_t offset = (NULL == buffer) ? buf_len : 0U;
+    size_t frame_len = 0;
+    bool found = false;
+
+    while ( (!found) && (offset < buf_len))
+    {
+        if (RE_CA_UART_STX != buffer[offset])
+        {
+            offset++;
+        }
+        else
+        {
+            // STX without LEN byte yet is kept for more bytes like a cut frame.
+            if ( (offset + RE_CA_UART_LEN_INDEX) < buf_len)
+            {
+                frame_len = (size_t) buffer[offset + RE_CA_UART_LEN_INDEX]
+                            + RE_CA_UART_FRAME_OVERHEAD;
+                frame_len = (frame_len <= (buf_len - offset)) ? frame_len : 0U;
+            }
+
+            found = true;
+        }
+    }
+
+    if (NULL != buffer)
+    {
+        re_stats_record_discarded (p_stats, offset);
+    }
+
+    if (NULL != p_frame_len)
+    {
+        *p_frame_len = frame_len;
+    }
+
+    return offset;
+}
+
 static re_status_t re_ca_uart_encode_adv_rprt (uint8_t * const buffer,
         uint8_t * const buf_len,
         const re_ca_uart_payload_t * const payload)
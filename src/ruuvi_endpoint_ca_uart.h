@@ -2,7 +2,9 @@
 #define RUUVI_ENDPOINT_CA_UART_H
 
 #include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_stats.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_CA_CRC_DEFAULT       0xFFFF
 #define RE_CA_CRC_INVALID       0
@@ -65,6 +67,8 @@
 #define RE_CA_UART_LEN_INDEX     (1U) //!< Position of length byte.
 #define RE_CA_UART_CMD_INDEX     (2U) //!< Position of CMD byte.
 #define RE_CA_UART_PAYLOAD_INDEX (3U) //!< Start of payload.
+#define RE_CA_UART_FRAME_OVERHEAD (RE_CA_UART_HEADER_SIZE + RE_CA_UART_CRC_SIZE \
+                                   + RE_CA_UART_STX_ETX_LEN) //!< Bytes in frame besides payload.
 
 #define RE_CA_UART_CH39_BYTE     (4U) //!< Byte of channel 39, starting from 0.
 #define RE_CA_UART_CH39_BIT      (7U) //!< Bit of channel 39, starting from 0.
@@ -462,4 +466,59 @@ re_status_t re_ca_uart_encode (uint8_t * const buffer, uint8_t * const buf_len,
 re_status_t re_ca_uart_decode (const uint8_t * const buffer,
                                re_ca_uart_payload_t * const payload);
 
+/**
+ * @brief Decode buffer of known length to @ref re_ca_uart_payload_t.
+ *
+ * Length-checked variant of @ref re_ca_uart_decode for untrusted input. The frame
+ * length declared in the LEN byte is compared against buf_len before any other byte
+ * of the frame is read, and decoding work is bounded by the 255-byte maximum payload.
+ * Bytes after the ETX are ignored.
+ *
+ * param[in]  buffer Buffer to decode command.
+ * param[in]  buf_len Number of valid bytes in buffer.
+ * param[out] payload Pointer to the buffer to store the decoded payload.
+ *
+ * @retval RE_ERROR_DATA_SIZE if buffer is shorter than the frame it declares.
+ * @return Otherwise the result of @ref re_ca_uart_decode.
+ */
+re_status_t re_ca_uart_decode_checked (const uint8_t * const buffer,
+                                       const size_t buf_len,
+                                       re_ca_uart_payload_t * const payload);
+
+/**
+ * @brief Decode given buffer to @ref re_ca_uart_payload_t and record the result.
+ *
+ * Works like @ref re_ca_uart_decode_checked, additionally counts the frame as
+ * decoded or failed per command and per error bit in given statistics.
+ *
+ * param[in]  buffer Buffer to decode command.
+ * param[in]  buf_len Number of valid bytes in buffer.
+ * param[out] payload Pointer to the buffer to store the decoded payload.
+ * param[in,out] p_stats Decode statistics to update, may be NULL.
+ */
+re_status_t re_ca_uart_decode_stats (const uint8_t * const buffer,
+                                     const size_t buf_len,
+                                     re_ca_uart_payload_t * const payload,
+                                     re_stats_t * const p_stats);
+
+/**
+ * @brief Find the next frame in a stream of received bytes.
+ *
+ * Skips bytes up to the next STX, as a receiver does to resynchronize after
+ * line noise or a lost frame, and counts them as discarded in given statistics.
+ * If the frame declared at STX does not fit in the buffer yet, its offset is
+ * returned with frame length 0 so that the caller can wait for more bytes.
+ * If the found frame then fails to decode, continue from the byte after its STX.
+ *
+ * param[in]  buffer Received bytes.
+ * param[in]  buf_len Number of received bytes.
+ * param[out] p_frame_len Length of complete frame at returned offset, 0 if it
+ *                        is not complete. May be NULL.
+ * param[in,out] p_stats Decode statistics to update, may be NULL.
+ *
+ * @return Offset of next STX, buf_len if there is none or buffer is NULL.
+ */
+size_t re_ca_uart_resync (const uint8_t * const buffer, const size_t buf_len,
+                          size_t * const p_frame_len, re_stats_t * const p_stats);
+
 #endif // RUUVI_ENDPOINT_GW_UART_H
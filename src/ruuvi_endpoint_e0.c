@@ -25,23 +25,6 @@
 #define RE_E0_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI (3U)
 #define RE_E0_RAW_PACKET_MANUFACTURER_ID_VAL       (0x499U)
 
-// Avoid mocking simple function
-#ifdef TEST
-void
-re_clip (re_float * const value, const re_float min, const re_float max)
-{
-    if (*value > max)
-    {
-        *value = max;
-    }
-
-    if (*value < min)
-    {
-        *value = min;
-    }
-}
-#endif
-
 static void
 re_e0_encode_temperature (uint8_t * const p_slot, re_float val)
 {
@@ -548,6 +531,22 @@ re_status_t re_e0_decode (const uint8_t * const p_buffer, re_e0_data_t * const p
     return result;
 }
 
+re_status_t re_e0_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_e0_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_E0_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_e0_decode (p_buffer, p_data);
+}
+
 re_e0_data_t
 re_e0_data_invalid (const uint16_t measurement_cnt, const uint64_t radio_mac)
 {
@@ -12,6 +12,7 @@
 
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_E0_DESTINATION         (0xE0U)
 
@@ -73,6 +74,8 @@
 
 #define RE_E0_OFFSET_PAYLOAD          (4U)
 
+#define RE_E0_RAW_MIN_LEN (RE_E0_OFFSET_PAYLOAD + RE_E0_DATA_LENGTH) //!< Shortest decodable buffer.
+
 #define RE_E0_OFFSET_HEADER (0U)
 
 #define RE_E0_OFFSET_TEMPERATURE_MSB (1U)
@@ -190,6 +193,24 @@ re_e0_check_format (const uint8_t * const p_buffer);
 re_status_t
 re_e0_decode (const uint8_t * const p_buffer, re_e0_data_t * const p_data);
 
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DFxE0 format.
+ *
+ * Length-checked variant of @ref re_e0_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DFxE0 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_e0_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_E0_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DFxE0.
+ */
+re_status_t re_e0_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_e0_data_t * const p_data);
+
 /**
  * @brief Create invalid Ruuvi DFxE0 data.
  * @param measurement_cnt Running counter of measurement.
@@ -70,7 +70,7 @@ const re_i16_coeffs_t re_e1_coeffs_temperature =
     .ratio       = RE_E1_TEMPERATURE_RATIO,
 };
 
-static const re_u16_coeffs_t re_e1_coeffs_humidity =
+const re_u16_coeffs_t re_e1_coeffs_humidity =
 {
     .invalid_val = RE_E1_INVALID_HUMIDITY,
     .min_val     = RE_E1_HUMIDITY_MIN,
@@ -78,7 +78,7 @@ static const re_u16_coeffs_t re_e1_coeffs_humidity =
     .ratio       = RE_E1_HUMIDITY_RATIO,
 };
 
-static const re_u16_coeffs_t re_e1_coeffs_pressure =
+const re_u16_coeffs_t re_e1_coeffs_pressure =
 {
     .invalid_val = RE_E1_INVALID_PRESSURE,
     .min_val     = RE_E1_PRESSURE_MIN,
@@ -86,7 +86,7 @@ static const re_u16_coeffs_t re_e1_coeffs_pressure =
     .ratio       = RE_E1_PRESSURE_RATIO,
 };
 
-static const re_u16_coeffs_t re_e1_coeffs_pm =
+const re_u16_coeffs_t re_e1_coeffs_pm =
 {
     .invalid_val = RE_E1_INVALID_PM,
     .min_val     = RE_E1_PM_MIN,
@@ -94,7 +94,7 @@ static const re_u16_coeffs_t re_e1_coeffs_pm =
     .ratio       = RE_E1_PM_RATIO,
 };
 
-static const re_u16_coeffs_t re_e1_coeffs_co2 =
+const re_u16_coeffs_t re_e1_coeffs_co2 =
 {
     .invalid_val = RE_E1_INVALID_CO2,
     .min_val     = RE_E1_CO2_MIN,
@@ -186,66 +186,6 @@ re_e1_decode_nox (const uint8_t * const p_slot, const uint8_t * const p_flags)
     return re_decode_u9 (p_slot, p_flags, &re_e1_coeffs_nox);
 }
 
-static inline uint8_t
-re_be24_get_high_byte (const uint32_t value)
-{
-    return (uint8_t) ( (value >> RE_BYTE_2_SHIFT) & RE_BYTE_MASK);
-}
-
-static inline uint8_t
-re_be24_get_mid_byte (const uint32_t value)
-{
-    return (uint8_t) ( (value >> RE_BYTE_1_SHIFT) & RE_BYTE_MASK);
-}
-
-static inline uint8_t
-re_be24_get_low_byte (const uint32_t value)
-{
-    return (uint8_t) (value & RE_BYTE_MASK);
-}
-
-static inline void
-re_encode_u24 (
-    uint8_t * const p_slot,
-    const re_float val,
-    const uint32_t invalid_val,
-    const re_float min_val,
-    const re_float max_val,
-    const re_float scale_factor)
-{
-    uint32_t coded_val = invalid_val;
-
-    if (!isnan (val))
-    {
-        const re_float val_clipped = RE_CLIP (val, min_val, max_val);
-        coded_val                  = (uint32_t) lrintf ( (val_clipped - min_val) * scale_factor);
-    }
-
-    p_slot[0] |= re_be24_get_high_byte (coded_val);
-    p_slot[1] |= re_be24_get_mid_byte (coded_val);
-    p_slot[2] |= re_be24_get_low_byte (coded_val);
-}
-
-static inline re_float
-re_decode_u24 (
-    const uint8_t * const p_slot,
-    const uint32_t       invalid_val,
-    const re_float       min_val,
-    const re_float       scale_factor)
-{
-    uint32_t coded_val = 0;
-    coded_val |= ( (uint32_t) p_slot[0]) << RE_BYTE_2_SHIFT;
-    coded_val |= ( (uint32_t) p_slot[1]) << RE_BYTE_1_SHIFT;
-    coded_val |= ( (uint32_t) p_slot[2]) << RE_BYTE_0_SHIFT;
-
-    if (invalid_val == coded_val)
-    {
-        return NAN;
-    }
-
-    return (re_float) coded_val / scale_factor + min_val;
-}
-
 static void
 re_e1_encode_luminosity (uint8_t * const p_slot, const re_float val)
 {
@@ -547,6 +487,23 @@ re_e1_decode (const uint8_t * const p_buffer, re_e1_data_t * const p_data)
     return result;
 }
 
+re_status_t
+re_e1_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                      re_e1_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_E1_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_e1_decode (p_buffer, p_data);
+}
+
 re_e1_data_t
 re_e1_data_invalid (const re_e1_seq_cnt_t seq_cnt, const re_e1_mac_addr_t radio_mac)
 {
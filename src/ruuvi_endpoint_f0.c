@@ -38,23 +38,6 @@
 #define RE_F0_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI       (10U)
 #define RE_F0_RAW_PACKET_MANUFACTURER_ID_VAL             (0x499U)
 
-// Avoid mocking simple function
-#ifdef TEST
-void
-re_clip (re_float * const value, const re_float min, const re_float max)
-{
-    if (*value > max)
-    {
-        *value = max;
-    }
-
-    if (*value < min)
-    {
-        *value = min;
-    }
-}
-#endif
-
 static void
 re_f0_encode_temperature (uint8_t * const p_slot, re_float val)
 {
@@ -518,6 +501,22 @@ re_status_t re_f0_decode (const uint8_t * const p_buffer, re_f0_data_t * const p
     return result;
 }
 
+re_status_t re_f0_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_f0_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_F0_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_f0_decode (p_buffer, p_data);
+}
+
 re_f0_data_t
 re_f0_data_invalid (const uint8_t measurement_cnt, const uint64_t radio_mac)
 {
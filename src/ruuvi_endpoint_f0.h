@@ -12,6 +12,7 @@
 
 #include "ruuvi_endpoints.h"
 #include <stdbool.h>
+#include <stddef.h>
 
 #define RE_F0_DESTINATION         (0xF0U)
 
@@ -73,6 +74,8 @@
 
 #define RE_F0_OFFSET_PAYLOAD (11U)
 
+#define RE_F0_RAW_MIN_LEN (RE_F0_OFFSET_PAYLOAD + RE_F0_DATA_LENGTH) //!< Shortest decodable buffer.
+
 #define RE_F0_OFFSET_HEADER      (0U)
 #define RE_F0_OFFSET_TEMPERATURE (1U)
 #define RE_F0_OFFSET_HUMIDITY    (2U)
@@ -155,6 +158,24 @@ re_f0_check_format (const uint8_t * const p_buffer);
 re_status_t
 re_f0_decode (const uint8_t * const p_buffer, re_f0_data_t * const p_data);
 
+/**
+ * @brief Decodes a buffer of known length using the Ruuvi DFxF0 format.
+ *
+ * Length-checked variant of @ref re_f0_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with Ruuvi DFxF0 formatted payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_f0_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_F0_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not DFxF0.
+ */
+re_status_t re_f0_decode_checked (const uint8_t * const p_buffer, const size_t buf_len,
+                                  re_f0_data_t * const p_data);
+
 /**
  * @brief Create invalid Ruuvi DFxFE data.
  * @param measurement_cnt Running counter of measurement.
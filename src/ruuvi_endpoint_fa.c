@@ -1,14 +1,31 @@
 #include "ruuvi_endpoint_fa.h"
 #include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoints_internal.h"
 #include <math.h>
 #include <string.h>
 
 #if RE_FA_ENABLED
 
+#if !RE_3_ENABLED
+#   error "RE_FA_ENABLED requires RE_3_ENABLED, FA fields are encoded as DF3."
+#endif
+
 #define RE_FA_INVALID_MAC (0xFFFFFFFFFFFFU)
 #define RE_FA_ENCODE_MAC_MAX (0xFFFFFFFFFFFEU)
 #define RE_FA_ENCODE_MAC_MIN (0U)
 
+#define RE_FA_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET    (0U)
+#define RE_FA_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL       (2U)
+#define RE_FA_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET  (1U)
+#define RE_FA_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL     (1U)
+#define RE_FA_RAW_PACKET_LENGTH_OFFSET               (3U)
+#define RE_FA_RAW_PACKET_LENGTH_VAL                  (26U)
+#define RE_FA_RAW_PACKET_TYPE_OFFSET                 (4U)
+#define RE_FA_RAW_PACKET_TYPE_VAL                    (0xFFU)
+#define RE_FA_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO   (5U)
+#define RE_FA_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
+#define RE_FA_RAW_PACKET_MANUFACTURER_ID_VAL         (0x499U)
+
 static void fill_re_3 (re_3_data_t * const re_3_data,
                        const re_fa_data_t * const re_fa_data)
 {
@@ -66,4 +83,181 @@ re_status_t re_fa_encode (uint8_t * const buffer,
     re_fa_encode_set_address (buffer, data);
     return encoding_status;
 }
+
+static uint64_t re_fa_decode_address (const uint8_t * const buffer)
+{
+    uint64_t mac = 0;
+
+    for (uint8_t offset = RE_FA_OFFSET_ADDRESS_MSB; offset <= RE_FA_OFFSET_ADDRESS_LSB; offset++)
+    {
+        mac = (mac << 8U) | buffer[offset];
+    }
+
+    return mac;
+}
+
+/**
+ * @brief Verify trailing NULLs of decrypted data and decode fields.
+ *
+ * @param[in]  p_payload FA payload as received.
+ * @param[in]  p_cleartext Decrypted RE_FA_CIPHERTEXT_LENGTH bytes of payload.
+ * @param[out] p_data Decoded data.
+ */
+static re_status_t re_fa_decode_cleartext (const uint8_t * const p_payload,
+        const uint8_t * const p_cleartext,
+        re_fa_data_t * const p_data)
+{
+    uint8_t frame[RE_FA_DATA_LENGTH];
+    re_3_data_t re_3_data = {0};
+
+    // Decode from a cleartext copy of the payload to use the same offsets as encoder.
+    memcpy (frame, p_payload, RE_FA_DATA_LENGTH);
+    memcpy (&frame[RE_FA_OFFSET_CIPHER], p_cleartext, RE_FA_CIPHERTEXT_LENGTH);
+
+    if ( (0U != frame[RE_FA_OFFSET_TRAILING_NULL_1])
+            || (0U != frame[RE_FA_OFFSET_TRAILING_NULL_2]))
+    {
+        return RE_ERROR_DECODING;
+    }
+
+    re_3_decode_fields (frame, &re_3_data);
+    p_data->humidity_rh     = re_3_data.humidity_rh;
+    p_data->pressure_pa     = re_3_data.pressure_pa;
+    p_data->temperature_c   = re_3_data.temperature_c;
+    p_data->accelerationx_g = re_3_data.accelerationx_g;
+    p_data->accelerationy_g = re_3_data.accelerationy_g;
+    p_data->accelerationz_g = re_3_data.accelerationz_g;
+    p_data->battery_v       = re_3_data.battery_v;
+    p_data->message_counter = frame[RE_FA_OFFSET_COUNTER];
+    p_data->address = re_fa_decode_address (frame);
+    return RE_SUCCESS;
+}
+
+bool re_fa_check_format (const uint8_t * const p_buffer)
+{
+    if (NULL == p_buffer)
+    {
+        return false;
+    }
+
+    if (RE_FA_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL !=
+            p_buffer[RE_FA_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_FA_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL !=
+            p_buffer[RE_FA_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_FA_RAW_PACKET_LENGTH_VAL != p_buffer[RE_FA_RAW_PACKET_LENGTH_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_FA_RAW_PACKET_TYPE_VAL != p_buffer[RE_FA_RAW_PACKET_TYPE_OFFSET])
+    {
+        return false;
+    }
+
+    const uint16_t manufacturer_id = (uint16_t) ( (uint16_t)
+                                     p_buffer[RE_FA_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI] << 8U)
+                                     + p_buffer[RE_FA_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO];
+
+    if (RE_FA_RAW_PACKET_MANUFACTURER_ID_VAL != manufacturer_id)
+    {
+        return false;
+    }
+
+    if (RE_FA_DESTINATION != p_buffer[RE_FA_OFFSET_PAYLOAD + RE_FA_OFFSET_HEADER])
+    {
+        return false;
+    }
+
+    return true;
+}
+
+re_status_t re_fa_decode (const uint8_t * const p_buffer,
+                          re_fa_data_t * const p_data,
+                          re_fa_decrypt_fp decipher,
+                          const uint8_t * const key,
+                          const size_t key_size)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data) || (NULL == decipher) || (NULL == key))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    const uint8_t * const p_payload = &p_buffer[RE_FA_OFFSET_PAYLOAD];
+    uint8_t cleartext[RE_FA_CIPHERTEXT_LENGTH] = {0};
+    memset (p_data, 0, sizeof (*p_data));
+
+    if (RE_FA_DESTINATION != p_payload[RE_FA_OFFSET_HEADER])
+    {
+        return RE_ERROR_INVALID_PARAM;
+    }
+
+    if (0 != decipher (&p_payload[RE_FA_OFFSET_CIPHER], cleartext, RE_FA_CIPHERTEXT_LENGTH,
+                       key, key_size))
+    {
+        return RE_ERROR_DECODING;
+    }
+
+    return re_fa_decode_cleartext (p_payload, cleartext, p_data);
+}
+
+re_status_t re_fa_decode_checked (const uint8_t * const p_buffer,
+                                  const size_t buf_len,
+                                  re_fa_data_t * const p_data,
+                                  re_fa_decrypt_fp decipher,
+                                  const uint8_t * const key,
+                                  const size_t key_size)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_FA_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_fa_decode (p_buffer, p_data, decipher, key, key_size);
+}
+
+static re_status_t re_fa_decode_block (const uint8_t * const p_payload,
+        const uint8_t * const p_cleartext,
+        void * const p_data)
+{
+    return re_fa_decode_cleartext (p_payload, p_cleartext, (re_fa_data_t *) p_data);
+}
+
+_Static_assert (RE_FA_CIPHERTEXT_LENGTH <= RE_CIPHER_BLOCK_SIZE,
+                "Ciphertext does not fit batch decode buffer");
+
+static const re_cipher_format_t re_fa_cipher_format =
+{
+    .destination = RE_FA_DESTINATION,
+    .offset_payload = RE_FA_OFFSET_PAYLOAD,
+    .offset_header = RE_FA_OFFSET_HEADER,
+    .offset_cipher = RE_FA_OFFSET_CIPHER,
+    .cipher_length = RE_FA_CIPHERTEXT_LENGTH,
+    .data_size = sizeof (re_fa_data_t),
+    .decode_cleartext = &re_fa_decode_block,
+};
+
+re_status_t re_fa_decode_batch (const uint8_t * const * const pp_buffers,
+                                const uint8_t * const * const pp_keys,
+                                const size_t key_size,
+                                const size_t num_buffers,
+                                re_fa_data_t * const p_data,
+                                re_status_t * const p_status,
+                                re_cipher_batch_fp cipher)
+{
+    return re_cipher_decode_batch (&re_fa_cipher_format, pp_buffers, pp_keys, key_size,
+                                   num_buffers, p_data, p_status, cipher);
+}
 #endif
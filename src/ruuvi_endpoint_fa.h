@@ -12,6 +12,7 @@
  */
 
 #include "ruuvi_endpoints.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
@@ -39,6 +40,10 @@
 #define RE_FA_OFFSET_TRAILING_NULL_2      (16U) //!< Trailing NULL 2
 #define RE_FA_OFFSET_ADDRESS_MSB          (17U) //!< Plaintext Address offset
 #define RE_FA_OFFSET_ADDRESS_LSB          (RE_FA_OFFSET_ADDRESS_MSB + 5U) //!< Addr end.
+#define RE_FA_OFFSET_CIPHER               (1U)  //!< Index of first encrypted byte
+
+#define RE_FA_OFFSET_PAYLOAD (7U) //!< Start of payload in BLE frame
+#define RE_FA_RAW_MIN_LEN (RE_FA_OFFSET_PAYLOAD + RE_FA_DATA_LENGTH) //!< Shortest decodable buffer.
 
 /** @brief All data required for Ruuvi dataformat fa package. */
 typedef struct
@@ -79,6 +84,22 @@ typedef uint32_t (*re_fa_encrypt_fp) (const uint8_t * const cleartext,
                                       const uint8_t * const key,
                                       const size_t key_size);
 
+/**
+ * @brief Decryption function for data format.
+ *
+ * @param[in]  ciphertext Data to decrypt
+ * @param[out] cleartext Decrypted data
+ * @param[in]  data_size Size of input/output buffers
+ * @param[in]  key Key to decrypt data
+ * @param[in]  key_size Length of key in bytes
+ * @return 0 on success, non-zero error code otherwise.
+ */
+typedef uint32_t (*re_fa_decrypt_fp) (const uint8_t * const ciphertext,
+                                      uint8_t * const cleartext,
+                                      const size_t data_size,
+                                      const uint8_t * const key,
+                                      const size_t key_size);
+
 /**
  * @brief Encode data to Ruuvi Format FA.
  *
@@ -95,4 +116,82 @@ re_status_t re_fa_encode (uint8_t * const buffer,
                           const uint8_t * const key,
                           const size_t key_size);
 
+/**
+ * @brief Checks if the provided buffer conforms to the Ruuvi FA format.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 31 bytes to be checked.
+ * @return Returns 'true' if the buffer format is Ruuvi FA, 'false' otherwise.
+ */
+bool re_fa_check_format (const uint8_t * const p_buffer);
+
+/**
+ * @brief Decrypt and decode a Bluetooth frame with Ruuvi FA payload.
+ *
+ * FA has no checksum, the two trailing NULL bytes of the decrypted block are
+ * verified instead before any field is decoded. Sensor fields are decoded
+ * as in DF3.
+ *
+ * @param[in]  p_buffer Pointer to a uint8_t input array with a length of 31 bytes.
+ * @param[out] p_data Decoded data.
+ * @param[in]  decipher Pointer to decryption function.
+ * @param[in]  key Decryption key of the tag.
+ * @param[in]  key_size Decryption key length in bytes.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the payload header is not FA.
+ * @retval RE_ERROR_DECODING if decryption failed or trailing NULLs do not match, e.g. wrong key.
+ */
+re_status_t re_fa_decode (const uint8_t * const p_buffer,
+                          re_fa_data_t * const p_data,
+                          re_fa_decrypt_fp decipher,
+                          const uint8_t * const key,
+                          const size_t key_size);
+
+/**
+ * @brief Decrypt and decode a buffer of known length.
+ *
+ * Length-checked variant of @ref re_fa_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in]  p_buffer Pointer to a uint8_t input array representing a Bluetooth frame.
+ * @param[in]  buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Decoded data.
+ * @param[in]  decipher Pointer to decryption function.
+ * @param[in]  key Decryption key of the tag.
+ * @param[in]  key_size Decryption key length in bytes.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_FA_RAW_MIN_LEN.
+ * @return Otherwise the result of @ref re_fa_decode.
+ */
+re_status_t re_fa_decode_checked (const uint8_t * const p_buffer,
+                                  const size_t buf_len,
+                                  re_fa_data_t * const p_data,
+                                  re_fa_decrypt_fp decipher,
+                                  const uint8_t * const key,
+                                  const size_t key_size);
+
+/**
+ * @brief Decrypt and decode an array of Bluetooth frames with Ruuvi FA payload.
+ *
+ * Ciphertexts are handed to the cipher up to RE_CIPHER_BATCH_BLOCKS at a time.
+ * Frames with a wrong header or without a key are not passed to the cipher.
+ *
+ * @param[in]  pp_buffers Array of num_buffers pointers to frames as in @ref re_fa_decode.
+ * @param[in]  pp_keys Array of num_buffers pointers to decryption keys, NULL if unknown.
+ * @param[in]  key_size Length of each key in bytes.
+ * @param[in]  num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers decoded data structs.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @param[in]  cipher Batched decryption function.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers, pp_keys, p_data or cipher is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+re_status_t re_fa_decode_batch (const uint8_t * const * const pp_buffers,
+                                const uint8_t * const * const pp_keys,
+                                const size_t key_size,
+                                const size_t num_buffers,
+                                re_fa_data_t * const p_data,
+                                re_status_t * const p_status,
+                                re_cipher_batch_fp cipher);
+
 #endif // RUUVI_ENDPOINT_FA_H
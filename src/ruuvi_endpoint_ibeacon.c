@@ -1,5 +1,6 @@
 #include "ruuvi_endpoint_ibeacon.h"
 #include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_internal.h"
 #include <string.h>
 
 #if RE_IBEACON_ENABLED
@@ -7,6 +8,22 @@
 #define RE_IBEACON_BYTE_MASK    0xFF
 #define RE_IBEACON_BYTE_SHIT    8
 
+#define RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET    (0U)
+#define RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL       (2U)
+#define RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET  (1U)
+#define RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL     (1U)
+#define RE_IBEACON_RAW_PACKET_LENGTH_OFFSET               (3U)
+#define RE_IBEACON_RAW_PACKET_LENGTH_VAL                  (26U)
+#define RE_IBEACON_RAW_PACKET_TYPE_OFFSET                 (4U)
+#define RE_IBEACON_RAW_PACKET_TYPE_VAL                    (0xFFU)
+#define RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO   (5U)
+#define RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI   (6U)
+#define RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_VAL         (0x004CU)
+#define RE_IBEACON_RAW_PACKET_BEACON_TYPE_OFFSET          (7U)
+#define RE_IBEACON_RAW_PACKET_BEACON_TYPE_VAL             (0x02U)
+#define RE_IBEACON_RAW_PACKET_BEACON_LEN_OFFSET           (8U)
+#define RE_IBEACON_RAW_PACKET_BEACON_LEN_VAL              (0x15U)
+
 re_status_t re_ibeacon_encode (uint8_t * const buffer,
                                const re_ibeacon_data_t * data)
 {
@@ -34,8 +51,8 @@ re_status_t re_ibeacon_encode (uint8_t * const buffer,
             buffer[RE_IBEACON_OFFSET_MAJOR_MSB] = (major >> RE_IBEACON_BYTE_SHIT);
             buffer[RE_IBEACON_OFFSET_MAJOR_LSB] = (major & RE_IBEACON_BYTE_MASK);
             uint16_t minor = data->minor;
-            buffer[RE_IBEACON_OFFSET_MAJOR_MSB] = (minor >> RE_IBEACON_BYTE_SHIT);
-            buffer[RE_IBEACON_OFFSET_MAJOR_LSB] = (minor & RE_IBEACON_BYTE_MASK);
+            buffer[RE_IBEACON_OFFSET_MINOR_MSB] = (minor >> RE_IBEACON_BYTE_SHIT);
+            buffer[RE_IBEACON_OFFSET_MINOR_LSB] = (minor & RE_IBEACON_BYTE_MASK);
             int8_t tx_power = data->tx_power;
             buffer[RE_IBEACON_OFFSET_TX_POWER] = tx_power;
         }
@@ -43,4 +60,115 @@ re_status_t re_ibeacon_encode (uint8_t * const buffer,
 
     return re_status;
 }
+
+bool re_ibeacon_check_format (const uint8_t * const p_buffer)
+{
+    if (NULL == p_buffer)
+    {
+        return false;
+    }
+
+    if (RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_LEN_VAL !=
+            p_buffer[RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_LEN_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_FLAG1_VAL !=
+            p_buffer[RE_IBEACON_RAW_PACKET_ADV_DATA_TYPE_FLAG1_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_IBEACON_RAW_PACKET_LENGTH_VAL != p_buffer[RE_IBEACON_RAW_PACKET_LENGTH_OFFSET])
+    {
+        return false;
+    }
+
+    if (RE_IBEACON_RAW_PACKET_TYPE_VAL != p_buffer[RE_IBEACON_RAW_PACKET_TYPE_OFFSET])
+    {
+        return false;
+    }
+
+    const uint16_t manufacturer_id = (uint16_t) ( (uint16_t)
+                                     p_buffer[RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_OFFSET_HI]
+                                     << RE_IBEACON_BYTE_SHIT)
+                                     + p_buffer[RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_OFFSET_LO];
+
+    if (RE_IBEACON_RAW_PACKET_MANUFACTURER_ID_VAL != manufacturer_id)
+    {
+        return false;
+    }
+
+    if ( (RE_IBEACON_RAW_PACKET_BEACON_TYPE_VAL !=
+            p_buffer[RE_IBEACON_RAW_PACKET_BEACON_TYPE_OFFSET])
+            || (RE_IBEACON_RAW_PACKET_BEACON_LEN_VAL !=
+                p_buffer[RE_IBEACON_RAW_PACKET_BEACON_LEN_OFFSET]))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+re_status_t re_ibeacon_decode (const uint8_t * const p_buffer,
+                               re_ibeacon_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    const uint8_t * const p_payload = &p_buffer[RE_IBEACON_OFFSET_PAYLOAD];
+    memset (p_data, 0, sizeof (*p_data));
+
+    if ( (RE_IBEACON_RAW_PACKET_BEACON_TYPE_VAL !=
+            p_buffer[RE_IBEACON_RAW_PACKET_BEACON_TYPE_OFFSET])
+            || (RE_IBEACON_RAW_PACKET_BEACON_LEN_VAL !=
+                p_buffer[RE_IBEACON_RAW_PACKET_BEACON_LEN_OFFSET]))
+    {
+        return RE_ERROR_INVALID_PARAM;
+    }
+
+    memcpy (p_data->proximity_uuid, &p_payload[RE_IBEACON_OFFSET_PROXIMITY_UUID],
+            RE_IBEACON_PROXIMITY_UUID_SIZE);
+    p_data->major = (uint16_t) ( (p_payload[RE_IBEACON_OFFSET_MAJOR_MSB] << RE_IBEACON_BYTE_SHIT)
+                                 | p_payload[RE_IBEACON_OFFSET_MAJOR_LSB]);
+    p_data->minor = (uint16_t) ( (p_payload[RE_IBEACON_OFFSET_MINOR_MSB] << RE_IBEACON_BYTE_SHIT)
+                                 | p_payload[RE_IBEACON_OFFSET_MINOR_LSB]);
+    p_data->tx_power = (int8_t) p_payload[RE_IBEACON_OFFSET_TX_POWER];
+    return RE_SUCCESS;
+}
+
+re_status_t re_ibeacon_decode_checked (const uint8_t * const p_buffer,
+                                       const size_t buf_len,
+                                       re_ibeacon_data_t * const p_data)
+{
+    if ( (NULL == p_buffer) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    if (buf_len < RE_IBEACON_RAW_MIN_LEN)
+    {
+        return RE_ERROR_DATA_SIZE;
+    }
+
+    return re_ibeacon_decode (p_buffer, p_data);
+}
+
+static re_status_t re_ibeacon_decode_frame (const uint8_t * const p_buffer,
+        void * const p_data)
+{
+    return re_ibeacon_decode (p_buffer, (re_ibeacon_data_t *) p_data);
+}
+
+re_status_t re_ibeacon_decode_batch (const uint8_t * const * const pp_buffers,
+                                     const size_t num_buffers,
+                                     re_ibeacon_data_t * const p_data,
+                                     re_status_t * const p_status)
+{
+    return re_decode_batch (pp_buffers, num_buffers, p_data, sizeof (re_ibeacon_data_t),
+                            &re_ibeacon_decode_frame, p_status);
+}
 #endif
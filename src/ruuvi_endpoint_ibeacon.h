@@ -1,12 +1,18 @@
 #ifndef RUUVI_ENDPOINT_IBEACON_H
 #define RUUVI_ENDPOINT_IBEACON_H
 #include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stddef.h>
 
 #define RE_IBEACON_OFFSET_EXCEPT_HEADER
 #define RE_IBEACON_PROXIMITY_UUID_SIZE              16
 #define RE_IBEACON_INVALID_TX_POWER                 127
+#define RE_IBEACON_DATA_LENGTH                      (21U) //!< UUID, major, minor, TX power.
+#define RE_IBEACON_RAW_HEADER_LEN                   (9U)  //!< Flags and iBeacon prefix.
+#define RE_IBEACON_RAW_MIN_LEN (RE_IBEACON_RAW_HEADER_LEN + RE_IBEACON_DATA_LENGTH) //!< Shortest decodable buffer.
 
 #ifndef RE_IBEACON_OFFSET_EXCEPT_HEADER
+#define RE_IBEACON_OFFSET_PAYLOAD                   0
 #define RE_IBEACON_OFFSET_PROXIMITY_UUID            9
 #define RE_IBEACON_OFFSET_MAJOR_MSB                 25
 #define RE_IBEACON_OFFSET_MAJOR_LSB                 26
@@ -14,6 +20,7 @@
 #define RE_IBEACON_OFFSET_MINOR_LSB                 28
 #define RE_IBEACON_OFFSET_TX_POWER                  29
 #else
+#define RE_IBEACON_OFFSET_PAYLOAD                   9
 #define RE_IBEACON_OFFSET_PROXIMITY_UUID            0
 #define RE_IBEACON_OFFSET_MAJOR_MSB                 16
 #define RE_IBEACON_OFFSET_MAJOR_LSB                 17
@@ -47,4 +54,60 @@ typedef struct
 re_status_t re_ibeacon_encode (uint8_t * const buffer,
                                const re_ibeacon_data_t * data);
 
+/**
+ * @brief Checks if the provided buffer is an iBeacon advertisement.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 30 bytes to be checked.
+ * @return Returns 'true' if the buffer format is iBeacon, 'false' otherwise.
+ */
+bool re_ibeacon_check_format (const uint8_t * const p_buffer);
+
+/**
+ * @brief Decode iBeacon advertisement.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array with a length of 30 bytes
+ *  representing a Bluetooth frame with iBeacon payload.
+ * @param[out] p_data Pointer to a re_ibeacon_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the frame does not have iBeacon type and length.
+ */
+re_status_t re_ibeacon_decode (const uint8_t * const p_buffer,
+                               re_ibeacon_data_t * const p_data);
+
+/**
+ * @brief Decode iBeacon advertisement of known length.
+ *
+ * Length-checked variant of @ref re_ibeacon_decode for untrusted input. The buffer is
+ * rejected with a single length comparison before any byte is read.
+ *
+ * @param[in] p_buffer Pointer to a uint8_t input array representing a Bluetooth frame
+ *  with iBeacon payload.
+ * @param[in] buf_len Number of valid bytes in p_buffer.
+ * @param[out] p_data Pointer to a re_ibeacon_data_t struct.
+ * @retval RE_SUCCESS if the data was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buf_len is less than RE_IBEACON_RAW_MIN_LEN.
+ * @retval RE_ERROR_INVALID_PARAM if the frame does not have iBeacon type and length.
+ */
+re_status_t re_ibeacon_decode_checked (const uint8_t * const p_buffer,
+                                       const size_t buf_len,
+                                       re_ibeacon_data_t * const p_data);
+
+/**
+ * @brief Decode an array of iBeacon advertisements.
+ *
+ * @param[in] pp_buffers Array of num_buffers pointers to frames as in @ref re_ibeacon_decode.
+ * @param[in] num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers re_ibeacon_data_t structs.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers or p_data is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+re_status_t re_ibeacon_decode_batch (const uint8_t * const * const pp_buffers,
+                                     const size_t num_buffers,
+                                     re_ibeacon_data_t * const p_data,
+                                     re_status_t * const p_status);
+
 #endif // RUUVI_ENDPOINT_IBEACON_H
@@ -0,0 +1,173 @@
+#include "ruuvi_endpoint_imu.h"
+#include "ruuvi_endpoints.h"
+#include <math.h>
+#include <stddef.h>
+
+#if RE_IMU_ENABLED
+
+#define RE_IMU_AXES      (3U)
+#define RE_IMU_VALUE_MAX (32767.0F)
+
+static re_float re_imu_scale (const uint8_t source)
+{
+    re_float scale = 0.0F;
+
+    if (RE_ACC_XYZ == source)
+    {
+        scale = RE_IMU_ACCELERATION_SF;
+    }
+    else if (RE_GYR_XYZ == source)
+    {
+        scale = RE_IMU_GYRATION_SF;
+    }
+    else
+    {
+        // No packed encoding for source.
+    }
+
+    return scale;
+}
+
+static void re_imu_write_u16 (uint8_t * const p_msb, const uint16_t value)
+{
+    p_msb[0] = (uint8_t) ( (value >> RE_BYTE_1_SHIFT) & RE_BYTE_MASK);
+    p_msb[1] = (uint8_t) (value & RE_BYTE_MASK);
+}
+
+static uint16_t re_imu_read_u16 (const uint8_t * const p_msb)
+{
+    return (uint16_t) ( ( (uint16_t) p_msb[0] << RE_BYTE_1_SHIFT) | p_msb[1]);
+}
+
+static uint16_t re_imu_encode_value (const re_float value, const re_float scale)
+{
+    uint16_t coded = RE_IMU_INVALID;
+
+    if (!isnan (value))
+    {
+        const re_float scaled = re_clip_float (roundf (value * scale), -RE_IMU_VALUE_MAX,
+                                               RE_IMU_VALUE_MAX);
+        coded = (uint16_t) (int16_t) scaled;
+    }
+
+    return coded;
+}
+
+/**
+ * @brief Decode one value, written without branches on data so that the
+ *        sample loop can be vectorised.
+ */
+static inline re_float re_imu_decode_value (const uint8_t * const p_msb,
+        const re_float inv_scale)
+{
+    const uint16_t coded = re_imu_read_u16 (p_msb);
+    const re_float value = (re_float) (int16_t) coded * inv_scale;
+    return (RE_IMU_INVALID == coded) ? NAN : value;
+}
+
+re_status_t re_imu_stream_encode (uint8_t * const buffer, const size_t buf_len,
+                                  re_imu_stream_t * const p_stream,
+                                  const re_float * const p_xyz,
+                                  const size_t num_samples)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == buffer) || (NULL == p_stream) || (NULL == p_xyz))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U == num_samples) || (buf_len < RE_IMU_LENGTH (1U)))
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else if (0.0F == re_imu_scale (p_stream->source))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const re_float scale = re_imu_scale (p_stream->source);
+        size_t count = (buf_len - RE_IMU_HEADER_LEN) / RE_IMU_SAMPLE_LEN;
+        uint8_t * p_sample = &buffer[RE_IMU_PAYLOAD_IDX];
+
+        if (count > num_samples)
+        {
+            count = num_samples;
+        }
+
+        if (count > RE_IMU_MAX_SAMPLES)
+        {
+            count = RE_IMU_MAX_SAMPLES;
+        }
+
+        buffer[RE_STANDARD_SOURCE_INDEX] = p_stream->source;
+        buffer[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_IMU_STREAM_WRITE;
+        re_imu_write_u16 (&buffer[RE_IMU_SEQUENCE_MSB_IDX], p_stream->sequence);
+        re_imu_write_u16 (&buffer[RE_IMU_RATE_MSB_IDX], p_stream->sample_rate_hz);
+        buffer[RE_IMU_NUM_SAMPLES_IDX] = (uint8_t) count;
+
+        for (size_t ii = 0; ii < (count * RE_IMU_AXES); ii++)
+        {
+            re_imu_write_u16 (p_sample, re_imu_encode_value (p_xyz[ii], scale));
+            p_sample += sizeof (uint16_t);
+        }
+
+        p_stream->num_samples = (uint8_t) count;
+        p_stream->sequence++;
+    }
+
+    return result;
+}
+
+re_status_t re_imu_stream_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                  re_imu_stream_t * const p_stream,
+                                  re_float * const p_x,
+                                  re_float * const p_y,
+                                  re_float * const p_z)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_msg) || (NULL == p_stream) || (NULL == p_x) || (NULL == p_y)
+            || (NULL == p_z))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (msg_len < RE_IMU_HEADER_LEN)
+    {
+        result |= RE_ERROR_DECODING_LEN;
+    }
+    else if (RE_STANDARD_IMU_STREAM_WRITE != p_msg[RE_STANDARD_OPERATION_INDEX])
+    {
+        result |= RE_ERROR_DECODING_CMD;
+    }
+    else if (RE_IMU_LENGTH ( (size_t) p_msg[RE_IMU_NUM_SAMPLES_IDX]) > msg_len)
+    {
+        result |= RE_ERROR_DECODING_LEN;
+    }
+    else if (0.0F == re_imu_scale (p_msg[RE_STANDARD_SOURCE_INDEX]))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const re_float inv_scale = 1.0F / re_imu_scale (p_msg[RE_STANDARD_SOURCE_INDEX]);
+        const uint8_t * const p_samples = &p_msg[RE_IMU_PAYLOAD_IDX];
+        const size_t count = p_msg[RE_IMU_NUM_SAMPLES_IDX];
+        p_stream->source = p_msg[RE_STANDARD_SOURCE_INDEX];
+        p_stream->sequence = re_imu_read_u16 (&p_msg[RE_IMU_SEQUENCE_MSB_IDX]);
+        p_stream->sample_rate_hz = re_imu_read_u16 (&p_msg[RE_IMU_RATE_MSB_IDX]);
+        p_stream->num_samples = (uint8_t) count;
+
+        for (size_t ii = 0; ii < count; ii++)
+        {
+            const uint8_t * const p_sample = &p_samples[ii * RE_IMU_SAMPLE_LEN];
+            p_x[ii] = re_imu_decode_value (&p_sample[0], inv_scale);
+            p_y[ii] = re_imu_decode_value (&p_sample[2], inv_scale);
+            p_z[ii] = re_imu_decode_value (&p_sample[4], inv_scale);
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * Ruuvi Endpoint packed IMU stream.
+ *
+ * An IMU stream message carries consecutive XYZ samples of acceleration or
+ * gyration as big-endian int16 triplets. Samples are taken at the rate given
+ * in the header, the sequence number of the message tells the central how
+ * many samples were lost in between. One notification of ATT MTU 247 holds
+ * 39 samples, enough for continuous 100 Hz streaming.
+ *
+ * Message layout:
+ *  0     Destination
+ *  1     Source, RE_ACC_XYZ or RE_GYR_XYZ
+ *  2     RE_STANDARD_IMU_STREAM_WRITE
+ *  3-4   Sequence number of message
+ *  5-6   Sample rate, Hz
+ *  7     Number of samples
+ *  8-    Samples, X Y Z int16 each
+ *
+ * Acceleration is encoded in mg and gyration in 0.1 dps, values saturate to
+ * the int16 range. RE_IMU_INVALID marks a value which was not available.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINT_IMU_H
+#define RUUVI_ENDPOINT_IMU_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_IMU_SEQUENCE_MSB_IDX    (3U)      //!< MSB of message sequence number.
+#define RE_IMU_RATE_MSB_IDX        (5U)      //!< MSB of sample rate.
+#define RE_IMU_NUM_SAMPLES_IDX     (7U)      //!< Number of samples.
+#define RE_IMU_PAYLOAD_IDX         (8U)      //!< First sample.
+#define RE_IMU_HEADER_LEN          (8U)      //!< Bytes before first sample.
+#define RE_IMU_SAMPLE_LEN          (6U)      //!< Bytes of one XYZ sample.
+#define RE_IMU_MAX_SAMPLES         (255U)    //!< Samples in one message at most.
+#define RE_IMU_INVALID             (0x8000U) //!< Value not available.
+#define RE_IMU_ACCELERATION_SF     (1000.0F) //!< g -> mg.
+#define RE_IMU_GYRATION_SF         (10.0F)   //!< dps -> 0.1 dps.
+
+/** @brief Bytes of a message with given number of samples. */
+#define RE_IMU_LENGTH(num_samples) (RE_IMU_HEADER_LEN + ((num_samples) * RE_IMU_SAMPLE_LEN))
+
+/** @brief Header of an IMU stream message. */
+typedef struct
+{
+    uint8_t source;          //!< RE_ACC_XYZ or RE_GYR_XYZ.
+    uint16_t sequence;       //!< Message counter, wraps around.
+    uint16_t sample_rate_hz; //!< Rate at which samples were taken.
+    uint8_t num_samples;     //!< Samples in message.
+} re_imu_stream_t;
+
+/**
+ * @brief Encode samples from a FIFO batch into an IMU stream message.
+ *
+ * Encodes as many samples as fit in the buffer, the rest are left for the
+ * next message. On success p_stream->sequence is incremented so that
+ * consecutive calls number the messages, and p_stream->num_samples is the
+ * number of samples consumed from the batch. As with
+ * @ref re_log_write_header, destination byte is not modified.
+ *
+ * @param[out]    buffer Message buffer, send RE_IMU_LENGTH(num_samples) bytes.
+ * @param[in]     buf_len Size of buffer.
+ * @param[in,out] p_stream Source, sequence and sample rate of message.
+ * @param[in]     p_xyz Interleaved X Y Z samples in g or dps as read from sensor FIFO.
+ * @param[in]     num_samples Number of XYZ samples in batch.
+ * @retval RE_SUCCESS if at least one sample was encoded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if batch is empty or buffer has no room for a sample.
+ * @retval RE_ERROR_INVALID_PARAM if source is not RE_ACC_XYZ or RE_GYR_XYZ.
+ */
+re_status_t re_imu_stream_encode (uint8_t * const buffer, const size_t buf_len,
+                                  re_imu_stream_t * const p_stream,
+                                  const re_float * const p_xyz,
+                                  const size_t num_samples);
+
+/**
+ * @brief Decode an IMU stream message into column arrays.
+ *
+ * Each output array must have room for every sample of the message, at most
+ * RE_IMU_MAX_SAMPLES. Invalid values are decoded as NAN.
+ *
+ * @param[in]  p_msg Received message.
+ * @param[in]  msg_len Number of received bytes.
+ * @param[out] p_stream Header of message.
+ * @param[out] p_x X values in g or dps.
+ * @param[out] p_y Y values in g or dps.
+ * @param[out] p_z Z values in g or dps.
+ * @retval RE_SUCCESS if message was decoded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DECODING_CMD if operation is not RE_STANDARD_IMU_STREAM_WRITE.
+ * @retval RE_ERROR_DECODING_LEN if samples do not fit in msg_len.
+ * @retval RE_ERROR_INVALID_PARAM if source is not RE_ACC_XYZ or RE_GYR_XYZ.
+ */
+re_status_t re_imu_stream_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                  re_imu_stream_t * const p_stream,
+                                  re_float * const p_x,
+                                  re_float * const p_y,
+                                  re_float * const p_z);
+
+#endif // RUUVI_ENDPOINT_IMU_H
@@ -0,0 +1,384 @@
+#include "ruuvi_endpoint_log_airq.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#include "ruuvi_endpoints_internal.h"
+
+#if RE_LOG_AIRQ_ENABLED
+
+#define RE_LOG_AIRQ_RESERVED_LEN (RE_LOG_WRITE_AIRQ_RECORD_LEN - RE_LOG_WRITE_AIRQ_RESERVED1_OFS)
+#define RE_LOG_AIRQ_RESERVED_VAL (0xFFU)
+
+static void re_log_airq_write_u32 (uint8_t * const p_msb, const uint32_t value)
+{
+    p_msb[0] = (uint8_t) ( (value >> RE_BYTE_3_SHIFT) & RE_BYTE_MASK);
+    p_msb[1] = (uint8_t) ( (value >> RE_BYTE_2_SHIFT) & RE_BYTE_MASK);
+    p_msb[2] = (uint8_t) ( (value >> RE_BYTE_1_SHIFT) & RE_BYTE_MASK);
+    p_msb[3] = (uint8_t) (value & RE_BYTE_MASK);
+}
+
+static uint32_t re_log_airq_read_u32 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << RE_BYTE_3_SHIFT)
+           | ( (uint32_t) p_msb[1] << RE_BYTE_2_SHIFT)
+           | ( (uint32_t) p_msb[2] << RE_BYTE_1_SHIFT)
+           | p_msb[3];
+}
+
+static uint32_t re_log_airq_read_u24 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << RE_BYTE_2_SHIFT)
+           | ( (uint32_t) p_msb[1] << RE_BYTE_1_SHIFT)
+           | p_msb[2];
+}
+
+static re_e1_flags_t re_log_airq_decode_flags (const uint8_t flags)
+{
+    const re_e1_flags_t decoded =
+    {
+        .flag_calibration_in_progress = (0U != (flags & RE_E1_FLAGS_CALIBRATION_IN_PROGRESS)),
+        .flag_button_pressed          = (0U != (flags & RE_E1_FLAGS_BUTTON_PRESSED)),
+        .flag_rtc_running_on_boot     = (0U != (flags & RE_E1_FLAGS_RTC_RUNNING_ON_BOOT)),
+    };
+    return decoded;
+}
+
+static re_float re_log_airq_decode_luminosity (const uint8_t * const p_slot)
+{
+    return re_decode_u24 (p_slot, RE_E1_INVALID_LUMINOSITY, RE_E1_LUMINOSITY_MIN,
+                          RE_E1_LUMINOSITY_RATIO);
+}
+
+re_status_t re_log_airq_encode (uint8_t * const p_record,
+                                const re_log_airq_record_t * const p_data)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_record) || (NULL == p_data))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        const re_e1_data_t * const p_meas = &p_data->measurement;
+        uint8_t * const p_flags = &p_record[RE_LOG_WRITE_AIRQ_FLAGS_OFS];
+        memset (p_record, 0, RE_LOG_WRITE_AIRQ_RECORD_LEN);
+        re_log_airq_write_u32 (&p_record[RE_LOG_WRITE_AIRQ_TIMESTAMP_MSB_OFS],
+                               p_data->timestamp_s);
+        p_record[RE_LOG_WRITE_AIRQ_DATA_FORMAT_OFS] = RE_LOG_AIRQ_DATA_FORMAT;
+        re_encode_i16 (&p_record[RE_LOG_WRITE_AIRQ_TEMPERATURE_MSB_OFS],
+                       &re_e1_coeffs_temperature, p_meas->temperature_c);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_HUMIDITY_MSB_OFS],
+                       &re_e1_coeffs_humidity, p_meas->humidity_rh);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PRESSURE_MSB_OFS],
+                       &re_e1_coeffs_pressure, p_meas->pressure_pa);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM1P0_MSB_OFS],
+                       &re_e1_coeffs_pm, p_meas->pm1p0_ppm);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM2P5_MSB_OFS],
+                       &re_e1_coeffs_pm, p_meas->pm2p5_ppm);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM4P0_MSB_OFS],
+                       &re_e1_coeffs_pm, p_meas->pm4p0_ppm);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM10P0_MSB_OFS],
+                       &re_e1_coeffs_pm, p_meas->pm10p0_ppm);
+        re_encode_u16 (&p_record[RE_LOG_WRITE_AIRQ_CO2_MSB_OFS],
+                       &re_e1_coeffs_co2, p_meas->co2);
+        re_encode_u9 (&p_record[RE_LOG_WRITE_AIRQ_VOC_MSB_OFS], p_flags,
+                      &re_e1_coeffs_voc, p_meas->voc);
+        re_encode_u9 (&p_record[RE_LOG_WRITE_AIRQ_NOX_MSB_OFS], p_flags,
+                      &re_e1_coeffs_nox, p_meas->nox);
+        re_encode_u24 (&p_record[RE_LOG_WRITE_AIRQ_LUMINOSITY_MSB_OFS], p_meas->luminosity,
+                       RE_E1_INVALID_LUMINOSITY, RE_E1_LUMINOSITY_MIN,
+                       RE_E1_LUMINOSITY_MAX, RE_E1_LUMINOSITY_RATIO);
+        re_encode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_INST_DBA_OFS], p_flags,
+                      &re_e1_coeffs_sound_inst_dba, p_meas->sound_inst_dba);
+        re_encode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_AVG_DBA_OFS], p_flags,
+                      &re_e1_coeffs_sound_avg_dba, p_meas->sound_avg_dba);
+        re_encode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_PEAK_SPL_DB_OFS], p_flags,
+                      &re_e1_coeffs_sound_peak_spl_db, p_meas->sound_peak_spl_db);
+        p_record[RE_LOG_WRITE_AIRQ_SEQ_CNT_MSB_OFS] =
+            re_be24_get_high_byte (p_meas->seq_cnt);
+        p_record[RE_LOG_WRITE_AIRQ_SEQ_CNT_MSB_OFS + 1U] =
+            re_be24_get_mid_byte (p_meas->seq_cnt);
+        p_record[RE_LOG_WRITE_AIRQ_SEQ_CNT_MSB_OFS + 2U] =
+            re_be24_get_low_byte (p_meas->seq_cnt);
+
+        if (p_meas->flags.flag_calibration_in_progress)
+        {
+            *p_flags |= RE_E1_FLAGS_CALIBRATION_IN_PROGRESS;
+        }
+
+        if (p_meas->flags.flag_button_pressed)
+        {
+            *p_flags |= RE_E1_FLAGS_BUTTON_PRESSED;
+        }
+
+        if (p_meas->flags.flag_rtc_running_on_boot)
+        {
+            *p_flags |= RE_E1_FLAGS_RTC_RUNNING_ON_BOOT;
+        }
+
+        p_record[RE_LOG_WRITE_AIRQ_FW_VER_OFS] = p_data->fw_version;
+        memset (&p_record[RE_LOG_WRITE_AIRQ_RESERVED1_OFS], RE_LOG_AIRQ_RESERVED_VAL,
+                RE_LOG_AIRQ_RESERVED_LEN);
+    }
+
+    return result;
+}
+
+re_status_t re_log_airq_decode (const uint8_t * const p_record,
+                                re_log_airq_record_t * const p_data)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_record) || (NULL == p_data))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (RE_LOG_AIRQ_DATA_FORMAT != p_record[RE_LOG_WRITE_AIRQ_DATA_FORMAT_OFS])
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        re_e1_data_t * const p_meas = &p_data->measurement;
+        const uint8_t * const p_flags = &p_record[RE_LOG_WRITE_AIRQ_FLAGS_OFS];
+        memset (p_data, 0, sizeof (*p_data));
+        p_data->timestamp_s =
+            re_log_airq_read_u32 (&p_record[RE_LOG_WRITE_AIRQ_TIMESTAMP_MSB_OFS]);
+        p_data->fw_version = p_record[RE_LOG_WRITE_AIRQ_FW_VER_OFS];
+        p_meas->temperature_c = re_decode_i16 (&p_record[RE_LOG_WRITE_AIRQ_TEMPERATURE_MSB_OFS],
+                                               &re_e1_coeffs_temperature);
+        p_meas->humidity_rh = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_HUMIDITY_MSB_OFS],
+                                             &re_e1_coeffs_humidity);
+        p_meas->pressure_pa = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PRESSURE_MSB_OFS],
+                                             &re_e1_coeffs_pressure);
+        p_meas->pm1p0_ppm = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM1P0_MSB_OFS],
+                                           &re_e1_coeffs_pm);
+        p_meas->pm2p5_ppm = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM2P5_MSB_OFS],
+                                           &re_e1_coeffs_pm);
+        p_meas->pm4p0_ppm = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM4P0_MSB_OFS],
+                                           &re_e1_coeffs_pm);
+        p_meas->pm10p0_ppm = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_PM10P0_MSB_OFS],
+                                            &re_e1_coeffs_pm);
+        p_meas->co2 = re_decode_u16 (&p_record[RE_LOG_WRITE_AIRQ_CO2_MSB_OFS],
+                                     &re_e1_coeffs_co2);
+        p_meas->voc = re_decode_u9 (&p_record[RE_LOG_WRITE_AIRQ_VOC_MSB_OFS], p_flags,
+                                    &re_e1_coeffs_voc);
+        p_meas->nox = re_decode_u9 (&p_record[RE_LOG_WRITE_AIRQ_NOX_MSB_OFS], p_flags,
+                                    &re_e1_coeffs_nox);
+        p_meas->luminosity =
+            re_log_airq_decode_luminosity (&p_record[RE_LOG_WRITE_AIRQ_LUMINOSITY_MSB_OFS]);
+        p_meas->sound_inst_dba = re_decode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_INST_DBA_OFS],
+                                               p_flags, &re_e1_coeffs_sound_inst_dba);
+        p_meas->sound_avg_dba = re_decode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_AVG_DBA_OFS],
+                                              p_flags, &re_e1_coeffs_sound_avg_dba);
+        p_meas->sound_peak_spl_db =
+            re_decode_u9 (&p_record[RE_LOG_WRITE_AIRQ_SOUND_PEAK_SPL_DB_OFS],
+                          p_flags, &re_e1_coeffs_sound_peak_spl_db);
+        p_meas->seq_cnt = re_log_airq_read_u24 (&p_record[RE_LOG_WRITE_AIRQ_SEQ_CNT_MSB_OFS]);
+        p_meas->flags = re_log_airq_decode_flags (*p_flags);
+    }
+
+    return result;
+}
+
+static void re_log_airq_column_i16 (const re_log_multi_t * const p_log, const size_t offset,
+                                    const re_i16_coeffs_t * const p_coeffs,
+                                    re_float * const p_column)
+{
+    if (NULL != p_column)
+    {
+        const uint8_t * p_slot = &p_log->p_records[offset];
+
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            p_column[ii] = re_decode_i16 (p_slot, p_coeffs);
+            p_slot += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+        }
+    }
+}
+
+static void re_log_airq_column_u16 (const re_log_multi_t * const p_log, const size_t offset,
+                                    const re_u16_coeffs_t * const p_coeffs,
+                                    re_float * const p_column)
+{
+    if (NULL != p_column)
+    {
+        const uint8_t * p_slot = &p_log->p_records[offset];
+
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            p_column[ii] = re_decode_u16 (p_slot, p_coeffs);
+            p_slot += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+        }
+    }
+}
+
+static void re_log_airq_column_u9 (const re_log_multi_t * const p_log, const size_t offset,
+                                   const re_u9_coeffs_t * const p_coeffs,
+                                   re_float * const p_column)
+{
+    if (NULL != p_column)
+    {
+        const uint8_t * p_slot = &p_log->p_records[offset];
+        const uint8_t * p_flags = &p_log->p_records[RE_LOG_WRITE_AIRQ_FLAGS_OFS];
+
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            p_column[ii] = re_decode_u9 (p_slot, p_flags, p_coeffs);
+            p_slot += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+            p_flags += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+        }
+    }
+}
+
+static void re_log_airq_column_luminosity (const re_log_multi_t * const p_log,
+        re_float * const p_column)
+{
+    if (NULL != p_column)
+    {
+        const uint8_t * p_slot = &p_log->p_records[RE_LOG_WRITE_AIRQ_LUMINOSITY_MSB_OFS];
+
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            p_column[ii] = re_log_airq_decode_luminosity (p_slot);
+            p_slot += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+        }
+    }
+}
+
+static void re_log_airq_column_raw (const re_log_multi_t * const p_log,
+                                    const re_log_airq_columns_t * const p_columns)
+{
+    const uint8_t * p_record = p_log->p_records;
+
+    for (size_t ii = 0; ii < p_log->num_records; ii++)
+    {
+        if (NULL != p_columns->p_timestamps_s)
+        {
+            p_columns->p_timestamps_s[ii] =
+                re_log_airq_read_u32 (&p_record[RE_LOG_WRITE_AIRQ_TIMESTAMP_MSB_OFS]);
+        }
+
+        if (NULL != p_columns->p_seq_cnt)
+        {
+            p_columns->p_seq_cnt[ii] =
+                re_log_airq_read_u24 (&p_record[RE_LOG_WRITE_AIRQ_SEQ_CNT_MSB_OFS]);
+        }
+
+        if (NULL != p_columns->p_flags)
+        {
+            p_columns->p_flags[ii] =
+                re_log_airq_decode_flags (p_record[RE_LOG_WRITE_AIRQ_FLAGS_OFS]);
+        }
+
+        p_record += RE_LOG_WRITE_AIRQ_RECORD_LEN;
+    }
+}
+
+static void re_log_airq_set_nan (re_float * const p_column, const size_t index)
+{
+    if (NULL != p_column)
+    {
+        p_column[index] = NAN;
+    }
+}
+
+/**
+ * @brief Overwrite values of a record with unknown data format, timestamp is kept.
+ */
+static void re_log_airq_invalidate_row (const re_log_airq_columns_t * const p_columns,
+                                        const size_t index)
+{
+    const re_e1_flags_t no_flags = re_log_airq_decode_flags (0U);
+    re_log_airq_set_nan (p_columns->p_temperature_c, index);
+    re_log_airq_set_nan (p_columns->p_humidity_rh, index);
+    re_log_airq_set_nan (p_columns->p_pressure_pa, index);
+    re_log_airq_set_nan (p_columns->p_pm1p0_ppm, index);
+    re_log_airq_set_nan (p_columns->p_pm2p5_ppm, index);
+    re_log_airq_set_nan (p_columns->p_pm4p0_ppm, index);
+    re_log_airq_set_nan (p_columns->p_pm10p0_ppm, index);
+    re_log_airq_set_nan (p_columns->p_co2, index);
+    re_log_airq_set_nan (p_columns->p_voc, index);
+    re_log_airq_set_nan (p_columns->p_nox, index);
+    re_log_airq_set_nan (p_columns->p_luminosity, index);
+    re_log_airq_set_nan (p_columns->p_sound_inst_dba, index);
+    re_log_airq_set_nan (p_columns->p_sound_avg_dba, index);
+    re_log_airq_set_nan (p_columns->p_sound_peak_spl_db, index);
+
+    if (NULL != p_columns->p_seq_cnt)
+    {
+        p_columns->p_seq_cnt[index] = RE_E1_INVALID_SEQUENCE;
+    }
+
+    if (NULL != p_columns->p_flags)
+    {
+        p_columns->p_flags[index] = no_flags;
+    }
+}
+
+re_status_t re_log_airq_decode_columns (const re_log_multi_t * const p_log,
+                                        const re_log_airq_columns_t * const p_columns)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_log) || (NULL == p_log->p_records) || (NULL == p_columns))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (RE_ENV_AIRQ != p_log->source)
+              || (RE_LOG_WRITE_AIRQ_RECORD_LEN != p_log->record_len))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        re_log_airq_column_raw (p_log, p_columns);
+        re_log_airq_column_i16 (p_log, RE_LOG_WRITE_AIRQ_TEMPERATURE_MSB_OFS,
+                                &re_e1_coeffs_temperature, p_columns->p_temperature_c);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_HUMIDITY_MSB_OFS,
+                                &re_e1_coeffs_humidity, p_columns->p_humidity_rh);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_PRESSURE_MSB_OFS,
+                                &re_e1_coeffs_pressure, p_columns->p_pressure_pa);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_PM1P0_MSB_OFS,
+                                &re_e1_coeffs_pm, p_columns->p_pm1p0_ppm);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_PM2P5_MSB_OFS,
+                                &re_e1_coeffs_pm, p_columns->p_pm2p5_ppm);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_PM4P0_MSB_OFS,
+                                &re_e1_coeffs_pm, p_columns->p_pm4p0_ppm);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_PM10P0_MSB_OFS,
+                                &re_e1_coeffs_pm, p_columns->p_pm10p0_ppm);
+        re_log_airq_column_u16 (p_log, RE_LOG_WRITE_AIRQ_CO2_MSB_OFS,
+                                &re_e1_coeffs_co2, p_columns->p_co2);
+        re_log_airq_column_u9 (p_log, RE_LOG_WRITE_AIRQ_VOC_MSB_OFS,
+                               &re_e1_coeffs_voc, p_columns->p_voc);
+        re_log_airq_column_u9 (p_log, RE_LOG_WRITE_AIRQ_NOX_MSB_OFS,
+                               &re_e1_coeffs_nox, p_columns->p_nox);
+        re_log_airq_column_luminosity (p_log, p_columns->p_luminosity);
+        re_log_airq_column_u9 (p_log, RE_LOG_WRITE_AIRQ_SOUND_INST_DBA_OFS,
+                               &re_e1_coeffs_sound_inst_dba, p_columns->p_sound_inst_dba);
+        re_log_airq_column_u9 (p_log, RE_LOG_WRITE_AIRQ_SOUND_AVG_DBA_OFS,
+                               &re_e1_coeffs_sound_avg_dba, p_columns->p_sound_avg_dba);
+        re_log_airq_column_u9 (p_log, RE_LOG_WRITE_AIRQ_SOUND_PEAK_SPL_DB_OFS,
+                               &re_e1_coeffs_sound_peak_spl_db, p_columns->p_sound_peak_spl_db);
+
+        // Unknown formats are rare, fix them up after the fast passes.
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            const size_t format_ofs = (ii * RE_LOG_WRITE_AIRQ_RECORD_LEN)
+                                      + RE_LOG_WRITE_AIRQ_DATA_FORMAT_OFS;
+
+            if (RE_LOG_AIRQ_DATA_FORMAT != p_log->p_records[format_ofs])
+            {
+                re_log_airq_invalidate_row (p_columns, ii);
+                result |= RE_ERROR_DECODING;
+            }
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * Ruuvi Endpoint AirQ log record helper.
+ *
+ * AirQ history is sent as RE_LOG_WRITE_AIRQ_RECORD_LEN byte records, a 32-bit
+ * timestamp in seconds followed by the DFxE1 payload without the MAC address.
+ * Values are scaled with the same coefficients as DFxE1 broadcasts, so a
+ * measurement decodes identically from history and from an advertisement.
+ *
+ * Records are usually received in LOG_MULTI messages, @ref re_log_airq_decode_columns
+ * decodes every record of a message into column arrays for bulk storage.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINT_LOG_AIRQ_H
+#define RUUVI_ENDPOINT_LOG_AIRQ_H
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_e1.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_LOG_AIRQ_DATA_FORMAT (RE_E1_DESTINATION) //!< Data format byte of a record.
+
+/** @brief Decoded AirQ log record. */
+typedef struct
+{
+    uint32_t timestamp_s;     //!< Timestamp of measurement in seconds.
+    uint8_t fw_version;       //!< Firmware version byte stored by the tag.
+    re_e1_data_t measurement; //!< Measurement, address is not logged and is 0.
+} re_log_airq_record_t;
+
+/**
+ * @brief Column arrays of decoded AirQ log records.
+ *
+ * Each non-NULL column has room for the number of decoded records. NULL
+ * columns are skipped, decode only the values that are stored.
+ */
+typedef struct
+{
+    uint32_t * p_timestamps_s;       //!< Timestamps in seconds.
+    re_float * p_temperature_c;      //!< Temperatures in degrees Celsius.
+    re_float * p_humidity_rh;        //!< Relative humidities in percent.
+    re_float * p_pressure_pa;        //!< Pressures in Pascals.
+    re_float * p_pm1p0_ppm;          //!< PM1.0 in micrograms/m3.
+    re_float * p_pm2p5_ppm;          //!< PM2.5 in micrograms/m3.
+    re_float * p_pm4p0_ppm;          //!< PM4.0 in micrograms/m3.
+    re_float * p_pm10p0_ppm;         //!< PM10.0 in micrograms/m3.
+    re_float * p_co2;                //!< CO2 concentrations in ppm.
+    re_float * p_voc;                //!< VOC index points.
+    re_float * p_nox;                //!< NOx index points.
+    re_float * p_luminosity;         //!< Luminosities.
+    re_float * p_sound_inst_dba;     //!< Instant sound levels in dBA.
+    re_float * p_sound_avg_dba;      //!< Average sound levels in dBA.
+    re_float * p_sound_peak_spl_db;  //!< Peak sound levels in dB.
+    re_e1_seq_cnt_t * p_seq_cnt;     //!< Measurement sequence counters.
+    re_e1_flags_t * p_flags;         //!< Flags.
+} re_log_airq_columns_t;
+
+/**
+ * @brief Encode an AirQ log record.
+ *
+ * NAN can be used as a placeholder for invalid / not available values.
+ * Address of the measurement is not encoded.
+ *
+ * @param[out] p_record Buffer of RE_LOG_WRITE_AIRQ_RECORD_LEN bytes.
+ * @param[in]  p_data Record to encode.
+ * @retval RE_SUCCESS if record was encoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ */
+re_status_t re_log_airq_encode (uint8_t * const p_record,
+                                const re_log_airq_record_t * const p_data);
+
+/**
+ * @brief Decode an AirQ log record.
+ *
+ * @param[in]  p_record Buffer of RE_LOG_WRITE_AIRQ_RECORD_LEN bytes.
+ * @param[out] p_data Decoded record.
+ * @retval RE_SUCCESS if record was decoded successfully.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if data format of record is not DFxE1.
+ */
+re_status_t re_log_airq_decode (const uint8_t * const p_record,
+                                re_log_airq_record_t * const p_data);
+
+/**
+ * @brief Decode all records of a parsed LOG_MULTI message into column arrays.
+ *
+ * Columns are filled one at a time so that each pass runs a single decoder
+ * over the records. Records with an unknown data format are decoded as
+ * invalid: timestamp is kept, values are NAN, sequence counter is
+ * RE_E1_INVALID_SEQUENCE and flags are cleared.
+ *
+ * @param[in]  p_log Records from @ref re_log_multi_decode.
+ * @param[out] p_columns Column arrays of at least p_log->num_records elements.
+ * @retval RE_SUCCESS if every record was decoded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if source is not RE_ENV_AIRQ or records are
+ *                                not RE_LOG_WRITE_AIRQ_RECORD_LEN bytes.
+ * @retval RE_ERROR_DECODING if at least one record had an unknown data format.
+ */
+re_status_t re_log_airq_decode_columns (const re_log_multi_t * const p_log,
+                                        const re_log_airq_columns_t * const p_columns);
+
+#endif // RUUVI_ENDPOINT_LOG_AIRQ_H
@@ -0,0 +1,313 @@
+#include "ruuvi_endpoint_log_delta.h"
+#include "ruuvi_endpoints.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if RE_LOG_DELTA_ENABLED
+
+#define RE_LOG_DELTA_VARINT_DATA_MASK (0x7FU)
+#define RE_LOG_DELTA_VARINT_MORE_BIT  (0x80U)
+#define RE_LOG_DELTA_VARINT_SHIFT     (7U)
+#define RE_LOG_DELTA_SIGN_SHIFT       (63U)
+#define RE_LOG_DELTA_TIME_MAX         (0xFFFFFFFF)
+#define RE_LOG_DELTA_DOD_LIMIT        (0x200000000) //!< Largest delta-of-delta of 32-bit time.
+#define RE_LOG_DELTA_VALUE_LIMIT      (0x100000000) //!< Largest delta of 32-bit value.
+
+static uint32_t re_log_delta_read_u32 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << RE_BYTE_3_SHIFT)
+           | ( (uint32_t) p_msb[1] << RE_BYTE_2_SHIFT)
+           | ( (uint32_t) p_msb[2] << RE_BYTE_1_SHIFT)
+           | p_msb[3];
+}
+
+static uint64_t re_log_delta_zigzag (const int64_t value)
+{
+    const uint64_t bits = (uint64_t) value;
+    return (bits << 1U) ^ (0U - (bits >> RE_LOG_DELTA_SIGN_SHIFT));
+}
+
+static int64_t re_log_delta_unzigzag (const uint64_t value)
+{
+    return (int64_t) ( (value >> 1U) ^ (0U - (value & 1U)));
+}
+
+/**
+ * @brief Write a zigzag LEB128 varint.
+ *
+ * @return Number of bytes written, at most RE_LOG_DELTA_VARINT_MAX_LEN.
+ */
+static size_t re_log_delta_write_varint (uint8_t * const p_out, const int64_t value)
+{
+    uint64_t bits = re_log_delta_zigzag (value);
+    size_t len = 0;
+
+    while (bits > RE_LOG_DELTA_VARINT_DATA_MASK)
+    {
+        p_out[len] = (uint8_t) ( (bits & RE_LOG_DELTA_VARINT_DATA_MASK)
+                                 | RE_LOG_DELTA_VARINT_MORE_BIT);
+        bits >>= RE_LOG_DELTA_VARINT_SHIFT;
+        len++;
+    }
+
+    p_out[len] = (uint8_t) bits;
+    return len + 1U;
+}
+
+static re_status_t re_log_delta_read_varint (re_log_delta_decoder_t * const p_dec,
+        int64_t * const p_value)
+{
+    re_status_t result = RE_ERROR_DECODING_LEN;
+    uint64_t bits = 0;
+
+    for (size_t ii = 0; ii < RE_LOG_DELTA_VARINT_MAX_LEN; ii++)
+    {
+        if (p_dec->offset >= p_dec->msg_len)
+        {
+            break;
+        }
+
+        const uint8_t byte = p_dec->p_msg[p_dec->offset];
+        p_dec->offset++;
+        bits |= ( (uint64_t) (byte & RE_LOG_DELTA_VARINT_DATA_MASK))
+                << (ii * RE_LOG_DELTA_VARINT_SHIFT);
+
+        if (0U == (byte & RE_LOG_DELTA_VARINT_MORE_BIT))
+        {
+            *p_value = re_log_delta_unzigzag (bits);
+            result = RE_SUCCESS;
+            break;
+        }
+        else if ( (RE_LOG_DELTA_VARINT_MAX_LEN - 1U) == ii)
+        {
+            result = RE_ERROR_DECODING;
+        }
+        else
+        {
+            // Continue to next byte.
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_log_delta_encode_start (re_log_delta_encoder_t * const p_enc,
+                                       uint8_t * const p_buffer,
+                                       const size_t buf_len,
+                                       const uint8_t source)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_enc) || (NULL == p_buffer))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (buf_len < RE_LOG_DELTA_HEADER_LEN)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else if (0.0F == re_log_scale_factor (source))
+    {
+        result |= RE_ERROR_NOT_IMPLEMENTED;
+    }
+    else
+    {
+        memset (p_enc, 0, sizeof (*p_enc));
+        memset (&p_buffer[RE_STANDARD_SOURCE_INDEX], 0,
+                RE_LOG_DELTA_HEADER_LEN - RE_STANDARD_SOURCE_INDEX);
+        p_buffer[RE_STANDARD_SOURCE_INDEX] = source;
+        p_buffer[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_DELTA_WRITE;
+        p_enc->p_buffer = p_buffer;
+        p_enc->buf_len = buf_len;
+        p_enc->length = RE_LOG_DELTA_HEADER_LEN;
+    }
+
+    return result;
+}
+
+re_status_t re_log_delta_encode_value (re_log_delta_encoder_t * const p_enc,
+                                       const uint64_t timestamp_ms,
+                                       const re_float data)
+{
+    re_status_t result = RE_SUCCESS;
+    uint8_t message[RE_STANDARD_MESSAGE_LENGTH] = {0};
+
+    if ( (NULL == p_enc) || (NULL == p_enc->p_buffer))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (RE_LOG_DELTA_MAX_SAMPLES <= p_enc->p_buffer[RE_LOG_DELTA_NUM_SAMPLES_IDX])
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        // Scale and round exactly like single value messages.
+        result |= re_log_write_timestamp (message, timestamp_ms);
+        result |= re_log_write_data (message, data,
+                                     p_enc->p_buffer[RE_STANDARD_SOURCE_INDEX]);
+    }
+
+    if (RE_SUCCESS == result)
+    {
+        uint8_t * const p_buffer = p_enc->p_buffer;
+        const uint32_t timestamp_s = re_log_delta_read_u32 (&message[RE_LOG_WRITE_TS_MSB_IDX]);
+        const int32_t value = (int32_t) re_log_delta_read_u32 (
+                                  &message[RE_LOG_WRITE_VALUE_MSB_IDX]);
+        int64_t interval_s = 0;
+
+        if (0U == p_buffer[RE_LOG_DELTA_NUM_SAMPLES_IDX])
+        {
+            memcpy (&p_buffer[RE_LOG_DELTA_TS_MSB_IDX], &message[RE_LOG_WRITE_TS_MSB_IDX],
+                    RE_STANDARD_PAYLOAD_LENGTH);
+        }
+        else
+        {
+            uint8_t varints[2U * RE_LOG_DELTA_VARINT_MAX_LEN];
+            size_t len = 0;
+            interval_s = (int64_t) timestamp_s - (int64_t) p_enc->timestamp_s;
+            len += re_log_delta_write_varint (&varints[len], interval_s - p_enc->interval_s);
+            len += re_log_delta_write_varint (&varints[len],
+                                              (int64_t) value - (int64_t) p_enc->value);
+
+            if ( (p_enc->length + len) > p_enc->buf_len)
+            {
+                result |= RE_ERROR_DATA_SIZE;
+            }
+            else
+            {
+                memcpy (&p_buffer[p_enc->length], varints, len);
+                p_enc->length += len;
+            }
+        }
+
+        if (RE_SUCCESS == result)
+        {
+            p_buffer[RE_LOG_DELTA_NUM_SAMPLES_IDX]++;
+            p_enc->timestamp_s = timestamp_s;
+            p_enc->interval_s = interval_s;
+            p_enc->value = value;
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_log_delta_decode_start (re_log_delta_decoder_t * const p_dec,
+                                       const uint8_t * const p_msg,
+                                       const size_t msg_len)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_dec) || (NULL == p_msg))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (msg_len < RE_LOG_DELTA_HEADER_LEN)
+    {
+        result |= RE_ERROR_DECODING_LEN;
+    }
+    else if (RE_STANDARD_LOG_DELTA_WRITE != p_msg[RE_STANDARD_OPERATION_INDEX])
+    {
+        result |= RE_ERROR_DECODING_CMD;
+    }
+    else
+    {
+        memset (p_dec, 0, sizeof (*p_dec));
+        p_dec->scale = re_log_scale_factor (p_msg[RE_STANDARD_SOURCE_INDEX]);
+
+        if (0.0F == p_dec->scale)
+        {
+            result |= RE_ERROR_NOT_IMPLEMENTED;
+        }
+        else
+        {
+            p_dec->p_msg = p_msg;
+            p_dec->msg_len = msg_len;
+            p_dec->remaining = p_msg[RE_LOG_DELTA_NUM_SAMPLES_IDX];
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_log_delta_decode_next (re_log_delta_decoder_t * const p_dec,
+                                      uint32_t * const p_timestamp_s,
+                                      re_float * const p_value)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_dec) || (NULL == p_timestamp_s) || (NULL == p_value))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (0U == p_dec->remaining)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else if (0U == p_dec->offset)
+    {
+        p_dec->timestamp_s = re_log_delta_read_u32 (&p_dec->p_msg[RE_LOG_DELTA_TS_MSB_IDX]);
+        p_dec->value = (int32_t) re_log_delta_read_u32 (
+                           &p_dec->p_msg[RE_LOG_DELTA_VALUE_MSB_IDX]);
+        p_dec->offset = RE_LOG_DELTA_PAYLOAD_IDX;
+    }
+    else
+    {
+        int64_t dod = 0;
+        int64_t value_delta = 0;
+        result |= re_log_delta_read_varint (p_dec, &dod);
+
+        if (RE_SUCCESS == result)
+        {
+            result |= re_log_delta_read_varint (p_dec, &value_delta);
+        }
+
+        if ( (RE_SUCCESS == result)
+                && ( (dod > RE_LOG_DELTA_DOD_LIMIT) || (dod < -RE_LOG_DELTA_DOD_LIMIT)
+                     || (value_delta > RE_LOG_DELTA_VALUE_LIMIT)
+                     || (value_delta < -RE_LOG_DELTA_VALUE_LIMIT)))
+        {
+            result |= RE_ERROR_DECODING;
+        }
+
+        if (RE_SUCCESS == result)
+        {
+            const int64_t interval_s = p_dec->interval_s + dod;
+            const int64_t timestamp_s = (int64_t) p_dec->timestamp_s + interval_s;
+            const int64_t value = (int64_t) p_dec->value + value_delta;
+
+            if ( (timestamp_s < 0) || (timestamp_s > RE_LOG_DELTA_TIME_MAX)
+                    || (value < INT32_MIN) || (value > INT32_MAX))
+            {
+                result |= RE_ERROR_DECODING;
+            }
+            else
+            {
+                p_dec->interval_s = interval_s;
+                p_dec->timestamp_s = (uint32_t) timestamp_s;
+                p_dec->value = (int32_t) value;
+            }
+        }
+    }
+
+    if ( (NULL != p_dec) && (0U == (result & (RE_ERROR_NULL | RE_ERROR_DATA_SIZE))))
+    {
+        if (RE_SUCCESS == result)
+        {
+            *p_timestamp_s = p_dec->timestamp_s;
+            *p_value = (RE_STANDARD_INVALID_I32 == (uint32_t) p_dec->value)
+                       ? NAN : ( (re_float) p_dec->value / p_dec->scale);
+            p_dec->remaining--;
+        }
+        else
+        {
+            p_dec->remaining = 0;
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * Ruuvi Endpoint compressed log stream.
+ *
+ * A LOG_DELTA message carries samples of a single source. The first sample is
+ * stored in the header as in @ref re_log_write_timestamp and
+ * @ref re_log_write_data. Every following sample is two zigzag LEB128 varints:
+ * the change of the timestamp interval (delta-of-delta) and the change of the
+ * scaled value. Samples logged at a fixed interval with slowly changing
+ * values take 2 bytes each instead of 8.
+ *
+ * Each message is decodable on its own, a lost notification loses only its
+ * own samples.
+ *
+ * Message layout:
+ *  0     Destination
+ *  1     Source
+ *  2     RE_STANDARD_LOG_DELTA_WRITE
+ *  3     Number of samples
+ *  4-7   Timestamp of first sample, seconds
+ *  8-11  Scaled value of first sample, i32
+ *  12-   Varints of following samples
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINT_LOG_DELTA_H
+#define RUUVI_ENDPOINT_LOG_DELTA_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_LOG_DELTA_NUM_SAMPLES_IDX (3U)   //!< Number of samples.
+#define RE_LOG_DELTA_TS_MSB_IDX      (4U)   //!< MSB of first timestamp.
+#define RE_LOG_DELTA_VALUE_MSB_IDX   (8U)   //!< MSB of first value.
+#define RE_LOG_DELTA_PAYLOAD_IDX     (12U)  //!< First varint.
+#define RE_LOG_DELTA_HEADER_LEN      (12U)  //!< Bytes before first varint.
+#define RE_LOG_DELTA_MAX_SAMPLES     (255U) //!< Samples in one message at most.
+#define RE_LOG_DELTA_VARINT_MAX_LEN  (10U)  //!< Bytes of a 64-bit varint at most.
+
+/** @brief State of a message being encoded. */
+typedef struct
+{
+    uint8_t * p_buffer;    //!< Message.
+    size_t buf_len;        //!< Size of message buffer.
+    size_t length;         //!< Bytes of message used.
+    uint32_t timestamp_s;  //!< Timestamp of previous sample.
+    int64_t interval_s;    //!< Timestamp delta of previous sample.
+    int32_t value;         //!< Scaled value of previous sample.
+} re_log_delta_encoder_t;
+
+/** @brief State of a message being decoded. */
+typedef struct
+{
+    const uint8_t * p_msg; //!< Message.
+    size_t msg_len;        //!< Received bytes.
+    size_t offset;         //!< Next varint, 0 before first sample.
+    uint8_t remaining;     //!< Samples not yet decoded.
+    re_float scale;        //!< Scale factor of source.
+    uint32_t timestamp_s;  //!< Timestamp of previous sample.
+    int64_t interval_s;    //!< Timestamp delta of previous sample.
+    int32_t value;         //!< Scaled value of previous sample.
+} re_log_delta_decoder_t;
+
+/**
+ * @brief Start a LOG_DELTA message with no samples.
+ *
+ * As with @ref re_log_write_header, destination byte is not modified.
+ *
+ * @param[out] p_enc Encoder state.
+ * @param[out] p_buffer Message buffer.
+ * @param[in]  buf_len Size of buffer, at least RE_LOG_DELTA_HEADER_LEN.
+ * @param[in]  source Source endpoint of samples, e.g. RE_STANDARD_DESTINATION_TEMPERATURE.
+ * @retval RE_SUCCESS if message was started.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if buffer is too small for the header.
+ * @retval RE_ERROR_NOT_IMPLEMENTED if there's no encoding for given source.
+ */
+re_status_t re_log_delta_encode_start (re_log_delta_encoder_t * const p_enc,
+                                       uint8_t * const p_buffer,
+                                       const size_t buf_len,
+                                       const uint8_t source);
+
+/**
+ * @brief Append a sample to a LOG_DELTA message.
+ *
+ * Value is scaled and rounded as by @ref re_log_write_data. Message is not
+ * modified if the sample cannot be appended.
+ *
+ * @param[in,out] p_enc Started encoder.
+ * @param[in]     timestamp_ms Timestamp as it will be sent to remote.
+ * @param[in]     data Value to encode.
+ * @retval RE_SUCCESS if sample was appended.
+ * @retval RE_ERROR_NULL if p_enc is NULL.
+ * @retval RE_ERROR_DATA_SIZE if message is full, send it and start a new one.
+ * @return Otherwise error of timestamp or value encoding.
+ */
+re_status_t re_log_delta_encode_value (re_log_delta_encoder_t * const p_enc,
+                                       const uint64_t timestamp_ms,
+                                       const re_float data);
+
+/**
+ * @brief Start decoding a received LOG_DELTA message.
+ *
+ * @param[out] p_dec Decoder state.
+ * @param[in]  p_msg Received message, must stay valid while decoding.
+ * @param[in]  msg_len Number of received bytes.
+ * @retval RE_SUCCESS if decoding was started, p_dec->remaining samples follow.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DECODING_CMD if operation is not RE_STANDARD_LOG_DELTA_WRITE.
+ * @retval RE_ERROR_DECODING_LEN if message is shorter than header.
+ * @retval RE_ERROR_NOT_IMPLEMENTED if there's no encoding for the source.
+ */
+re_status_t re_log_delta_decode_start (re_log_delta_decoder_t * const p_dec,
+                                       const uint8_t * const p_msg,
+                                       const size_t msg_len);
+
+/**
+ * @brief Decode next sample of a LOG_DELTA message.
+ *
+ * @param[in,out] p_dec Started decoder with remaining samples.
+ * @param[out]    p_timestamp_s Timestamp of sample in seconds.
+ * @param[out]    p_value Value of sample, scaled back by source. NaN if sample
+ *                        was logged as RE_STANDARD_INVALID_I32.
+ * @retval RE_SUCCESS if sample was decoded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if there are no remaining samples.
+ * @retval RE_ERROR_DECODING_LEN if message ended in the middle of a sample.
+ * @retval RE_ERROR_DECODING if timestamp or value is out of range.
+ * On error no samples remain.
+ */
+re_status_t re_log_delta_decode_next (re_log_delta_decoder_t * const p_dec,
+                                      uint32_t * const p_timestamp_s,
+                                      re_float * const p_value);
+
+#endif // RUUVI_ENDPOINT_LOG_DELTA_H
@@ -0,0 +1,344 @@
+#include "ruuvi_endpoint_log_reader.h"
+#include "ruuvi_endpoints.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#if RE_LOG_READER_ENABLED
+
+#define RE_LOG_READER_SOURCE_NONE (RE_LOG_READER_MAX_SOURCES)
+#define RE_LOG_READER_TIME_MAX    (0xFFFFFFFF)
+
+static size_t re_log_reader_column (const re_log_reader_t * const p_reader,
+                                    const uint8_t source)
+{
+    size_t column = RE_LOG_READER_SOURCE_NONE;
+
+    for (size_t ii = 0; ii < p_reader->num_sources; ii++)
+    {
+        if (source == p_reader->sources[ii])
+        {
+            column = ii;
+            break;
+        }
+    }
+
+    return column;
+}
+
+static bool re_log_reader_is_end (const uint8_t * const p_msg)
+{
+    bool is_end = true;
+
+    for (size_t ii = RE_STANDARD_PAYLOAD_START_INDEX; ii < RE_STANDARD_MESSAGE_LENGTH; ii++)
+    {
+        is_end = is_end && (RE_LOG_READER_END_MARKER == p_msg[ii]);
+    }
+
+    return is_end;
+}
+
+/**
+ * @brief First row at or after given position with timestamp not less than ts.
+ */
+static size_t re_log_reader_seek (const re_log_reader_t * const p_reader,
+                                  const size_t cursor,
+                                  const uint32_t ts)
+{
+    const uint32_t * const p_ts = p_reader->columns.p_timestamps_s;
+    size_t pos = cursor;
+
+    if ( (pos > 0U) && (ts <= p_ts[pos - 1U]))
+    {
+        // Source went back in time, binary search rows before cursor.
+        size_t low = 0;
+        size_t high = pos;
+
+        while (low < high)
+        {
+            const size_t mid = low + ( (high - low) / 2U);
+
+            if (p_ts[mid] < ts)
+            {
+                low = mid + 1U;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        pos = low;
+    }
+    else
+    {
+        while ( (pos < p_reader->num_rows) && (p_ts[pos] < ts))
+        {
+            pos++;
+        }
+    }
+
+    return pos;
+}
+
+/**
+ * @brief Insert an empty row, moving later rows of every column by one.
+ *
+ * Rows are appended without moves when pos is at the end of stored rows.
+ */
+static void re_log_reader_insert_row (re_log_reader_t * const p_reader,
+                                      const size_t pos,
+                                      const uint32_t ts)
+{
+    re_log_reader_columns_t * const p_cols = &p_reader->columns;
+    const size_t tail = p_reader->num_rows - pos;
+
+    if (0U != tail)
+    {
+        memmove (&p_cols->p_timestamps_s[pos + 1U], &p_cols->p_timestamps_s[pos],
+                 tail * sizeof (uint32_t));
+    }
+
+    p_cols->p_timestamps_s[pos] = ts;
+
+    for (size_t ii = 0; ii < p_reader->num_sources; ii++)
+    {
+        if (0U != tail)
+        {
+            memmove (&p_cols->p_values[ii][pos + 1U], &p_cols->p_values[ii][pos],
+                     tail * sizeof (re_float));
+        }
+
+        p_cols->p_values[ii][pos] = NAN;
+
+        if (p_reader->cursors[ii] > pos)
+        {
+            p_reader->cursors[ii]++;
+        }
+    }
+
+    p_reader->num_rows++;
+}
+
+/**
+ * @brief Store a value, adding a row for a new timestamp.
+ *
+ * @retval RE_ERROR_DATA_SIZE if a row was needed and storage is full.
+ */
+static re_status_t re_log_reader_store (re_log_reader_t * const p_reader,
+                                        const size_t column,
+                                        const uint32_t ts,
+                                        const re_float value)
+{
+    re_status_t result = RE_SUCCESS;
+    const size_t pos = re_log_reader_seek (p_reader, p_reader->cursors[column], ts);
+    const bool row_exists = (pos < p_reader->num_rows)
+                            && (ts == p_reader->columns.p_timestamps_s[pos]);
+
+    if ( (!row_exists) && (p_reader->num_rows >= p_reader->columns.capacity))
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        if (!row_exists)
+        {
+            re_log_reader_insert_row (p_reader, pos, ts);
+        }
+
+        p_reader->columns.p_values[column][pos] = value;
+        p_reader->cursors[column] = pos + 1U;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Decode a single message.
+ *
+ * @retval RE_ERROR_DATA_SIZE if the message could not be stored and has to be
+ *                            consumed again later.
+ */
+static re_status_t re_log_reader_message (re_log_reader_t * const p_reader,
+        const uint8_t * const p_msg)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (RE_STANDARD_LOG_VALUE_WRITE != p_msg[RE_STANDARD_OPERATION_INDEX])
+    {
+        result |= RE_ERROR_DECODING_CMD;
+    }
+    else if (re_log_reader_is_end (p_msg))
+    {
+        p_reader->complete = true;
+    }
+    else
+    {
+        const size_t column = re_log_reader_column (p_reader, p_msg[RE_STANDARD_SOURCE_INDEX]);
+        const re_log_multi_t record =
+        {
+            .source = p_msg[RE_STANDARD_SOURCE_INDEX],
+            .num_records = 1U,
+            .record_len = RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN,
+            .p_records = &p_msg[RE_STANDARD_PAYLOAD_START_INDEX],
+        };
+        uint32_t tag_ts = 0;
+        re_float value = NAN;
+
+        if ( (RE_LOG_READER_SOURCE_NONE == column)
+                || (RE_SUCCESS != re_log_multi_decode_values (&record, &tag_ts, &value)))
+        {
+            p_reader->num_dropped++;
+        }
+        else
+        {
+            const int64_t ts = (int64_t) tag_ts + p_reader->clock_offset_s;
+
+            if ( (ts < 0) || (ts > RE_LOG_READER_TIME_MAX))
+            {
+                result |= RE_ERROR_INVALID_PARAM;
+            }
+            else if (ts < p_reader->start_time_s)
+            {
+                p_reader->num_dropped++;
+            }
+            else
+            {
+                result |= re_log_reader_store (p_reader, column, (uint32_t) ts, value);
+            }
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_log_reader_init (re_log_reader_t * const p_reader,
+                                const re_log_reader_columns_t * const p_columns,
+                                const uint8_t * const p_sources,
+                                const size_t num_sources)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_reader) || (NULL == p_columns) || (NULL == p_sources)
+            || (NULL == p_columns->p_timestamps_s))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U == num_sources) || (num_sources > RE_LOG_READER_MAX_SOURCES))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0; ii < num_sources; ii++)
+        {
+            if (NULL == p_columns->p_values[ii])
+            {
+                result |= RE_ERROR_NULL;
+            }
+        }
+
+        if (RE_SUCCESS == result)
+        {
+            memset (p_reader, 0, sizeof (*p_reader));
+            p_reader->columns = *p_columns;
+            memcpy (p_reader->sources, p_sources, num_sources);
+            p_reader->num_sources = num_sources;
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_log_reader_start (re_log_reader_t * const p_reader,
+                                 const uint8_t * const p_request,
+                                 const uint32_t tag_time_s)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_reader) || (NULL == p_request))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (RE_STANDARD_LOG_VALUE_READ != p_request[RE_STANDARD_OPERATION_INDEX])
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        p_reader->clock_offset_s = (int64_t) re_std_log_current_time (p_request)
+                                   - (int64_t) tag_time_s;
+        p_reader->start_time_s = re_std_log_start_time (p_request);
+        p_reader->num_dropped = 0;
+        p_reader->complete = false;
+        re_log_reader_clear_rows (p_reader);
+    }
+
+    return result;
+}
+
+re_status_t re_log_reader_consume (re_log_reader_t * const p_reader,
+                                   const uint8_t * const p_data,
+                                   const size_t data_len,
+                                   size_t * const p_consumed)
+{
+    re_status_t result = RE_SUCCESS;
+    size_t offset = 0;
+
+    if ( (NULL == p_reader) || (NULL == p_data))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        while ( (!p_reader->complete)
+                && ( (offset + RE_STANDARD_MESSAGE_LENGTH) <= data_len))
+        {
+            const re_status_t msg_status = re_log_reader_message (p_reader, &p_data[offset]);
+
+            if (0U != (msg_status & RE_ERROR_DATA_SIZE))
+            {
+                result |= RE_ERROR_DATA_SIZE;
+                break;
+            }
+
+            result |= msg_status;
+            offset += RE_STANDARD_MESSAGE_LENGTH;
+        }
+
+        if ( (0U == (result & RE_ERROR_DATA_SIZE)) && (!p_reader->complete))
+        {
+            if (offset != data_len)
+            {
+                result |= RE_ERROR_DECODING_LEN;
+                offset = data_len;
+            }
+        }
+        else if (p_reader->complete)
+        {
+            offset = data_len;
+        }
+        else
+        {
+            // Storage is full, caller continues from offset.
+        }
+    }
+
+    if (NULL != p_consumed)
+    {
+        *p_consumed = offset;
+    }
+
+    return result;
+}
+
+void re_log_reader_clear_rows (re_log_reader_t * const p_reader)
+{
+    if (NULL != p_reader)
+    {
+        p_reader->num_rows = 0;
+        memset (p_reader->cursors, 0, sizeof (p_reader->cursors));
+    }
+}
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * Ruuvi Endpoint log download decoder for centrals.
+ *
+ * Consumes the RE_STANDARD_LOG_VALUE_WRITE messages a tag sends in reply to a
+ * log read request and stores them as rows of time-aligned values, one column
+ * per source endpoint, in caller-provided arrays. Timestamps are moved from
+ * the clock of the tag to the clock of the central using the current time
+ * that was sent in the log read request.
+ *
+ * Each source keeps a cursor to the row of its previous value, so logs sent
+ * interleaved (temperature, humidity, pressure of one sample) are aligned in
+ * linear time, as are logs sent one source after another while later sources
+ * sample at timestamps already stored. A timestamp that falls between stored
+ * rows moves every later row of every column, so a source with many
+ * timestamps unknown to the sources before it costs O(rows) per value.
+ * Nothing is allocated while decoding.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINT_LOG_READER_H
+#define RUUVI_ENDPOINT_LOG_READER_H
+
+#include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef RE_LOG_READER_MAX_SOURCES
+#   define RE_LOG_READER_MAX_SOURCES (8U) //!< Columns of a reader at most.
+#endif
+
+#define RE_LOG_READER_END_MARKER (0xFFU) //!< Every payload byte of end of log message.
+
+/**
+ * @brief Caller-provided row storage.
+ *
+ * Column ii holds the values of source ii given to @ref re_log_reader_init,
+ * NAN where the source had no value at the row timestamp.
+ */
+typedef struct
+{
+    uint32_t * p_timestamps_s;                      //!< Row timestamps, central clock.
+    re_float * p_values[RE_LOG_READER_MAX_SOURCES]; //!< Value column of each source.
+    size_t capacity;                                //!< Rows in each array.
+} re_log_reader_columns_t;
+
+/** @brief Log download state. */
+typedef struct
+{
+    re_log_reader_columns_t columns;              //!< Row storage.
+    uint8_t sources[RE_LOG_READER_MAX_SOURCES];   //!< Source endpoint of each column.
+    size_t cursors[RE_LOG_READER_MAX_SOURCES];    //!< Row after previous value of each source.
+    size_t num_sources;                           //!< Number of columns.
+    size_t num_rows;                              //!< Rows stored.
+    int64_t clock_offset_s;                       //!< Central time minus tag time.
+    uint32_t start_time_s;                        //!< Oldest accepted row, central clock.
+    uint32_t num_dropped;                         //!< Values skipped as unknown or too old.
+    bool complete;                                //!< End of log was received.
+} re_log_reader_t;
+
+/**
+ * @brief Initialize a reader on caller-provided storage.
+ *
+ * @param[out] p_reader Reader to initialize.
+ * @param[in]  p_columns Row storage, copied into the reader.
+ * @param[in]  p_sources Source endpoint of each column,
+ *                       e.g. RE_STANDARD_DESTINATION_TEMPERATURE.
+ * @param[in]  num_sources Number of sources, at most RE_LOG_READER_MAX_SOURCES.
+ * @retval RE_SUCCESS if reader was initialized.
+ * @retval RE_ERROR_NULL if any of the pointers or used columns is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if number of sources is 0 or too large.
+ */
+re_status_t re_log_reader_init (re_log_reader_t * const p_reader,
+                                const re_log_reader_columns_t * const p_columns,
+                                const uint8_t * const p_sources,
+                                const size_t num_sources);
+
+/**
+ * @brief Start decoding the reply to a log read request.
+ *
+ * Clock offset is the current time of the request minus the time of the tag
+ * when it received the request. Pass the current time of the request as
+ * tag_time_s if the tag compensates timestamps itself.
+ * Stored rows are cleared.
+ *
+ * @param[in,out] p_reader Initialized reader.
+ * @param[in]     p_request 11-byte log read request sent to the tag.
+ * @param[in]     tag_time_s Time of the tag when request was received, seconds.
+ * @retval RE_SUCCESS if download was started.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if p_request is not a log read request.
+ */
+re_status_t re_log_reader_start (re_log_reader_t * const p_reader,
+                                 const uint8_t * const p_request,
+                                 const uint32_t tag_time_s);
+
+/**
+ * @brief Decode a batch of received log messages.
+ *
+ * Messages are RE_STANDARD_MESSAGE_LENGTH bytes back to back, e.g. the
+ * notifications of one connection event. Values of sources without a column
+ * and values older than the start time of the request are counted in
+ * num_dropped. Messages after the end of log are ignored.
+ *
+ * @param[in,out] p_reader Started reader.
+ * @param[in]     p_data Received messages.
+ * @param[in]     data_len Number of received bytes.
+ * @param[out]    p_consumed Bytes processed, may be NULL. Less than data_len
+ *                           only if rows ran out, clear rows and continue
+ *                           from here.
+ * @retval RE_SUCCESS if every message was decoded.
+ * @retval RE_ERROR_NULL if p_reader or p_data is NULL.
+ * @retval RE_ERROR_DATA_SIZE if rows ran out.
+ * @retval RE_ERROR_DECODING_LEN if data ended with a partial message, it is skipped.
+ * @retval RE_ERROR_DECODING_CMD if a message was not a log value write, it is skipped.
+ * @retval RE_ERROR_INVALID_PARAM if a timestamp did not fit in central clock, it is skipped.
+ */
+re_status_t re_log_reader_consume (re_log_reader_t * const p_reader,
+                                   const uint8_t * const p_data,
+                                   const size_t data_len,
+                                   size_t * const p_consumed);
+
+/**
+ * @brief Clear stored rows after they have been processed.
+ *
+ * Download state and clock offset are kept.
+ *
+ * @param[in,out] p_reader Reader.
+ */
+void re_log_reader_clear_rows (re_log_reader_t * const p_reader);
+
+#endif // RUUVI_ENDPOINT_LOG_READER_H
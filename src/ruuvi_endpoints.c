@@ -1,6 +1,7 @@
 #include "ruuvi_endpoints.h"
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #if (RE_7_ENABLED | RE_8_ENABLED)
 // CRC8 calculation https://oshgarage.com/the-crc8-checksum/
@@ -147,25 +148,72 @@ re_status_t re_log_write_timestamp (uint8_t * const buffer, const uint64_t times
     return err_code;
 }
 
-static int32_t f2i (re_float value)
+re_float re_log_scale_factor (const uint8_t source)
 {
-    int32_t rvalue = 0x80000000;
-    value = (value) >= 0 ? (value) + 0.5f : (value) - 0.5f;
+    re_float scale = 0.0F;
 
-    if (value >= INT32_MAX)
+    switch (source)
     {
-        rvalue = INT32_MAX;
-    }
-    else if (value <= (INT32_MIN + 1))
-    {
-        rvalue = INT32_MIN + 1;
-    }
-    else
-    {
-        rvalue = (int32_t) value;
+        case RE_STANDARD_DESTINATION_ACCELERATION_X:
+        case RE_STANDARD_DESTINATION_ACCELERATION_Y:
+        case RE_STANDARD_DESTINATION_ACCELERATION_Z:
+            scale = RE_STANDARD_ACCELERATION_SF;
+            break;
+
+        case RE_STANDARD_DESTINATION_GYRATION_X:
+        case RE_STANDARD_DESTINATION_GYRATION_Y:
+        case RE_STANDARD_DESTINATION_GYRATION_Z:
+            scale = RE_STANDARD_GYRATION_SF;
+            break;
+
+        case RE_STANDARD_DESTINATION_HUMIDITY:
+            scale = RE_STANDARD_HUMIDITY_SF;
+            break;
+
+        case RE_STANDARD_DESTINATION_PRESSURE:
+            scale = RE_STANDARD_PRESSURE_SF;
+            break;
+
+        case RE_STANDARD_DESTINATION_TEMPERATURE:
+            scale = RE_STANDARD_TEMPERATURE_SF;
+            break;
+
+        default:
+            break;
     }
 
-    return rvalue;
+    return scale;
+}
+
+#define RE_F2I_LIMIT     (2147483648.0F) //!< INT32_MAX and INT32_MIN + 1 as float.
+#define RE_F2I_FLOAT_MAX (2147483520.0F) //!< Largest float below 2^31.
+#define RE_LOG_BATCH_BLOCK (32U)         //!< Values quantised per pass.
+
+/**
+ * @brief Round half away from zero and saturate to [INT32_MIN + 1, INT32_MAX].
+ *
+ * Written as selects rather than branches so that it vectorises in
+ * @ref re_log_write_data_batch.
+ */
+static inline int32_t f2i (const re_float value)
+{
+    const re_float rounded = value + ( (value >= 0.0F) ? 0.5F : -0.5F);
+    const re_float clamped = fminf (fmaxf (rounded, -RE_F2I_FLOAT_MAX), RE_F2I_FLOAT_MAX);
+    const int32_t over = - (int32_t) (rounded >= RE_F2I_LIMIT);
+    const int32_t under = - (int32_t) (rounded <= -RE_F2I_LIMIT);
+    return ( ( (int32_t) clamped) & ~ (over | under))
+           | (INT32_MAX & over)
+           | ( (INT32_MIN + 1) & under);
+}
+
+static inline void re_log_write_value (uint8_t * const buffer, const int32_t discrete_value)
+{
+    // These shifts do not rely on the value of leftmost bit if original
+    // value is negative, so this is safe way to encode bytes.
+    buffer[RE_LOG_WRITE_VALUE_MSB_IDX] = (uint8_t) ( (discrete_value >> 24U) & 0xFFU);
+    buffer[RE_LOG_WRITE_VALUE_B2_IDX] = (uint8_t) ( (discrete_value >> 16U) & 0xFFU);
+    buffer[RE_LOG_WRITE_VALUE_B3_IDX] = (uint8_t) ( (discrete_value >> 8U) & 0xFFU);
+    buffer[RE_LOG_WRITE_VALUE_LSB_IDX] = (uint8_t) (discrete_value & 0xFFU);
 }
 
 /**
@@ -179,6 +227,8 @@ static int32_t f2i (re_float value)
  * @retval RE_ERROR_NULL Buffer was NULL.
  * @retval RE_ERROR_INVALID_PARAM if data is NAN or inf.
  * @retval RE_NOT_IMPLEMENTED if there's no encoding for given data source.
+ *          RE_ENV_ALL has no single value encoding, log it with
+ *          @ref re_log_write_multi_env.
  *
  * @warning if data is outside representable range resulting encoding is undefined.
  */
@@ -199,47 +249,514 @@ re_status_t re_log_write_data (uint8_t * const buffer, const re_float data,
     }
     else
     {
-        switch (source)
+        const re_float scale = re_log_scale_factor (source);
+
+        if (0.0F == scale)
         {
-            case RE_STANDARD_DESTINATION_ACCELERATION_X:
-            case RE_STANDARD_DESTINATION_ACCELERATION_Y:
-            case RE_STANDARD_DESTINATION_ACCELERATION_Z:
-                scaled_value = (data * RE_STANDARD_ACCELERATION_SF);
-                break;
-
-            case RE_STANDARD_DESTINATION_GYRATION_X:
-            case RE_STANDARD_DESTINATION_GYRATION_Y:
-            case RE_STANDARD_DESTINATION_GYRATION_Z:
-                scaled_value = (data * RE_STANDARD_GYRATION_SF);
-                break;
-
-            case RE_STANDARD_DESTINATION_HUMIDITY:
-                scaled_value = (data * RE_STANDARD_HUMIDITY_SF);
-                break;
-
-            case RE_STANDARD_DESTINATION_PRESSURE:
-                scaled_value = (data * RE_STANDARD_PRESSURE_SF);
-                break;
-
-            case RE_STANDARD_DESTINATION_TEMPERATURE:
-                scaled_value = (data * RE_STANDARD_TEMPERATURE_SF);
-                break;
-
-            default:
-                err_code |= RE_ERROR_NOT_IMPLEMENTED;
-                break;
+            err_code |= RE_ERROR_NOT_IMPLEMENTED;
         }
 
+        scaled_value = data * scale;
         scaled_value = roundf (scaled_value);
         discrete_value = f2i (scaled_value);
     }
 
-    // These shifts do not rely on the value of leftmost bit if original
-    // value is negative, so this is safe way to encode bytes.
-    buffer[RE_LOG_WRITE_VALUE_MSB_IDX] = (uint8_t) ( (discrete_value >> 24U) & 0xFFU);
-    buffer[RE_LOG_WRITE_VALUE_B2_IDX] = (uint8_t) ( (discrete_value >> 16U) & 0xFFU);
-    buffer[RE_LOG_WRITE_VALUE_B3_IDX] = (uint8_t) ( (discrete_value >> 8U) & 0xFFU);
-    buffer[RE_LOG_WRITE_VALUE_LSB_IDX] = (uint8_t) (discrete_value & 0xFFU);
+    if (NULL != buffer)
+    {
+        re_log_write_value (buffer, discrete_value);
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_data_batch (uint8_t * const p_messages, const re_float * const p_data,
+                                     const size_t num_values, const uint8_t source)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == p_messages) || (NULL == p_data))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else
+    {
+        const re_float scale = re_log_scale_factor (source);
+        int32_t block[RE_LOG_BATCH_BLOCK];
+        int32_t invalid_seen = 0;
+
+        if (0.0F == scale)
+        {
+            err_code |= RE_ERROR_NOT_IMPLEMENTED;
+        }
+
+        for (size_t start = 0; start < num_values; start += RE_LOG_BATCH_BLOCK)
+        {
+            const size_t count = ( (num_values - start) < RE_LOG_BATCH_BLOCK)
+                                 ? (num_values - start) : RE_LOG_BATCH_BLOCK;
+
+            for (size_t ii = 0; ii < count; ii++)
+            {
+                const re_float data = p_data[start + ii];
+                const int32_t invalid = - (int32_t) (isnan (data) || isinf (data));
+                block[ii] = (f2i (roundf (data * scale)) & ~invalid)
+                            | ( (int32_t) RE_STANDARD_INVALID_I32 & invalid);
+                invalid_seen |= invalid;
+            }
+
+            for (size_t ii = 0; ii < count; ii++)
+            {
+                re_log_write_value (&p_messages[ (start + ii) * RE_STANDARD_MESSAGE_LENGTH],
+                                    block[ii]);
+            }
+        }
+
+        if (0 != invalid_seen)
+        {
+            err_code |= RE_ERROR_INVALID_PARAM;
+        }
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_header (uint8_t * const buffer, const uint8_t source,
+                                       const uint8_t record_len)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if (NULL == buffer)
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if (0U == record_len)
+    {
+        err_code |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        buffer[RE_STANDARD_SOURCE_INDEX] = source;
+        buffer[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_MULTI_WRITE;
+        buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX] = 0U;
+        buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX] = record_len;
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_record (uint8_t * const buffer, const size_t buf_len,
+                                       const uint8_t * const p_record)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == buffer) || (NULL == p_record))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else
+    {
+        const uint8_t num_records = buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX];
+        const size_t record_len = buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX];
+        const size_t offset = re_log_write_multi_length (buffer);
+
+        if ( (RE_LOG_WRITE_MULTI_MAX_RECORDS <= num_records)
+                || ( (offset + record_len) > buf_len))
+        {
+            err_code |= RE_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            memcpy (&buffer[offset], p_record, record_len);
+            buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX] = num_records + 1U;
+        }
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_value (uint8_t * const buffer, const size_t buf_len,
+                                      const uint64_t timestamp_ms, const re_float data)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t message[RE_STANDARD_MESSAGE_LENGTH] = {0};
+
+    if (NULL == buffer)
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if (RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN != buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX])
+    {
+        err_code |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        // Value record has the same layout as payload of a single value message.
+        err_code |= re_log_write_timestamp (message, timestamp_ms);
+        err_code |= re_log_write_data (message, data, buffer[RE_STANDARD_SOURCE_INDEX]);
+
+        if (RE_SUCCESS == err_code)
+        {
+            err_code |= re_log_write_multi_record (buffer, buf_len,
+                                                   &message[RE_STANDARD_PAYLOAD_START_INDEX]);
+        }
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_ms_header (uint8_t * const buffer, const uint8_t source)
+{
+    re_status_t err_code = re_log_write_multi_header (buffer, source,
+                           RE_LOG_WRITE_MULTI_MS_RECORD_LEN);
+
+    if (RE_SUCCESS == err_code)
+    {
+        buffer[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_MULTI_MS_WRITE;
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_value_ms (uint8_t * const buffer, const size_t buf_len,
+        const uint64_t timestamp_ms, const re_float data)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t message[RE_STANDARD_MESSAGE_LENGTH] = {0};
+
+    if (NULL == buffer)
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if ( (RE_STANDARD_LOG_MULTI_MS_WRITE != buffer[RE_STANDARD_OPERATION_INDEX])
+              || (RE_LOG_WRITE_MULTI_MS_RECORD_LEN != buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX]))
+    {
+        err_code |= RE_ERROR_DATA_SIZE;
+    }
+    else if (timestamp_ms > RE_LOG_WRITE_MULTI_MS_TS_MAX)
+    {
+        err_code |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        err_code |= re_log_write_data (message, data, buffer[RE_STANDARD_SOURCE_INDEX]);
+
+        if (RE_SUCCESS == err_code)
+        {
+            uint8_t record[RE_LOG_WRITE_MULTI_MS_RECORD_LEN] = {0};
+
+            for (size_t ii = 0; ii < RE_LOG_WRITE_MULTI_MS_TS_LEN; ii++)
+            {
+                const size_t shift = (RE_LOG_WRITE_MULTI_MS_TS_LEN - 1U - ii) * 8U;
+                record[RE_LOG_WRITE_MULTI_MS_TS_MSB_OFS + ii] =
+                    (uint8_t) ( (timestamp_ms >> shift) & 0xFFU);
+            }
+
+            memcpy (&record[RE_LOG_WRITE_MULTI_MS_VALUE_MSB_OFS],
+                    &message[RE_LOG_WRITE_VALUE_MSB_IDX], sizeof (uint32_t));
+            err_code |= re_log_write_multi_record (buffer, buf_len, record);
+        }
+    }
+
+    return err_code;
+}
+
+static void re_log_write_u16 (uint8_t * const p_msb, const uint16_t value)
+{
+    p_msb[0] = (uint8_t) (value >> 8U);
+    p_msb[1] = (uint8_t) (value & 0xFFU);
+}
+
+re_status_t re_log_write_env_record (uint8_t * const p_record, const uint64_t timestamp_ms,
+                                     const re_log_env_t * const p_env)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t message[RE_STANDARD_MESSAGE_LENGTH] = {0};
+
+    if ( (NULL == p_record) || (NULL == p_env))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else
+    {
+        err_code |= re_log_write_timestamp (message, timestamp_ms);
+    }
+
+    if (RE_SUCCESS == err_code)
+    {
+        uint16_t temperature = RE_LOG_WRITE_ENV_INVALID_I16;
+        uint16_t humidity = RE_LOG_WRITE_ENV_INVALID_U16;
+        uint16_t pressure = RE_LOG_WRITE_ENV_INVALID_U16;
+
+        if (!isnan (p_env->temperature_c))
+        {
+            const re_float value = re_clip_float (p_env->temperature_c,
+                                                  -RE_LOG_WRITE_ENV_TEMPERATURE_MAX,
+                                                  RE_LOG_WRITE_ENV_TEMPERATURE_MAX);
+            temperature = (uint16_t) (int16_t) roundf (value * RE_STANDARD_TEMPERATURE_SF);
+        }
+
+        if (!isnan (p_env->humidity_rh))
+        {
+            const re_float value = re_clip_float (p_env->humidity_rh, 0.0F,
+                                                  RE_LOG_WRITE_ENV_HUMIDITY_MAX);
+            humidity = (uint16_t) roundf (value * RE_STANDARD_HUMIDITY_SF);
+        }
+
+        if (!isnan (p_env->pressure_pa))
+        {
+            const re_float value = re_clip_float (p_env->pressure_pa,
+                                                  RE_LOG_WRITE_ENV_PRESSURE_MIN,
+                                                  RE_LOG_WRITE_ENV_PRESSURE_MAX);
+            pressure = (uint16_t) roundf (value - RE_LOG_WRITE_ENV_PRESSURE_MIN);
+        }
+
+        memcpy (&p_record[RE_LOG_WRITE_ENV_TS_MSB_OFS], &message[RE_LOG_WRITE_TS_MSB_IDX],
+                sizeof (uint32_t));
+        re_log_write_u16 (&p_record[RE_LOG_WRITE_ENV_TEMPERATURE_MSB_OFS], temperature);
+        re_log_write_u16 (&p_record[RE_LOG_WRITE_ENV_HUMIDITY_MSB_OFS], humidity);
+        re_log_write_u16 (&p_record[RE_LOG_WRITE_ENV_PRESSURE_MSB_OFS], pressure);
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_write_multi_env (uint8_t * const buffer, const size_t buf_len,
+                                    const uint64_t timestamp_ms,
+                                    const re_log_env_t * const p_env)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t record[RE_LOG_WRITE_ENV_RECORD_LEN] = {0};
+
+    if ( (NULL == buffer) || (NULL == p_env))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if ( (RE_STANDARD_DESTINATION_ENVIRONMENTAL != buffer[RE_STANDARD_SOURCE_INDEX])
+              || (RE_LOG_WRITE_ENV_RECORD_LEN != buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX]))
+    {
+        err_code |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        err_code |= re_log_write_env_record (record, timestamp_ms, p_env);
+
+        if (RE_SUCCESS == err_code)
+        {
+            err_code |= re_log_write_multi_record (buffer, buf_len, record);
+        }
+    }
+
+    return err_code;
+}
+
+size_t re_log_write_multi_length (const uint8_t * const buffer)
+{
+    size_t length = 0;
+
+    if (NULL != buffer)
+    {
+        length = RE_LOG_WRITE_MULTI_HEADER_LEN
+                 + ( (size_t) buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]
+                     * buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX]);
+    }
+
+    return length;
+}
+
+static re_status_t re_log_multi_parse (const uint8_t * const p_msg, const size_t msg_len,
+                                       const uint8_t operation, re_log_multi_t * const p_log)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == p_msg) || (NULL == p_log))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if (msg_len < RE_LOG_WRITE_MULTI_HEADER_LEN)
+    {
+        err_code |= RE_ERROR_DECODING_LEN;
+    }
+    else if (operation != p_msg[RE_STANDARD_OPERATION_INDEX])
+    {
+        err_code |= RE_ERROR_DECODING_CMD;
+    }
+    else if ( (0U == p_msg[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX])
+              || (re_log_write_multi_length (p_msg) > msg_len))
+    {
+        err_code |= RE_ERROR_DECODING_LEN;
+    }
+    else
+    {
+        p_log->source = p_msg[RE_STANDARD_SOURCE_INDEX];
+        p_log->num_records = p_msg[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX];
+        p_log->record_len = p_msg[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX];
+        p_log->p_records = &p_msg[RE_LOG_WRITE_MULTI_PAYLOAD_IDX];
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_multi_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                 re_log_multi_t * const p_log)
+{
+    return re_log_multi_parse (p_msg, msg_len, RE_STANDARD_LOG_MULTI_WRITE, p_log);
+}
+
+re_status_t re_log_multi_ms_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                    re_log_multi_t * const p_log)
+{
+    return re_log_multi_parse (p_msg, msg_len, RE_STANDARD_LOG_MULTI_MS_WRITE, p_log);
+}
+
+static uint32_t re_log_read_u32 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << 24U)
+           | ( (uint32_t) p_msb[1] << 16U)
+           | ( (uint32_t) p_msb[2] << 8U)
+           | p_msb[3];
+}
+
+/** @brief Scale a logged value back, NaN if it was logged as invalid. */
+static re_float re_log_value_of (const uint32_t raw, const re_float scale)
+{
+    return (RE_STANDARD_INVALID_I32 == raw) ? NAN : ( (re_float) (int32_t) raw / scale);
+}
+
+re_status_t re_log_multi_decode_values (const re_log_multi_t * const p_log,
+                                        uint32_t * const p_timestamps_s,
+                                        re_float * const p_values)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == p_log) || (NULL == p_log->p_records) || (NULL == p_timestamps_s)
+            || (NULL == p_values))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if (RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN != p_log->record_len)
+    {
+        err_code |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const re_float scale = re_log_scale_factor (p_log->source);
+
+        if (0.0F == scale)
+        {
+            err_code |= RE_ERROR_NOT_IMPLEMENTED;
+        }
+        else
+        {
+            const uint8_t * p_record = p_log->p_records;
+
+            for (size_t ii = 0; ii < p_log->num_records; ii++)
+            {
+                p_timestamps_s[ii] =
+                    re_log_read_u32 (&p_record[RE_LOG_WRITE_MULTI_VALUE_TS_MSB_OFS]);
+                p_values[ii] = re_log_value_of (
+                                   re_log_read_u32 (&p_record[RE_LOG_WRITE_MULTI_VALUE_MSB_OFS]), scale);
+                p_record += RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+re_status_t re_log_multi_decode_values_ms (const re_log_multi_t * const p_log,
+        uint64_t * const p_timestamps_ms,
+        re_float * const p_values)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == p_log) || (NULL == p_log->p_records) || (NULL == p_timestamps_ms)
+            || (NULL == p_values))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if (RE_LOG_WRITE_MULTI_MS_RECORD_LEN != p_log->record_len)
+    {
+        err_code |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const re_float scale = re_log_scale_factor (p_log->source);
+
+        if (0.0F == scale)
+        {
+            err_code |= RE_ERROR_NOT_IMPLEMENTED;
+        }
+        else
+        {
+            const uint8_t * p_record = p_log->p_records;
+
+            for (size_t ii = 0; ii < p_log->num_records; ii++)
+            {
+                uint64_t timestamp_ms = 0;
+
+                for (size_t jj = 0; jj < RE_LOG_WRITE_MULTI_MS_TS_LEN; jj++)
+                {
+                    timestamp_ms = (timestamp_ms << 8U)
+                                   | p_record[RE_LOG_WRITE_MULTI_MS_TS_MSB_OFS + jj];
+                }
+
+                p_timestamps_ms[ii] = timestamp_ms;
+                p_values[ii] = re_log_value_of (
+                                   re_log_read_u32 (&p_record[RE_LOG_WRITE_MULTI_MS_VALUE_MSB_OFS]), scale);
+                p_record += RE_LOG_WRITE_MULTI_MS_RECORD_LEN;
+            }
+        }
+    }
+
+    return err_code;
+}
+
+static uint16_t re_log_read_u16 (const uint8_t * const p_msb)
+{
+    return (uint16_t) ( ( (uint16_t) p_msb[0] << 8U) | p_msb[1]);
+}
+
+re_status_t re_log_multi_decode_env (const re_log_multi_t * const p_log,
+                                     uint32_t * const p_timestamps_s,
+                                     re_log_env_t * const p_env)
+{
+    re_status_t err_code = RE_SUCCESS;
+
+    if ( (NULL == p_log) || (NULL == p_log->p_records) || (NULL == p_timestamps_s)
+            || (NULL == p_env))
+    {
+        err_code |= RE_ERROR_NULL;
+    }
+    else if ( (RE_STANDARD_DESTINATION_ENVIRONMENTAL != p_log->source)
+              || (RE_LOG_WRITE_ENV_RECORD_LEN != p_log->record_len))
+    {
+        err_code |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const uint8_t * p_record = p_log->p_records;
+
+        for (size_t ii = 0; ii < p_log->num_records; ii++)
+        {
+            const uint16_t temperature =
+                re_log_read_u16 (&p_record[RE_LOG_WRITE_ENV_TEMPERATURE_MSB_OFS]);
+            const uint16_t humidity =
+                re_log_read_u16 (&p_record[RE_LOG_WRITE_ENV_HUMIDITY_MSB_OFS]);
+            const uint16_t pressure =
+                re_log_read_u16 (&p_record[RE_LOG_WRITE_ENV_PRESSURE_MSB_OFS]);
+            p_timestamps_s[ii] = re_log_read_u32 (&p_record[RE_LOG_WRITE_ENV_TS_MSB_OFS]);
+            p_env[ii].temperature_c = (RE_LOG_WRITE_ENV_INVALID_I16 == temperature)
+                                      ? NAN
+                                      : (re_float) (int16_t) temperature / RE_STANDARD_TEMPERATURE_SF;
+            p_env[ii].humidity_rh = (RE_LOG_WRITE_ENV_INVALID_U16 == humidity)
+                                    ? NAN
+                                    : (re_float) humidity / RE_STANDARD_HUMIDITY_SF;
+            p_env[ii].pressure_pa = (RE_LOG_WRITE_ENV_INVALID_U16 == pressure)
+                                    ? NAN
+                                    : (re_float) pressure + RE_LOG_WRITE_ENV_PRESSURE_MIN;
+            p_record += RE_LOG_WRITE_ENV_RECORD_LEN;
+        }
+    }
+
     return err_code;
 }
 
@@ -29,7 +29,7 @@
 #   define RE_F0_ENABLED (1U)
 #endif
 #if !defined(RE_FA_ENABLED)
-#   define RE_FA_ENABLED (1U)
+#   define RE_FA_ENABLED (RE_3_ENABLED) //!< Shares field encoding with DF3.
 #endif
 #if !defined(RE_E0_ENABLED)
 #   define RE_E0_ENABLED (1U)
@@ -40,11 +40,57 @@
 #if !defined(RE_IBEACON_ENABLED)
 #   define RE_IBEACON_ENABLED (1U)
 #endif
+#if !defined(RE_KEYSTORE_ENABLED)
+#   define RE_KEYSTORE_ENABLED (1U)
+#endif
+#if !defined(RE_REPLAY_ENABLED)
+#   define RE_REPLAY_ENABLED (1U)
+#endif
+#if !defined(RE_LOG_AIRQ_ENABLED)
+#   define RE_LOG_AIRQ_ENABLED (RE_E1_ENABLED)
+#endif
+#if !defined(RE_LOG_READER_ENABLED)
+#   define RE_LOG_READER_ENABLED (1U)
+#endif
+#if !defined(RE_LOG_DELTA_ENABLED)
+#   define RE_LOG_DELTA_ENABLED (1U)
+#endif
+#if !defined(RE_IMU_ENABLED)
+#   define RE_IMU_ENABLED (1U)
+#endif
+#if !defined(RE_TAG_TABLE_ENABLED)
+#   define RE_TAG_TABLE_ENABLED (1U)
+#endif
+#if !defined(RE_DEDUP_ENABLED)
+#   define RE_DEDUP_ENABLED (1U)
+#endif
+#if !defined(RE_SEQ_ENABLED)
+#   define RE_SEQ_ENABLED (1U)
+#endif
+#if !defined(RE_JSON_ENABLED)
+#   define RE_JSON_ENABLED (1U)
+#endif
+#if !defined(RE_EXPORT_ENABLED)
+#   define RE_EXPORT_ENABLED (1U)
+#endif
+#if !defined(RE_TEXT_ENABLED)
+#   define RE_TEXT_ENABLED (RE_JSON_ENABLED | RE_EXPORT_ENABLED)
+#endif
+#if !defined(RE_SERIES_ENABLED)
+#   define RE_SERIES_ENABLED (1U)
+#endif
+#if !defined(RE_CAPTURE_ENABLED)
+#   define RE_CAPTURE_ENABLED (RE_CA_ENABLED)
+#endif
+#if !defined(RE_PIPELINE_ENABLED)
+#   define RE_PIPELINE_ENABLED (0U) //!< Host only, needs C11 atomics.
+#endif
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
-#define RUUVI_ENDPOINTS_SEMVER "4.1.0"          //!< SEMVER of endpoints.
+#define RUUVI_ENDPOINTS_SEMVER "4.2.0"          //!< SEMVER of endpoints.
 
 #define RE_SUCCESS                  (0U)        //!< Encoded successfully.
 #define RE_ERROR_DATA_SIZE          (1U << 3U)  //!< Data size too large/small.
@@ -118,6 +164,18 @@ typedef uint8_t re_bit_offset_t;                //!< Bit offset type, used for b
 #define RE_STANDARD_LOG_MULTI_READ             (RE_STANDARD_LOG_MULTI_WRITE | \
                                                     RE_STANDARD_OP_READ_BIT)
 
+#define RE_STANDARD_LOG_MULTI_MS_WRITE         (0x22U) //!< LOG_MULTI with millisecond timestamps.
+#define RE_STANDARD_LOG_MULTI_MS_READ          (RE_STANDARD_LOG_MULTI_MS_WRITE | \
+                                                    RE_STANDARD_OP_READ_BIT)
+
+#define RE_STANDARD_LOG_DELTA_WRITE            (0x30U)
+#define RE_STANDARD_LOG_DELTA_READ             (RE_STANDARD_LOG_DELTA_WRITE | \
+                                                    RE_STANDARD_OP_READ_BIT)
+
+#define RE_STANDARD_IMU_STREAM_WRITE           (0x40U) //!< Packed XYZ samples.
+#define RE_STANDARD_IMU_STREAM_READ            (RE_STANDARD_IMU_STREAM_WRITE | \
+                                                    RE_STANDARD_OP_READ_BIT)
+
 #define RE_SYS_CONFIG_WRITE_HEARTBEAT          (0xF2U)
 #define RE_SYS_CONFIG_READ_HEARTBEAT           (RE_SYS_CONFIG_WRITE_HEARTBEAT | \
                                                     RE_STANDARD_OP_READ_BIT)
@@ -146,6 +204,29 @@ typedef uint8_t re_bit_offset_t;                //!< Bit offset type, used for b
 #define RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX     (3U)    //!< Number of records.
 #define RE_LOG_WRITE_MULTI_RECORD_LEN_IDX      (4U)    //!< Length of record.
 #define RE_LOG_WRITE_MULTI_PAYLOAD_IDX         (5U)    //!< Start of payload.
+#define RE_LOG_WRITE_MULTI_HEADER_LEN          (5U)    //!< Bytes before first record.
+#define RE_LOG_WRITE_MULTI_MAX_RECORDS         (255U)  //!< Records in one message at most.
+#define RE_LOG_WRITE_MULTI_VALUE_TS_MSB_OFS    (0U)    //!< MSB offset of timestamp in value record.
+#define RE_LOG_WRITE_MULTI_VALUE_MSB_OFS       (4U)    //!< MSB offset of value in value record.
+#define RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN    (8U)    //!< Timestamp and value as in 11-byte message.
+
+#define RE_LOG_WRITE_MULTI_MS_TS_MSB_OFS       (0U)    //!< MSB offset of 48-bit millisecond timestamp.
+#define RE_LOG_WRITE_MULTI_MS_TS_LEN           (6U)    //!< Bytes of millisecond timestamp.
+#define RE_LOG_WRITE_MULTI_MS_VALUE_MSB_OFS    (6U)    //!< MSB offset of value in millisecond record.
+#define RE_LOG_WRITE_MULTI_MS_RECORD_LEN       (10U)   //!< Millisecond timestamp and value.
+#define RE_LOG_WRITE_MULTI_MS_TS_MAX           (0xFFFFFFFFFFFFU) //!< Largest 48-bit timestamp.
+
+#define RE_LOG_WRITE_ENV_TS_MSB_OFS            (0U)    //!< MSB offset of timestamp in RE_ENV_ALL record.
+#define RE_LOG_WRITE_ENV_TEMPERATURE_MSB_OFS   (4U)    //!< MSB offset of temperature, i16 centi-C.
+#define RE_LOG_WRITE_ENV_HUMIDITY_MSB_OFS      (6U)    //!< MSB offset of humidity, u16 centi-RH%.
+#define RE_LOG_WRITE_ENV_PRESSURE_MSB_OFS      (8U)    //!< MSB offset of pressure, u16 Pa above minimum.
+#define RE_LOG_WRITE_ENV_RECORD_LEN            (10U)   //!< Length of RE_ENV_ALL record.
+#define RE_LOG_WRITE_ENV_INVALID_I16           (0x8000U) //!< Temperature not available.
+#define RE_LOG_WRITE_ENV_INVALID_U16           (0xFFFFU) //!< Humidity or pressure not available.
+#define RE_LOG_WRITE_ENV_TEMPERATURE_MAX       (327.67F)   //!< Largest absolute temperature, C.
+#define RE_LOG_WRITE_ENV_HUMIDITY_MAX          (655.34F)   //!< Largest humidity, RH%.
+#define RE_LOG_WRITE_ENV_PRESSURE_MIN          (50000.0F)  //!< Smallest pressure, Pa.
+#define RE_LOG_WRITE_ENV_PRESSURE_MAX          (115534.0F) //!< Largest pressure, Pa.
 
 #define RE_LOG_WRITE_AIRQ_TIMESTAMP_MSB_OFS     (0U)    //!< MSB offset of timestamp.
 #define RE_LOG_WRITE_AIRQ_PAYLOAD_OFS           (4U)    //!< Offset of payload.
@@ -227,6 +308,12 @@ typedef enum
     RE_LOG_R = RE_STANDARD_LOG_VALUE_READ,
     RE_LOG_W_MULTI = RE_STANDARD_LOG_MULTI_WRITE,
     RE_LOG_R_MULTI = RE_STANDARD_LOG_MULTI_READ,
+    RE_LOG_W_MULTI_MS = RE_STANDARD_LOG_MULTI_MS_WRITE,
+    RE_LOG_R_MULTI_MS = RE_STANDARD_LOG_MULTI_MS_READ,
+    RE_LOG_W_DELTA = RE_STANDARD_LOG_DELTA_WRITE,
+    RE_LOG_R_DELTA = RE_STANDARD_LOG_DELTA_READ,
+    RE_IMU_W_STREAM = RE_STANDARD_IMU_STREAM_WRITE,
+    RE_IMU_R_STREAM = RE_STANDARD_IMU_STREAM_READ,
 } re_op_t;
 
 /**
@@ -281,6 +368,254 @@ re_status_t re_log_write_timestamp (uint8_t * const buffer, const uint64_t times
 re_status_t re_log_write_data (uint8_t * const buffer, const re_float data,
                                const uint8_t source);
 
+/**
+ * @brief Encode an array of floats of one source into consecutive log messages.
+ *
+ * Output is identical to calling @ref re_log_write_data for each value, but
+ * scaling and saturation run over blocks of values without branches.
+ * Headers and timestamps of the messages are not modified.
+ *
+ * @param[in,out] p_messages num_values 11-byte messages, back to back, with
+ *                           header and timestamp already written.
+ * @param[in]     p_data Values to encode.
+ * @param[in]     num_values Number of values and messages.
+ * @param[in]     source Ruuvi Endpoint data source, e.g. RE_STANDARD_DESTINATION_TEMPERATURE.
+ *
+ * @retval RE_SUCCESS Data was encoded successfully.
+ * @retval RE_ERROR_NULL p_messages or p_data was NULL.
+ * @retval RE_ERROR_INVALID_PARAM if any value was NAN or inf, those are encoded as 0xFFFFFFFF.
+ * @retval RE_NOT_IMPLEMENTED if there's no encoding for given data source.
+ */
+re_status_t re_log_write_data_batch (uint8_t * const p_messages, const re_float * const p_data,
+                                     const size_t num_values, const uint8_t source);
+
+/**
+ * @brief Scale factor from float to i32 of a log data source.
+ *
+ * @param[in] source Ruuvi Endpoint data source, e.g. RE_STANDARD_DESTINATION_TEMPERATURE.
+ * @return Scale factor, 0 if there's no encoding for given source.
+ */
+re_float re_log_scale_factor (const uint8_t source);
+
+/** @brief Records of a received LOG_MULTI message, points into the message. */
+typedef struct
+{
+    uint8_t source;             //!< Source endpoint of data.
+    uint8_t num_records;        //!< Number of records.
+    uint8_t record_len;         //!< Length of each record in bytes.
+    const uint8_t * p_records;  //!< First record.
+} re_log_multi_t;
+
+/**
+ * @brief Write a LOG_MULTI header with no records to given buffer.
+ *
+ * Records are added with @ref re_log_write_multi_record or
+ * @ref re_log_write_multi_value until the buffer is full. As with
+ * @ref re_log_write_header, destination byte is not modified.
+ *
+ * @param[out] buffer Buffer of at least RE_LOG_WRITE_MULTI_HEADER_LEN bytes.
+ * @param[in]  source Source endpoint of data, e.g. RE_STANDARD_DESTINATION_TEMPERATURE.
+ * @param[in]  record_len Length of each record in bytes.
+ * @retval RE_SUCCESS Header was written successfully.
+ * @retval RE_ERROR_NULL Buffer was NULL.
+ * @retval RE_ERROR_INVALID_PARAM record_len was 0.
+ */
+re_status_t re_log_write_multi_header (uint8_t * const buffer, const uint8_t source,
+                                       const uint8_t record_len);
+
+/**
+ * @brief Append a record to a LOG_MULTI message.
+ *
+ * @param[in,out] buffer Message started with @ref re_log_write_multi_header.
+ * @param[in]     buf_len Size of buffer, at most the notification payload size
+ *                        allowed by negotiated ATT MTU (MTU - 3).
+ * @param[in]     p_record Record of record_len bytes.
+ * @retval RE_SUCCESS Record was appended.
+ * @retval RE_ERROR_NULL Buffer or record was NULL.
+ * @retval RE_ERROR_DATA_SIZE Message is full, send it and start a new one.
+ */
+re_status_t re_log_write_multi_record (uint8_t * const buffer, const size_t buf_len,
+                                       const uint8_t * const p_record);
+
+/**
+ * @brief Encode timestamp and value and append them to a LOG_MULTI message.
+ *
+ * The record is encoded as bytes 3 ... 10 of the single value message, see
+ * @ref re_log_write_timestamp and @ref re_log_write_data. Header must have
+ * record length RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN.
+ *
+ * @param[in,out] buffer Message started with @ref re_log_write_multi_header.
+ * @param[in]     buf_len Size of buffer.
+ * @param[in]     timestamp_ms Timestamp as it will be sent to remote.
+ * @param[in]     data Value to encode, scaled by source of the message.
+ * @retval RE_SUCCESS Record was appended.
+ * @retval RE_ERROR_NULL Buffer was NULL.
+ * @retval RE_ERROR_DATA_SIZE Message is full or has other than value records.
+ * @return Otherwise error of timestamp or value encoding, record is not appended.
+ */
+re_status_t re_log_write_multi_value (uint8_t * const buffer, const size_t buf_len,
+                                      const uint64_t timestamp_ms, const re_float data);
+
+/**
+ * @brief Write a LOG_MULTI_MS header with no records to given buffer.
+ *
+ * LOG_MULTI_MS has the framing of LOG_MULTI, but records carry a 48-bit
+ * millisecond timestamp so that samples within a second keep their order.
+ * Records are added with @ref re_log_write_multi_value_ms.
+ *
+ * @param[out] buffer Buffer of at least RE_LOG_WRITE_MULTI_HEADER_LEN bytes.
+ * @param[in]  source Source endpoint of data, e.g. RE_STANDARD_DESTINATION_ACCELERATION_X.
+ * @retval RE_SUCCESS Header was written successfully.
+ * @retval RE_ERROR_NULL Buffer was NULL.
+ */
+re_status_t re_log_write_multi_ms_header (uint8_t * const buffer, const uint8_t source);
+
+/**
+ * @brief Encode millisecond timestamp and value and append them to a LOG_MULTI_MS message.
+ *
+ * Value is scaled and rounded as by @ref re_log_write_data.
+ *
+ * @param[in,out] buffer Message started with @ref re_log_write_multi_ms_header.
+ * @param[in]     buf_len Size of buffer.
+ * @param[in]     timestamp_ms Timestamp as it will be sent to remote.
+ * @param[in]     data Value to encode, scaled by source of the message.
+ * @retval RE_SUCCESS Record was appended.
+ * @retval RE_ERROR_NULL Buffer was NULL.
+ * @retval RE_ERROR_DATA_SIZE Message is full or is not a LOG_MULTI_MS message.
+ * @retval RE_ERROR_INVALID_PARAM Timestamp does not fit in 48 bits.
+ * @return Otherwise error of value encoding, record is not appended.
+ */
+re_status_t re_log_write_multi_value_ms (uint8_t * const buffer, const size_t buf_len,
+        const uint64_t timestamp_ms, const re_float data);
+
+/**
+ * @brief Get the number of bytes to send for a LOG_MULTI message.
+ *
+ * @param[in] buffer Message started with @ref re_log_write_multi_header.
+ * @return Length of header and records, 0 if buffer was NULL.
+ */
+size_t re_log_write_multi_length (const uint8_t * const buffer);
+
+/**
+ * @brief Parse a received LOG_MULTI message.
+ *
+ * Records are not copied, p_log points into the message.
+ *
+ * @param[in]  p_msg Received message.
+ * @param[in]  msg_len Number of received bytes.
+ * @param[out] p_log Records of the message.
+ * @retval RE_SUCCESS Message was parsed.
+ * @retval RE_ERROR_NULL p_msg or p_log was NULL.
+ * @retval RE_ERROR_DECODING_CMD Operation is not RE_STANDARD_LOG_MULTI_WRITE.
+ * @retval RE_ERROR_DECODING_LEN Records do not fit in msg_len or record length is 0.
+ */
+re_status_t re_log_multi_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                 re_log_multi_t * const p_log);
+
+/**
+ * @brief Decode value records of a parsed LOG_MULTI message.
+ *
+ * @param[in]  p_log Records from @ref re_log_multi_decode.
+ * @param[out] p_timestamps_s Array of num_records timestamps in seconds.
+ * @param[out] p_values Array of num_records values, scaled back by source. NaN for
+ *                      values logged as RE_STANDARD_INVALID_I32.
+ * @retval RE_SUCCESS Values were decoded.
+ * @retval RE_ERROR_NULL Any pointer was NULL.
+ * @retval RE_ERROR_INVALID_PARAM Records are not value records.
+ * @retval RE_ERROR_NOT_IMPLEMENTED There's no encoding for the source.
+ */
+re_status_t re_log_multi_decode_values (const re_log_multi_t * const p_log,
+                                        uint32_t * const p_timestamps_s,
+                                        re_float * const p_values);
+
+/**
+ * @brief Parse a received LOG_MULTI_MS message.
+ *
+ * @param[in]  p_msg Received message.
+ * @param[in]  msg_len Number of received bytes.
+ * @param[out] p_log Records of the message, pointing into the message.
+ * @retval RE_SUCCESS Message was parsed.
+ * @retval RE_ERROR_NULL p_msg or p_log was NULL.
+ * @retval RE_ERROR_DECODING_CMD Operation is not RE_STANDARD_LOG_MULTI_MS_WRITE.
+ * @retval RE_ERROR_DECODING_LEN Records do not fit in msg_len or record length is 0.
+ */
+re_status_t re_log_multi_ms_decode (const uint8_t * const p_msg, const size_t msg_len,
+                                    re_log_multi_t * const p_log);
+
+/**
+ * @brief Decode millisecond value records of a parsed LOG_MULTI_MS message.
+ *
+ * @param[in]  p_log Records from @ref re_log_multi_ms_decode.
+ * @param[out] p_timestamps_ms Array of num_records timestamps in milliseconds.
+ * @param[out] p_values Array of num_records values, scaled back by source. NaN for
+ *                      values logged as RE_STANDARD_INVALID_I32.
+ * @retval RE_SUCCESS Records were decoded.
+ * @retval RE_ERROR_NULL Any pointer was NULL.
+ * @retval RE_ERROR_INVALID_PARAM Records are not millisecond value records.
+ * @retval RE_ERROR_NOT_IMPLEMENTED There's no encoding for the source.
+ */
+re_status_t re_log_multi_decode_values_ms (const re_log_multi_t * const p_log,
+        uint64_t * const p_timestamps_ms,
+        re_float * const p_values);
+
+/** @brief Environmental sample of a RE_ENV_ALL record. */
+typedef struct
+{
+    re_float temperature_c; //!< Temperature in degrees Celsius, NAN if not available.
+    re_float humidity_rh;   //!< Relative humidity in percent, NAN if not available.
+    re_float pressure_pa;   //!< Pressure in Pascals, NAN if not available.
+} re_log_env_t;
+
+/**
+ * @brief Encode a combined temperature, humidity and pressure record.
+ *
+ * Replaces three single value messages of RE_ENV_TEMP, RE_ENV_HUMI and
+ * RE_ENV_PRES with one record in a LOG_MULTI message of source RE_ENV_ALL.
+ * Values have the resolution of the single value messages and are clipped
+ * to the range of the record.
+ *
+ * @param[out] p_record Buffer of RE_LOG_WRITE_ENV_RECORD_LEN bytes.
+ * @param[in]  timestamp_ms Timestamp as it will be sent to remote.
+ * @param[in]  p_env Sample to encode, NAN values are encoded as not available.
+ * @retval RE_SUCCESS Record was encoded.
+ * @retval RE_ERROR_NULL Any pointer was NULL.
+ * @retval RE_ERROR_INVALID_PARAM Timestamp cannot be encoded as 32-bit second value.
+ */
+re_status_t re_log_write_env_record (uint8_t * const p_record, const uint64_t timestamp_ms,
+                                     const re_log_env_t * const p_env);
+
+/**
+ * @brief Encode a combined environmental record and append it to a LOG_MULTI message.
+ *
+ * Header must have source RE_ENV_ALL and record length RE_LOG_WRITE_ENV_RECORD_LEN.
+ *
+ * @param[in,out] buffer Message started with @ref re_log_write_multi_header.
+ * @param[in]     buf_len Size of buffer.
+ * @param[in]     timestamp_ms Timestamp as it will be sent to remote.
+ * @param[in]     p_env Sample to encode.
+ * @retval RE_SUCCESS Record was appended.
+ * @retval RE_ERROR_NULL Buffer or p_env was NULL.
+ * @retval RE_ERROR_DATA_SIZE Message is full or has other than RE_ENV_ALL records.
+ * @return Otherwise error of record encoding, record is not appended.
+ */
+re_status_t re_log_write_multi_env (uint8_t * const buffer, const size_t buf_len,
+                                    const uint64_t timestamp_ms,
+                                    const re_log_env_t * const p_env);
+
+/**
+ * @brief Decode RE_ENV_ALL records of a parsed LOG_MULTI message.
+ *
+ * @param[in]  p_log Records from @ref re_log_multi_decode.
+ * @param[out] p_timestamps_s Array of num_records timestamps in seconds.
+ * @param[out] p_env Array of num_records samples, NAN where not available.
+ * @retval RE_SUCCESS Records were decoded.
+ * @retval RE_ERROR_NULL Any pointer was NULL.
+ * @retval RE_ERROR_INVALID_PARAM Records are not RE_ENV_ALL records.
+ */
+re_status_t re_log_multi_decode_env (const re_log_multi_t * const p_log,
+                                     uint32_t * const p_timestamps_s,
+                                     re_log_env_t * const p_env);
+
 /**
  * @brief Clip given float to the given range.
  *
@@ -354,4 +689,35 @@ static inline re_float re_clip_float (const re_float value, const re_float min,
  */
 uint8_t re_calc_crc8 (const uint8_t * DataArray, const uint16_t Length);
 
+/** @brief One block of a batched cipher operation. */
+typedef struct
+{
+    const uint8_t * p_input;  //!< Input block, block_size bytes.
+    uint8_t * p_output;       //!< Output block, block_size bytes.
+    const uint8_t * p_key;    //!< Key of this block.
+    size_t key_size;          //!< Length of key in bytes.
+    uint32_t status;          //!< Set by cipher, 0 on success.
+} re_cipher_block_t;
+
+#ifndef RE_CIPHER_BATCH_BLOCKS
+#   define RE_CIPHER_BATCH_BLOCKS (16U) //!< Blocks per cipher call in batch decode, uses stack.
+#endif
+#define RE_CIPHER_BLOCK_SIZE (16U) //!< Largest ciphertext of a batch decoded data format.
+
+/**
+ * @brief Batched cipher function for encrypted data formats.
+ *
+ * Processes all given blocks in one call so that the implementation can
+ * pipeline hardware AES instructions over independent blocks. Blocks may
+ * have different keys.
+ *
+ * @param[in,out] p_blocks Blocks to process, status of each block is set.
+ * @param[in]     num_blocks Number of blocks.
+ * @param[in]     block_size Size of each input and output block in bytes.
+ * @return 0 on success, non-zero if the whole batch failed.
+ */
+typedef uint32_t (*re_cipher_batch_fp) (re_cipher_block_t * const p_blocks,
+                                        const size_t num_blocks,
+                                        const size_t block_size);
+
 #endif
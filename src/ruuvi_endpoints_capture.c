@@ -0,0 +1,347 @@
+#include "ruuvi_endpoints_capture.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if RE_CAPTURE_ENABLED
+
+#define RE_CAPTURE_VERSION_IDX     (4U)  //!< Version.
+#define RE_CAPTURE_INDEX_CAP_IDX   (8U)  //!< MSB of index capacity.
+#define RE_CAPTURE_NUM_INDEX_IDX   (12U) //!< MSB of index entries used.
+#define RE_CAPTURE_DATA_LEN_IDX    (16U) //!< MSB of bytes of records.
+#define RE_CAPTURE_NUM_RECORDS_IDX (20U) //!< MSB of number of records.
+#define RE_CAPTURE_ENTRY_OFFSET_IDX (8U) //!< MSB of record offset in index entry.
+#define RE_CAPTURE_FRAME_LEN_IDX   (8U)  //!< MSB of frame length in record.
+#define RE_CAPTURE_BYTE_SHIFT      (8U)  //!< Bits per byte.
+
+static const uint8_t m_magic[] = { 'R', 'E', 'C', 'P' };
+
+static void re_capture_write_u32 (uint8_t * const p_msb, const uint32_t value)
+{
+    p_msb[0] = (uint8_t) (value >> RE_BYTE_3_SHIFT);
+    p_msb[1] = (uint8_t) (value >> RE_BYTE_2_SHIFT);
+    p_msb[2] = (uint8_t) (value >> RE_BYTE_1_SHIFT);
+    p_msb[3] = (uint8_t) value;
+}
+
+static uint32_t re_capture_read_u32 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << RE_BYTE_3_SHIFT)
+           | ( (uint32_t) p_msb[1] << RE_BYTE_2_SHIFT)
+           | ( (uint32_t) p_msb[2] << RE_BYTE_1_SHIFT)
+           | p_msb[3];
+}
+
+static void re_capture_write_u64 (uint8_t * const p_msb, const uint64_t value)
+{
+    for (size_t ii = 0; ii < sizeof (value); ii++)
+    {
+        p_msb[ii] = (uint8_t) (value >> ( (sizeof (value) - 1U - ii) * RE_CAPTURE_BYTE_SHIFT));
+    }
+}
+
+static uint64_t re_capture_read_u64 (const uint8_t * const p_msb)
+{
+    uint64_t value = 0;
+
+    for (size_t ii = 0; ii < sizeof (value); ii++)
+    {
+        value = (value << RE_CAPTURE_BYTE_SHIFT) | p_msb[ii];
+    }
+
+    return value;
+}
+
+static const uint8_t * re_capture_entry (const re_capture_reader_t * const p_reader,
+        const uint32_t index)
+{
+    return &p_reader->p_segment[RE_CAPTURE_HEADER_LEN
+                                + ( (size_t) index * RE_CAPTURE_INDEX_ENTRY_LEN)];
+}
+
+/**
+ * @brief Parse header of record at given offset.
+ *
+ * @return False if record does not fit in the records of the segment.
+ */
+static bool re_capture_record_at (const re_capture_reader_t * const p_reader,
+                                  const uint32_t offset, uint64_t * const p_time,
+                                  size_t * const p_frame_len)
+{
+    bool valid = false;
+
+    if ( (offset < p_reader->data_len)
+            && ( (p_reader->data_len - offset) >= RE_CAPTURE_RECORD_HEADER_LEN))
+    {
+        const uint8_t * const p_record = &p_reader->p_segment[p_reader->data_start + offset];
+        const size_t frame_len = ( (size_t) p_record[RE_CAPTURE_FRAME_LEN_IDX]
+                                   << RE_BYTE_1_SHIFT)
+                                 | p_record[RE_CAPTURE_FRAME_LEN_IDX + 1U];
+        *p_time = re_capture_read_u64 (p_record);
+        *p_frame_len = frame_len;
+        valid = (0U != frame_len)
+                && ( (p_reader->data_len - offset - RE_CAPTURE_RECORD_HEADER_LEN) >= frame_len);
+    }
+
+    return valid;
+}
+
+re_status_t re_capture_create (re_capture_writer_t * const p_writer,
+                               uint8_t * const p_segment,
+                               const size_t segment_len)
+{
+    re_status_t result = RE_SUCCESS;
+    const uint64_t index_cap = ( (uint64_t) segment_len / RE_CAPTURE_INDEX_STRIDE) + 1U;
+    const uint64_t data_start = RE_CAPTURE_HEADER_LEN
+                                + (index_cap * RE_CAPTURE_INDEX_ENTRY_LEN);
+
+    if ( (NULL == p_writer) || (NULL == p_segment))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( ( (uint64_t) segment_len > UINT32_MAX) || (data_start >= segment_len))
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        memset (p_writer, 0, sizeof (*p_writer));
+        p_writer->p_segment = p_segment;
+        p_writer->segment_len = segment_len;
+        p_writer->data_start = (size_t) data_start;
+        p_writer->index_cap = (uint32_t) index_cap;
+        memset (p_segment, 0, RE_CAPTURE_HEADER_LEN);
+        memcpy (p_segment, m_magic, sizeof (m_magic));
+        p_segment[RE_CAPTURE_VERSION_IDX] = RE_CAPTURE_VERSION;
+        re_capture_write_u32 (&p_segment[RE_CAPTURE_INDEX_CAP_IDX], p_writer->index_cap);
+    }
+
+    return result;
+}
+
+re_status_t re_capture_append (re_capture_writer_t * const p_writer,
+                               const uint64_t time,
+                               const uint8_t * const p_frame,
+                               const size_t frame_len)
+{
+    re_status_t result = RE_SUCCESS;
+    re_ca_uart_payload_t payload = {0};
+
+    if ( (NULL == p_writer) || (NULL == p_frame))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U != p_writer->num_records) && (time < p_writer->last_time))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        result |= re_ca_uart_decode_checked (p_frame, frame_len, &payload);
+    }
+
+    if (RE_SUCCESS == result)
+    {
+        // Store only the frame, not bytes received after it.
+        const size_t stored_len = (size_t) p_frame[RE_CA_UART_LEN_INDEX]
+                                  + RE_CA_UART_FRAME_OVERHEAD;
+        const size_t record_len = RE_CAPTURE_RECORD_HEADER_LEN + stored_len;
+        const uint32_t offset = p_writer->data_len;
+
+        if ( (p_writer->segment_len - p_writer->data_start - offset) < record_len)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            uint8_t * const p_segment = p_writer->p_segment;
+            uint8_t * const p_record = &p_segment[p_writer->data_start + offset];
+            re_capture_write_u64 (p_record, time);
+            p_record[RE_CAPTURE_FRAME_LEN_IDX] = (uint8_t) (stored_len >> RE_BYTE_1_SHIFT);
+            p_record[RE_CAPTURE_FRAME_LEN_IDX + 1U] = (uint8_t) stored_len;
+            memcpy (&p_record[RE_CAPTURE_RECORD_HEADER_LEN], p_frame, stored_len);
+
+            if ( (offset >= p_writer->next_index_at)
+                    && (p_writer->num_index < p_writer->index_cap))
+            {
+                uint8_t * const p_entry = &p_segment[RE_CAPTURE_HEADER_LEN
+                                                     + ( (size_t) p_writer->num_index
+                                                         * RE_CAPTURE_INDEX_ENTRY_LEN)];
+                re_capture_write_u64 (p_entry, time);
+                re_capture_write_u32 (&p_entry[RE_CAPTURE_ENTRY_OFFSET_IDX], offset);
+                p_writer->num_index++;
+                p_writer->next_index_at = offset + RE_CAPTURE_INDEX_STRIDE;
+            }
+
+            p_writer->data_len += (uint32_t) record_len;
+            p_writer->num_records++;
+            p_writer->last_time = time;
+            // Commit record before index entry, readers never see a dangling entry.
+            re_capture_write_u32 (&p_segment[RE_CAPTURE_DATA_LEN_IDX], p_writer->data_len);
+            re_capture_write_u32 (&p_segment[RE_CAPTURE_NUM_RECORDS_IDX],
+                                  p_writer->num_records);
+            re_capture_write_u32 (&p_segment[RE_CAPTURE_NUM_INDEX_IDX], p_writer->num_index);
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_capture_open (re_capture_reader_t * const p_reader,
+                             const uint8_t * const p_segment,
+                             const size_t segment_len)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_reader) || (NULL == p_segment))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (segment_len < RE_CAPTURE_HEADER_LEN)
+              || (0 != memcmp (p_segment, m_magic, sizeof (m_magic)))
+              || (RE_CAPTURE_VERSION != p_segment[RE_CAPTURE_VERSION_IDX]))
+    {
+        result |= RE_ERROR_DECODING;
+    }
+    else
+    {
+        const uint64_t index_cap = re_capture_read_u32 (&p_segment[RE_CAPTURE_INDEX_CAP_IDX]);
+        const uint32_t num_index = re_capture_read_u32 (&p_segment[RE_CAPTURE_NUM_INDEX_IDX]);
+        const uint32_t data_len = re_capture_read_u32 (&p_segment[RE_CAPTURE_DATA_LEN_IDX]);
+        const uint64_t data_start = RE_CAPTURE_HEADER_LEN
+                                    + (index_cap * RE_CAPTURE_INDEX_ENTRY_LEN);
+
+        if ( (num_index > index_cap) || (data_start > segment_len)
+                || (data_len > (segment_len - data_start)))
+        {
+            result |= RE_ERROR_DECODING_LEN;
+        }
+        else
+        {
+            p_reader->p_segment = p_segment;
+            p_reader->data_start = (size_t) data_start;
+            p_reader->data_len = data_len;
+            p_reader->num_index = num_index;
+            p_reader->offset = 0U;
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_capture_seek (re_capture_reader_t * const p_reader, const uint64_t time)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_reader)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        uint32_t low = 0;
+        uint32_t high = p_reader->num_index;
+        uint32_t offset = 0;
+
+        // Find first entry at or after time, scan from the one before it.
+        while (low < high)
+        {
+            const uint32_t mid = low + ( (high - low) / 2U);
+
+            if (re_capture_read_u64 (re_capture_entry (p_reader, mid)) < time)
+            {
+                low = mid + 1U;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+
+        if (0U != low)
+        {
+            offset = re_capture_read_u32 (&re_capture_entry (p_reader,
+                                          low - 1U) [RE_CAPTURE_ENTRY_OFFSET_IDX]);
+        }
+
+        bool found = false;
+
+        while ( (RE_SUCCESS == result) && (!found) && (offset < p_reader->data_len))
+        {
+            uint64_t record_time = 0;
+            size_t frame_len = 0;
+
+            if (!re_capture_record_at (p_reader, offset, &record_time, &frame_len))
+            {
+                result |= RE_ERROR_DECODING_LEN;
+            }
+            else if (record_time >= time)
+            {
+                found = true;
+            }
+            else
+            {
+                offset += (uint32_t) (RE_CAPTURE_RECORD_HEADER_LEN + frame_len);
+            }
+        }
+
+        if (RE_SUCCESS == result)
+        {
+            p_reader->offset = (offset < p_reader->data_len) ? offset : p_reader->data_len;
+        }
+    }
+
+    return result;
+}
+
+re_status_t re_capture_read (re_capture_reader_t * const p_reader,
+                             const uint8_t ** const pp_frames,
+                             size_t * const p_frame_lens, uint64_t * const p_times,
+                             const size_t max_records, size_t * const p_num_records)
+{
+    re_status_t result = RE_SUCCESS;
+    size_t num_records = 0;
+
+    if ( (NULL == p_reader) || (NULL == pp_frames) || (NULL == p_num_records))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        while ( (RE_SUCCESS == result) && (num_records < max_records)
+                && (p_reader->offset < p_reader->data_len))
+        {
+            uint64_t time = 0;
+            size_t frame_len = 0;
+
+            if (!re_capture_record_at (p_reader, p_reader->offset, &time, &frame_len))
+            {
+                result |= RE_ERROR_DECODING_LEN;
+            }
+            else
+            {
+                pp_frames[num_records] = &p_reader->p_segment[p_reader->data_start
+                                         + p_reader->offset + RE_CAPTURE_RECORD_HEADER_LEN];
+
+                if (NULL != p_frame_lens)
+                {
+                    p_frame_lens[num_records] = frame_len;
+                }
+
+                if (NULL != p_times)
+                {
+                    p_times[num_records] = time;
+                }
+
+                p_reader->offset += (uint32_t) (RE_CAPTURE_RECORD_HEADER_LEN + frame_len);
+                num_records++;
+            }
+        }
+
+        *p_num_records = num_records;
+    }
+
+    return result;
+}
+
+#endif
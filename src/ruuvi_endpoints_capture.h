@@ -0,0 +1,161 @@
+/**
+ * Ruuvi Endpoints capture segments of raw CA UART traffic.
+ *
+ * Records received CA UART frames with their receive time into append-only
+ * segments for incident analysis and benchmarks. A segment is a fixed-size
+ * block of caller memory, normally a file mapped with mmap, so frames are
+ * written to and read from the page cache without copies:
+ *
+ *     fd = open (path, O_RDWR | O_CREAT, 0644);
+ *     ftruncate (fd, len);
+ *     p_segment = mmap (NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+ *     re_capture_create (&writer, p_segment, len);
+ *
+ * The library itself makes no system calls. The reader returns pointers into
+ * the segment, which can be passed on as is, e.g. to
+ * @ref re_ca_uart_decode_checked.
+ *
+ * Segment layout, integers big-endian:
+ *  0-3   Magic "RECP"
+ *  4     Version
+ *  5-7   Reserved, 0
+ *  8-11  Index capacity, entries
+ *  12-15 Index entries used
+ *  16-19 Bytes of records
+ *  20-23 Number of records
+ *  24-   Sparse index, 12 bytes per entry: u64 time, u32 record offset.
+ *        An entry is added for the first record at or after every
+ *        RE_CAPTURE_INDEX_STRIDE bytes of records.
+ *  Then records: u64 receive time, u16 frame length, frame.
+ *
+ * Counters in the header are updated after the record is written, a
+ * segment cut short by a crash holds only complete records.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_CAPTURE_H
+#define RUUVI_ENDPOINTS_CAPTURE_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(RE_CAPTURE_INDEX_STRIDE)
+#   define RE_CAPTURE_INDEX_STRIDE (4096U) //!< Bytes of records between index entries.
+#endif
+#define RE_CAPTURE_VERSION          (1U)
+#define RE_CAPTURE_HEADER_LEN       (24U)  //!< Bytes before index.
+#define RE_CAPTURE_INDEX_ENTRY_LEN  (12U)  //!< Bytes of an index entry.
+#define RE_CAPTURE_RECORD_HEADER_LEN (10U) //!< Bytes before frame in a record.
+
+/** @brief State of a segment being written. */
+typedef struct
+{
+    uint8_t * p_segment;    //!< Segment.
+    size_t segment_len;     //!< Size of segment.
+    size_t data_start;      //!< Offset of first record.
+    uint32_t data_len;      //!< Bytes of records.
+    uint32_t num_records;   //!< Number of records.
+    uint32_t index_cap;     //!< Index capacity.
+    uint32_t num_index;     //!< Index entries used.
+    uint32_t next_index_at; //!< Record offset of next index entry.
+    uint64_t last_time;     //!< Receive time of last record.
+} re_capture_writer_t;
+
+/** @brief State of a segment being read. */
+typedef struct
+{
+    const uint8_t * p_segment; //!< Segment.
+    size_t data_start;         //!< Offset of first record.
+    uint32_t data_len;         //!< Bytes of records.
+    uint32_t num_index;        //!< Index entries.
+    uint32_t offset;           //!< Offset of next record.
+} re_capture_reader_t;
+
+/**
+ * @brief Start a new empty segment.
+ *
+ * @param[out] p_writer Writer state.
+ * @param[out] p_segment Segment memory, e.g. a mapped file.
+ * @param[in]  segment_len Size of segment, less than 4 GiB.
+ * @retval RE_SUCCESS if segment was started.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if segment is too small or too large.
+ */
+re_status_t re_capture_create (re_capture_writer_t * const p_writer,
+                               uint8_t * const p_segment,
+                               const size_t segment_len);
+
+/**
+ * @brief Validate a received frame and append it to the segment.
+ *
+ * Only the frame length declared by its LEN byte is stored, bytes after ETX
+ * are dropped.
+ *
+ * @param[in,out] p_writer Started writer.
+ * @param[in]     time Receive time in caller's units, e.g. microseconds.
+ *                     Must not decrease, seek relies on it.
+ * @param[in]     p_frame Received CA UART frame.
+ * @param[in]     frame_len Number of received bytes.
+ * @retval RE_SUCCESS if frame was appended.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if time is before time of last record.
+ * @retval RE_ERROR_DATA_SIZE if segment is full, start a new one.
+ * @return Otherwise error of @ref re_ca_uart_decode_checked, frame is not appended.
+ */
+re_status_t re_capture_append (re_capture_writer_t * const p_writer,
+                               const uint64_t time,
+                               const uint8_t * const p_frame,
+                               const size_t frame_len);
+
+/**
+ * @brief Open a segment for reading from its first record.
+ *
+ * @param[out] p_reader Reader state.
+ * @param[in]  p_segment Segment, must stay valid while reading.
+ * @param[in]  segment_len Size of segment.
+ * @retval RE_SUCCESS if segment was opened.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DECODING if segment has no valid header.
+ * @retval RE_ERROR_DECODING_LEN if header points beyond segment_len.
+ */
+re_status_t re_capture_open (re_capture_reader_t * const p_reader,
+                             const uint8_t * const p_segment,
+                             const size_t segment_len);
+
+/**
+ * @brief Move reader to the first record received at or after given time.
+ *
+ * Binary searches the sparse index, then scans at most one stride of records.
+ *
+ * @param[in,out] p_reader Opened reader.
+ * @param[in]     time Receive time to seek to.
+ * @retval RE_SUCCESS if reader was moved, possibly to the end of segment.
+ * @retval RE_ERROR_NULL if p_reader is NULL.
+ * @retval RE_ERROR_DECODING_LEN if a record is corrupt.
+ */
+re_status_t re_capture_seek (re_capture_reader_t * const p_reader, const uint64_t time);
+
+/**
+ * @brief Read next records without copying frames.
+ *
+ * Frame pointers point into the segment, arrays can be handed to decoders
+ * in one batch.
+ *
+ * @param[in,out] p_reader Opened reader.
+ * @param[out]    pp_frames Pointers to frames.
+ * @param[out]    p_frame_lens Lengths of frames, may be NULL.
+ * @param[out]    p_times Receive times, may be NULL.
+ * @param[in]     max_records Size of output arrays.
+ * @param[out]    p_num_records Number of records read, 0 at end of segment.
+ * @retval RE_SUCCESS if records were read or segment has ended.
+ * @retval RE_ERROR_NULL if a required pointer is NULL.
+ * @retval RE_ERROR_DECODING_LEN if a record is corrupt, records before it are read.
+ */
+re_status_t re_capture_read (re_capture_reader_t * const p_reader,
+                             const uint8_t ** const pp_frames,
+                             size_t * const p_frame_lens, uint64_t * const p_times,
+                             const size_t max_records, size_t * const p_num_records);
+
+#endif // RUUVI_ENDPOINTS_CAPTURE_H
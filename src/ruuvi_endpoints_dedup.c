@@ -0,0 +1,279 @@
+#include "ruuvi_endpoints_dedup.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoints_internal.h"
+#include <string.h>
+
+#if RE_DEDUP_ENABLED
+
+static void re_dedup_release (re_dedup_t * const p_dedup, re_dedup_entry_t * const p_entry)
+{
+    p_entry->state = RE_DEDUP_ENTRY_RELEASED;
+    p_dedup->release (&p_entry->adv, p_dedup->p_context);
+}
+
+/**
+ * @brief Order of reuse of entries of other tags, lowest first.
+ */
+static uint8_t re_dedup_reuse_rank (const re_dedup_entry_t * const p_entry)
+{
+    uint8_t rank = 2U;
+
+    if (RE_DEDUP_ENTRY_EMPTY == p_entry->state)
+    {
+        rank = 0U;
+    }
+    else if (RE_DEDUP_ENTRY_RELEASED == p_entry->state)
+    {
+        rank = 1U;
+    }
+    else
+    {
+        // Held copies are reused last.
+    }
+
+    return rank;
+}
+
+/**
+ * @brief Entry of given tag in its bucket, or the entry to reuse for it.
+ *
+ * Empty entries are reused before released ones and released before held,
+ * older before newer.
+ */
+static re_dedup_entry_t * re_dedup_find (const re_dedup_t * const p_dedup,
+        const uint64_t mac)
+{
+    const size_t ways = (p_dedup->capacity < RE_DEDUP_WAYS) ?
+                        p_dedup->capacity : RE_DEDUP_WAYS;
+    const size_t first = re_mac_home_slot (mac, p_dedup->capacity) & ~ (ways - 1U);
+    re_dedup_entry_t * p_found = NULL;
+    re_dedup_entry_t * p_reuse = &p_dedup->p_entries[first];
+
+    for (size_t ii = first; (ii < (first + ways)) && (NULL == p_found); ii++)
+    {
+        re_dedup_entry_t * const p_entry = &p_dedup->p_entries[ii];
+        const uint8_t rank = re_dedup_reuse_rank (p_entry);
+        const uint8_t reuse_rank = re_dedup_reuse_rank (p_reuse);
+
+        if ( (RE_DEDUP_ENTRY_EMPTY != p_entry->state) && (mac == p_entry->mac))
+        {
+            p_found = p_entry;
+        }
+        else if ( (rank < reuse_rank)
+                  || ( (rank == reuse_rank)
+                       && ( (int32_t) (p_entry->first_seen_ms - p_reuse->first_seen_ms) < 0)))
+        {
+            p_reuse = p_entry;
+        }
+        else
+        {
+            // Keep current candidate.
+        }
+    }
+
+    return (NULL != p_found) ? p_found : p_reuse;
+}
+
+re_status_t re_dedup_counter_read (const uint8_t * const p_adv, const size_t adv_len,
+                                   uint8_t * const p_data_format,
+                                   uint32_t * const p_counter)
+{
+    re_status_t result = RE_SUCCESS;
+    uint32_t counter = 0;
+    uint8_t data_format = 0;
+
+    if ( (NULL == p_adv) || (NULL == p_data_format) || (NULL == p_counter))
+    {
+        result |= RE_ERROR_NULL;
+    }
+#if RE_5_ENABLED
+    else if ( (adv_len >= RE_5_RAW_MIN_LEN) && re_5_check_format (p_adv))
+    {
+        const uint8_t * const p_seq = &p_adv[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_MSB];
+        data_format = RE_5_DESTINATION;
+        counter = ( (uint32_t) p_seq[0] << RE_BYTE_1_SHIFT) | p_seq[1];
+        result |= (RE_5_INVALID_SEQUENCE == counter) ? RE_ERROR_INVALID_PARAM : RE_SUCCESS;
+    }
+#endif
+#if RE_6_ENABLED
+    else if ( (adv_len >= RE_6_RAW_BUF_SIZE) && re_6_check_format (p_adv))
+    {
+        data_format = RE_6_DESTINATION;
+        counter = p_adv[RE_6_OFFSET_PAYLOAD + RE_6_OFFSET_SEQ_CNT2];
+    }
+#endif
+#if RE_7_ENABLED
+    else if ( (adv_len >= RE_7_RAW_MIN_LEN) && re_7_check_format (p_adv))
+    {
+        data_format = RE_7_DESTINATION;
+        counter = p_adv[RE_7_OFFSET_PAYLOAD + RE_7_OFFSET_SEQ];
+        result |= (RE_7_INVALID_SEQUENCE == counter) ? RE_ERROR_INVALID_PARAM : RE_SUCCESS;
+    }
+#endif
+#if RE_E1_ENABLED
+    else if ( (adv_len >= RE_E1_RAW_MIN_LEN) && re_e1_check_format (p_adv))
+    {
+        const uint8_t * const p_seq = &p_adv[RE_E1_OFFSET_PAYLOAD + RE_E1_OFFSET_SEQ_CNT_MSB];
+        data_format = RE_E1_DESTINATION;
+        counter = ( (uint32_t) p_seq[0] << RE_BYTE_2_SHIFT)
+                  | ( (uint32_t) p_seq[1] << RE_BYTE_1_SHIFT)
+                  | p_seq[2];
+        result |= (RE_E1_INVALID_SEQUENCE == counter) ? RE_ERROR_INVALID_PARAM : RE_SUCCESS;
+    }
+#endif
+    else
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+
+    if (RE_SUCCESS == result)
+    {
+        *p_data_format = data_format;
+        *p_counter = counter;
+    }
+
+    return result;
+}
+
+re_status_t re_dedup_init (re_dedup_t * const p_dedup,
+                           re_dedup_entry_t * const p_entries,
+                           const size_t capacity,
+                           const uint32_t window_ms,
+                           re_dedup_release_fp release,
+                           void * const p_context)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_dedup) || (NULL == p_entries) || (NULL == release))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U == capacity) || (0U != (capacity & (capacity - 1U))))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        memset (p_entries, 0, capacity * sizeof (re_dedup_entry_t));
+        p_dedup->p_entries = p_entries;
+        p_dedup->capacity = capacity;
+        p_dedup->window_ms = window_ms;
+        p_dedup->release = release;
+        p_dedup->p_context = p_context;
+        p_dedup->num_dropped = 0;
+    }
+
+    return result;
+}
+
+re_status_t re_dedup_push (re_dedup_t * const p_dedup,
+                           const re_ca_uart_ble_adv_t * const p_adv,
+                           const uint32_t now_ms,
+                           re_dedup_action_t * const p_action)
+{
+    re_status_t result = RE_SUCCESS;
+    re_dedup_action_t action = RE_DEDUP_PASSED;
+    uint8_t data_format = 0;
+    uint32_t counter = 0;
+
+    if ( (NULL == p_dedup) || (NULL == p_adv))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (p_adv->adv_len > sizeof (p_adv->adv))
+              || (RE_SUCCESS != re_dedup_counter_read (p_adv->adv, p_adv->adv_len,
+                      &data_format, &counter)))
+    {
+        p_dedup->release (p_adv, p_dedup->p_context);
+    }
+    else
+    {
+        const uint64_t mac = re_mac_read (p_adv->mac);
+        re_dedup_entry_t * const p_entry = re_dedup_find (p_dedup, mac);
+        const bool same_key = (RE_DEDUP_ENTRY_EMPTY != p_entry->state)
+                              && (mac == p_entry->mac)
+                              && (data_format == p_entry->data_format)
+                              && (counter == p_entry->counter);
+
+        if (same_key && (RE_DEDUP_ENTRY_HELD == p_entry->state)
+                && (p_adv->rssi_db > p_entry->adv.rssi_db))
+        {
+            memcpy (&p_entry->adv, p_adv, sizeof (p_entry->adv));
+            p_dedup->num_dropped++;
+            action = RE_DEDUP_REPLACED;
+        }
+        else if (same_key)
+        {
+            p_dedup->num_dropped++;
+            action = RE_DEDUP_DROPPED;
+        }
+        else
+        {
+            if (RE_DEDUP_ENTRY_HELD == p_entry->state)
+            {
+                re_dedup_release (p_dedup, p_entry);
+            }
+
+            memcpy (&p_entry->adv, p_adv, sizeof (p_entry->adv));
+            p_entry->mac = mac;
+            p_entry->counter = counter;
+            p_entry->data_format = data_format;
+            p_entry->first_seen_ms = now_ms;
+            p_entry->state = RE_DEDUP_ENTRY_HELD;
+            action = RE_DEDUP_HELD;
+        }
+    }
+
+    if (NULL != p_action)
+    {
+        *p_action = action;
+    }
+
+    return result;
+}
+
+size_t re_dedup_flush (re_dedup_t * const p_dedup, const uint32_t now_ms)
+{
+    size_t num_released = 0;
+
+    if (NULL != p_dedup)
+    {
+        for (size_t ii = 0; ii < p_dedup->capacity; ii++)
+        {
+            re_dedup_entry_t * const p_entry = &p_dedup->p_entries[ii];
+
+            if ( (RE_DEDUP_ENTRY_HELD == p_entry->state)
+                    && ( (uint32_t) (now_ms - p_entry->first_seen_ms) >= p_dedup->window_ms))
+            {
+                re_dedup_release (p_dedup, p_entry);
+                num_released++;
+            }
+        }
+    }
+
+    return num_released;
+}
+
+size_t re_dedup_flush_all (re_dedup_t * const p_dedup)
+{
+    size_t num_released = 0;
+
+    if (NULL != p_dedup)
+    {
+        for (size_t ii = 0; ii < p_dedup->capacity; ii++)
+        {
+            if (RE_DEDUP_ENTRY_HELD == p_dedup->p_entries[ii].state)
+            {
+                re_dedup_release (p_dedup, &p_dedup->p_entries[ii]);
+                num_released++;
+            }
+        }
+    }
+
+    return num_released;
+}
+
+#endif
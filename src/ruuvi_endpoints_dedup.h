@@ -0,0 +1,155 @@
+/**
+ * Ruuvi Endpoints cross-channel duplicate suppression.
+ *
+ * A scanner may report the same advertisement once on each of the primary
+ * advertising channels 37, 38 and 39. Reports are keyed by MAC address, data
+ * format and measurement counter of the payload, which are read from the raw
+ * advertisement without decoding it. The first copy of a measurement is held
+ * for a short window and the copy with the best RSSI is released to the
+ * caller when the window closes, later copies are dropped.
+ *
+ * Formats with a measurement counter are DF5, DF6, DF7 and DFxE1. Reports of
+ * other formats are released immediately.
+ *
+ * Storage is provided by the caller. Each tag hashes to a bucket of
+ * RE_DEDUP_WAYS entries. When every entry of a bucket is in use the oldest
+ * one is reused and its held copy is released early, size the table for the
+ * number of tags in range.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_DEDUP_H
+#define RUUVI_ENDPOINTS_DEDUP_H
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_DEDUP_DEFAULT_WINDOW_MS (100U) //!< Covers reports of one advertising event.
+#define RE_DEDUP_WAYS              (4U)   //!< Entries of a bucket, power of two.
+
+/** @brief What was done with a pushed report. */
+typedef enum
+{
+    RE_DEDUP_HELD = 0, //!< First copy of a measurement, held until window closes.
+    RE_DEDUP_REPLACED, //!< Copy with better RSSI replaced the held copy.
+    RE_DEDUP_DROPPED,  //!< Repeat of a measurement, dropped.
+    RE_DEDUP_PASSED    //!< Format has no measurement counter, released immediately.
+} re_dedup_action_t;
+
+/** @brief State of an entry. */
+typedef enum
+{
+    RE_DEDUP_ENTRY_EMPTY = 0, //!< Entry has not been used.
+    RE_DEDUP_ENTRY_HELD,      //!< A copy is held.
+    RE_DEDUP_ENTRY_RELEASED   //!< Copy was released, key is kept to drop late repeats.
+} re_dedup_entry_state_t;
+
+/** @brief Latest measurement of one tag. */
+typedef struct
+{
+    re_ca_uart_ble_adv_t adv;     //!< Best copy of the measurement.
+    uint64_t mac;                 //!< MAC address of the tag.
+    uint32_t counter;             //!< Measurement counter.
+    uint32_t first_seen_ms;       //!< Arrival time of first copy.
+    uint8_t data_format;          //!< Data format of payload.
+    re_dedup_entry_state_t state; //!< State of entry.
+} re_dedup_entry_t;
+
+/**
+ * @brief Receives released reports.
+ *
+ * @param[in] p_adv Report to process, valid only during the call.
+ * @param[in] p_context Context given to @ref re_dedup_init.
+ */
+typedef void (*re_dedup_release_fp) (const re_ca_uart_ble_adv_t * const p_adv,
+                                     void * const p_context);
+
+/** @brief Duplicate suppression state. */
+typedef struct
+{
+    re_dedup_entry_t * p_entries; //!< Capacity entries.
+    size_t capacity;              //!< Number of entries, power of two.
+    uint32_t window_ms;           //!< Time a copy is held.
+    re_dedup_release_fp release;  //!< Called with released reports.
+    void * p_context;             //!< Passed to release.
+    uint32_t num_dropped;         //!< Repeats dropped since init.
+} re_dedup_t;
+
+/**
+ * @brief Read data format and measurement counter from a raw advertisement.
+ *
+ * @param[in]  p_adv Raw advertisement, as in re_ca_uart_ble_adv_t.adv.
+ * @param[in]  adv_len Length of advertisement.
+ * @param[out] p_data_format Data format of payload.
+ * @param[out] p_counter Measurement counter.
+ * @retval RE_SUCCESS if counter was read.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if format has no counter, is not enabled or counter
+ *                                is not available.
+ */
+re_status_t re_dedup_counter_read (const uint8_t * const p_adv, const size_t adv_len,
+                                   uint8_t * const p_data_format,
+                                   uint32_t * const p_counter);
+
+/**
+ * @brief Initialize duplicate suppression on caller-provided storage.
+ *
+ * @param[out] p_dedup State to initialize.
+ * @param[in]  p_entries Array of capacity entries.
+ * @param[in]  capacity Number of entries, power of two.
+ * @param[in]  window_ms Time a copy is held, e.g. RE_DEDUP_DEFAULT_WINDOW_MS.
+ * @param[in]  release Called with every report that passes.
+ * @param[in]  p_context Passed to release, may be NULL.
+ * @retval RE_SUCCESS if state was initialized.
+ * @retval RE_ERROR_NULL if p_dedup, p_entries or release is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if capacity is not a power of two.
+ */
+re_status_t re_dedup_init (re_dedup_t * const p_dedup,
+                           re_dedup_entry_t * const p_entries,
+                           const size_t capacity,
+                           const uint32_t window_ms,
+                           re_dedup_release_fp release,
+                           void * const p_context);
+
+/**
+ * @brief Process a scanned report.
+ *
+ * A held copy of another measurement of the same tag is released first, as is
+ * the held copy of another tag whose entry is reused.
+ *
+ * @param[in,out] p_dedup Duplicate suppression state.
+ * @param[in]     p_adv Scanned report.
+ * @param[in]     now_ms Arrival time of the report.
+ * @param[out]    p_action What was done with the report, may be NULL.
+ * @retval RE_SUCCESS if report was processed.
+ * @retval RE_ERROR_NULL if p_dedup or p_adv is NULL.
+ */
+re_status_t re_dedup_push (re_dedup_t * const p_dedup,
+                           const re_ca_uart_ble_adv_t * const p_adv,
+                           const uint32_t now_ms,
+                           re_dedup_action_t * const p_action);
+
+/**
+ * @brief Release held copies whose window has closed.
+ *
+ * Call periodically, e.g. every window_ms.
+ *
+ * @param[in,out] p_dedup Duplicate suppression state.
+ * @param[in]     now_ms Current time.
+ * @return Number of released reports, 0 if p_dedup is NULL.
+ */
+size_t re_dedup_flush (re_dedup_t * const p_dedup, const uint32_t now_ms);
+
+/**
+ * @brief Release every held copy, e.g. before shutdown.
+ *
+ * @param[in,out] p_dedup Duplicate suppression state.
+ * @return Number of released reports, 0 if p_dedup is NULL.
+ */
+size_t re_dedup_flush_all (re_dedup_t * const p_dedup);
+
+#endif // RUUVI_ENDPOINTS_DEDUP_H
@@ -0,0 +1,326 @@
+#include "ruuvi_endpoints_export.h"
+#include "ruuvi_endpoints_text.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if RE_EXPORT_ENABLED
+
+/** @brief Inputs of a batch, indexed by record. */
+typedef struct
+{
+    const re_text_field_t * p_fields;                //!< Fields of format.
+    size_t num_fields;                               //!< Number of fields.
+    size_t record_size;                              //!< Size of a record.
+    const uint8_t * p_records;                       //!< Records.
+    const re_export_prefix_t * const * pp_prefixes; //!< Line protocol prefixes.
+    const uint64_t * p_macs;                         //!< CSV MACs, may be NULL.
+    const uint64_t * p_timestamps;                   //!< Timestamps, may be NULL.
+    uint8_t data_format;                             //!< Format of records.
+} re_export_batch_t;
+
+/**
+ * @brief Write one row of a batch.
+ *
+ * @return False if row was skipped.
+ */
+typedef bool (*re_export_row_fp) (re_text_out_t * const p_out,
+                                  const re_export_batch_t * const p_batch,
+                                  const size_t index);
+
+static bool re_export_is_mac (const re_text_field_t * const p_field)
+{
+    return (RE_TEXT_MAC48 == p_field->type) || (RE_TEXT_MAC24 == p_field->type);
+}
+
+static bool re_export_put_line (re_text_out_t * const p_out,
+                                const re_export_batch_t * const p_batch,
+                                const size_t index)
+{
+    const re_export_prefix_t * const p_prefix = p_batch->pp_prefixes[index];
+    const void * const p_record = &p_batch->p_records[index * p_batch->record_size];
+    size_t num_values = 0;
+    re_text_put (p_out, p_prefix->text, p_prefix->len);
+
+    for (size_t ii = 0; ii < p_batch->num_fields; ii++)
+    {
+        const re_text_field_t * const p_field = &p_batch->p_fields[ii];
+
+        if (!re_export_is_mac (p_field))
+        {
+            const size_t start = p_out->pos;
+            const bool overflow = p_out->overflow;
+
+            if (0U != num_values)
+            {
+                re_text_put_char (p_out, ',');
+            }
+
+            re_text_put (p_out, p_field->p_key, p_field->key_len);
+            re_text_put_char (p_out, '=');
+
+            if (!re_text_put_value (p_out, p_field, p_record))
+            {
+                p_out->pos = start;
+                p_out->overflow = overflow;
+            }
+            else
+            {
+                if ( (RE_TEXT_FLOAT != p_field->type) && (RE_TEXT_BOOL != p_field->type))
+                {
+                    re_text_put_char (p_out, 'i');
+                }
+
+                num_values++;
+            }
+        }
+    }
+
+    if (NULL != p_batch->p_timestamps)
+    {
+        re_text_put_char (p_out, ' ');
+        re_text_put_uint (p_out, p_batch->p_timestamps[index], 1U);
+    }
+
+    re_text_put_char (p_out, '\n');
+    return (0U != num_values);
+}
+
+static bool re_export_put_csv (re_text_out_t * const p_out,
+                               const re_export_batch_t * const p_batch,
+                               const size_t index)
+{
+    const void * const p_record = &p_batch->p_records[index * p_batch->record_size];
+
+    if (NULL != p_batch->p_timestamps)
+    {
+        re_text_put_uint (p_out, p_batch->p_timestamps[index], 1U);
+    }
+
+    re_text_put_char (p_out, ',');
+
+    if (NULL != p_batch->p_macs)
+    {
+        re_text_put_mac (p_out, p_batch->p_macs[index], RE_TEXT_MAC48_BYTES);
+    }
+
+    re_text_put_char (p_out, ',');
+    re_text_put_uint (p_out, p_batch->data_format, 1U);
+
+    for (size_t ii = 0; ii < p_batch->num_fields; ii++)
+    {
+        if (!re_export_is_mac (&p_batch->p_fields[ii]))
+        {
+            re_text_put_char (p_out, ',');
+            // Invalid value leaves cell empty.
+            (void) re_text_put_value (p_out, &p_batch->p_fields[ii], p_record);
+        }
+    }
+
+    re_text_put_char (p_out, '\n');
+    return true;
+}
+
+/**
+ * @brief Write rows of a batch until buffer is full, never cutting a row.
+ */
+static re_status_t re_export_write_rows (char * const p_buf, const size_t buf_size,
+        size_t * const p_offset, const re_export_batch_t * const p_batch,
+        const size_t num_records, size_t * const p_num_written,
+        const re_export_row_fp put_row)
+{
+    re_status_t result = RE_SUCCESS;
+    size_t num_written = 0;
+
+    if (NULL == p_batch->p_fields)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else if (*p_offset >= buf_size)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        re_text_out_t out = { p_buf, buf_size, *p_offset, false };
+
+        while ( (num_written < num_records) && (!out.overflow))
+        {
+            const size_t start = out.pos;
+            const bool written = put_row (&out, p_batch, num_written);
+
+            if (out.overflow)
+            {
+                out.pos = start;
+                result |= RE_ERROR_DATA_SIZE;
+            }
+            else
+            {
+                if (!written)
+                {
+                    out.pos = start;
+                }
+
+                num_written++;
+            }
+        }
+
+        p_buf[out.pos] = '\0';
+        *p_offset = out.pos;
+    }
+
+    *p_num_written = num_written;
+    return result;
+}
+
+re_status_t re_export_line_prefix (re_export_prefix_t * const p_prefix,
+                                   const char * const p_measurement,
+                                   const uint8_t data_format, const uint64_t mac)
+{
+    static const char mac_tag[] = ",mac=";
+    static const char format_tag[] = ",dataFormat=";
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_prefix) || (NULL == p_measurement))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( ('\0' == p_measurement[0])
+              || (NULL != strpbrk (p_measurement, " ,=\\\"\n")))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        // Prefix is NUL-terminated as a side effect, keep room for it.
+        re_text_out_t out = { p_prefix->text, sizeof (p_prefix->text), 0U, false };
+        re_text_put (&out, p_measurement, strlen (p_measurement));
+        re_text_put (&out, mac_tag, sizeof (mac_tag) - 1U);
+        re_text_put_mac (&out, mac, RE_TEXT_MAC48_BYTES);
+        re_text_put (&out, format_tag, sizeof (format_tag) - 1U);
+        re_text_put_uint (&out, data_format, 1U);
+        re_text_put_char (&out, ' ');
+
+        if (out.overflow)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+            out.pos = 0U;
+        }
+
+        p_prefix->text[out.pos] = '\0';
+        p_prefix->len = (uint8_t) out.pos;
+    }
+
+    return result;
+}
+
+re_status_t re_export_write_line (char * const p_buf, const size_t buf_size,
+                                  size_t * const p_offset, const uint8_t data_format,
+                                  const void * const p_records,
+                                  const re_export_prefix_t * const * const pp_prefixes,
+                                  const uint64_t * const p_timestamps,
+                                  const size_t num_records, size_t * const p_num_written)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_buf) || (NULL == p_offset) || (NULL == p_records)
+            || (NULL == pp_prefixes) || (NULL == p_num_written))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        re_export_batch_t batch =
+        {
+            .p_records = (const uint8_t *) p_records,
+            .pp_prefixes = pp_prefixes,
+            .p_timestamps = p_timestamps,
+            .data_format = data_format
+        };
+        batch.p_fields = re_text_fields (data_format, &batch.num_fields, &batch.record_size);
+        result |= re_export_write_rows (p_buf, buf_size, p_offset, &batch, num_records,
+                                        p_num_written, &re_export_put_line);
+    }
+
+    return result;
+}
+
+re_status_t re_export_write_csv_header (char * const p_buf, const size_t buf_size,
+                                        size_t * const p_offset, const uint8_t data_format)
+{
+    static const char columns[] = "time,mac,dataFormat";
+    re_status_t result = RE_SUCCESS;
+    size_t num_fields = 0;
+    const re_text_field_t * const p_fields = re_text_fields (data_format, &num_fields, NULL);
+
+    if ( (NULL == p_buf) || (NULL == p_offset))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (NULL == p_fields)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else if (*p_offset >= buf_size)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        re_text_out_t out = { p_buf, buf_size, *p_offset, false };
+        re_text_put (&out, columns, sizeof (columns) - 1U);
+
+        for (size_t ii = 0; ii < num_fields; ii++)
+        {
+            if (!re_export_is_mac (&p_fields[ii]))
+            {
+                re_text_put_char (&out, ',');
+                re_text_put (&out, p_fields[ii].p_key, p_fields[ii].key_len);
+            }
+        }
+
+        re_text_put_char (&out, '\n');
+
+        if (out.overflow)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+            out.pos = *p_offset;
+        }
+
+        p_buf[out.pos] = '\0';
+        *p_offset = out.pos;
+    }
+
+    return result;
+}
+
+re_status_t re_export_write_csv (char * const p_buf, const size_t buf_size,
+                                 size_t * const p_offset, const uint8_t data_format,
+                                 const void * const p_records, const uint64_t * const p_macs,
+                                 const uint64_t * const p_timestamps,
+                                 const size_t num_records, size_t * const p_num_written)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_buf) || (NULL == p_offset) || (NULL == p_records)
+            || (NULL == p_num_written))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        re_export_batch_t batch =
+        {
+            .p_records = (const uint8_t *) p_records,
+            .p_macs = p_macs,
+            .p_timestamps = p_timestamps,
+            .data_format = data_format
+        };
+        batch.p_fields = re_text_fields (data_format, &batch.num_fields, &batch.record_size);
+        result |= re_export_write_rows (p_buf, buf_size, p_offset, &batch, num_records,
+                                        p_num_written, &re_export_put_csv);
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/**
+ * Ruuvi Endpoints InfluxDB line protocol and CSV export of decoded data.
+ *
+ * Writes batches of decoded records, e.g. an array of re_5_data_t, with
+ * their timestamps into a caller buffer without allocating or calling
+ * printf. Fields are described by the tables of ruuvi_endpoints_text.h and
+ * printed in fixed point at the resolution of the format.
+ *
+ * Line protocol puts the measurement name and tags of a tag first on every
+ * line. Build the prefix once per MAC with @ref re_export_line_prefix and keep
+ * it with the per-tag state, e.g. in an array indexed by @ref re_tag_table_t
+ * slot, so only field values are printed per record:
+ * ruuvi,mac=CB:B8:33:4C:88:4F,dataFormat=5 temperature=24.3,humidity=53.49,
+ * pressure=100044,...,txPower=4i,movementCounter=66i 1700000000000000000
+ *
+ * CSV has a header row from @ref re_export_write_csv_header and one row per
+ * record with time, MAC and data format first. Invalid values are left empty.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_EXPORT_H
+#define RUUVI_ENDPOINTS_EXPORT_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_EXPORT_PREFIX_MAX_LEN (64U) //!< Room for measurement name and tags.
+
+/** @brief Precomputed line protocol prefix of a tag. */
+typedef struct
+{
+    char text[RE_EXPORT_PREFIX_MAX_LEN]; //!< Measurement, tags and separating space.
+    uint8_t len;                         //!< Length of text.
+} re_export_prefix_t;
+
+/**
+ * @brief Build line protocol prefix of a tag.
+ *
+ * @param[out] p_prefix Prefix "<measurement>,mac=<MAC>,dataFormat=<format> ".
+ * @param[in]  p_measurement NUL-terminated measurement name, e.g. "ruuvi".
+ * @param[in]  data_format Data format of records of the tag.
+ * @param[in]  mac 48-bit MAC address of the tag.
+ * @retval RE_SUCCESS if prefix was built.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if measurement is empty or has characters
+ *                                that line protocol would need escaped.
+ * @retval RE_ERROR_DATA_SIZE if measurement is too long.
+ */
+re_status_t re_export_line_prefix (re_export_prefix_t * const p_prefix,
+                                   const char * const p_measurement,
+                                   const uint8_t data_format, const uint64_t mac);
+
+/**
+ * @brief Write records of one format in InfluxDB line protocol.
+ *
+ * Integers are written with the "i" suffix and invalid fields are left out.
+ * MAC fields are left out, the MAC is a tag of the prefix. A record without
+ * any valid field is skipped, as line protocol needs at least one field.
+ * Records are written until the buffer is full, a line is never cut.
+ *
+ * @param[out]    p_buf Output buffer, NUL-terminated after the last line.
+ * @param[in]     buf_size Size of output buffer.
+ * @param[in,out] p_offset Position to write at, advanced past the last line.
+ * @param[in]     data_format Format of records, e.g. RE_5_DESTINATION.
+ * @param[in]     p_records Array of decoded data of data_format, e.g. re_5_data_t.
+ * @param[in]     pp_prefixes Prefix of each record, records of a tag share one.
+ * @param[in]     p_timestamps Timestamp of each record in precision of the
+ *                             database, e.g. ns. NULL to let the server set time.
+ * @param[in]     num_records Number of records.
+ * @param[out]    p_num_written Number of records consumed, including skipped ones.
+ * @retval RE_SUCCESS if all records were written.
+ * @retval RE_ERROR_NULL if any of the required pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if format is not supported.
+ * @retval RE_ERROR_DATA_SIZE if not all records fit.
+ */
+re_status_t re_export_write_line (char * const p_buf, const size_t buf_size,
+                                  size_t * const p_offset, const uint8_t data_format,
+                                  const void * const p_records,
+                                  const re_export_prefix_t * const * const pp_prefixes,
+                                  const uint64_t * const p_timestamps,
+                                  const size_t num_records, size_t * const p_num_written);
+
+/**
+ * @brief Write CSV header row of a format.
+ *
+ * Columns are time, mac, dataFormat and fields of the format.
+ *
+ * @param[out]    p_buf Output buffer, NUL-terminated after the row.
+ * @param[in]     buf_size Size of output buffer.
+ * @param[in,out] p_offset Position to write at, advanced past the row.
+ * @param[in]     data_format Format of records, e.g. RE_5_DESTINATION.
+ * @retval RE_SUCCESS if row was written.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if format is not supported.
+ * @retval RE_ERROR_DATA_SIZE if row does not fit, nothing is written.
+ */
+re_status_t re_export_write_csv_header (char * const p_buf, const size_t buf_size,
+                                        size_t * const p_offset, const uint8_t data_format);
+
+/**
+ * @brief Write records of one format as CSV rows.
+ *
+ * Invalid values and missing timestamps or MACs are written as empty cells.
+ * Records are written until the buffer is full, a row is never cut.
+ *
+ * @param[out]    p_buf Output buffer, NUL-terminated after the last row.
+ * @param[in]     buf_size Size of output buffer.
+ * @param[in,out] p_offset Position to write at, advanced past the last row.
+ * @param[in]     data_format Format of records, e.g. RE_5_DESTINATION.
+ * @param[in]     p_records Array of decoded data of data_format, e.g. re_5_data_t.
+ * @param[in]     p_macs MAC of each record, may be NULL.
+ * @param[in]     p_timestamps Timestamp of each record, may be NULL.
+ * @param[in]     num_records Number of records.
+ * @param[out]    p_num_written Number of records written.
+ * @retval RE_SUCCESS if all records were written.
+ * @retval RE_ERROR_NULL if any of the required pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if format is not supported.
+ * @retval RE_ERROR_DATA_SIZE if not all records fit.
+ */
+re_status_t re_export_write_csv (char * const p_buf, const size_t buf_size,
+                                 size_t * const p_offset, const uint8_t data_format,
+                                 const void * const p_records, const uint64_t * const p_macs,
+                                 const uint64_t * const p_timestamps,
+                                 const size_t num_records, size_t * const p_num_written);
+
+#endif // RUUVI_ENDPOINTS_EXPORT_H
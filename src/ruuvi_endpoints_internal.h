@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <math.h>
+#include <string.h>
 #include "ruuvi_endpoints.h"
 
 /**
@@ -49,6 +50,20 @@ typedef struct re_u9_coeffs_t
     const re_float ratio;              //!< Scale factor, used for scaling the value.
 } re_u9_coeffs_t;
 
+/**
+ * @brief Coefficients of data format E1, shared by AirQ log records.
+ */
+extern const re_i16_coeffs_t re_e1_coeffs_temperature;
+extern const re_u16_coeffs_t re_e1_coeffs_humidity;
+extern const re_u16_coeffs_t re_e1_coeffs_pressure;
+extern const re_u16_coeffs_t re_e1_coeffs_pm;
+extern const re_u16_coeffs_t re_e1_coeffs_co2;
+extern const re_u9_coeffs_t re_e1_coeffs_voc;
+extern const re_u9_coeffs_t re_e1_coeffs_nox;
+extern const re_u9_coeffs_t re_e1_coeffs_sound_inst_dba;
+extern const re_u9_coeffs_t re_e1_coeffs_sound_avg_dba;
+extern const re_u9_coeffs_t re_e1_coeffs_sound_peak_spl_db;
+
 static inline uint8_t
 re_be16_get_high_byte (const uint16_t value)
 {
@@ -126,7 +141,7 @@ re_decode_u16 (const uint8_t * const p_slot, const re_u16_coeffs_t * const p_coe
     return (re_float) coded_val / p_coeffs->ratio + p_coeffs->min_val;
 }
 
-static void
+static inline void
 re_encode_u9 (uint8_t * const p_slot, uint8_t * const p_flags,
               const re_u9_coeffs_t * const p_coeffs, const re_float val)
 {
@@ -147,7 +162,7 @@ re_encode_u9 (uint8_t * const p_slot, uint8_t * const p_flags,
     }
 }
 
-static re_float
+static inline re_float
 re_decode_u9 (const uint8_t * const p_slot, const uint8_t * const p_flags,
               const re_u9_coeffs_t * const p_coeffs)
 {
@@ -167,4 +182,298 @@ re_decode_u9 (const uint8_t * const p_slot, const uint8_t * const p_flags,
     return (re_float) coded_val / p_coeffs->ratio + p_coeffs->min_val;
 }
 
+static inline uint8_t
+re_be24_get_high_byte (const uint32_t value)
+{
+    return (uint8_t) ( (value >> RE_BYTE_2_SHIFT) & RE_BYTE_MASK);
+}
+
+static inline uint8_t
+re_be24_get_mid_byte (const uint32_t value)
+{
+    return (uint8_t) ( (value >> RE_BYTE_1_SHIFT) & RE_BYTE_MASK);
+}
+
+static inline uint8_t
+re_be24_get_low_byte (const uint32_t value)
+{
+    return (uint8_t) (value & RE_BYTE_MASK);
+}
+
+static inline void
+re_encode_u24 (
+    uint8_t * const p_slot,
+    const re_float val,
+    const uint32_t invalid_val,
+    const re_float min_val,
+    const re_float max_val,
+    const re_float scale_factor)
+{
+    uint32_t coded_val = invalid_val;
+
+    if (!isnan (val))
+    {
+        const re_float val_clipped = RE_CLIP (val, min_val, max_val);
+        coded_val                  = (uint32_t) lrintf ( (val_clipped - min_val) * scale_factor);
+    }
+
+    p_slot[0] |= re_be24_get_high_byte (coded_val);
+    p_slot[1] |= re_be24_get_mid_byte (coded_val);
+    p_slot[2] |= re_be24_get_low_byte (coded_val);
+}
+
+static inline re_float
+re_decode_u24 (
+    const uint8_t * const p_slot,
+    const uint32_t       invalid_val,
+    const re_float       min_val,
+    const re_float       scale_factor)
+{
+    uint32_t coded_val = 0;
+    coded_val |= ( (uint32_t) p_slot[0]) << RE_BYTE_2_SHIFT;
+    coded_val |= ( (uint32_t) p_slot[1]) << RE_BYTE_1_SHIFT;
+    coded_val |= ( (uint32_t) p_slot[2]) << RE_BYTE_0_SHIFT;
+
+    if (invalid_val == coded_val)
+    {
+        return NAN;
+    }
+
+    return (re_float) coded_val / scale_factor + min_val;
+}
+
+#define RE_MAC_HASH_MUL   (0x9E3779B97F4A7C15U) //!< 2^64 / golden ratio.
+#define RE_MAC_HASH_SHIFT (32U)
+
+/**
+ * @brief Home slot of a MAC address in a power-of-two sized hash table.
+ *
+ * Fibonacci hashing spreads sequential MAC addresses of a production batch.
+ */
+static inline size_t
+re_mac_home_slot (const uint64_t mac, const size_t capacity)
+{
+    const uint64_t hash = (mac * RE_MAC_HASH_MUL) >> RE_MAC_HASH_SHIFT;
+    return ( (size_t) hash) & (capacity - 1U);
+}
+
+#define RE_MAC_BYTES (6U) //!< Bytes of a BLE MAC address.
+
+/**
+ * @brief Read a 6-byte MAC address stored MSB first, as in scan reports.
+ */
+static inline uint64_t
+re_mac_read (const uint8_t * const p_mac)
+{
+    uint64_t mac = 0;
+
+    for (size_t ii = 0; ii < RE_MAC_BYTES; ii++)
+    {
+        mac = (mac << RE_BYTE_1_SHIFT) | p_mac[ii];
+    }
+
+    return mac;
+}
+
+/**
+ * @brief Decoder of a single frame, as called by @ref re_decode_batch.
+ */
+typedef re_status_t (*re_decode_frame_fn_t) (const uint8_t * const p_buffer,
+        void * const p_data);
+
+/**
+ * @brief Run a single-frame decoder over an array of frames.
+ *
+ * Shared loop of the re_X_decode_batch functions.
+ *
+ * @param[in] pp_buffers Array of num_buffers pointers to frames.
+ * @param[in] num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers decoded structs of data_size bytes each.
+ * @param[in] data_size Size of one decoded struct.
+ * @param[in] decode_frame Decoder of a single frame.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers or p_data is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+static inline re_status_t
+re_decode_batch (const uint8_t * const * const pp_buffers, const size_t num_buffers,
+                 void * const p_data, const size_t data_size,
+                 const re_decode_frame_fn_t decode_frame, re_status_t * const p_status)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == pp_buffers) || (NULL == p_data))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    for (size_t idx = 0; idx < num_buffers; idx++)
+    {
+        const re_status_t status = decode_frame (pp_buffers[idx],
+                                   (uint8_t *) p_data + (idx * data_size));
+
+        if (NULL != p_status)
+        {
+            p_status[idx] = status;
+        }
+
+        result |= status;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Decoder of a decrypted frame, as called by @ref re_cipher_decode_batch.
+ *
+ * @param[in]  p_payload Payload as received.
+ * @param[in]  p_cleartext Decrypted ciphertext of the payload.
+ * @param[out] p_data Decoded data.
+ */
+typedef re_status_t (*re_decode_cleartext_fn_t) (const uint8_t * const p_payload,
+        const uint8_t * const p_cleartext, void * const p_data);
+
+/**
+ * @brief Layout of an encrypted data format for @ref re_cipher_decode_batch.
+ */
+typedef struct re_cipher_format_t
+{
+    uint8_t destination;    //!< Expected header byte of the payload.
+    size_t offset_payload;  //!< Start of payload in BLE frame.
+    size_t offset_header;   //!< Index of header in payload.
+    size_t offset_cipher;   //!< Index of first encrypted byte in payload.
+    size_t cipher_length;   //!< Length of ciphertext, at most RE_CIPHER_BLOCK_SIZE.
+    size_t data_size;       //!< Size of one decoded struct.
+    re_decode_cleartext_fn_t decode_cleartext; //!< Decoder of a decrypted frame.
+} re_cipher_format_t;
+
+/**
+ * @brief Decode up to RE_CIPHER_BATCH_BLOCKS frames with a single cipher call.
+ *
+ * Ciphertexts of frames with a valid header and key are gathered into one
+ * cipher call, results are scattered back to the frames.
+ */
+static inline void
+re_cipher_decode_chunk (const re_cipher_format_t * const p_format,
+                        const uint8_t * const * const pp_buffers,
+                        const uint8_t * const * const pp_keys,
+                        const size_t key_size,
+                        const size_t num_buffers,
+                        uint8_t * const p_data,
+                        re_status_t * const p_status,
+                        re_cipher_batch_fp cipher)
+{
+    re_cipher_block_t blocks[RE_CIPHER_BATCH_BLOCKS];
+    uint8_t cleartext[RE_CIPHER_BATCH_BLOCKS][RE_CIPHER_BLOCK_SIZE];
+    size_t block_frame[RE_CIPHER_BATCH_BLOCKS];
+    size_t num_blocks = 0;
+    uint32_t batch_status = 0;
+
+    for (size_t idx = 0; idx < num_buffers; idx++)
+    {
+        memset (&p_data[idx * p_format->data_size], 0, p_format->data_size);
+
+        if ( (NULL == pp_buffers[idx]) || (NULL == pp_keys[idx]))
+        {
+            p_status[idx] = RE_ERROR_NULL;
+        }
+        else if (p_format->destination !=
+                 pp_buffers[idx][p_format->offset_payload + p_format->offset_header])
+        {
+            p_status[idx] = RE_ERROR_INVALID_PARAM;
+        }
+        else
+        {
+            blocks[num_blocks].p_input =
+                &pp_buffers[idx][p_format->offset_payload + p_format->offset_cipher];
+            blocks[num_blocks].p_output = cleartext[num_blocks];
+            blocks[num_blocks].p_key = pp_keys[idx];
+            blocks[num_blocks].key_size = key_size;
+            blocks[num_blocks].status = 0;
+            block_frame[num_blocks] = idx;
+            num_blocks++;
+        }
+    }
+
+    if (0 < num_blocks)
+    {
+        batch_status = cipher (blocks, num_blocks, p_format->cipher_length);
+    }
+
+    for (size_t block = 0; block < num_blocks; block++)
+    {
+        const size_t idx = block_frame[block];
+
+        if ( (0 != batch_status) || (0 != blocks[block].status))
+        {
+            p_status[idx] = RE_ERROR_DECODING;
+        }
+        else
+        {
+            p_status[idx] = p_format->decode_cleartext (
+                                &pp_buffers[idx][p_format->offset_payload], cleartext[block],
+                                &p_data[idx * p_format->data_size]);
+        }
+    }
+}
+
+/**
+ * @brief Decrypt and decode an array of frames of an encrypted data format.
+ *
+ * Shared loop of the re_X_decode_batch functions of encrypted formats.
+ *
+ * @param[in]  p_format Layout of the data format.
+ * @param[in]  pp_buffers Array of num_buffers pointers to frames.
+ * @param[in]  pp_keys Array of num_buffers pointers to decryption keys, NULL if unknown.
+ * @param[in]  key_size Length of each key in bytes.
+ * @param[in]  num_buffers Number of frames to decode.
+ * @param[out] p_data Array of num_buffers decoded structs of p_format->data_size bytes.
+ * @param[out] p_status Array of num_buffers status codes, one per frame. May be NULL.
+ * @param[in]  cipher Batched decryption function.
+ * @retval RE_SUCCESS if all frames were decoded successfully.
+ * @retval RE_ERROR_NULL if pp_buffers, pp_keys, p_data or cipher is NULL.
+ * @return Otherwise bitwise OR of the errors of individual frames.
+ */
+static inline re_status_t
+re_cipher_decode_batch (const re_cipher_format_t * const p_format,
+                        const uint8_t * const * const pp_buffers,
+                        const uint8_t * const * const pp_keys,
+                        const size_t key_size,
+                        const size_t num_buffers,
+                        void * const p_data,
+                        re_status_t * const p_status,
+                        re_cipher_batch_fp cipher)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == pp_buffers) || (NULL == pp_keys) || (NULL == p_data) || (NULL == cipher))
+    {
+        return RE_ERROR_NULL;
+    }
+
+    for (size_t start = 0; start < num_buffers; start += RE_CIPHER_BATCH_BLOCKS)
+    {
+        re_status_t chunk_status[RE_CIPHER_BATCH_BLOCKS];
+        const size_t remaining = num_buffers - start;
+        const size_t chunk = (remaining < RE_CIPHER_BATCH_BLOCKS) ?
+                             remaining : RE_CIPHER_BATCH_BLOCKS;
+        re_cipher_decode_chunk (p_format, &pp_buffers[start], &pp_keys[start], key_size, chunk,
+                                (uint8_t *) p_data + (start * p_format->data_size),
+                                chunk_status, cipher);
+
+        for (size_t idx = 0; idx < chunk; idx++)
+        {
+            if (NULL != p_status)
+            {
+                p_status[start + idx] = chunk_status[idx];
+            }
+
+            result |= chunk_status[idx];
+        }
+    }
+
+    return result;
+}
+
 #endif /* RUUVI_ENDPOINTS_INTERNAL_H */
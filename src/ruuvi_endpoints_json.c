@@ -0,0 +1,248 @@
+#include "ruuvi_endpoints_json.h"
+#include "ruuvi_endpoints_text.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if RE_JSON_ENABLED
+
+static void re_json_put_key (re_text_out_t * const p_out, const char * const p_key,
+                             const size_t key_len)
+{
+    re_text_put_char (p_out, ',');
+    re_text_put_char (p_out, '"');
+    re_text_put (p_out, p_key, key_len);
+    re_text_put_char (p_out, '"');
+    re_text_put_char (p_out, ':');
+}
+
+static void re_json_put_field (re_text_out_t * const p_out,
+                               const re_text_field_t * const p_field,
+                               const void * const p_data)
+{
+    const size_t start = p_out->pos;
+    const bool overflow = p_out->overflow;
+    const bool quoted = (RE_TEXT_MAC48 == p_field->type)
+                        || (RE_TEXT_MAC24 == p_field->type);
+    re_json_put_key (p_out, p_field->p_key, p_field->key_len);
+
+    if (quoted)
+    {
+        re_text_put_char (p_out, '"');
+    }
+
+    if (!re_text_put_value (p_out, p_field, p_data))
+    {
+        // Invalid fields are left out, key included.
+        p_out->pos = start;
+        p_out->overflow = overflow;
+    }
+    else if (quoted)
+    {
+        re_text_put_char (p_out, '"');
+    }
+    else
+    {
+        // Value is complete.
+    }
+}
+
+static void re_json_put_bool (re_text_out_t * const p_out, const char * const p_key,
+                              const size_t key_len, const bool value)
+{
+    re_json_put_key (p_out, p_key, key_len);
+    re_text_put (p_out, value ? "true" : "false", value ? 4U : 5U);
+}
+
+/**
+ * @brief Write one record into out, closing the object.
+ *
+ * @retval RE_ERROR_INVALID_PARAM if format is not supported.
+ */
+static re_status_t re_json_put_record (re_text_out_t * const p_out, const uint8_t data_format,
+                                       const void * const p_data)
+{
+    static const char format_key[] = "{\"dataFormat\":";
+    re_status_t result = RE_SUCCESS;
+    size_t num_fields = 0;
+    const re_text_field_t * const p_fields = re_text_fields (data_format, &num_fields, NULL);
+
+    if (NULL == p_fields)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        re_text_put (p_out, format_key, sizeof (format_key) - 1U);
+        re_text_put_uint (p_out, data_format, 1U);
+
+        for (size_t ii = 0; ii < num_fields; ii++)
+        {
+            re_json_put_field (p_out, &p_fields[ii], p_data);
+        }
+
+        if (RE_6_DESTINATION == data_format)
+        {
+            const re_6_data_t * const p_6 = (const re_6_data_t *) p_data;
+            const uint64_t mac = ( (uint64_t) p_6->mac_addr_24.byte3 << RE_BYTE_2_SHIFT)
+                                 | ( (uint64_t) p_6->mac_addr_24.byte4 << RE_BYTE_1_SHIFT)
+                                 | p_6->mac_addr_24.byte5;
+            re_json_put_bool (p_out, "calibrationInProgress", 21U,
+                              p_6->flags.flag_calibration_in_progress);
+            re_json_put_bool (p_out, "buttonPressed", 13U, p_6->flags.flag_button_pressed);
+            re_json_put_bool (p_out, "rtcRunningOnBoot", 16U,
+                              p_6->flags.flag_rtc_running_on_boot);
+
+            if (RE_6_INVALID_MAC != mac)
+            {
+                re_json_put_key (p_out, "mac", 3U);
+                re_text_put_char (p_out, '"');
+                re_text_put_mac (p_out, mac, RE_TEXT_MAC24_BYTES);
+                re_text_put_char (p_out, '"');
+            }
+        }
+        else if (RE_E1_DESTINATION == data_format)
+        {
+            const re_e1_data_t * const p_e1 = (const re_e1_data_t *) p_data;
+            re_json_put_bool (p_out, "calibrationInProgress", 21U,
+                              p_e1->flags.flag_calibration_in_progress);
+            re_json_put_bool (p_out, "buttonPressed", 13U, p_e1->flags.flag_button_pressed);
+            re_json_put_bool (p_out, "rtcRunningOnBoot", 16U,
+                              p_e1->flags.flag_rtc_running_on_boot);
+        }
+        else
+        {
+            // All fields are in the table.
+        }
+
+        re_text_put_char (p_out, '}');
+    }
+
+    return result;
+}
+
+/**
+ * @brief Write a single record at offset, rolling back if it does not fit.
+ */
+static re_status_t re_json_write (char * const p_buf, const size_t buf_size,
+                                  size_t * const p_offset, const uint8_t data_format,
+                                  const void * const p_data)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_buf) || (NULL == p_offset) || (NULL == p_data))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (*p_offset >= buf_size)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        re_text_out_t out = { p_buf, buf_size, *p_offset, false };
+        result |= re_json_put_record (&out, data_format, p_data);
+
+        if (out.overflow)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+            out.pos = *p_offset;
+        }
+
+        p_buf[out.pos] = '\0';
+        *p_offset = out.pos;
+    }
+
+    return result;
+}
+
+re_status_t re_json_write_5 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_5_data_t * const p_data)
+{
+    return re_json_write (p_buf, buf_size, p_offset, RE_5_DESTINATION, p_data);
+}
+
+re_status_t re_json_write_6 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_6_data_t * const p_data)
+{
+    return re_json_write (p_buf, buf_size, p_offset, RE_6_DESTINATION, p_data);
+}
+
+re_status_t re_json_write_7 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_7_data_t * const p_data)
+{
+    return re_json_write (p_buf, buf_size, p_offset, RE_7_DESTINATION, p_data);
+}
+
+re_status_t re_json_write_e1 (char * const p_buf, const size_t buf_size,
+                              size_t * const p_offset, const re_e1_data_t * const p_data)
+{
+    return re_json_write (p_buf, buf_size, p_offset, RE_E1_DESTINATION, p_data);
+}
+
+re_status_t re_json_write_array (char * const p_buf, const size_t buf_size,
+                                 size_t * const p_offset, const uint8_t data_format,
+                                 const void * const p_records, const size_t num_records,
+                                 size_t * const p_num_written)
+{
+    re_status_t result = RE_SUCCESS;
+    size_t stride = 0;
+    size_t num_written = 0;
+    (void) re_text_fields (data_format, NULL, &stride);
+
+    if ( (NULL == p_buf) || (NULL == p_offset) || (NULL == p_records)
+            || (NULL == p_num_written))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (0U == stride)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else if ( (*p_offset >= buf_size) || ( (buf_size - *p_offset) < 3U))
+    {
+        // Room for "[]" and NUL.
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        // Records are written one byte short of buffer to keep room for ']'.
+        re_text_out_t out = { p_buf, buf_size - 1U, *p_offset, false };
+        const uint8_t * const p_bytes = (const uint8_t *) p_records;
+        re_text_put_char (&out, '[');
+
+        while ( (num_written < num_records) && (!out.overflow))
+        {
+            const size_t start = out.pos;
+
+            if (0U != num_written)
+            {
+                re_text_put_char (&out, ',');
+            }
+
+            (void) re_json_put_record (&out, data_format, &p_bytes[num_written * stride]);
+
+            if (out.overflow)
+            {
+                out.pos = start;
+                result |= RE_ERROR_DATA_SIZE;
+            }
+            else
+            {
+                num_written++;
+            }
+        }
+
+        p_buf[out.pos] = ']';
+        p_buf[out.pos + 1U] = '\0';
+        *p_offset = out.pos + 1U;
+    }
+
+    if (NULL != p_num_written)
+    {
+        *p_num_written = num_written;
+    }
+
+    return result;
+}
+
+#endif
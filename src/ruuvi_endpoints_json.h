@@ -0,0 +1,85 @@
+/**
+ * Ruuvi Endpoints JSON export of decoded data.
+ *
+ * Writes decoded records as compact JSON objects into a caller buffer without
+ * allocating or calling printf. Fields are described by the tables of
+ * ruuvi_endpoints_text.h, values are printed in fixed point at the resolution
+ * of the format, e.g. 0.005 C temperature of DF5 with 3 decimals, and
+ * trailing zeros are dropped. Fields that are NaN or carry the invalid marker
+ * of the format are left out.
+ *
+ * Writers append at an offset and keep the buffer NUL-terminated, so many
+ * records can be written one after another, or as an array with
+ * @ref re_json_write_array.
+ *
+ * Example output of DF5:
+ * {"dataFormat":5,"temperature":24.3,"humidity":53.49,"pressure":100044,
+ *  "accelX":0.004,"accelY":-0.004,"accelZ":1.036,"voltage":2.977,"txPower":4,
+ *  "movementCounter":66,"measurementSequenceNumber":205,"mac":"CB:B8:33:4C:88:4F"}
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_JSON_H
+#define RUUVI_ENDPOINTS_JSON_H
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Write a DF5 record as a JSON object.
+ *
+ * @param[out]    p_buf Output buffer.
+ * @param[in]     buf_size Size of output buffer.
+ * @param[in,out] p_offset Position to write at, advanced past the object.
+ * @param[in]     p_data Decoded data.
+ * @retval RE_SUCCESS if object was written, buffer is NUL-terminated after it.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if object does not fit, offset is not changed and
+ *                            buffer is NUL-terminated at offset.
+ */
+re_status_t re_json_write_5 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_5_data_t * const p_data);
+
+/** @brief Write a DF6 record as a JSON object, see @ref re_json_write_5. */
+re_status_t re_json_write_6 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_6_data_t * const p_data);
+
+/** @brief Write a DF7 record as a JSON object, see @ref re_json_write_5. */
+re_status_t re_json_write_7 (char * const p_buf, const size_t buf_size,
+                             size_t * const p_offset, const re_7_data_t * const p_data);
+
+/** @brief Write a DFxE1 record as a JSON object, see @ref re_json_write_5. */
+re_status_t re_json_write_e1 (char * const p_buf, const size_t buf_size,
+                              size_t * const p_offset, const re_e1_data_t * const p_data);
+
+/**
+ * @brief Write records of one format as a JSON array.
+ *
+ * Writes as many records as fit and always closes the array if its brackets
+ * fit, so a full buffer still holds valid JSON.
+ *
+ * @param[out]    p_buf Output buffer.
+ * @param[in]     buf_size Size of output buffer.
+ * @param[in,out] p_offset Position to write at, advanced past the array.
+ * @param[in]     data_format Format of records, e.g. RE_5_DESTINATION.
+ * @param[in]     p_records Array of decoded data of data_format, e.g. re_5_data_t.
+ * @param[in]     num_records Number of records.
+ * @param[out]    p_num_written Number of records written.
+ * @retval RE_SUCCESS if all records were written.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if format is not supported.
+ * @retval RE_ERROR_DATA_SIZE if not all records fit. If the brackets do not
+ *                            fit either, nothing is written.
+ */
+re_status_t re_json_write_array (char * const p_buf, const size_t buf_size,
+                                 size_t * const p_offset, const uint8_t data_format,
+                                 const void * const p_records, const size_t num_records,
+                                 size_t * const p_num_written);
+
+#endif // RUUVI_ENDPOINTS_JSON_H
@@ -0,0 +1,235 @@
+#include "ruuvi_endpoints_keystore.h"
+#include "ruuvi_endpoints_internal.h"
+#include <stdbool.h>
+#include <string.h>
+
+#if RE_KEYSTORE_ENABLED
+
+#define RE_KEYSTORE_MIN_CAPACITY (4U)
+
+static size_t re_keystore_slot (const re_keystore_t * const p_store, const uint64_t mac)
+{
+    return re_mac_home_slot (mac, p_store->capacity);
+}
+
+static size_t re_keystore_max_count (const re_keystore_t * const p_store)
+{
+    return p_store->capacity - (p_store->capacity >> 2U);
+}
+
+/**
+ * @brief Find slot of given MAC or the empty slot that ends its probe sequence.
+ */
+static size_t re_keystore_probe (const re_keystore_t * const p_store, const uint64_t mac)
+{
+    size_t slot = re_keystore_slot (p_store, mac);
+
+    // Load factor is capped below 1, there always is an empty slot.
+    while ( (RE_KEYSTORE_EMPTY != p_store->p_macs[slot])
+            && (mac != p_store->p_macs[slot]))
+    {
+        slot = (slot + 1U) & (p_store->capacity - 1U);
+    }
+
+    return slot;
+}
+
+re_status_t re_keystore_init (re_keystore_t * const p_store,
+                              uint64_t * const p_macs,
+                              re_keystore_entry_t * const p_entries,
+                              const size_t capacity,
+                              re_key_expand_fp expand)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_store) || (NULL == p_macs) || (NULL == p_entries) || (NULL == expand))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (capacity < RE_KEYSTORE_MIN_CAPACITY)
+              || (0U != (capacity & (capacity - 1U))))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        p_store->p_macs = p_macs;
+        p_store->p_entries = p_entries;
+        p_store->capacity = capacity;
+        p_store->count = 0;
+        p_store->expand = expand;
+        memset (p_macs, 0xFF, capacity * sizeof (uint64_t));
+    }
+
+    return result;
+}
+
+re_status_t re_keystore_put (re_keystore_t * const p_store,
+                             const uint64_t mac,
+                             const uint8_t * const p_key,
+                             const size_t key_size)
+{
+    re_status_t result = RE_SUCCESS;
+    uint8_t schedule[RE_KEYSTORE_SCHEDULE_SIZE];
+
+    if ( (NULL == p_store) || (NULL == p_key))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (RE_KEYSTORE_KEY_SIZE != key_size) || (0U != (mac & ~RE_KEYSTORE_MAC_MASK)))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const size_t slot = re_keystore_probe (p_store, mac);
+        const bool is_new = (RE_KEYSTORE_EMPTY == p_store->p_macs[slot]);
+
+        if (is_new && (p_store->count >= re_keystore_max_count (p_store)))
+        {
+            result |= RE_ERROR_DATA_SIZE;
+        }
+        else if (0U != p_store->expand (p_key, key_size, schedule, sizeof (schedule)))
+        {
+            result |= RE_ERROR_INVALID_PARAM;
+        }
+        else
+        {
+            re_keystore_entry_t * const p_entry = &p_store->p_entries[slot];
+
+            if (is_new || (0 != memcmp (p_entry->key, p_key, RE_KEYSTORE_KEY_SIZE)))
+            {
+                memset (&p_entry->replay, 0, sizeof (p_entry->replay));
+            }
+
+            memcpy (p_entry->schedule, schedule, sizeof (schedule));
+            memcpy (p_entry->key, p_key, RE_KEYSTORE_KEY_SIZE);
+            p_store->p_macs[slot] = mac;
+
+            if (is_new)
+            {
+                p_store->count++;
+            }
+        }
+
+        memset (schedule, 0, sizeof (schedule));
+    }
+
+    return result;
+}
+
+re_keystore_entry_t * re_keystore_find (const re_keystore_t * const p_store,
+                                        const uint64_t mac)
+{
+    re_keystore_entry_t * p_entry = NULL;
+
+    if ( (NULL != p_store) && (0U == (mac & ~RE_KEYSTORE_MAC_MASK)))
+    {
+        const size_t slot = re_keystore_probe (p_store, mac);
+
+        if (mac == p_store->p_macs[slot])
+        {
+            p_entry = &p_store->p_entries[slot];
+        }
+    }
+
+    return p_entry;
+}
+
+re_status_t re_keystore_remove (re_keystore_t * const p_store, const uint64_t mac)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_store)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (0U != (mac & ~RE_KEYSTORE_MAC_MASK))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const size_t mask = p_store->capacity - 1U;
+        size_t hole = re_keystore_probe (p_store, mac);
+
+        if (mac != p_store->p_macs[hole])
+        {
+            result |= RE_ERROR_INVALID_PARAM;
+        }
+        else
+        {
+            size_t next = (hole + 1U) & mask;
+            memset (&p_store->p_entries[hole], 0, sizeof (re_keystore_entry_t));
+
+            // Backward shift: move later entries of the cluster into the hole
+            // if their home slot does not lie cyclically between hole and entry.
+            while (RE_KEYSTORE_EMPTY != p_store->p_macs[next])
+            {
+                const size_t home = re_keystore_slot (p_store, p_store->p_macs[next]);
+
+                if ( ( (next - home) & mask) >= ( (next - hole) & mask))
+                {
+                    p_store->p_macs[hole] = p_store->p_macs[next];
+                    memcpy (&p_store->p_entries[hole], &p_store->p_entries[next],
+                            sizeof (re_keystore_entry_t));
+                    memset (&p_store->p_entries[next], 0, sizeof (re_keystore_entry_t));
+                    hole = next;
+                }
+
+                next = (next + 1U) & mask;
+            }
+
+            p_store->p_macs[hole] = RE_KEYSTORE_EMPTY;
+            p_store->count--;
+        }
+    }
+
+    return result;
+}
+
+uint64_t re_keystore_mac_read (const uint8_t * const p_address)
+{
+    return re_mac_read (p_address);
+}
+
+re_status_t re_keystore_find_batch (const re_keystore_t * const p_store,
+                                    const uint8_t * const * const pp_buffers,
+                                    const size_t address_offset,
+                                    const size_t num_buffers,
+                                    const uint8_t ** const pp_schedules)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_store) || (NULL == pp_buffers) || (NULL == pp_schedules))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        for (size_t ii = 0; ii < num_buffers; ii++)
+        {
+            const re_keystore_entry_t * p_entry = NULL;
+
+            if (NULL != pp_buffers[ii])
+            {
+                p_entry = re_keystore_find (p_store,
+                                            re_keystore_mac_read (&pp_buffers[ii][address_offset]));
+            }
+
+            if (NULL == p_entry)
+            {
+                pp_schedules[ii] = NULL;
+                result |= RE_ERROR_INVALID_PARAM;
+            }
+            else
+            {
+                pp_schedules[ii] = p_entry->schedule;
+            }
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,170 @@
+/**
+ * Ruuvi Endpoints per-device key store.
+ *
+ * Open-addressing hash table from 48-bit BLE MAC address to the decryption key
+ * of the tag. The key schedule, e.g. expanded AES round keys, is computed once
+ * when the key is stored so that decoding a packet costs a single table probe
+ * instead of a key expansion.
+ *
+ * Storage is provided by the caller, the key store does not allocate memory.
+ * Lookups use linear probing and removal uses backward shift, so no tombstones
+ * accumulate in long-running gateways.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_KEYSTORE_H
+#define RUUVI_ENDPOINTS_KEYSTORE_H
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_replay.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef RE_KEYSTORE_KEY_SIZE
+#   define RE_KEYSTORE_KEY_SIZE      (16U)  //!< Bytes of key, AES-128.
+#endif
+#ifndef RE_KEYSTORE_SCHEDULE_SIZE
+#   define RE_KEYSTORE_SCHEDULE_SIZE (176U) //!< Bytes of key schedule, 11 AES-128 round keys.
+#endif
+
+#define RE_KEYSTORE_MAC_MASK  (0xFFFFFFFFFFFFU)     //!< Valid bits of a MAC address.
+#define RE_KEYSTORE_EMPTY     (0xFFFFFFFFFFFFFFFFU) //!< Marks an unused slot.
+#define RE_KEYSTORE_MAC_BYTES (6U)                  //!< Bytes of MAC address in payload.
+
+/**
+ * @brief Expand a key into the schedule used by the cipher.
+ *
+ * @param[in]  p_key Key to expand.
+ * @param[in]  key_size Length of key in bytes, RE_KEYSTORE_KEY_SIZE.
+ * @param[out] p_schedule Expanded key.
+ * @param[in]  schedule_size Length of schedule in bytes, RE_KEYSTORE_SCHEDULE_SIZE.
+ * @return 0 on success, non-zero error code otherwise.
+ */
+typedef uint32_t (*re_key_expand_fp) (const uint8_t * const p_key,
+                                      const size_t key_size,
+                                      uint8_t * const p_schedule,
+                                      const size_t schedule_size);
+
+/** @brief Key material of a single tag. */
+typedef struct
+{
+    uint8_t schedule[RE_KEYSTORE_SCHEDULE_SIZE]; //!< Expanded key, passed to the cipher.
+    uint8_t key[RE_KEYSTORE_KEY_SIZE];           //!< Key as given to @ref re_keystore_put.
+    re_replay_window_t replay;                   //!< Accepted message counters.
+} re_keystore_entry_t;
+
+/**
+ * @brief Key store state.
+ *
+ * MAC addresses are kept apart from the key material so that probing touches
+ * only 8 bytes per slot.
+ */
+typedef struct
+{
+    uint64_t * p_macs;               //!< Capacity slots of MAC, RE_KEYSTORE_EMPTY if unused.
+    re_keystore_entry_t * p_entries; //!< Capacity slots of key material.
+    size_t capacity;                 //!< Number of slots, power of two.
+    size_t count;                    //!< Number of stored keys.
+    re_key_expand_fp expand;         //!< Key expansion function.
+} re_keystore_t;
+
+/**
+ * @brief Initialize an empty key store on caller-provided storage.
+ *
+ * At most 3/4 of the slots are used to keep probe sequences short, size the
+ * storage accordingly.
+ *
+ * @param[out] p_store Key store to initialize.
+ * @param[in]  p_macs Array of capacity MAC slots.
+ * @param[in]  p_entries Array of capacity key slots.
+ * @param[in]  capacity Number of slots, power of two and at least 4.
+ * @param[in]  expand Key expansion function.
+ * @retval RE_SUCCESS if key store was initialized.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if capacity is not a power of two or less than 4.
+ */
+re_status_t re_keystore_init (re_keystore_t * const p_store,
+                              uint64_t * const p_macs,
+                              re_keystore_entry_t * const p_entries,
+                              const size_t capacity,
+                              re_key_expand_fp expand);
+
+/**
+ * @brief Store or replace the key of a tag.
+ *
+ * The key is expanded before the table is modified, an existing key of the
+ * tag is kept if the expansion fails. The replay window of the tag is reset
+ * if the key changes.
+ *
+ * @param[in,out] p_store Key store.
+ * @param[in]     mac 48-bit MAC address of the tag.
+ * @param[in]     p_key Key of the tag.
+ * @param[in]     key_size Length of key in bytes, must be RE_KEYSTORE_KEY_SIZE.
+ * @retval RE_SUCCESS if key was stored.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if mac has bits above 48, key size is wrong
+ *                                or the key expansion failed.
+ * @retval RE_ERROR_DATA_SIZE if the key store is full.
+ */
+re_status_t re_keystore_put (re_keystore_t * const p_store,
+                             const uint64_t mac,
+                             const uint8_t * const p_key,
+                             const size_t key_size);
+
+/**
+ * @brief Find the key material of a tag.
+ *
+ * The replay window of the returned entry may be updated by the caller, e.g.
+ * with @ref re_replay_accept after the frame has been decrypted and verified.
+ *
+ * @param[in] p_store Key store.
+ * @param[in] mac 48-bit MAC address of the tag.
+ * @return Pointer to key material, NULL if the tag is unknown or p_store is NULL.
+ */
+re_keystore_entry_t * re_keystore_find (const re_keystore_t * const p_store,
+                                        const uint64_t mac);
+
+/**
+ * @brief Remove the key of a tag.
+ *
+ * @param[in,out] p_store Key store.
+ * @param[in]     mac 48-bit MAC address of the tag.
+ * @retval RE_SUCCESS if the key was removed.
+ * @retval RE_ERROR_NULL if p_store is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the tag is unknown.
+ */
+re_status_t re_keystore_remove (re_keystore_t * const p_store, const uint64_t mac);
+
+/**
+ * @brief Read a MAC address stored most significant byte first.
+ *
+ * @param[in] p_address Pointer to first byte of address, e.g. payload + RE_8_OFFSET_ADDR_MSB.
+ * @return 48-bit MAC address.
+ */
+uint64_t re_keystore_mac_read (const uint8_t * const p_address);
+
+/**
+ * @brief Look up key schedules for an array of frames.
+ *
+ * Output is suitable as the key array of batch decoders such as
+ * @ref re_8_decode_batch with key size RE_KEYSTORE_SCHEDULE_SIZE.
+ *
+ * @param[in]  p_store Key store.
+ * @param[in]  pp_buffers Array of num_buffers frames.
+ * @param[in]  address_offset Offset of MAC address MSB in each frame,
+ *                            e.g. RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_ADDR_MSB.
+ * @param[in]  num_buffers Number of frames.
+ * @param[out] pp_schedules Array of num_buffers key schedules, NULL for unknown
+ *                          tags and NULL frames.
+ * @retval RE_SUCCESS if every tag was found.
+ * @retval RE_ERROR_NULL if any of the array pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if at least one tag was unknown.
+ */
+re_status_t re_keystore_find_batch (const re_keystore_t * const p_store,
+                                    const uint8_t * const * const pp_buffers,
+                                    const size_t address_offset,
+                                    const size_t num_buffers,
+                                    const uint8_t ** const pp_schedules);
+
+#endif // RUUVI_ENDPOINTS_KEYSTORE_H
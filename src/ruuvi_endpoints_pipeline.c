@@ -0,0 +1,294 @@
+#include "ruuvi_endpoints_pipeline.h"
+#include "ruuvi_endpoints_internal.h"
+#include <string.h>
+
+#if RE_PIPELINE_ENABLED
+
+#define RE_PIPELINE_SHARD_SHIFT (56U) //!< Shard uses top bits of hash, dedup entries lower bits.
+
+static bool re_pipeline_is_pow2 (const size_t value)
+{
+    return (0U != value) && (0U == (value & (value - 1U)));
+}
+
+/**
+ * @brief Classify and decode a released report into next free output record.
+ *
+ * Called by duplicate suppression on the worker thread of the shard.
+ */
+static void re_pipeline_emit (const re_ca_uart_ble_adv_t * const p_adv, void * const p_context)
+{
+    re_pipeline_shard_t * const p_shard = (re_pipeline_shard_t *) p_context;
+    const size_t head = atomic_load_explicit (&p_shard->output_head, memory_order_relaxed);
+    const size_t tail = atomic_load_explicit (&p_shard->output_tail, memory_order_acquire);
+
+    if ( (head - tail) > p_shard->output_mask)
+    {
+        p_shard->num_overflow++;
+    }
+    else
+    {
+        re_pipeline_record_t * const p_record = &p_shard->p_records[head & p_shard->output_mask];
+        const size_t len = p_adv->adv_len;
+        memcpy (&p_record->adv, p_adv, sizeof (p_record->adv));
+        p_record->data_format = 0;
+        p_record->status = RE_ERROR_INVALID_PARAM;
+
+        if (len > sizeof (p_adv->adv))
+        {
+            // Length is beyond report, pass through undecoded.
+        }
+#if RE_5_ENABLED
+        else if ( (len >= RE_5_RAW_MIN_LEN) && re_5_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_5_DESTINATION;
+            p_record->status = re_5_decode (p_adv->adv, &p_record->data.df5);
+        }
+#endif
+#if RE_6_ENABLED
+        else if ( (len >= RE_6_RAW_BUF_SIZE) && re_6_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_6_DESTINATION;
+            p_record->status = re_6_decode (p_adv->adv, &p_record->data.df6);
+        }
+#endif
+#if RE_E1_ENABLED
+        else if ( (len >= RE_E1_RAW_MIN_LEN) && re_e1_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_E1_DESTINATION;
+            p_record->status = re_e1_decode (p_adv->adv, &p_record->data.dfe1);
+        }
+#endif
+#if RE_7_ENABLED
+        else if ( (len >= RE_7_RAW_MIN_LEN) && re_7_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_7_DESTINATION;
+            p_record->status = re_7_decode (p_adv->adv, &p_record->data.df7);
+        }
+#endif
+#if RE_C5_ENABLED
+        else if ( (len >= RE_C5_RAW_MIN_LEN) && re_c5_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_C5_DESTINATION;
+            p_record->status = re_c5_decode (p_adv->adv, &p_record->data.dfc5);
+        }
+#endif
+#if RE_3_ENABLED
+        else if ( (len >= RE_3_RAW_MIN_LEN) && re_3_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_3_DESTINATION;
+            p_record->status = re_3_decode (p_adv->adv, &p_record->data.df3);
+        }
+#endif
+#if RE_E0_ENABLED
+        else if ( (len >= RE_E0_RAW_MIN_LEN) && re_e0_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_E0_DESTINATION;
+            p_record->status = re_e0_decode (p_adv->adv, &p_record->data.dfe0);
+        }
+#endif
+#if RE_F0_ENABLED
+        else if ( (len >= RE_F0_RAW_MIN_LEN) && re_f0_check_format (p_adv->adv))
+        {
+            p_record->data_format = RE_F0_DESTINATION;
+            p_record->status = re_f0_decode (p_adv->adv, &p_record->data.dff0);
+        }
+#endif
+        else
+        {
+            // Unknown format, pass report through undecoded.
+        }
+
+        if (0U != p_record->data_format)
+        {
+            re_stats_record_format (&p_shard->stats, p_record->data_format, p_record->status);
+        }
+
+        if (RE_SUCCESS == p_record->status)
+        {
+            p_shard->num_decoded++;
+        }
+        else
+        {
+            p_shard->num_failed++;
+        }
+
+        atomic_store_explicit (&p_shard->output_head, head + 1U, memory_order_release);
+    }
+}
+
+re_status_t re_pipeline_init (re_pipeline_t * const p_pipeline,
+                              const re_pipeline_config_t * const p_config)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_pipeline) || (NULL == p_config) || (NULL == p_config->p_shards)
+            || (NULL == p_config->p_cells) || (NULL == p_config->p_entries)
+            || (NULL == p_config->p_records))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (!re_pipeline_is_pow2 (p_config->num_shards))
+              || (p_config->num_shards > RE_PIPELINE_MAX_SHARDS)
+              || (!re_pipeline_is_pow2 (p_config->queue_len))
+              || (!re_pipeline_is_pow2 (p_config->dedup_len))
+              || (!re_pipeline_is_pow2 (p_config->output_len)))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        for (size_t ii = 0; ii < p_config->num_shards; ii++)
+        {
+            re_pipeline_shard_t * const p_shard = &p_config->p_shards[ii];
+            memset (p_shard, 0, sizeof (re_pipeline_shard_t));
+            p_shard->p_cells = &p_config->p_cells[ii * p_config->queue_len];
+            p_shard->queue_mask = p_config->queue_len - 1U;
+            p_shard->p_records = &p_config->p_records[ii * p_config->output_len];
+            p_shard->output_mask = p_config->output_len - 1U;
+            atomic_init (&p_shard->enqueue_pos, 0U);
+            atomic_init (&p_shard->num_rejected, 0U);
+            atomic_init (&p_shard->output_head, 0U);
+            atomic_init (&p_shard->output_tail, 0U);
+
+            for (size_t jj = 0; jj < p_config->queue_len; jj++)
+            {
+                atomic_init (&p_shard->p_cells[jj].sequence, jj);
+            }
+
+            result |= re_dedup_init (&p_shard->dedup,
+                                     &p_config->p_entries[ii * p_config->dedup_len],
+                                     p_config->dedup_len, p_config->window_ms,
+                                     &re_pipeline_emit, p_shard);
+        }
+
+        p_pipeline->p_shards = p_config->p_shards;
+        p_pipeline->num_shards = p_config->num_shards;
+    }
+
+    return result;
+}
+
+size_t re_pipeline_shard_of (const re_pipeline_t * const p_pipeline,
+                             const uint8_t * const p_mac)
+{
+    const uint64_t hash = re_mac_read (p_mac) * RE_MAC_HASH_MUL;
+    return ( (size_t) (hash >> RE_PIPELINE_SHARD_SHIFT)) & (p_pipeline->num_shards - 1U);
+}
+
+re_status_t re_pipeline_submit (re_pipeline_t * const p_pipeline,
+                                const re_ca_uart_ble_adv_t * const p_adv,
+                                const uint32_t now_ms)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_pipeline) || (NULL == p_adv))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else
+    {
+        re_pipeline_shard_t * const p_shard =
+            &p_pipeline->p_shards[re_pipeline_shard_of (p_pipeline, p_adv->mac)];
+        re_pipeline_cell_t * p_cell = NULL;
+        size_t pos = atomic_load_explicit (&p_shard->enqueue_pos, memory_order_relaxed);
+
+        // Bounded MPMC queue of D. Vyukov, used with a single consumer.
+        while ( (NULL == p_cell) && (RE_SUCCESS == result))
+        {
+            re_pipeline_cell_t * const p_candidate = &p_shard->p_cells[pos & p_shard->queue_mask];
+            const size_t sequence = atomic_load_explicit (&p_candidate->sequence,
+                                    memory_order_acquire);
+
+            if (sequence == pos)
+            {
+                // On failure pos is updated to current enqueue position.
+                if (atomic_compare_exchange_weak_explicit (&p_shard->enqueue_pos, &pos,
+                        pos + 1U, memory_order_relaxed, memory_order_relaxed))
+                {
+                    p_cell = p_candidate;
+                }
+            }
+            else if ( (ptrdiff_t) (sequence - pos) < 0)
+            {
+                atomic_fetch_add_explicit (&p_shard->num_rejected, 1U, memory_order_relaxed);
+                result |= RE_ERROR_DATA_SIZE;
+            }
+            else
+            {
+                pos = atomic_load_explicit (&p_shard->enqueue_pos, memory_order_relaxed);
+            }
+        }
+
+        if (NULL != p_cell)
+        {
+            memcpy (&p_cell->adv, p_adv, sizeof (p_cell->adv));
+            p_cell->time_ms = now_ms;
+            atomic_store_explicit (&p_cell->sequence, pos + 1U, memory_order_release);
+        }
+    }
+
+    return result;
+}
+
+size_t re_pipeline_shard_run (re_pipeline_t * const p_pipeline, const size_t shard,
+                              const uint32_t now_ms, const size_t max_reports)
+{
+    size_t num_processed = 0;
+
+    if ( (NULL != p_pipeline) && (shard < p_pipeline->num_shards))
+    {
+        re_pipeline_shard_t * const p_shard = &p_pipeline->p_shards[shard];
+        bool empty = false;
+
+        while ( (!empty) && (num_processed < max_reports))
+        {
+            const size_t pos = p_shard->dequeue_pos;
+            re_pipeline_cell_t * const p_cell = &p_shard->p_cells[pos & p_shard->queue_mask];
+            const size_t sequence = atomic_load_explicit (&p_cell->sequence,
+                                    memory_order_acquire);
+
+            if (sequence != (pos + 1U))
+            {
+                empty = true;
+            }
+            else
+            {
+                (void) re_dedup_push (&p_shard->dedup, &p_cell->adv, p_cell->time_ms, NULL);
+                atomic_store_explicit (&p_cell->sequence, pos + p_shard->queue_mask + 1U,
+                                       memory_order_release);
+                p_shard->dequeue_pos = pos + 1U;
+                num_processed++;
+            }
+        }
+
+        (void) re_dedup_flush (&p_shard->dedup, now_ms);
+    }
+
+    return num_processed;
+}
+
+bool re_pipeline_read (re_pipeline_t * const p_pipeline, const size_t shard,
+                       re_pipeline_record_t * const p_record)
+{
+    bool has_record = false;
+
+    if ( (NULL != p_pipeline) && (NULL != p_record) && (shard < p_pipeline->num_shards))
+    {
+        re_pipeline_shard_t * const p_shard = &p_pipeline->p_shards[shard];
+        const size_t tail = atomic_load_explicit (&p_shard->output_tail, memory_order_relaxed);
+        const size_t head = atomic_load_explicit (&p_shard->output_head, memory_order_acquire);
+
+        if (head != tail)
+        {
+            memcpy (p_record, &p_shard->p_records[tail & p_shard->output_mask],
+                    sizeof (re_pipeline_record_t));
+            atomic_store_explicit (&p_shard->output_tail, tail + 1U, memory_order_release);
+            has_record = true;
+        }
+    }
+
+    return has_record;
+}
+
+#endif
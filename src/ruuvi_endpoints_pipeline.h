@@ -0,0 +1,194 @@
+/**
+ * Ruuvi Endpoints sharded ingest pipeline for hosts.
+ *
+ * Spreads scan reports over shards by MAC address so that decoding scales
+ * across cores. Any number of threads, e.g. CA UART parsers, submit reports to
+ * the lock-free input queue of the shard of the tag. Each shard is drained by
+ * one worker thread which suppresses duplicates with @ref re_dedup_t, decodes
+ * the payload and writes a record to the output ring of the shard, which is
+ * read by one consumer thread.
+ *
+ * The library does not create threads, callers run @ref re_pipeline_shard_run
+ * in their own workers. All reports of a tag are handled by the same shard,
+ * so per-tag state such as @ref re_seq_t needs no locking if it is kept per
+ * shard.
+ *
+ * Needs C11 atomics and is disabled by default, define RE_PIPELINE_ENABLED
+ * to 1 to build it.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_PIPELINE_H
+#define RUUVI_ENDPOINTS_PIPELINE_H
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_dedup.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_c5.h"
+#include "ruuvi_endpoint_e0.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_f0.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if RE_PIPELINE_ENABLED
+
+#include <stdatomic.h>
+
+#define RE_PIPELINE_CACHE_LINE (64U)  //!< Assumed cache line size.
+#define RE_PIPELINE_MAX_SHARDS (256U) //!< Shard is selected with 8 bits of MAC hash.
+
+/** @brief One entry of a shard input queue. */
+typedef struct
+{
+    atomic_size_t sequence;   //!< Queue position the entry is ready for.
+    re_ca_uart_ble_adv_t adv; //!< Submitted report.
+    uint32_t time_ms;         //!< Arrival time of report.
+} re_pipeline_cell_t;
+
+/** @brief Decoded report. */
+typedef struct
+{
+    re_ca_uart_ble_adv_t adv; //!< Best copy of the report.
+    uint8_t data_format;      //!< Data format of decoded payload, 0 if not decoded.
+    re_status_t status;       //!< Result of decoding, RE_ERROR_INVALID_PARAM for unknown formats.
+    union
+    {
+        re_3_data_t df3;
+        re_5_data_t df5;
+        re_6_data_t df6;
+        re_7_data_t df7;
+        re_c5_data_t dfc5;
+        re_e0_data_t dfe0;
+        re_e1_data_t dfe1;
+        re_f0_data_t dff0;
+    } data; //!< Decoded data of data_format.
+} re_pipeline_record_t;
+
+/**
+ * @brief State of one shard.
+ *
+ * Indices written by different threads are on separate cache lines.
+ */
+typedef struct
+{
+    _Alignas (RE_PIPELINE_CACHE_LINE)
+    atomic_size_t enqueue_pos;        //!< Next free input position, shared by producers.
+    atomic_size_t num_rejected;       //!< Reports rejected because input queue was full.
+    _Alignas (RE_PIPELINE_CACHE_LINE)
+    size_t dequeue_pos;               //!< Next input position to process.
+    re_pipeline_cell_t * p_cells;     //!< Input queue entries.
+    size_t queue_mask;                //!< Input queue length - 1.
+    re_dedup_t dedup;                 //!< Duplicate suppression of the shard.
+    re_pipeline_record_t * p_records; //!< Output ring entries.
+    size_t output_mask;               //!< Output ring length - 1.
+    uint32_t num_decoded;             //!< Records decoded successfully.
+    uint32_t num_failed;              //!< Records that could not be decoded.
+    uint32_t num_overflow;            //!< Records lost because output ring was full.
+    re_stats_t stats;                 //!< Decode results of known data formats.
+    _Alignas (RE_PIPELINE_CACHE_LINE)
+    atomic_size_t output_head;        //!< Next output position to write, by worker.
+    _Alignas (RE_PIPELINE_CACHE_LINE)
+    atomic_size_t output_tail;        //!< Next output position to read, by consumer.
+} re_pipeline_shard_t;
+
+/** @brief Storage and sizes of a pipeline. Lengths are per shard and powers of two. */
+typedef struct
+{
+    re_pipeline_shard_t * p_shards;   //!< Array of num_shards shards.
+    size_t num_shards;                //!< Number of shards, power of two, at most RE_PIPELINE_MAX_SHARDS.
+    re_pipeline_cell_t * p_cells;     //!< Array of num_shards * queue_len entries.
+    size_t queue_len;                 //!< Input queue length of a shard.
+    re_dedup_entry_t * p_entries;     //!< Array of num_shards * dedup_len entries.
+    size_t dedup_len;                 //!< Duplicate suppression entries of a shard.
+    re_pipeline_record_t * p_records; //!< Array of num_shards * output_len records.
+    size_t output_len;                //!< Output ring length of a shard.
+    uint32_t window_ms;               //!< Duplicate suppression window.
+} re_pipeline_config_t;
+
+/** @brief Pipeline state. */
+typedef struct
+{
+    re_pipeline_shard_t * p_shards; //!< Shards.
+    size_t num_shards;              //!< Number of shards.
+} re_pipeline_t;
+
+/**
+ * @brief Initialize a pipeline on caller-provided storage.
+ *
+ * Not thread safe, call before starting workers.
+ *
+ * @param[out] p_pipeline Pipeline to initialize.
+ * @param[in]  p_config Storage and sizes.
+ * @retval RE_SUCCESS if pipeline was initialized.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if a count or length is not a power of two
+ *                                or there are too many shards.
+ */
+re_status_t re_pipeline_init (re_pipeline_t * const p_pipeline,
+                              const re_pipeline_config_t * const p_config);
+
+/**
+ * @brief Get the shard that handles reports of a tag.
+ *
+ * @param[in] p_pipeline Pipeline.
+ * @param[in] p_mac 6-byte MAC address, MSB first.
+ * @return Index of shard.
+ */
+size_t re_pipeline_shard_of (const re_pipeline_t * const p_pipeline,
+                             const uint8_t * const p_mac);
+
+/**
+ * @brief Queue a scan report to the shard of its tag.
+ *
+ * Thread safe, may be called from any number of threads.
+ *
+ * @param[in,out] p_pipeline Pipeline.
+ * @param[in]     p_adv Scan report.
+ * @param[in]     now_ms Arrival time of report.
+ * @retval RE_SUCCESS if report was queued.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if the input queue of the shard is full, report is dropped.
+ */
+re_status_t re_pipeline_submit (re_pipeline_t * const p_pipeline,
+                                const re_ca_uart_ble_adv_t * const p_adv,
+                                const uint32_t now_ms);
+
+/**
+ * @brief Process queued reports of a shard.
+ *
+ * Runs duplicate suppression and decoding and releases reports whose
+ * suppression window has closed by now_ms. Call from a single worker thread
+ * per shard, e.g. in a loop that sleeps when nothing was processed.
+ *
+ * @param[in,out] p_pipeline Pipeline.
+ * @param[in]     shard Index of shard.
+ * @param[in]     now_ms Current time.
+ * @param[in]     max_reports Most reports to take from the input queue.
+ * @return Number of reports taken from the input queue, 0 on invalid parameters.
+ */
+size_t re_pipeline_shard_run (re_pipeline_t * const p_pipeline, const size_t shard,
+                              const uint32_t now_ms, const size_t max_reports);
+
+/**
+ * @brief Read the oldest record of a shard.
+ *
+ * Call from a single consumer thread per shard.
+ *
+ * @param[in,out] p_pipeline Pipeline.
+ * @param[in]     shard Index of shard.
+ * @param[out]    p_record Copy of the record.
+ * @return True if a record was read, false if the ring is empty or on invalid parameters.
+ */
+bool re_pipeline_read (re_pipeline_t * const p_pipeline, const size_t shard,
+                       re_pipeline_record_t * const p_record);
+
+#endif
+
+#endif // RUUVI_ENDPOINTS_PIPELINE_H
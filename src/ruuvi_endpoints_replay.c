@@ -0,0 +1,99 @@
+#include "ruuvi_endpoints_replay.h"
+#include <stddef.h>
+
+#if RE_REPLAY_ENABLED
+
+#define RE_REPLAY_NEWEST_BIT ( (uint64_t) 1U)
+
+/**
+ * @brief Distance from newest accepted counter to given counter, modulo modulus.
+ */
+static uint32_t re_replay_distance (const re_replay_window_t * const p_window,
+                                    const uint16_t counter,
+                                    const uint32_t modulus)
+{
+    uint32_t distance = (uint32_t) counter - p_window->newest;
+
+    if (counter < p_window->newest)
+    {
+        distance += modulus;
+    }
+
+    return distance;
+}
+
+void re_replay_reset (re_replay_window_t * const p_window)
+{
+    if (NULL != p_window)
+    {
+        p_window->seen = 0;
+        p_window->newest = 0;
+    }
+}
+
+bool re_replay_check (const re_replay_window_t * const p_window,
+                      const uint16_t counter,
+                      const uint32_t modulus)
+{
+    bool fresh = false;
+
+    if ( (NULL != p_window) && (counter < modulus))
+    {
+        if (0U == p_window->seen)
+        {
+            fresh = true;
+        }
+        else
+        {
+            const uint32_t ahead = re_replay_distance (p_window, counter, modulus);
+
+            if ( (0U != ahead) && (ahead <= (modulus / 2U)))
+            {
+                fresh = true;
+            }
+            else
+            {
+                const uint32_t behind = (modulus - ahead) % modulus;
+                fresh = (behind < RE_REPLAY_WINDOW)
+                        && (0U == (p_window->seen & (RE_REPLAY_NEWEST_BIT << behind)));
+            }
+        }
+    }
+
+    return fresh;
+}
+
+bool re_replay_accept (re_replay_window_t * const p_window,
+                       const uint16_t counter,
+                       const uint32_t modulus)
+{
+    const bool fresh = re_replay_check (p_window, counter, modulus);
+
+    if (fresh)
+    {
+        if (0U == p_window->seen)
+        {
+            p_window->seen = RE_REPLAY_NEWEST_BIT;
+            p_window->newest = counter;
+        }
+        else
+        {
+            const uint32_t ahead = re_replay_distance (p_window, counter, modulus);
+
+            if (ahead <= (modulus / 2U))
+            {
+                p_window->seen = (ahead < RE_REPLAY_WINDOW) ? (p_window->seen << ahead) : 0U;
+                p_window->seen |= RE_REPLAY_NEWEST_BIT;
+                p_window->newest = counter;
+            }
+            else
+            {
+                p_window->seen |= RE_REPLAY_NEWEST_BIT << (modulus - ahead);
+            }
+        }
+    }
+
+    return fresh;
+}
+
+#endif
@@ -0,0 +1,70 @@
+/**
+ * Ruuvi Endpoints replay protection.
+ *
+ * Sliding window of recently accepted message counters of one device, as in
+ * IPsec anti-replay (RFC 4303). The newest counter and a bitmap of the
+ * RE_REPLAY_WINDOW counters before it fit in 16 bytes, so the window can be
+ * stored next to the key of the device, see @ref re_keystore_entry_t.
+ *
+ * Counters wrap around at the modulus of the data format. A counter more than
+ * half of the modulus ahead of the newest one is treated as an old counter
+ * from before the wrap.
+ *
+ * Only counters of frames that passed the integrity check should be accepted,
+ * otherwise forged frames could advance the window.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_REPLAY_H
+#define RUUVI_ENDPOINTS_REPLAY_H
+
+#include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RE_REPLAY_WINDOW     (64U)     //!< Number of counters tracked, including newest.
+#define RE_REPLAY_MODULUS_8  (0xFFFFU) //!< DF8 counter runs 0 ... 0xFFFE, 0xFFFF is N/A.
+#define RE_REPLAY_MODULUS_FA (0x100U)  //!< FA counter runs 0 ... 0xFF.
+
+/** @brief Replay window of one device. All zeroes is an empty window. */
+typedef struct
+{
+    uint64_t seen;   //!< Bit n set if counter newest - n was accepted. 0 if nothing accepted.
+    uint16_t newest; //!< Newest accepted counter.
+} re_replay_window_t;
+
+/**
+ * @brief Forget all accepted counters.
+ *
+ * @param[out] p_window Window to reset.
+ */
+void re_replay_reset (re_replay_window_t * const p_window);
+
+/**
+ * @brief Check if a counter would be accepted, without updating the window.
+ *
+ * @param[in] p_window Window of the device.
+ * @param[in] counter Message counter of received frame.
+ * @param[in] modulus Number of distinct counter values, e.g. RE_REPLAY_MODULUS_8.
+ * @retval true if the counter is new and inside the window or ahead of it.
+ * @retval false if the counter was already accepted, is older than the window,
+ *               is not less than modulus or p_window is NULL.
+ */
+bool re_replay_check (const re_replay_window_t * const p_window,
+                      const uint16_t counter,
+                      const uint32_t modulus);
+
+/**
+ * @brief Check a counter and mark it accepted.
+ *
+ * @param[in,out] p_window Window of the device.
+ * @param[in]     counter Message counter of received frame.
+ * @param[in]     modulus Number of distinct counter values, e.g. RE_REPLAY_MODULUS_8.
+ * @return Same as @ref re_replay_check. The window is updated only if true.
+ */
+bool re_replay_accept (re_replay_window_t * const p_window,
+                       const uint16_t counter,
+                       const uint32_t modulus);
+
+#endif // RUUVI_ENDPOINTS_REPLAY_H
@@ -0,0 +1,153 @@
+#include "ruuvi_endpoints_seq.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_f0.h"
+#include <stddef.h>
+#include <string.h>
+
+#if RE_SEQ_ENABLED
+
+#define RE_SEQ_6_PERIOD  (256U)                       //!< 8 bits, all valid.
+#define RE_SEQ_F0_PERIOD (RE_F0_FLAGS_SEQ_MASK + 1U)  //!< 4 bits, all valid.
+#define RE_SEQ_E1_PERIOD (RE_E1_INVALID_SEQUENCE)     //!< 24 bits, top value invalid.
+
+uint32_t re_seq_period (const uint8_t data_format)
+{
+    uint32_t period = 0;
+
+    switch (data_format)
+    {
+        case RE_5_DESTINATION:
+            period = RE_5_SEQCTR_MAX + 1U;
+            break;
+
+        case RE_6_DESTINATION:
+            period = RE_SEQ_6_PERIOD;
+            break;
+
+        case RE_7_DESTINATION:
+            period = RE_7_SEQCTR_MAX + 1U;
+            break;
+
+        case RE_E1_DESTINATION:
+            period = RE_SEQ_E1_PERIOD;
+            break;
+
+        case RE_F0_DESTINATION:
+            period = RE_SEQ_F0_PERIOD;
+            break;
+
+        default:
+            break;
+    }
+
+    return period;
+}
+
+re_status_t re_seq_init (re_seq_t * const p_seq, const uint32_t period)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_seq)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (period < RE_SEQ_MIN_PERIOD)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        memset (p_seq, 0, sizeof (re_seq_t));
+        p_seq->period = period;
+    }
+
+    return result;
+}
+
+static void re_seq_restart (re_seq_t * const p_seq, const uint32_t counter)
+{
+    p_seq->last = counter;
+    p_seq->window = RE_BIT1_MASK;
+    p_seq->received++;
+}
+
+re_status_t re_seq_update (re_seq_t * const p_seq, const uint32_t counter,
+                           re_seq_event_t * const p_event)
+{
+    re_status_t result = RE_SUCCESS;
+    re_seq_event_t event = RE_SEQ_IN_ORDER;
+
+    if (NULL == p_seq)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (counter >= p_seq->period)
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else if (!p_seq->started)
+    {
+        p_seq->started = true;
+        re_seq_restart (p_seq, counter);
+    }
+    else
+    {
+        // Distance forward from last, modulo period. Both are below period.
+        const uint32_t ahead = (counter >= p_seq->last)
+                               ? (counter - p_seq->last)
+                               : (counter + (p_seq->period - p_seq->last));
+        const uint32_t behind = (0U == ahead) ? 0U : (p_seq->period - ahead);
+
+        if (0U == ahead)
+        {
+            p_seq->duplicates++;
+            event = RE_SEQ_DUPLICATE;
+        }
+        else if (ahead <= (p_seq->period / 2U))
+        {
+            p_seq->window = (ahead >= RE_SEQ_WINDOW_BITS)
+                            ? RE_BIT1_MASK
+                            : ( (p_seq->window << ahead) | RE_BIT1_MASK);
+            p_seq->last = counter;
+            p_seq->received++;
+            p_seq->lost += ahead - 1U;
+            event = (1U == ahead) ? RE_SEQ_IN_ORDER : RE_SEQ_GAP;
+        }
+        else if (behind >= RE_SEQ_WINDOW_BITS)
+        {
+            p_seq->restarts++;
+            re_seq_restart (p_seq, counter);
+            event = RE_SEQ_RESTART;
+        }
+        else if (0U != (p_seq->window & (RE_BIT1_MASK << behind)))
+        {
+            p_seq->duplicates++;
+            event = RE_SEQ_DUPLICATE;
+        }
+        else
+        {
+            p_seq->window |= RE_BIT1_MASK << behind;
+            p_seq->received++;
+            p_seq->reordered++;
+
+            if (0U != p_seq->lost)
+            {
+                p_seq->lost--;
+            }
+
+            event = RE_SEQ_REORDERED;
+        }
+    }
+
+    if (NULL != p_event)
+    {
+        *p_event = event;
+    }
+
+    return result;
+}
+
+#endif
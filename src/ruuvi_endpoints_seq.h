@@ -0,0 +1,86 @@
+/**
+ * Ruuvi Endpoints per-tag sequence tracker.
+ *
+ * Counts received, lost, duplicate and reordered packets of a tag from the
+ * wrapping measurement counter of its data format. Counters of different
+ * formats have different widths and some reserve their top value as invalid,
+ * so the tracker is configured with the period of the counter, see
+ * @ref re_seq_period. Each update is O(1).
+ *
+ * A 32-bit window of recently received counters tells apart a duplicate from
+ * a late packet that was counted as lost. A jump further back than the window
+ * is taken as a restart of the tag and the tracker resynchronizes. Gaps of at
+ * least half the period cannot be told apart from reordering, which limits
+ * loss detection of the 4-bit F0 counter to gaps of 7 packets.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_SEQ_H
+#define RUUVI_ENDPOINTS_SEQ_H
+
+#include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define RE_SEQ_WINDOW_BITS (32U) //!< Received counters remembered behind the latest.
+#define RE_SEQ_MIN_PERIOD  (2U)  //!< Shortest counter period tracked.
+
+/** @brief What an update was counted as. */
+typedef enum
+{
+    RE_SEQ_IN_ORDER = 0, //!< Next expected counter, or first packet.
+    RE_SEQ_GAP,          //!< Counter skipped ahead, skipped packets counted as lost.
+    RE_SEQ_DUPLICATE,    //!< Counter was already received.
+    RE_SEQ_REORDERED,    //!< Late packet that was counted as lost.
+    RE_SEQ_RESTART       //!< Counter jumped back beyond the window, tracker resynchronized.
+} re_seq_event_t;
+
+/** @brief Sequence state and link statistics of one tag. */
+typedef struct
+{
+    uint32_t period;     //!< Number of distinct counter values.
+    uint32_t last;       //!< Latest counter value.
+    uint32_t window;     //!< Bit n is set if counter last - n was received.
+    uint32_t received;   //!< Unique packets received.
+    uint32_t lost;       //!< Packets skipped by the counter and not received late.
+    uint32_t duplicates; //!< Packets with an already received counter.
+    uint32_t reordered;  //!< Packets received after a later counter.
+    uint32_t restarts;   //!< Resynchronizations.
+    bool started;        //!< True once the first packet was received.
+} re_seq_t;
+
+/**
+ * @brief Get the period of the measurement counter of a data format.
+ *
+ * @param[in] data_format Data format header byte, e.g. RE_5_DESTINATION.
+ * @return Number of valid counter values, 0 if format has no measurement counter.
+ */
+uint32_t re_seq_period (const uint8_t data_format);
+
+/**
+ * @brief Initialize tracker of one tag.
+ *
+ * @param[out] p_seq Tracker to initialize.
+ * @param[in]  period Number of valid counter values, e.g. from @ref re_seq_period.
+ * @retval RE_SUCCESS if tracker was initialized.
+ * @retval RE_ERROR_NULL if p_seq is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if period is less than RE_SEQ_MIN_PERIOD.
+ */
+re_status_t re_seq_init (re_seq_t * const p_seq, const uint32_t period);
+
+/**
+ * @brief Count a received packet.
+ *
+ * @param[in,out] p_seq Tracker of the tag.
+ * @param[in]     counter Measurement counter of the packet.
+ * @param[out]    p_event What the packet was counted as, may be NULL.
+ * @retval RE_SUCCESS if packet was counted.
+ * @retval RE_ERROR_NULL if p_seq is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if counter is not less than period, e.g. the
+ *                                invalid marker of the format. Nothing is counted.
+ */
+re_status_t re_seq_update (re_seq_t * const p_seq, const uint32_t counter,
+                           re_seq_event_t * const p_event);
+
+#endif // RUUVI_ENDPOINTS_SEQ_H
@@ -0,0 +1,443 @@
+#include "ruuvi_endpoints_series.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if RE_SERIES_ENABLED
+
+#define RE_SERIES_SIGN_SHIFT           (63U)
+#define RE_SERIES_BITS_IN_BYTE         (8U)
+#define RE_SERIES_ACC_BITS             (64U)
+#define RE_SERIES_CODED_MAX            (2147483647.0) //!< INT32_MIN is reserved for NaN.
+#define RE_SERIES_NUM_TS_CODES         (5U)
+#define RE_SERIES_NUM_VALUE_CODES      (5U)
+#define RE_SERIES_VALUE_INVALID_PREFIX (5U)           //!< Ones of invalid value code.
+
+/** @brief Variable length code: prefix of ones ended by zero, then payload bits. */
+typedef struct
+{
+    uint8_t prefix_len; //!< Prefix bits including terminating zero, if any.
+    uint8_t num_bits;   //!< Payload bits.
+} re_series_code_t;
+
+static const re_series_code_t m_ts_codes[RE_SERIES_NUM_TS_CODES] =
+{
+    { 1U, 0U }, { 2U, 7U }, { 3U, 9U }, { 4U, 12U }, { 4U, 34U }
+};
+
+static const re_series_code_t m_value_codes[RE_SERIES_NUM_VALUE_CODES] =
+{
+    { 1U, 0U }, { 2U, 4U }, { 3U, 8U }, { 4U, 16U }, { 5U, 33U }
+};
+
+/** @brief Bit reader of a block. */
+typedef struct
+{
+    const uint8_t * p_block; //!< Block.
+    size_t block_len;        //!< Bytes of block.
+    size_t byte_pos;         //!< Next byte to load.
+    uint64_t acc;            //!< Loaded bits, next bit is MSB.
+    uint8_t acc_bits;        //!< Number of loaded bits.
+} re_series_reader_t;
+
+static uint64_t re_series_zigzag (const int64_t value)
+{
+    const uint64_t bits = (uint64_t) value;
+    return (bits << 1U) ^ (0U - (bits >> RE_SERIES_SIGN_SHIFT));
+}
+
+static int64_t re_series_unzigzag (const uint64_t value)
+{
+    return (int64_t) ( (value >> 1U) ^ (0U - (value & 1U)));
+}
+
+static void re_series_write_u16 (uint8_t * const p_msb, const uint16_t value)
+{
+    p_msb[0] = (uint8_t) (value >> RE_BYTE_1_SHIFT);
+    p_msb[1] = (uint8_t) value;
+}
+
+static void re_series_write_u32 (uint8_t * const p_msb, const uint32_t value)
+{
+    p_msb[0] = (uint8_t) (value >> RE_BYTE_3_SHIFT);
+    p_msb[1] = (uint8_t) (value >> RE_BYTE_2_SHIFT);
+    p_msb[2] = (uint8_t) (value >> RE_BYTE_1_SHIFT);
+    p_msb[3] = (uint8_t) value;
+}
+
+static uint32_t re_series_read_u32 (const uint8_t * const p_msb)
+{
+    return ( (uint32_t) p_msb[0] << RE_BYTE_3_SHIFT)
+           | ( (uint32_t) p_msb[1] << RE_BYTE_2_SHIFT)
+           | ( (uint32_t) p_msb[2] << RE_BYTE_1_SHIFT)
+           | p_msb[3];
+}
+
+/**
+ * @brief Select shortest code that holds a zigzag coded value.
+ */
+static const re_series_code_t * re_series_code_of (const re_series_code_t * const p_codes,
+        const size_t num_codes, const uint64_t zigzag)
+{
+    size_t ii = 0;
+
+    while ( (ii < (num_codes - 1U)) && ( (zigzag >> p_codes[ii].num_bits) != 0U))
+    {
+        ii++;
+    }
+
+    return &p_codes[ii];
+}
+
+/**
+ * @brief Append bits MSB first. Caller has checked that they fit.
+ */
+static void re_series_put_bits (re_series_encoder_t * const p_enc, const uint64_t bits,
+                                uint8_t num_bits)
+{
+    while (num_bits > 0U)
+    {
+        const size_t byte_idx = RE_SERIES_HEADER_LEN
+                                + (p_enc->bit_pos / RE_SERIES_BITS_IN_BYTE);
+        const uint8_t used = (uint8_t) (p_enc->bit_pos % RE_SERIES_BITS_IN_BYTE);
+        const uint8_t free_bits = (uint8_t) (RE_SERIES_BITS_IN_BYTE - used);
+        const uint8_t take = (num_bits < free_bits) ? num_bits : free_bits;
+        const uint8_t chunk = (uint8_t) ( (bits >> (num_bits - take))
+                                          & ( (1U << take) - 1U));
+
+        if (0U == used)
+        {
+            p_enc->p_block[byte_idx] = 0U;
+        }
+
+        p_enc->p_block[byte_idx] |= (uint8_t) (chunk << (free_bits - take));
+        p_enc->bit_pos += take;
+        num_bits = (uint8_t) (num_bits - take);
+    }
+}
+
+/**
+ * @brief Append a code: prefix of ones, terminating zero if any, payload.
+ */
+static void re_series_put_code (re_series_encoder_t * const p_enc,
+                                const re_series_code_t * const p_code,
+                                const bool terminated, const uint64_t payload)
+{
+    const uint8_t ones = terminated ? (uint8_t) (p_code->prefix_len - 1U)
+                         : p_code->prefix_len;
+    re_series_put_bits (p_enc, (1U << ones) - 1U, ones);
+
+    if (terminated)
+    {
+        re_series_put_bits (p_enc, 0U, 1U);
+    }
+
+    re_series_put_bits (p_enc, payload, p_code->num_bits);
+}
+
+re_status_t re_series_encode_start (re_series_encoder_t * const p_enc,
+                                    uint8_t * const p_block,
+                                    const size_t block_len,
+                                    const re_float resolution)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_enc) || (NULL == p_block))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (! (resolution > 0.0F)) || isinf (resolution))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else if (block_len < RE_SERIES_HEADER_LEN)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        uint32_t resolution_bits = 0;
+        memset (p_enc, 0, sizeof (re_series_encoder_t));
+        p_enc->p_block = p_block;
+        p_enc->block_len = block_len;
+        p_enc->length = RE_SERIES_HEADER_LEN;
+        p_enc->resolution = resolution;
+        memset (p_block, 0, RE_SERIES_HEADER_LEN);
+        memcpy (&resolution_bits, &resolution, sizeof (resolution_bits));
+        re_series_write_u32 (&p_block[RE_SERIES_RESOLUTION_IDX], resolution_bits);
+    }
+
+    return result;
+}
+
+re_status_t re_series_encode_coded (re_series_encoder_t * const p_enc,
+                                    const uint32_t timestamp,
+                                    const int32_t value)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_enc)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (RE_SERIES_MAX_SAMPLES == p_enc->num_samples)
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else if (0U == p_enc->num_samples)
+    {
+        re_series_write_u32 (&p_enc->p_block[RE_SERIES_TS_MSB_IDX], timestamp);
+        re_series_write_u32 (&p_enc->p_block[RE_SERIES_VALUE_MSB_IDX], (uint32_t) value);
+        p_enc->timestamp = timestamp;
+        p_enc->value = (RE_SERIES_INVALID == value) ? 0 : value;
+    }
+    else
+    {
+        const int64_t interval = (int64_t) timestamp - (int64_t) p_enc->timestamp;
+        const uint64_t ts_bits = re_series_zigzag (interval - p_enc->interval);
+        const re_series_code_t * const p_ts_code =
+            re_series_code_of (m_ts_codes, RE_SERIES_NUM_TS_CODES, ts_bits);
+        const bool invalid = (RE_SERIES_INVALID == value);
+        const uint64_t value_bits = invalid ? 0U
+                                    : re_series_zigzag ( (int64_t) value - p_enc->value);
+        const re_series_code_t * const p_value_code =
+            re_series_code_of (m_value_codes, RE_SERIES_NUM_VALUE_CODES, value_bits);
+        const size_t value_len = invalid ? RE_SERIES_VALUE_INVALID_PREFIX
+                                 : ( (size_t) p_value_code->prefix_len + p_value_code->num_bits);
+        const size_t num_bits = (size_t) p_ts_code->prefix_len + p_ts_code->num_bits + value_len;
+        const size_t capacity = (p_enc->block_len - RE_SERIES_HEADER_LEN)
+                                * RE_SERIES_BITS_IN_BYTE;
+
+        if ( (capacity - p_enc->bit_pos) < num_bits)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            // Longest timestamp code is not terminated by a zero.
+            re_series_put_code (p_enc, p_ts_code,
+                                p_ts_code != &m_ts_codes[RE_SERIES_NUM_TS_CODES - 1U], ts_bits);
+
+            if (invalid)
+            {
+                re_series_put_bits (p_enc, (1U << RE_SERIES_VALUE_INVALID_PREFIX) - 1U,
+                                    RE_SERIES_VALUE_INVALID_PREFIX);
+            }
+            else
+            {
+                re_series_put_code (p_enc, p_value_code, true, value_bits);
+                p_enc->value = value;
+            }
+
+            p_enc->timestamp = timestamp;
+            p_enc->interval = interval;
+            p_enc->length = RE_SERIES_HEADER_LEN + ( (p_enc->bit_pos + RE_SERIES_BITS_IN_BYTE - 1U)
+                            / RE_SERIES_BITS_IN_BYTE);
+        }
+    }
+
+    if (RE_SUCCESS == result)
+    {
+        p_enc->num_samples++;
+        re_series_write_u16 (&p_enc->p_block[RE_SERIES_NUM_SAMPLES_IDX], p_enc->num_samples);
+    }
+
+    return result;
+}
+
+re_status_t re_series_encode_value (re_series_encoder_t * const p_enc,
+                                    const uint32_t timestamp,
+                                    const re_float value)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_enc)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (isnan (value))
+    {
+        result |= re_series_encode_coded (p_enc, timestamp, RE_SERIES_INVALID);
+    }
+    else
+    {
+        const double steps = round ( (double) value / (double) p_enc->resolution);
+
+        if (! (fabs (steps) <= RE_SERIES_CODED_MAX))
+        {
+            result |= RE_ERROR_ENCODING;
+        }
+        else
+        {
+            result |= re_series_encode_coded (p_enc, timestamp, (int32_t) steps);
+        }
+    }
+
+    return result;
+}
+
+size_t re_series_num_samples (const uint8_t * const p_block, const size_t block_len)
+{
+    size_t num_samples = 0;
+
+    if ( (NULL != p_block) && (block_len >= RE_SERIES_HEADER_LEN))
+    {
+        num_samples = ( (size_t) p_block[RE_SERIES_NUM_SAMPLES_IDX] << RE_BYTE_1_SHIFT)
+                      | p_block[RE_SERIES_NUM_SAMPLES_IDX + 1U];
+    }
+
+    return num_samples;
+}
+
+/**
+ * @brief Take bits from reader, MSB first.
+ *
+ * @return False if block ended.
+ */
+static bool re_series_get_bits (re_series_reader_t * const p_reader, const uint8_t num_bits,
+                                uint64_t * const p_bits)
+{
+    bool ok = true;
+
+    while ( (p_reader->acc_bits <= (RE_SERIES_ACC_BITS - RE_SERIES_BITS_IN_BYTE))
+            && (p_reader->byte_pos < p_reader->block_len))
+    {
+        p_reader->acc |= (uint64_t) p_reader->p_block[p_reader->byte_pos]
+                         << (RE_SERIES_ACC_BITS - RE_SERIES_BITS_IN_BYTE - p_reader->acc_bits);
+        p_reader->byte_pos++;
+        p_reader->acc_bits = (uint8_t) (p_reader->acc_bits + RE_SERIES_BITS_IN_BYTE);
+    }
+
+    if (num_bits > p_reader->acc_bits)
+    {
+        ok = false;
+    }
+    else if (0U == num_bits)
+    {
+        *p_bits = 0U;
+    }
+    else
+    {
+        *p_bits = p_reader->acc >> (RE_SERIES_ACC_BITS - num_bits);
+        p_reader->acc <<= num_bits;
+        p_reader->acc_bits = (uint8_t) (p_reader->acc_bits - num_bits);
+    }
+
+    return ok;
+}
+
+/**
+ * @brief Count prefix ones, stopping at a zero or at max_ones.
+ */
+static bool re_series_get_prefix (re_series_reader_t * const p_reader, const uint8_t max_ones,
+                                  uint8_t * const p_ones)
+{
+    bool ok = true;
+    bool done = false;
+    uint8_t ones = 0;
+
+    while (ok && (!done) && (ones < max_ones))
+    {
+        uint64_t bit = 0;
+        ok = re_series_get_bits (p_reader, 1U, &bit);
+
+        if (0U == bit)
+        {
+            done = true;
+        }
+        else
+        {
+            ones++;
+        }
+    }
+
+    *p_ones = ones;
+    return ok;
+}
+
+re_status_t re_series_decode (const uint8_t * const p_block, const size_t block_len,
+                              uint32_t * const p_timestamps, re_float * const p_values,
+                              const size_t max_samples, size_t * const p_num_samples)
+{
+    re_status_t result = RE_SUCCESS;
+    size_t num_decoded = 0;
+
+    if ( (NULL == p_block) || (NULL == p_timestamps) || (NULL == p_values)
+            || (NULL == p_num_samples))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (block_len < RE_SERIES_HEADER_LEN)
+    {
+        result |= RE_ERROR_DECODING_LEN;
+    }
+    else
+    {
+        const size_t num_samples = re_series_num_samples (p_block, block_len);
+        const size_t num_out = (num_samples > max_samples) ? max_samples : num_samples;
+        const uint32_t resolution_bits =
+            re_series_read_u32 (&p_block[RE_SERIES_RESOLUTION_IDX]);
+        const int32_t first =
+            (int32_t) re_series_read_u32 (&p_block[RE_SERIES_VALUE_MSB_IDX]);
+        re_series_reader_t reader = { p_block, block_len, RE_SERIES_HEADER_LEN, 0U, 0U };
+        uint32_t timestamp = re_series_read_u32 (&p_block[RE_SERIES_TS_MSB_IDX]);
+        int64_t interval = 0;
+        int64_t value = (RE_SERIES_INVALID == first) ? 0 : first;
+        float resolution = 0.0F;
+        bool ok = true;
+        memcpy (&resolution, &resolution_bits, sizeof (resolution));
+
+        if (num_samples > max_samples)
+        {
+            result |= RE_ERROR_DATA_SIZE;
+        }
+
+        if (0U != num_out)
+        {
+            p_timestamps[0] = timestamp;
+            p_values[0] = (RE_SERIES_INVALID == first) ? NAN : (re_float) value * resolution;
+            num_decoded = 1U;
+        }
+
+        while (ok && (num_decoded < num_out))
+        {
+            uint8_t ones = 0;
+            uint64_t bits = 0;
+            ok = re_series_get_prefix (&reader, RE_SERIES_NUM_TS_CODES - 1U, &ones)
+                 && re_series_get_bits (&reader, m_ts_codes[ones].num_bits, &bits);
+            interval += re_series_unzigzag (bits);
+            timestamp = (uint32_t) ( (int64_t) timestamp + interval);
+            ok = ok && re_series_get_prefix (&reader, RE_SERIES_VALUE_INVALID_PREFIX, &ones);
+
+            if (ok && (RE_SERIES_VALUE_INVALID_PREFIX == ones))
+            {
+                p_values[num_decoded] = NAN;
+            }
+            else
+            {
+                ok = ok && re_series_get_bits (&reader, m_value_codes[ones].num_bits, &bits);
+                value += re_series_unzigzag (bits);
+                p_values[num_decoded] = (re_float) value * resolution;
+            }
+
+            if (ok)
+            {
+                p_timestamps[num_decoded] = timestamp;
+                num_decoded++;
+            }
+            else
+            {
+                result |= RE_ERROR_DECODING_LEN;
+            }
+        }
+    }
+
+    if (NULL != p_num_samples)
+    {
+        *p_num_samples = num_decoded;
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * Ruuvi Endpoints compressed time series blocks.
+ *
+ * Stores samples of one value of one tag, e.g. DF5 temperature, in a block
+ * of caller memory. Values are quantized to integer steps of a resolution,
+ * e.g. the 0.005 C of DF5 temperature, so that the change between samples is
+ * a small integer. As in Gorilla (Pelkonen et al., VLDB 2015) the timestamp
+ * is stored as delta-of-delta and both are written as variable-length bit
+ * codes. Samples at a steady interval with unchanged value take 2 bits,
+ * slowly changing values typically 1-2 bytes, against 8 bytes of raw data.
+ *
+ * Blocks are self-contained and byte order independent, they can be kept in
+ * memory or written to disk as they are.
+ *
+ * Block layout:
+ *  0-1   Number of samples
+ *  2-5   Timestamp of first sample
+ *  6-9   Quantized value of first sample, i32, RE_SERIES_INVALID if NaN
+ *  10-13 Resolution, IEEE 754 float
+ *  14-   Bit stream of following samples, MSB first
+ *
+ * Timestamp delta-of-delta, zigzag coded:
+ *  0         Zero
+ *  10   +7   Up to +-63
+ *  110  +9   Up to +-255
+ *  1110 +12  Up to +-2047
+ *  1111 +34  Any
+ *
+ * Value delta from last valid value, zigzag coded:
+ *  0          Unchanged
+ *  10    +4   Up to +-7 steps
+ *  110   +8   Up to +-127 steps
+ *  1110  +16  Up to +-32767 steps
+ *  11110 +33  Any
+ *  11111      Invalid value, NaN
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_SERIES_H
+#define RUUVI_ENDPOINTS_SERIES_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_SERIES_NUM_SAMPLES_IDX (0U)        //!< MSB of number of samples.
+#define RE_SERIES_TS_MSB_IDX      (2U)        //!< MSB of first timestamp.
+#define RE_SERIES_VALUE_MSB_IDX   (6U)        //!< MSB of first value.
+#define RE_SERIES_RESOLUTION_IDX  (10U)       //!< MSB of resolution.
+#define RE_SERIES_HEADER_LEN      (14U)       //!< Bytes before bit stream.
+#define RE_SERIES_MAX_SAMPLES     (0xFFFFU)   //!< Samples in one block at most.
+#define RE_SERIES_MAX_SAMPLE_BITS (76U)       //!< Bits of one sample at most.
+#define RE_SERIES_INVALID         (INT32_MIN) //!< Quantized value of NaN.
+
+/** @brief State of a block being encoded. */
+typedef struct
+{
+    uint8_t * p_block;     //!< Block.
+    size_t block_len;      //!< Size of block buffer.
+    size_t length;         //!< Bytes of block used.
+    size_t bit_pos;        //!< Next bit of bit stream.
+    uint16_t num_samples;  //!< Samples in block.
+    uint32_t timestamp;    //!< Timestamp of previous sample.
+    int64_t interval;      //!< Timestamp delta of previous sample.
+    int32_t value;         //!< Last valid quantized value.
+    re_float resolution;   //!< Value of one quantization step.
+} re_series_encoder_t;
+
+/**
+ * @brief Start an empty block.
+ *
+ * @param[out] p_enc Encoder state.
+ * @param[out] p_block Block buffer.
+ * @param[in]  block_len Size of block buffer, at least RE_SERIES_HEADER_LEN.
+ * @param[in]  resolution Value of one quantization step, e.g. 0.005 for DF5 temperature.
+ * @retval RE_SUCCESS if block was started.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if resolution is not a positive number.
+ * @retval RE_ERROR_DATA_SIZE if buffer is too small for the header.
+ */
+re_status_t re_series_encode_start (re_series_encoder_t * const p_enc,
+                                    uint8_t * const p_block,
+                                    const size_t block_len,
+                                    const re_float resolution);
+
+/**
+ * @brief Append a quantized sample to a block.
+ *
+ * Use when the coded value of the payload is at hand, e.g. the raw i16 of
+ * DF5 temperature with resolution 0.005. Block is not modified if the sample
+ * cannot be appended.
+ *
+ * @param[in,out] p_enc Started encoder.
+ * @param[in]     timestamp Time of sample in caller's units, e.g. seconds.
+ * @param[in]     value Quantized value, RE_SERIES_INVALID for a missing value.
+ * @retval RE_SUCCESS if sample was appended.
+ * @retval RE_ERROR_NULL if p_enc is NULL.
+ * @retval RE_ERROR_DATA_SIZE if block is full, start a new one.
+ */
+re_status_t re_series_encode_coded (re_series_encoder_t * const p_enc,
+                                    const uint32_t timestamp,
+                                    const int32_t value);
+
+/**
+ * @brief Quantize a decoded value and append it to a block.
+ *
+ * @param[in,out] p_enc Started encoder.
+ * @param[in]     timestamp Time of sample in caller's units, e.g. seconds.
+ * @param[in]     value Decoded value, NaN is stored as a missing value.
+ * @retval RE_SUCCESS if sample was appended.
+ * @retval RE_ERROR_NULL if p_enc is NULL.
+ * @retval RE_ERROR_ENCODING if value is out of range of resolution.
+ * @retval RE_ERROR_DATA_SIZE if block is full, start a new one.
+ */
+re_status_t re_series_encode_value (re_series_encoder_t * const p_enc,
+                                    const uint32_t timestamp,
+                                    const re_float value);
+
+/**
+ * @brief Get number of samples in a block.
+ *
+ * @param[in] p_block Block.
+ * @param[in] block_len Bytes of block.
+ * @return Number of samples, 0 if block is shorter than header.
+ */
+size_t re_series_num_samples (const uint8_t * const p_block, const size_t block_len);
+
+/**
+ * @brief Decode all samples of a block.
+ *
+ * Decodes in one pass into caller arrays, quantized values are scaled back
+ * by the resolution of the block.
+ *
+ * @param[in]  p_block Block.
+ * @param[in]  block_len Bytes of block.
+ * @param[out] p_timestamps Timestamps of samples.
+ * @param[out] p_values Values of samples, NaN for missing values.
+ * @param[in]  max_samples Size of output arrays.
+ * @param[out] p_num_samples Number of decoded samples.
+ * @retval RE_SUCCESS if all samples were decoded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if block has more than max_samples samples,
+ *                            first max_samples are decoded.
+ * @retval RE_ERROR_DECODING_LEN if block is truncated, samples before the
+ *                               cut are decoded.
+ */
+re_status_t re_series_decode (const uint8_t * const p_block, const size_t block_len,
+                              uint32_t * const p_timestamps, re_float * const p_values,
+                              const size_t max_samples, size_t * const p_num_samples);
+
+#endif // RUUVI_ENDPOINTS_SERIES_H
@@ -0,0 +1,149 @@
+/**
+ * Ruuvi Endpoints decode telemetry.
+ *
+ * Counters of decoded and rejected frames, broken down by error bit,
+ * command and data format. Counters are plain increments so that they can be
+ * left enabled in production builds. Every function accepts a NULL context
+ * and does nothing in that case, callers can pass the statistics pointer
+ * unconditionally.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_STATS_H
+#define RUUVI_ENDPOINTS_STATS_H
+
+#include "ruuvi_endpoints.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define RE_STATS_ERROR_BITS   (32U)  //!< One counter per bit of re_status_t.
+#define RE_STATS_CMD_SLOTS    (64U)  //!< Commands above last slot are counted in last slot.
+#define RE_STATS_FORMAT_SLOTS (256U) //!< One counter per data format header byte.
+
+/** @brief Decode telemetry of a single stream. */
+typedef struct
+{
+    uint32_t frames_ok;                             //!< Frames decoded successfully.
+    uint32_t frames_failed;                         //!< Frames rejected by decoder.
+    uint32_t bytes_discarded;                       //!< Bytes skipped while resynchronizing.
+    uint32_t error_bits[RE_STATS_ERROR_BITS];       //!< Occurrences of each error bit.
+    uint32_t cmd_ok[RE_STATS_CMD_SLOTS];            //!< Decoded frames per command.
+    uint32_t cmd_failed[RE_STATS_CMD_SLOTS];        //!< Rejected frames per command.
+    uint32_t format_ok[RE_STATS_FORMAT_SLOTS];      //!< Decoded payloads per data format.
+    uint32_t format_failed[RE_STATS_FORMAT_SLOTS];  //!< Rejected payloads per data format.
+} re_stats_t;
+
+/**
+ * @brief Reset all counters to zero.
+ *
+ * @param[out] p_stats Statistics to reset, may be NULL.
+ */
+static inline void re_stats_init (re_stats_t * const p_stats)
+{
+    if (NULL != p_stats)
+    {
+        memset (p_stats, 0, sizeof (*p_stats));
+    }
+}
+
+/**
+ * @brief Count each set bit of given status code.
+ *
+ * @param[in,out] p_stats Statistics to update, may be NULL.
+ * @param[in]     status Status code returned by a decoder.
+ */
+static inline void re_stats_record_error (re_stats_t * const p_stats,
+        const re_status_t status)
+{
+    if (NULL != p_stats)
+    {
+        re_status_t remaining = status;
+        uint8_t bit = 0;
+
+        while (0U != remaining)
+        {
+            if (0U != (remaining & RE_BIT1_MASK))
+            {
+                p_stats->error_bits[bit]++;
+            }
+
+            remaining >>= 1U;
+            bit++;
+        }
+    }
+}
+
+/**
+ * @brief Record the result of decoding one transport frame.
+ *
+ * @param[in,out] p_stats Statistics to update, may be NULL.
+ * @param[in]     cmd Command byte of the frame.
+ * @param[in]     status Status code returned by the frame decoder.
+ */
+static inline void re_stats_record_frame (re_stats_t * const p_stats, const uint8_t cmd,
+        const re_status_t status)
+{
+    if (NULL != p_stats)
+    {
+        const uint8_t slot = (cmd < RE_STATS_CMD_SLOTS) ? cmd : (RE_STATS_CMD_SLOTS - 1U);
+
+        if (RE_SUCCESS == status)
+        {
+            p_stats->frames_ok++;
+            p_stats->cmd_ok[slot]++;
+        }
+        else
+        {
+            p_stats->frames_failed++;
+            p_stats->cmd_failed[slot]++;
+            re_stats_record_error (p_stats, status);
+        }
+    }
+}
+
+/**
+ * @brief Record the result of decoding one data format payload.
+ *
+ * The ingest pipeline records every report of a known format per shard.
+ *
+ * @param[in,out] p_stats Statistics to update, may be NULL.
+ * @param[in]     format Data format header byte, e.g. RE_5_DESTINATION.
+ * @param[in]     status Status code returned by the data format decoder.
+ */
+static inline void re_stats_record_format (re_stats_t * const p_stats,
+        const uint8_t format, const re_status_t status)
+{
+    if (NULL != p_stats)
+    {
+        if (RE_SUCCESS == status)
+        {
+            p_stats->format_ok[format]++;
+        }
+        else
+        {
+            p_stats->format_failed[format]++;
+            re_stats_record_error (p_stats, status);
+        }
+    }
+}
+
+/**
+ * @brief Record bytes skipped while searching for the start of the next frame.
+ *
+ * Called by @ref re_ca_uart_resync.
+ *
+ * @param[in,out] p_stats Statistics to update, may be NULL.
+ * @param[in]     num_bytes Number of discarded bytes.
+ */
+static inline void re_stats_record_discarded (re_stats_t * const p_stats,
+        const size_t num_bytes)
+{
+    if (NULL != p_stats)
+    {
+        p_stats->bytes_discarded += (uint32_t) num_bytes;
+    }
+}
+
+#endif // RUUVI_ENDPOINTS_STATS_H
@@ -0,0 +1,294 @@
+#include "ruuvi_endpoints_tag_table.h"
+#include "ruuvi_endpoints_internal.h"
+#include <string.h>
+
+#if RE_TAG_TABLE_ENABLED
+
+#define RE_TAG_TABLE_MIN_CAPACITY (4U)
+
+_Static_assert (sizeof (re_tag_table_slot_t) == RE_TAG_TABLE_SLOT_SIZE,
+                "Tag table slot must fill exactly one cache line");
+
+static size_t re_tag_table_max_count (const re_tag_table_t * const p_table)
+{
+    return p_table->capacity - (p_table->capacity >> 2U);
+}
+
+/**
+ * @brief Find slot of given MAC or the empty slot that ends its probe sequence.
+ */
+static size_t re_tag_table_probe (const re_tag_table_t * const p_table, const uint64_t mac)
+{
+    const size_t mask = p_table->capacity - 1U;
+    size_t slot = re_mac_home_slot (mac, p_table->capacity);
+
+    // Load factor is capped below 1, there always is an empty slot.
+    while ( (RE_TAG_TABLE_EMPTY != p_table->p_slots[slot].mac)
+            && (mac != p_table->p_slots[slot].mac))
+    {
+        slot = (slot + 1U) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Empty a slot, moving later entries of the cluster back into it.
+ */
+static void re_tag_table_remove_slot (re_tag_table_t * const p_table, size_t hole)
+{
+    const size_t mask = p_table->capacity - 1U;
+    re_tag_table_slot_t * const p_slots = p_table->p_slots;
+    size_t next = (hole + 1U) & mask;
+
+    // Backward shift: move later entries of the cluster into the hole
+    // if their home slot does not lie cyclically between hole and entry.
+    while (RE_TAG_TABLE_EMPTY != p_slots[next].mac)
+    {
+        const size_t home = re_mac_home_slot (p_slots[next].mac, p_table->capacity);
+
+        if ( ( (next - home) & mask) >= ( (next - hole) & mask))
+        {
+            memcpy (&p_slots[hole], &p_slots[next], sizeof (re_tag_table_slot_t));
+            hole = next;
+        }
+
+        next = (next + 1U) & mask;
+    }
+
+    memset (&p_slots[hole], 0, sizeof (re_tag_table_slot_t));
+    p_slots[hole].mac = RE_TAG_TABLE_EMPTY;
+    p_table->count--;
+}
+
+re_status_t re_tag_table_init (re_tag_table_t * const p_table,
+                               re_tag_table_slot_t * const p_slots,
+                               const size_t capacity)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_table) || (NULL == p_slots))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (capacity < RE_TAG_TABLE_MIN_CAPACITY)
+              || (0U != (capacity & (capacity - 1U))))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        p_table->p_slots = p_slots;
+        p_table->capacity = capacity;
+        p_table->count = 0;
+        memset (p_slots, 0, capacity * sizeof (re_tag_table_slot_t));
+
+        for (size_t ii = 0; ii < capacity; ii++)
+        {
+            p_slots[ii].mac = RE_TAG_TABLE_EMPTY;
+        }
+    }
+
+    return result;
+}
+
+re_tag_table_slot_t * re_tag_table_find (const re_tag_table_t * const p_table,
+        const uint64_t mac)
+{
+    re_tag_table_slot_t * p_slot = NULL;
+
+    if ( (NULL != p_table) && (0U == (mac & ~RE_TAG_TABLE_MAC_MASK)))
+    {
+        const size_t slot = re_tag_table_probe (p_table, mac);
+
+        if (mac == p_table->p_slots[slot].mac)
+        {
+            p_slot = &p_table->p_slots[slot];
+        }
+    }
+
+    return p_slot;
+}
+
+re_status_t re_tag_table_upsert (re_tag_table_t * const p_table,
+                                 const uint64_t mac,
+                                 const uint32_t now,
+                                 re_tag_table_slot_t ** const pp_slot,
+                                 bool * const p_is_new)
+{
+    re_status_t result = RE_SUCCESS;
+    bool is_new = false;
+
+    if ( (NULL == p_table) || (NULL == pp_slot))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (0U != (mac & ~RE_TAG_TABLE_MAC_MASK))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const size_t slot = re_tag_table_probe (p_table, mac);
+        re_tag_table_slot_t * const p_slot = &p_table->p_slots[slot];
+        is_new = (RE_TAG_TABLE_EMPTY == p_slot->mac);
+
+        if (is_new && (p_table->count >= re_tag_table_max_count (p_table)))
+        {
+            is_new = false;
+            result |= RE_ERROR_DATA_SIZE;
+        }
+        else
+        {
+            if (is_new)
+            {
+                memset (p_slot, 0, sizeof (re_tag_table_slot_t));
+                p_slot->mac = mac;
+                p_table->count++;
+            }
+
+            p_slot->last_seen = now;
+            *pp_slot = p_slot;
+        }
+    }
+
+    if (NULL != p_is_new)
+    {
+        *p_is_new = is_new;
+    }
+
+    return result;
+}
+
+re_status_t re_tag_table_store_payload (re_tag_table_slot_t * const p_slot,
+                                        const uint8_t * const p_payload,
+                                        const size_t payload_len)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if ( (NULL == p_slot) || (NULL == p_payload))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U == payload_len) || (payload_len > RE_TAG_TABLE_PAYLOAD_SIZE))
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        memcpy (p_slot->payload, p_payload, payload_len);
+        p_slot->payload_len = (uint8_t) payload_len;
+        p_slot->data_format = p_payload[0];
+    }
+
+    return result;
+}
+
+re_status_t re_tag_table_observe (re_tag_table_t * const p_table,
+                                  const uint64_t mac,
+                                  const uint32_t now,
+                                  const uint8_t * const p_payload,
+                                  const size_t payload_len,
+                                  const int8_t rssi,
+                                  re_tag_table_slot_t ** const pp_slot,
+                                  bool * const p_changed)
+{
+    re_status_t result = RE_SUCCESS;
+    re_tag_table_slot_t * p_slot = NULL;
+    bool changed = false;
+
+    if ( (NULL == p_payload) || (NULL == pp_slot) || (NULL == p_changed))
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if ( (0U == payload_len) || (payload_len > RE_TAG_TABLE_PAYLOAD_SIZE))
+    {
+        result |= RE_ERROR_DATA_SIZE;
+    }
+    else
+    {
+        result |= re_tag_table_upsert (p_table, mac, now, &p_slot, NULL);
+    }
+
+    if (RE_SUCCESS == result)
+    {
+        // A new slot has payload_len 0 and never matches.
+        changed = (payload_len != p_slot->payload_len)
+                  || (0 != memcmp (p_slot->payload, p_payload, payload_len));
+
+        if (changed)
+        {
+            result |= re_tag_table_store_payload (p_slot, p_payload, payload_len);
+        }
+
+        p_slot->rssi = rssi;
+        *pp_slot = p_slot;
+    }
+
+    if (NULL != p_changed)
+    {
+        *p_changed = changed;
+    }
+
+    return result;
+}
+
+re_status_t re_tag_table_remove (re_tag_table_t * const p_table, const uint64_t mac)
+{
+    re_status_t result = RE_SUCCESS;
+
+    if (NULL == p_table)
+    {
+        result |= RE_ERROR_NULL;
+    }
+    else if (0U != (mac & ~RE_TAG_TABLE_MAC_MASK))
+    {
+        result |= RE_ERROR_INVALID_PARAM;
+    }
+    else
+    {
+        const size_t slot = re_tag_table_probe (p_table, mac);
+
+        if (mac != p_table->p_slots[slot].mac)
+        {
+            result |= RE_ERROR_INVALID_PARAM;
+        }
+        else
+        {
+            re_tag_table_remove_slot (p_table, slot);
+        }
+    }
+
+    return result;
+}
+
+size_t re_tag_table_evict (re_tag_table_t * const p_table, const uint32_t oldest)
+{
+    size_t num_evicted = 0;
+
+    if (NULL != p_table)
+    {
+        size_t slot = 0;
+
+        while (slot < p_table->capacity)
+        {
+            const re_tag_table_slot_t * const p_slot = &p_table->p_slots[slot];
+
+            if ( (RE_TAG_TABLE_EMPTY != p_slot->mac)
+                    && ( (int32_t) (p_slot->last_seen - oldest) < 0))
+            {
+                // Backward shift may move a later entry here, check slot again.
+                re_tag_table_remove_slot (p_table, slot);
+                num_evicted++;
+            }
+            else
+            {
+                slot++;
+            }
+        }
+    }
+
+    return num_evicted;
+}
+
+#endif
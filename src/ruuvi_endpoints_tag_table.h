@@ -0,0 +1,174 @@
+/**
+ * Ruuvi Endpoints per-tag state table.
+ *
+ * Open-addressing hash table from 48-bit BLE MAC address to the latest state
+ * of a tag: raw payload, measurement sequence counter, RSSI and time of last
+ * update. It replaces the map every gateway integration builds around the
+ * decoders.
+ *
+ * Each slot is one 64-byte cache line holding the MAC and the state, so a
+ * lookup usually touches a single line. As in @ref re_keystore_t, storage is
+ * provided by the caller, lookups use linear probing and removal uses
+ * backward shift. Nothing is allocated after init and tags that have not been
+ * seen for a while are dropped with a periodic sweep, @ref re_tag_table_evict.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_TAG_TABLE_H
+#define RUUVI_ENDPOINTS_TAG_TABLE_H
+
+#include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_TAG_TABLE_SLOT_SIZE    (64U)                  //!< Bytes of a slot, one cache line.
+#define RE_TAG_TABLE_PAYLOAD_SIZE (44U)                  //!< Bytes of raw payload kept per tag.
+#define RE_TAG_TABLE_MAC_MASK     (0xFFFFFFFFFFFFU)      //!< Valid bits of a MAC address.
+#define RE_TAG_TABLE_EMPTY        (0xFFFFFFFFFFFFFFFFU)  //!< Marks an unused slot.
+
+/** @brief State of a single tag, one slot of the table. */
+typedef struct
+{
+    uint64_t mac;          //!< MAC address, RE_TAG_TABLE_EMPTY if slot is unused.
+    uint32_t last_seen;    //!< Time of last update, in caller's units, e.g. seconds.
+    uint32_t sequence;     //!< Last measurement sequence counter.
+    uint8_t payload_len;   //!< Bytes of payload, 0 if none stored.
+    uint8_t data_format;   //!< Data format of payload.
+    int8_t rssi;           //!< RSSI of last update in dBm.
+    uint8_t flags;         //!< Free for the caller.
+    uint8_t payload[RE_TAG_TABLE_PAYLOAD_SIZE]; //!< Raw payload of last update.
+} re_tag_table_slot_t;
+
+/** @brief Tag table state. */
+typedef struct
+{
+    re_tag_table_slot_t * p_slots; //!< Capacity slots.
+    size_t capacity;               //!< Number of slots, power of two.
+    size_t count;                  //!< Number of stored tags.
+} re_tag_table_t;
+
+/**
+ * @brief Initialize an empty tag table on caller-provided storage.
+ *
+ * At most 3/4 of the slots are used to keep probe sequences short, size the
+ * storage accordingly. Align storage to RE_TAG_TABLE_SLOT_SIZE so that each
+ * slot is a single cache line.
+ *
+ * @param[out] p_table Table to initialize.
+ * @param[in]  p_slots Array of capacity slots.
+ * @param[in]  capacity Number of slots, power of two and at least 4.
+ * @retval RE_SUCCESS if table was initialized.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if capacity is not a power of two or less than 4.
+ */
+re_status_t re_tag_table_init (re_tag_table_t * const p_table,
+                               re_tag_table_slot_t * const p_slots,
+                               const size_t capacity);
+
+/**
+ * @brief Find the state of a tag.
+ *
+ * Returned pointer stays valid until a tag is removed or evicted.
+ *
+ * @param[in] p_table Tag table.
+ * @param[in] mac 48-bit MAC address of the tag.
+ * @return Pointer to slot of the tag, NULL if the tag is unknown or p_table is NULL.
+ */
+re_tag_table_slot_t * re_tag_table_find (const re_tag_table_t * const p_table,
+        const uint64_t mac);
+
+/**
+ * @brief Find the state of a tag, adding the tag if it is unknown.
+ *
+ * A new slot has no payload and sequence and RSSI of 0. last_seen of the slot
+ * is set to now in both cases.
+ *
+ * @param[in,out] p_table Tag table.
+ * @param[in]     mac 48-bit MAC address of the tag.
+ * @param[in]     now Current time, in the units used for @ref re_tag_table_evict.
+ * @param[out]    pp_slot Slot of the tag.
+ * @param[out]    p_is_new True if the tag was added, may be NULL.
+ * @retval RE_SUCCESS if slot was found or added.
+ * @retval RE_ERROR_NULL if p_table or pp_slot is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if mac has bits above 48.
+ * @retval RE_ERROR_DATA_SIZE if the tag is unknown and the table is full.
+ */
+re_status_t re_tag_table_upsert (re_tag_table_t * const p_table,
+                                 const uint64_t mac,
+                                 const uint32_t now,
+                                 re_tag_table_slot_t ** const pp_slot,
+                                 bool * const p_is_new);
+
+/**
+ * @brief Store the raw payload of an update in the slot of a tag.
+ *
+ * @param[in,out] p_slot Slot of the tag.
+ * @param[in]     p_payload Raw payload, first byte is the data format.
+ * @param[in]     payload_len Bytes of payload, at most RE_TAG_TABLE_PAYLOAD_SIZE.
+ * @retval RE_SUCCESS if payload was stored.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_DATA_SIZE if payload is empty or does not fit, slot is not modified.
+ */
+re_status_t re_tag_table_store_payload (re_tag_table_slot_t * const p_slot,
+                                        const uint8_t * const p_payload,
+                                        const size_t payload_len);
+
+/**
+ * @brief Record an update of a tag and tell if its payload changed.
+ *
+ * Tags repeat an unchanged payload many times between measurements. The
+ * payload is compared with the stored payload of the tag, so the common case
+ * of a repeat costs one lookup and one compare and the caller can skip
+ * decoding it. RSSI is not part of the payload, it is updated in both cases.
+ *
+ * @param[in,out] p_table Tag table.
+ * @param[in]     mac 48-bit MAC address of the tag.
+ * @param[in]     now Current time, in the units used for @ref re_tag_table_evict.
+ * @param[in]     p_payload Raw payload, first byte is the data format.
+ * @param[in]     payload_len Bytes of payload, at most RE_TAG_TABLE_PAYLOAD_SIZE.
+ * @param[in]     rssi RSSI of the update in dBm.
+ * @param[out]    pp_slot Slot of the tag.
+ * @param[out]    p_changed True if the tag is new or payload differs from stored payload.
+ * @retval RE_SUCCESS if update was recorded.
+ * @retval RE_ERROR_NULL if any of the pointers is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if mac has bits above 48.
+ * @retval RE_ERROR_DATA_SIZE if payload is empty or does not fit or the tag
+ *                            is unknown and the table is full.
+ */
+re_status_t re_tag_table_observe (re_tag_table_t * const p_table,
+                                  const uint64_t mac,
+                                  const uint32_t now,
+                                  const uint8_t * const p_payload,
+                                  const size_t payload_len,
+                                  const int8_t rssi,
+                                  re_tag_table_slot_t ** const pp_slot,
+                                  bool * const p_changed);
+
+/**
+ * @brief Remove a tag.
+ *
+ * @param[in,out] p_table Tag table.
+ * @param[in]     mac 48-bit MAC address of the tag.
+ * @retval RE_SUCCESS if the tag was removed.
+ * @retval RE_ERROR_NULL if p_table is NULL.
+ * @retval RE_ERROR_INVALID_PARAM if the tag is unknown.
+ */
+re_status_t re_tag_table_remove (re_tag_table_t * const p_table, const uint64_t mac);
+
+/**
+ * @brief Remove every tag last seen before given time.
+ *
+ * Run periodically, e.g. once a minute with the time of the oldest update
+ * still of interest. Times are compared with wraparound, so 32-bit seconds
+ * or epoch counters may overflow as long as tags are evicted within 2^31
+ * units.
+ *
+ * @param[in,out] p_table Tag table.
+ * @param[in]     oldest Tags with last_seen before this are removed.
+ * @return Number of removed tags, 0 if p_table is NULL.
+ */
+size_t re_tag_table_evict (re_tag_table_t * const p_table, const uint32_t oldest);
+
+#endif // RUUVI_ENDPOINTS_TAG_TABLE_H
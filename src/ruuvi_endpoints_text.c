@@ -0,0 +1,341 @@
+#include "ruuvi_endpoints_text.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+#include <math.h>
+#include <string.h>
+
+#if RE_TEXT_ENABLED
+
+#define RE_TEXT_MAX_DECIMALS (6U)
+#define RE_TEXT_FIXED_LIMIT  (1e15)         //!< Scaled values above this are not printed.
+#define RE_TEXT_NO_INVALID   (UINT64_MAX)   //!< Field has no invalid marker.
+#define RE_TEXT_DIGITS_LEN   (20U)          //!< Decimal digits of UINT64_MAX.
+#define RE_TEXT_DECIMAL_BASE (10U)
+
+#define RE_TEXT_FIELD(key, data_t, member, type, decimals, invalid) \
+    { (key), sizeof (key) - 1U, (type), (decimals), offsetof (data_t, member), (invalid) }
+
+static const re_text_field_t m_fields_5[] =
+{
+    RE_TEXT_FIELD ("temperature", re_5_data_t, temperature_c, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("humidity", re_5_data_t, humidity_rh, RE_TEXT_FLOAT, 4U, 0U),
+    RE_TEXT_FIELD ("pressure", re_5_data_t, pressure_pa, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("accelX", re_5_data_t, accelerationx_g, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("accelY", re_5_data_t, accelerationy_g, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("accelZ", re_5_data_t, accelerationz_g, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("voltage", re_5_data_t, battery_v, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("txPower", re_5_data_t, tx_power, RE_TEXT_I8, 0U, RE_5_INVALID_POWER),
+    RE_TEXT_FIELD ("movementCounter", re_5_data_t, movement_count, RE_TEXT_U8, 0U,
+                   RE_5_INVALID_MOVEMENT),
+    RE_TEXT_FIELD ("measurementSequenceNumber", re_5_data_t, measurement_count,
+                   RE_TEXT_U16, 0U, RE_5_INVALID_SEQUENCE),
+    RE_TEXT_FIELD ("mac", re_5_data_t, address, RE_TEXT_MAC48, 0U, RE_5_INVALID_MAC)
+};
+
+static const re_text_field_t m_fields_6[] =
+{
+    RE_TEXT_FIELD ("temperature", re_6_data_t, temperature_c, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("humidity", re_6_data_t, humidity_rh, RE_TEXT_FLOAT, 4U, 0U),
+    RE_TEXT_FIELD ("pressure", re_6_data_t, pressure_pa, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("pm2p5", re_6_data_t, pm2p5_ppm, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("co2", re_6_data_t, co2, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("voc", re_6_data_t, voc, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("nox", re_6_data_t, nox, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("luminosity", re_6_data_t, luminosity, RE_TEXT_FLOAT, 2U, 0U),
+    RE_TEXT_FIELD ("soundAverage", re_6_data_t, sound_avg_dba, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("measurementSequenceNumber", re_6_data_t, seq_cnt2, RE_TEXT_U8, 0U,
+                   RE_TEXT_NO_INVALID)
+};
+
+static const re_text_field_t m_fields_7[] =
+{
+    RE_TEXT_FIELD ("temperature", re_7_data_t, temperature_c, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("humidity", re_7_data_t, humidity_rh, RE_TEXT_FLOAT, 4U, 0U),
+    RE_TEXT_FIELD ("pressure", re_7_data_t, pressure_pa, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("tiltX", re_7_data_t, tilt_x_deg, RE_TEXT_FLOAT, 2U, 0U),
+    RE_TEXT_FIELD ("tiltY", re_7_data_t, tilt_y_deg, RE_TEXT_FLOAT, 2U, 0U),
+    RE_TEXT_FIELD ("luminosity", re_7_data_t, luminosity_lux, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("colorTemperature", re_7_data_t, color_temp_k, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("voltage", re_7_data_t, battery_v, RE_TEXT_FLOAT, 2U, 0U),
+    RE_TEXT_FIELD ("motionIntensity", re_7_data_t, motion_intensity, RE_TEXT_U8, 0U,
+                   RE_7_INVALID_MOTION_INT),
+    RE_TEXT_FIELD ("movementCounter", re_7_data_t, motion_count, RE_TEXT_U8, 0U,
+                   RE_7_INVALID_MOTION_COUNT),
+    RE_TEXT_FIELD ("measurementSequenceNumber", re_7_data_t, sequence_counter,
+                   RE_TEXT_U8, 0U, RE_7_INVALID_SEQUENCE),
+    RE_TEXT_FIELD ("motionDetected", re_7_data_t, motion_detected, RE_TEXT_BOOL, 0U,
+                   RE_TEXT_NO_INVALID),
+    RE_TEXT_FIELD ("presenceDetected", re_7_data_t, presence_detected, RE_TEXT_BOOL, 0U,
+                   RE_TEXT_NO_INVALID),
+    RE_TEXT_FIELD ("mac", re_7_data_t, address, RE_TEXT_MAC24, 0U, RE_7_INVALID_MAC)
+};
+
+static const re_text_field_t m_fields_e1[] =
+{
+    RE_TEXT_FIELD ("temperature", re_e1_data_t, temperature_c, RE_TEXT_FLOAT, 3U, 0U),
+    RE_TEXT_FIELD ("humidity", re_e1_data_t, humidity_rh, RE_TEXT_FLOAT, 4U, 0U),
+    RE_TEXT_FIELD ("pressure", re_e1_data_t, pressure_pa, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("pm1p0", re_e1_data_t, pm1p0_ppm, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("pm2p5", re_e1_data_t, pm2p5_ppm, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("pm4p0", re_e1_data_t, pm4p0_ppm, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("pm10p0", re_e1_data_t, pm10p0_ppm, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("co2", re_e1_data_t, co2, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("voc", re_e1_data_t, voc, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("nox", re_e1_data_t, nox, RE_TEXT_FLOAT, 0U, 0U),
+    RE_TEXT_FIELD ("luminosity", re_e1_data_t, luminosity, RE_TEXT_FLOAT, 2U, 0U),
+    RE_TEXT_FIELD ("soundInstant", re_e1_data_t, sound_inst_dba, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("soundAverage", re_e1_data_t, sound_avg_dba, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("soundPeak", re_e1_data_t, sound_peak_spl_db, RE_TEXT_FLOAT, 1U, 0U),
+    RE_TEXT_FIELD ("measurementSequenceNumber", re_e1_data_t, seq_cnt, RE_TEXT_U32, 0U,
+                   RE_E1_INVALID_SEQUENCE),
+    RE_TEXT_FIELD ("mac", re_e1_data_t, address, RE_TEXT_MAC48, 0U, RE_E1_INVALID_MAC)
+};
+
+static const uint64_t m_pow10[RE_TEXT_MAX_DECIMALS + 1U] =
+{
+    1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U
+};
+
+static const char m_hex[] = "0123456789ABCDEF";
+
+const re_text_field_t * re_text_fields (const uint8_t data_format,
+                                        size_t * const p_num_fields,
+                                        size_t * const p_record_size)
+{
+    const re_text_field_t * p_fields = NULL;
+    size_t num_fields = 0;
+    size_t record_size = 0;
+
+    switch (data_format)
+    {
+        case RE_5_DESTINATION:
+            p_fields = m_fields_5;
+            num_fields = sizeof (m_fields_5) / sizeof (m_fields_5[0]);
+            record_size = sizeof (re_5_data_t);
+            break;
+
+        case RE_6_DESTINATION:
+            p_fields = m_fields_6;
+            num_fields = sizeof (m_fields_6) / sizeof (m_fields_6[0]);
+            record_size = sizeof (re_6_data_t);
+            break;
+
+        case RE_7_DESTINATION:
+            p_fields = m_fields_7;
+            num_fields = sizeof (m_fields_7) / sizeof (m_fields_7[0]);
+            record_size = sizeof (re_7_data_t);
+            break;
+
+        case RE_E1_DESTINATION:
+            p_fields = m_fields_e1;
+            num_fields = sizeof (m_fields_e1) / sizeof (m_fields_e1[0]);
+            record_size = sizeof (re_e1_data_t);
+            break;
+
+        default:
+            break;
+    }
+
+    if (NULL != p_num_fields)
+    {
+        *p_num_fields = num_fields;
+    }
+
+    if (NULL != p_record_size)
+    {
+        *p_record_size = record_size;
+    }
+
+    return p_fields;
+}
+
+void re_text_put (re_text_out_t * const p_out, const char * const p_str, const size_t len)
+{
+    // Keep one byte for terminating NUL.
+    if ( (!p_out->overflow) && (len < (p_out->size - p_out->pos)))
+    {
+        memcpy (&p_out->p_buf[p_out->pos], p_str, len);
+        p_out->pos += len;
+    }
+    else
+    {
+        p_out->overflow = true;
+    }
+}
+
+void re_text_put_char (re_text_out_t * const p_out, const char c)
+{
+    re_text_put (p_out, &c, 1U);
+}
+
+void re_text_put_uint (re_text_out_t * const p_out, uint64_t value, const size_t min_digits)
+{
+    char digits[RE_TEXT_DIGITS_LEN];
+    size_t num_digits = 0;
+
+    do
+    {
+        digits[RE_TEXT_DIGITS_LEN - 1U - num_digits] =
+            (char) ('0' + (value % RE_TEXT_DECIMAL_BASE));
+        value /= RE_TEXT_DECIMAL_BASE;
+        num_digits++;
+    } while ( (0U != value) || (num_digits < min_digits));
+
+    re_text_put (p_out, &digits[RE_TEXT_DIGITS_LEN - num_digits], num_digits);
+}
+
+void re_text_put_int (re_text_out_t * const p_out, const int64_t value)
+{
+    if (value < 0)
+    {
+        re_text_put_char (p_out, '-');
+        re_text_put_uint (p_out, 0U - (uint64_t) value, 1U);
+    }
+    else
+    {
+        re_text_put_uint (p_out, (uint64_t) value, 1U);
+    }
+}
+
+/**
+ * @brief Print a rounded fixed point value, dropping trailing zeros of fraction.
+ */
+static void re_text_put_fixed (re_text_out_t * const p_out, const int64_t scaled,
+                               const uint8_t decimals)
+{
+    const uint64_t magnitude = (scaled < 0) ? (0U - (uint64_t) scaled) : (uint64_t) scaled;
+    uint64_t fraction = magnitude % m_pow10[decimals];
+    size_t fraction_digits = decimals;
+
+    while ( (0U != fraction_digits) && (0U == (fraction % RE_TEXT_DECIMAL_BASE)))
+    {
+        fraction /= RE_TEXT_DECIMAL_BASE;
+        fraction_digits--;
+    }
+
+    if (scaled < 0)
+    {
+        re_text_put_char (p_out, '-');
+    }
+
+    re_text_put_uint (p_out, magnitude / m_pow10[decimals], 1U);
+
+    if (0U != fraction_digits)
+    {
+        re_text_put_char (p_out, '.');
+        re_text_put_uint (p_out, fraction, fraction_digits);
+    }
+}
+
+void re_text_put_mac (re_text_out_t * const p_out, const uint64_t mac, const size_t num_bytes)
+{
+    char text[RE_TEXT_MAC48_LEN + 1U];
+    size_t len = 0;
+
+    for (size_t ii = num_bytes; ii > 0U; ii--)
+    {
+        const uint8_t byte = (uint8_t) (mac >> ( (ii - 1U) * RE_BYTE_1_SHIFT));
+        text[len++] = m_hex[byte >> 4U];
+        text[len++] = m_hex[byte & 0x0FU];
+        text[len++] = ':';
+    }
+
+    // Drop separator after last byte.
+    re_text_put (p_out, text, len - 1U);
+}
+
+/**
+ * @brief Read an integer field of given type, widened to 64 bits.
+ */
+static uint64_t re_text_read_uint (const uint8_t * const p_field, const uint8_t type)
+{
+    uint64_t value = 0;
+
+    switch (type)
+    {
+        case RE_TEXT_U8:
+            value = * ( (const uint8_t *) p_field);
+            break;
+
+        case RE_TEXT_U16:
+            value = * ( (const uint16_t *) p_field);
+            break;
+
+        case RE_TEXT_U32:
+            value = * ( (const uint32_t *) p_field);
+            break;
+
+        case RE_TEXT_I8:
+            value = (uint8_t) * ( (const int8_t *) p_field);
+            break;
+
+        case RE_TEXT_BOOL:
+            value = * ( (const bool *) p_field) ? 1U : 0U;
+            break;
+
+        default:
+            value = * ( (const uint64_t *) p_field);
+            break;
+    }
+
+    return value;
+}
+
+bool re_text_put_value (re_text_out_t * const p_out, const re_text_field_t * const p_field,
+                        const void * const p_data)
+{
+    const uint8_t * const p_value = & ( (const uint8_t *) p_data) [p_field->offset];
+    bool valid = false;
+
+    if (RE_TEXT_FLOAT == p_field->type)
+    {
+        const double scaled = (double) * ( (const re_float *) p_value)
+                              * (double) m_pow10[p_field->decimals];
+
+        // NaN fails the comparison and is left out.
+        if (fabs (scaled) < RE_TEXT_FIXED_LIMIT)
+        {
+            re_text_put_fixed (p_out, (int64_t) llround (scaled), p_field->decimals);
+            valid = true;
+        }
+    }
+    else
+    {
+        const uint64_t value = re_text_read_uint (p_value, p_field->type);
+
+        if (value != p_field->invalid)
+        {
+            valid = true;
+
+            switch (p_field->type)
+            {
+                case RE_TEXT_I8:
+                    re_text_put_int (p_out, * ( (const int8_t *) p_value));
+                    break;
+
+                case RE_TEXT_BOOL:
+                    re_text_put (p_out, (0U != value) ? "true" : "false",
+                                 (0U != value) ? 4U : 5U);
+                    break;
+
+                case RE_TEXT_MAC48:
+                    re_text_put_mac (p_out, value, RE_TEXT_MAC48_BYTES);
+                    break;
+
+                case RE_TEXT_MAC24:
+                    re_text_put_mac (p_out, value, RE_TEXT_MAC24_BYTES);
+                    break;
+
+                default:
+                    re_text_put_uint (p_out, value, 1U);
+                    break;
+            }
+        }
+    }
+
+    return valid;
+}
+
+#endif
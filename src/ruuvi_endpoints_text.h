@@ -0,0 +1,114 @@
+/**
+ * Ruuvi Endpoints text formatting of decoded data.
+ *
+ * Shared by the JSON, line protocol and CSV writers. Describes the fields of
+ * decoded data of each format with a table and prints them into a caller
+ * buffer without allocating or calling printf. Floats are printed in fixed
+ * point at the resolution of the format, rounded with integer arithmetic,
+ * and trailing zeros are dropped.
+ *
+ * License: BSD-3
+ */
+
+#ifndef RUUVI_ENDPOINTS_TEXT_H
+#define RUUVI_ENDPOINTS_TEXT_H
+
+#include "ruuvi_endpoints.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RE_TEXT_MAC48_BYTES (6U)
+#define RE_TEXT_MAC24_BYTES (3U)
+#define RE_TEXT_MAC48_LEN   (17U) //!< Length of "AA:BB:CC:DD:EE:FF".
+
+/** @brief Type of a field in decoded data. */
+typedef enum
+{
+    RE_TEXT_FLOAT = 0, //!< re_float, printed with decimals, NaN is invalid.
+    RE_TEXT_U8,        //!< uint8_t.
+    RE_TEXT_U16,       //!< uint16_t.
+    RE_TEXT_U32,       //!< uint32_t.
+    RE_TEXT_I8,        //!< int8_t.
+    RE_TEXT_BOOL,      //!< bool, printed as true or false.
+    RE_TEXT_MAC48,     //!< uint64_t MAC address, printed as AA:BB:CC:DD:EE:FF.
+    RE_TEXT_MAC24      //!< uint64_t with lowest 24 bits of MAC, printed as DD:EE:FF.
+} re_text_type_t;
+
+/** @brief Description of a field of decoded data. */
+typedef struct
+{
+    const char * p_key;  //!< Name of field.
+    uint8_t key_len;     //!< Length of name.
+    uint8_t type;        //!< re_text_type_t of field.
+    uint8_t decimals;    //!< Decimals of RE_TEXT_FLOAT.
+    uint16_t offset;     //!< Offset of field in decoded data.
+    uint64_t invalid;    //!< Value of integer field that is not printed.
+} re_text_field_t;
+
+/** @brief Output position in a caller buffer. */
+typedef struct
+{
+    char * p_buf;   //!< Output buffer.
+    size_t size;    //!< Usable size of output buffer, one byte is kept for NUL.
+    size_t pos;     //!< Next character to write.
+    bool overflow;  //!< Set when something did not fit, nothing is written after.
+} re_text_out_t;
+
+/**
+ * @brief Get the field table of a data format.
+ *
+ * Tables cover formats 5, 6, 7 and E1. Flags of formats 6 and E1 and the MAC
+ * of format 6 are bit fields and not in the tables.
+ *
+ * @param[in]  data_format Data format, e.g. RE_5_DESTINATION.
+ * @param[out] p_num_fields Number of fields in table, 0 if format is not supported.
+ * @param[out] p_record_size Size of decoded data of format, e.g. sizeof (re_5_data_t).
+ * @return Table of fields, NULL if format is not supported.
+ */
+const re_text_field_t * re_text_fields (const uint8_t data_format,
+                                        size_t * const p_num_fields,
+                                        size_t * const p_record_size);
+
+/**
+ * @brief Append characters, marking overflow if they do not fit.
+ */
+void re_text_put (re_text_out_t * const p_out, const char * const p_str, const size_t len);
+
+/** @brief Append a character. */
+void re_text_put_char (re_text_out_t * const p_out, const char c);
+
+/**
+ * @brief Append an unsigned integer.
+ *
+ * @param[in,out] p_out Output.
+ * @param[in]     value Value to print.
+ * @param[in]     min_digits Value is padded with leading zeros to this many digits.
+ */
+void re_text_put_uint (re_text_out_t * const p_out, uint64_t value, const size_t min_digits);
+
+/** @brief Append a signed integer. */
+void re_text_put_int (re_text_out_t * const p_out, const int64_t value);
+
+/**
+ * @brief Append a MAC address as hex bytes separated by colons.
+ *
+ * @param[in,out] p_out Output.
+ * @param[in]     mac Address, least significant byte is printed last.
+ * @param[in]     num_bytes Number of bytes to print, e.g. RE_TEXT_MAC24_BYTES.
+ */
+void re_text_put_mac (re_text_out_t * const p_out, const uint64_t mac, const size_t num_bytes);
+
+/**
+ * @brief Append value of a field of decoded data.
+ *
+ * @param[in,out] p_out Output.
+ * @param[in]     p_field Field to print.
+ * @param[in]     p_data Decoded data the field belongs to.
+ * @return False if value is NaN, out of range or the invalid marker of the
+ *         field, nothing is written then.
+ */
+bool re_text_put_value (re_text_out_t * const p_out, const re_text_field_t * const p_field,
+                        const void * const p_data);
+
+#endif // RUUVI_ENDPOINTS_TEXT_H
@@ -2,6 +2,7 @@
 
 #include "ruuvi_endpoint_3.h"
 
+#include <math.h>
 #include <string.h>
 
 static const re_3_data_t m_re_3_data_ok =
@@ -190,3 +191,106 @@ void test_ruuvi_endpoint_3_get_invalid_data (void)
                  RE_3_INVALID_DATA == test_buffer[12] &&
                  RE_3_INVALID_DATA == test_buffer[13]);
 }
+
+void test_ruuvi_endpoint_3_decode_ok (void)
+{
+    uint8_t raw_buf[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_3_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    re_3_data_t decoded_data = {0};
+    TEST_ASSERT_TRUE (re_3_check_format (raw_buf));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_3_decode (raw_buf, &decoded_data));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.humidity_rh * 10.0f),
+                       lrintf (decoded_data.humidity_rh * 10.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.temperature_c * 100.0f),
+                       lrintf (decoded_data.temperature_c * 100.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.pressure_pa),
+                       lrintf (decoded_data.pressure_pa));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.accelerationx_g * 1000.0f),
+                       lrintf (decoded_data.accelerationx_g * 1000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.accelerationy_g * 1000.0f),
+                       lrintf (decoded_data.accelerationy_g * 1000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.accelerationz_g * 1000.0f),
+                       lrintf (decoded_data.accelerationz_g * 1000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.battery_v * 1000.0f),
+                       lrintf (decoded_data.battery_v * 1000.0f));
+}
+
+void test_ruuvi_endpoint_3_decode_negative_temperature (void)
+{
+    uint8_t raw_buf[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_3_OFFSET_PAYLOAD], min_data, sizeof (min_data));
+    re_3_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_3_decode (raw_buf, &decoded_data));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_min.temperature_c * 100.0f),
+                       lrintf (decoded_data.temperature_c * 100.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_min.accelerationx_g * 1000.0f),
+                       lrintf (decoded_data.accelerationx_g * 1000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_min.pressure_pa),
+                       lrintf (decoded_data.pressure_pa));
+}
+
+void test_ruuvi_endpoint_3_decode_fields_ignores_header (void)
+{
+    uint8_t payload[RE_3_DATA_LENGTH];
+    memcpy (payload, valid_data, sizeof (payload));
+    payload[RE_3_OFFSET_HEADER] = 0xFAU;
+    re_3_data_t decoded_data = {0};
+    re_3_decode_fields (payload, &decoded_data);
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.temperature_c * 100.0f),
+                       lrintf (decoded_data.temperature_c * 100.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.battery_v * 1000.0f),
+                       lrintf (decoded_data.battery_v * 1000.0f));
+}
+
+void test_ruuvi_endpoint_3_decode_wrong_header (void)
+{
+    uint8_t raw_buf[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04, 0x05};
+    re_3_data_t decoded_data = {0};
+    TEST_ASSERT_FALSE (re_3_check_format (raw_buf));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_3_decode (raw_buf, &decoded_data));
+}
+
+void test_ruuvi_endpoint_3_check_format_fail (void)
+{
+    const uint8_t raw_buf_len[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x1B, 0xFF, 0x99, 0x04, 0x03};
+    TEST_ASSERT_FALSE (re_3_check_format (raw_buf_len));
+    const uint8_t raw_buf_manufacturer_id[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x05, 0x03};
+    TEST_ASSERT_FALSE (re_3_check_format (raw_buf_manufacturer_id));
+    TEST_ASSERT_FALSE (re_3_check_format (NULL));
+}
+
+void test_ruuvi_endpoint_3_decode_checked (void)
+{
+    uint8_t raw_buf[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_3_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    re_3_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_3_decode_checked (raw_buf, sizeof (raw_buf),
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_3_decode_checked (raw_buf, sizeof (raw_buf) - 1U,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_3_decode_checked (NULL, sizeof (raw_buf),
+                       &decoded_data));
+}
+
+void test_ruuvi_endpoint_3_decode_batch (void)
+{
+    uint8_t raw_ok[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04};
+    uint8_t raw_max[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04};
+    const uint8_t raw_invalid[RE_3_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x11, 0xFF, 0x99, 0x04, 0x05};
+    memcpy (&raw_ok[RE_3_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    memcpy (&raw_max[RE_3_OFFSET_PAYLOAD], max_data, sizeof (max_data));
+    const uint8_t * const frames[] = {raw_ok, raw_invalid, raw_max};
+    re_3_data_t decoded_data[3];
+    re_status_t status[3];
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_3_decode_batch (frames, 3U, decoded_data,
+                       status));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[0]);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, status[1]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[2]);
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_ok.pressure_pa),
+                       lrintf (decoded_data[0].pressure_pa));
+    TEST_ASSERT_EQUAL (lrintf (m_re_3_data_max.pressure_pa),
+                       lrintf (decoded_data[2].pressure_pa));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_3_decode_batch (frames, 1U, decoded_data, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_3_decode_batch (NULL, 1U, decoded_data, NULL));
+}
@@ -1,6 +1,7 @@
 ﻿#include "unity.h"
 
 #include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoints.h"
 #include <string.h>
 
 static const re_5_data_t m_re_5_data_ok =
@@ -314,3 +315,25 @@ void test_ruuvi_endpoint_5_check_format_fail (void)
     const uint8_t raw_buf_byte0[31] = {0x03, 0x01, 0x04, 0x1B, 0xFF, 0x99, 0x04, 0x05};
     TEST_ASSERT_FALSE (re_5_check_format (raw_buf_byte0));
 }
+
+void test_ruuvi_endpoint_5_decode_checked (void)
+{
+    uint8_t raw_buf[RE_5_RAW_MIN_LEN] = {0x02, 0x01, 0x04, 0x1B, 0xFF, 0x99, 0x04};
+    re_5_data_t decoded_data = {0};
+    memcpy (&raw_buf[RE_5_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_5_decode_checked (raw_buf,
+                       RE_5_RAW_MIN_LEN - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_5_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_5_decode_checked (NULL, RE_5_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_5_decode_checked (raw_buf, RE_5_RAW_MIN_LEN, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_5_decode_checked (raw_buf, RE_5_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (lrintf (m_re_5_data_ok.temperature_c * 1000.0f),
+                       lrintf (decoded_data.temperature_c * 1000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_5_data_ok.humidity_rh * 10000.0f),
+                       lrintf (decoded_data.humidity_rh * 10000.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_5_data_ok.pressure_pa), lrintf (decoded_data.pressure_pa));
+    TEST_ASSERT_EQUAL (m_re_5_data_ok.measurement_count, decoded_data.measurement_count);
+    TEST_ASSERT_EQUAL (m_re_5_data_ok.address, decoded_data.address);
+}
@@ -1599,3 +1599,29 @@ test_re_6_data_invalid (void)
     TEST_ASSERT_EQUAL (data.mac_addr_24.byte4, (radio_mac >> 8) & 0xFFU);
     TEST_ASSERT_EQUAL (data.mac_addr_24.byte5, (radio_mac >> 0) & 0xFFU);
 }
+
+void test_ruuvi_endpoint_6_decode_checked (void)
+{
+    // Payload of test_ruuvi_endpoint_6_get_ok.
+    static const uint8_t raw_buf[RE_6_RAW_BUF_SIZE] =
+    {
+        RE_6_BLE_PACKET_HEADER,
+        0x06, 0x17, 0x0C, 0x56, 0x68, 0xC7, 0x9E, 0x00, 0x70, 0x00,
+        0xC9, 0x05, 0x01, 0xD9, 0x4A, 0xCD, 0x00, 0x4C, 0x88, 0x4F
+    };
+    re_6_data_t decoded_data = { 0 };
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_6_decode_checked (raw_buf,
+                       RE_6_RAW_BUF_SIZE - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_6_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_6_decode_checked (NULL, RE_6_RAW_BUF_SIZE,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_6_decode_checked (raw_buf, RE_6_RAW_BUF_SIZE, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_6_decode_checked (raw_buf, RE_6_RAW_BUF_SIZE,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (295, lrintf (decoded_data.temperature_c * 10.0f));
+    TEST_ASSERT_EQUAL (553, lrintf (decoded_data.humidity_rh * 10.0f));
+    TEST_ASSERT_EQUAL (101102, lrintf (decoded_data.pressure_pa));
+    TEST_ASSERT_EQUAL (205, decoded_data.seq_cnt2);
+    TEST_ASSERT_EQUAL (0x4C, decoded_data.mac_addr_24.byte3);
+    TEST_ASSERT_EQUAL (0x4F, decoded_data.mac_addr_24.byte5);
+}
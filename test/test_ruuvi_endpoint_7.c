@@ -721,4 +721,24 @@ test_ruuvi_endpoint_7_accel_to_tilt_negative (void)
     re_7_decode (raw_buf, &decoded_data);
     TEST_ASSERT_FLOAT_WITHIN (1.0f, 0.0f, decoded_data.tilt_x_deg);
     TEST_ASSERT_FLOAT_WITHIN (1.5f, -30.0f, decoded_data.tilt_y_deg);
-}
\ No newline at end of file
+}
+
+void test_ruuvi_endpoint_7_decode_checked (void)
+{
+    uint8_t raw_buf[RE_7_RAW_MIN_LEN] = {0x02, 0x01, 0x04, 0x17, 0xFF, 0x99, 0x04};
+    re_7_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_7_encode (&raw_buf[RE_7_OFFSET_PAYLOAD], &m_re_7_data_ok));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_7_decode_checked (raw_buf,
+                       RE_7_RAW_MIN_LEN - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_7_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_7_decode_checked (NULL, RE_7_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_7_decode_checked (raw_buf, RE_7_RAW_MIN_LEN, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_7_decode_checked (raw_buf, RE_7_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_FLOAT_WITHIN (0.01f, m_re_7_data_ok.temperature_c, decoded_data.temperature_c);
+    TEST_ASSERT_FLOAT_WITHIN (0.01f, m_re_7_data_ok.humidity_rh, decoded_data.humidity_rh);
+    TEST_ASSERT_FLOAT_WITHIN (1.0f, m_re_7_data_ok.pressure_pa, decoded_data.pressure_pa);
+    TEST_ASSERT_EQUAL (m_re_7_data_ok.sequence_counter, decoded_data.sequence_counter);
+    TEST_ASSERT_EQUAL (m_re_7_data_ok.address, decoded_data.address);
+}
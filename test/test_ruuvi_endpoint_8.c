@@ -1,6 +1,7 @@
 #ifdef TEST
 
 #include "unity.h"
+#include <math.h>
 #include <string.h>
 #include "ruuvi_endpoints.h"
 #include "ruuvi_endpoint_8.h"
@@ -96,4 +97,201 @@ void test_re_8_encode_ok (void)
     TEST_ASSERT (!memcmp (buffer, TEST_DATA_OK, RE_8_DATA_LENGTH));
 }
 
+static const uint8_t TEST_FRAME_PREFIX[RE_8_OFFSET_PAYLOAD] =
+{
+    0x02, 0x01, 0x06, 0x1B, 0xFF, 0x99, 0x04
+};
+
+static void test_frame_build (uint8_t * const p_frame)
+{
+    memcpy (p_frame, TEST_FRAME_PREFIX, sizeof (TEST_FRAME_PREFIX));
+    memcpy (&p_frame[RE_8_OFFSET_PAYLOAD], TEST_DATA_OK, sizeof (TEST_DATA_OK));
+}
+
+/**
+ * Inverse of mock_encrypt.
+ */
+uint32_t mock_decrypt (const uint8_t * const ciphertext,
+                       uint8_t * const cleartext,
+                       const size_t data_size,
+                       const uint8_t * const key,
+                       const size_t key_size)
+{
+    uint32_t ret_code = 0;
+
+    if (memcmp (key, TEST_KEY, RE_8_CIPHERTEXT_LENGTH))
+    {
+        // Wrong key decrypts to garbage.
+        memset (cleartext, 0xA5, data_size);
+    }
+    else if (memcmp (ciphertext, TEST_VECT_OUT, RE_8_CIPHERTEXT_LENGTH))
+    {
+        ret_code = 2;
+    }
+    else
+    {
+        memcpy (cleartext, TEST_VECT_IN, RE_8_CIPHERTEXT_LENGTH);
+    }
+
+    return ret_code;
+}
+
+static size_t m_batch_calls;
+
+uint32_t mock_decrypt_batch (re_cipher_block_t * const p_blocks,
+                             const size_t num_blocks,
+                             const size_t block_size)
+{
+    m_batch_calls++;
+
+    for (size_t ii = 0; ii < num_blocks; ii++)
+    {
+        p_blocks[ii].status = mock_decrypt (p_blocks[ii].p_input, p_blocks[ii].p_output,
+                                            block_size, p_blocks[ii].p_key,
+                                            p_blocks[ii].key_size);
+    }
+
+    return 0;
+}
+
+static void test_re_8_check_data (const re_8_data_t * const p_data)
+{
+    TEST_ASSERT_EQUAL (lrintf (m_re_8_data.temperature_c * 200.0f),
+                       lrintf (p_data->temperature_c * 200.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_8_data.humidity_rh * 400.0f),
+                       lrintf (p_data->humidity_rh * 400.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_8_data.pressure_pa), lrintf (p_data->pressure_pa));
+    TEST_ASSERT_EQUAL (lrintf (m_re_8_data.battery_v * 1000.0f),
+                       lrintf (p_data->battery_v * 1000.0f));
+    TEST_ASSERT_EQUAL (m_re_8_data.tx_power, p_data->tx_power);
+    TEST_ASSERT_EQUAL (m_re_8_data.movement_count, p_data->movement_count);
+    TEST_ASSERT_EQUAL (m_re_8_data.message_counter, p_data->message_counter);
+    TEST_ASSERT_EQUAL (m_re_8_data.address, p_data->address);
+}
+
+void test_re_8_decode_ok (void)
+{
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    TEST_ASSERT_TRUE (re_8_check_format (frame));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_8_decode (frame, &data, &mock_decrypt, TEST_KEY,
+                       RE_8_CIPHERTEXT_LENGTH));
+    test_re_8_check_data (&data);
+}
+
+void test_re_8_decode_crc_error (void)
+{
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    frame[RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_CRC8] ^= 0x01U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CRC, re_8_decode (frame, &data, &mock_decrypt,
+                       TEST_KEY, RE_8_CIPHERTEXT_LENGTH));
+}
+
+void test_re_8_decode_wrong_key (void)
+{
+    static const uint8_t wrong_key[RE_8_CIPHERTEXT_LENGTH] = {0};
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CRC, re_8_decode (frame, &data, &mock_decrypt,
+                       wrong_key, sizeof (wrong_key)));
+}
+
+void test_re_8_decode_cipher_error (void)
+{
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    frame[RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_CIPHER] ^= 0x01U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_8_decode (frame, &data, &mock_decrypt,
+                       TEST_KEY, RE_8_CIPHERTEXT_LENGTH));
+}
+
+void test_re_8_decode_invalid (void)
+{
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    frame[RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_HEADER] = 0x05U;
+    TEST_ASSERT_FALSE (re_8_check_format (frame));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_8_decode (frame, &data, &mock_decrypt,
+                       TEST_KEY, RE_8_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_8_decode (frame, &data, NULL, TEST_KEY,
+                       RE_8_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_8_decode_checked (frame, sizeof (frame) - 1U,
+                       &data, &mock_decrypt, TEST_KEY, RE_8_CIPHERTEXT_LENGTH));
+}
+
+void test_re_8_decode_checked_ok (void)
+{
+    uint8_t frame[RE_8_RAW_MIN_LEN];
+    re_8_data_t data = {0};
+    test_frame_build (frame);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_8_decode_checked (frame, sizeof (frame), &data,
+                       &mock_decrypt, TEST_KEY, RE_8_CIPHERTEXT_LENGTH));
+    test_re_8_check_data (&data);
+}
+
+void test_re_8_decode_batch (void)
+{
+    static const uint8_t wrong_key[RE_8_CIPHERTEXT_LENGTH] = {0};
+    const size_t num_frames = RE_CIPHER_BATCH_BLOCKS + 3U;
+    uint8_t frames[RE_CIPHER_BATCH_BLOCKS + 3U][RE_8_RAW_MIN_LEN];
+    const uint8_t * p_frames[RE_CIPHER_BATCH_BLOCKS + 3U];
+    const uint8_t * p_keys[RE_CIPHER_BATCH_BLOCKS + 3U];
+    re_8_data_t data[RE_CIPHER_BATCH_BLOCKS + 3U];
+    re_status_t status[RE_CIPHER_BATCH_BLOCKS + 3U];
+
+    for (size_t ii = 0; ii < num_frames; ii++)
+    {
+        test_frame_build (frames[ii]);
+        p_frames[ii] = frames[ii];
+        p_keys[ii] = TEST_KEY;
+    }
+
+    frames[1][RE_8_OFFSET_PAYLOAD + RE_8_OFFSET_HEADER] = 0x05U;
+    p_keys[2] = NULL;
+    p_keys[RE_CIPHER_BATCH_BLOCKS + 1U] = wrong_key;
+    m_batch_calls = 0;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM | RE_ERROR_NULL | RE_ERROR_DECODING_CRC,
+                       re_8_decode_batch (p_frames, p_keys, RE_8_CIPHERTEXT_LENGTH,
+                                          num_frames, data, status, &mock_decrypt_batch));
+    TEST_ASSERT_EQUAL (2, m_batch_calls);
+
+    for (size_t ii = 0; ii < num_frames; ii++)
+    {
+        if (1U == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, status[ii]);
+        }
+        else if (2U == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_NULL, status[ii]);
+        }
+        else if ( (RE_CIPHER_BATCH_BLOCKS + 1U) == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CRC, status[ii]);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL (RE_SUCCESS, status[ii]);
+            test_re_8_check_data (&data[ii]);
+        }
+    }
+}
+
+void test_re_8_decode_batch_null (void)
+{
+    const uint8_t * p_frames[1] = {NULL};
+    const uint8_t * p_keys[1] = {TEST_KEY};
+    re_8_data_t data[1];
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_8_decode_batch (p_frames, p_keys,
+                       RE_8_CIPHERTEXT_LENGTH, 1U, data, NULL, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_8_decode_batch (p_frames, p_keys,
+                       RE_8_CIPHERTEXT_LENGTH, 1U, data, NULL, &mock_decrypt_batch));
+}
+
 #endif // TEST
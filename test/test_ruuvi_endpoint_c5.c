@@ -1,6 +1,8 @@
 #include "unity.h"
 
 #include "ruuvi_endpoint_c5.h"
+#include "ruuvi_endpoints.h"
+#include <math.h>
 #include <string.h>
 
 static const re_c5_data_t m_re_c5_data_ok =
@@ -207,3 +209,97 @@ void test_ruuvi_endpoint_c5_overflow (void)
     TEST_ASSERT (! (memcmp (test_buffer, max_data, sizeof (max_data))));
 }
 
+
+void test_ruuvi_endpoint_c5_decode_ok (void)
+{
+    uint8_t raw_buf[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_C5_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    re_c5_data_t decoded_data = {0};
+    TEST_ASSERT_TRUE (re_c5_check_format (raw_buf));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_c5_decode (raw_buf, &decoded_data));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok.humidity_rh * 400.0f),
+                       lrintf (decoded_data.humidity_rh * 400.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok.temperature_c * 200.0f),
+                       lrintf (decoded_data.temperature_c * 200.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok.pressure_pa),
+                       lrintf (decoded_data.pressure_pa));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok.battery_v * 1000.0f),
+                       lrintf (decoded_data.battery_v * 1000.0f));
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok.tx_power, decoded_data.tx_power);
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok.movement_count, decoded_data.movement_count);
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok.measurement_count, decoded_data.measurement_count);
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok.address, decoded_data.address);
+}
+
+void test_ruuvi_endpoint_c5_decode_min (void)
+{
+    uint8_t raw_buf[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_C5_OFFSET_PAYLOAD], min_data, sizeof (min_data));
+    re_c5_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_c5_decode (raw_buf, &decoded_data));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok_min.temperature_c * 200.0f),
+                       lrintf (decoded_data.temperature_c * 200.0f));
+    TEST_ASSERT_EQUAL (lrintf (m_re_c5_data_ok_min.battery_v * 1000.0f),
+                       lrintf (decoded_data.battery_v * 1000.0f));
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok_min.tx_power, decoded_data.tx_power);
+}
+
+void test_ruuvi_endpoint_c5_decode_invalid_data (void)
+{
+    uint8_t raw_buf[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_C5_OFFSET_PAYLOAD], invalid_data, sizeof (invalid_data));
+    re_c5_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_c5_decode (raw_buf, &decoded_data));
+    TEST_ASSERT (isnan (decoded_data.temperature_c));
+    TEST_ASSERT (isnan (decoded_data.humidity_rh));
+    TEST_ASSERT (isnan (decoded_data.pressure_pa));
+    TEST_ASSERT (isnan (decoded_data.battery_v));
+    TEST_ASSERT_EQUAL (RE_C5_INVALID_POWER, decoded_data.tx_power);
+    TEST_ASSERT_EQUAL (RE_C5_INVALID_SEQUENCE, decoded_data.measurement_count);
+    TEST_ASSERT_EQUAL (RE_C5_INVALID_MAC, decoded_data.address);
+}
+
+void test_ruuvi_endpoint_c5_check_format_fail (void)
+{
+    const uint8_t raw_buf_payload_format[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04, 0x05};
+    TEST_ASSERT_FALSE (re_c5_check_format (raw_buf_payload_format));
+    const uint8_t raw_buf_len[31] = {0x02, 0x01, 0x06, 0x1B, 0xFF, 0x99, 0x04, 0xC5};
+    TEST_ASSERT_FALSE (re_c5_check_format (raw_buf_len));
+    const uint8_t raw_buf_type[31] = {0x02, 0x01, 0x06, 0x15, 0xFE, 0x99, 0x04, 0xC5};
+    TEST_ASSERT_FALSE (re_c5_check_format (raw_buf_type));
+    TEST_ASSERT_FALSE (re_c5_check_format (NULL));
+}
+
+void test_ruuvi_endpoint_c5_decode_checked (void)
+{
+    uint8_t raw_buf[RE_C5_RAW_MIN_LEN] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    memcpy (&raw_buf[RE_C5_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    re_c5_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_c5_decode_checked (raw_buf, sizeof (raw_buf),
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_c5_decode_checked (raw_buf,
+                       sizeof (raw_buf) - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_c5_decode_checked (raw_buf, sizeof (raw_buf), NULL));
+}
+
+void test_ruuvi_endpoint_c5_decode_batch (void)
+{
+    uint8_t raw_ok[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    uint8_t raw_max[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04};
+    const uint8_t raw_other[31] = {0x02, 0x01, 0x06, 0x15, 0xFF, 0x99, 0x04, 0x05};
+    memcpy (&raw_ok[RE_C5_OFFSET_PAYLOAD], valid_data, sizeof (valid_data));
+    memcpy (&raw_max[RE_C5_OFFSET_PAYLOAD], max_data, sizeof (max_data));
+    const uint8_t * const frames[] = {raw_ok, raw_max, raw_other};
+    re_c5_data_t decoded_data[3];
+    re_status_t status[3];
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_c5_decode_batch (frames, 3U, decoded_data,
+                       status));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[0]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[1]);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, status[2]);
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok.measurement_count, decoded_data[0].measurement_count);
+    TEST_ASSERT_EQUAL (m_re_c5_data_ok_max.measurement_count,
+                       decoded_data[1].measurement_count);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_c5_decode_batch (frames, 2U, decoded_data, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_c5_decode_batch (frames, 2U, NULL, NULL));
+}
@@ -2,6 +2,7 @@
 
 #include "ruuvi_endpoints.h"
 #include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_endpoints_stats.h"
 
 #include <string.h>
 
@@ -2395,3 +2396,219 @@ void test_ruuvi_endpoint_ca_uart_adv_rprt_decode_no_data (void)
                                   sizeof (expect_params));
     TEST_ASSERT_EQUAL_HEX8_ARRAY (&expect_cmd, &payload.cmd, sizeof (expect_cmd));
 }
+
+void test_ruuvi_endpoint_ca_uart_decode_stats_ok (void)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    re_stats_t stats;
+    re_stats_init (&stats);
+    err_code = re_ca_uart_decode_stats (data, sizeof (data), &payload, &stats);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, err_code);
+    TEST_ASSERT_EQUAL (RE_CA_UART_ADV_RPRT, payload.cmd);
+    TEST_ASSERT_EQUAL (1, stats.frames_ok);
+    TEST_ASSERT_EQUAL (0, stats.frames_failed);
+    TEST_ASSERT_EQUAL (1, stats.cmd_ok[RE_CA_UART_ADV_RPRT]);
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_stats_crc_error (void)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x8AU,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    re_stats_t stats;
+    re_stats_init (&stats);
+    err_code = re_ca_uart_decode_stats (data, sizeof (data), &payload, &stats);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CRC, err_code);
+    TEST_ASSERT_EQUAL (0, stats.frames_ok);
+    TEST_ASSERT_EQUAL (1, stats.frames_failed);
+    TEST_ASSERT_EQUAL (1, stats.cmd_failed[RE_CA_UART_ADV_RPRT]);
+    TEST_ASSERT_EQUAL (1, stats.error_bits[18]);
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_stats_no_stx (void)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t data[] =
+    {
+        0x00U, //!< Not STX
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    re_stats_t stats;
+    re_stats_init (&stats);
+    err_code = re_ca_uart_decode_stats (data, sizeof (data), &payload, &stats);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_STX, err_code);
+    TEST_ASSERT_EQUAL (1, stats.frames_failed);
+    TEST_ASSERT_EQUAL (1, stats.cmd_failed[0]);
+    TEST_ASSERT_EQUAL (1, stats.error_bits[16]);
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_stats_short_buffer (void)
+{
+    re_status_t err_code = RE_SUCCESS;
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    re_stats_t stats;
+    re_stats_init (&stats);
+    err_code = re_ca_uart_decode_stats (data, sizeof (data) - 1U, &payload, &stats);
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, err_code);
+    TEST_ASSERT_EQUAL (1, stats.frames_failed);
+    TEST_ASSERT_EQUAL (1, stats.cmd_failed[RE_CA_UART_ADV_RPRT]);
+    // Command byte was not received.
+    err_code = re_ca_uart_decode_stats (data, RE_CA_UART_CMD_INDEX, &payload, &stats);
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, err_code);
+    TEST_ASSERT_EQUAL (1, stats.cmd_failed[0]);
+}
+
+void test_ruuvi_endpoint_ca_uart_resync (void)
+{
+    uint8_t data[] =
+    {
+        0x00U, 0x11U, //!< Noise
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX,
+        RE_CA_UART_STX, 10U + CMD_IN_LEN //!< Start of next frame
+    };
+    const size_t frame_len = sizeof (data) - 4U;
+    re_ca_uart_payload_t payload = {0};
+    size_t found_len = 0;
+    re_stats_t stats;
+    re_stats_init (&stats);
+    TEST_ASSERT_EQUAL (2U, re_ca_uart_resync (data, sizeof (data), &found_len, &stats));
+    TEST_ASSERT_EQUAL (frame_len, found_len);
+    TEST_ASSERT_EQUAL (2U, stats.bytes_discarded);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ca_uart_decode_stats (&data[2], found_len, &payload,
+                       &stats));
+    // Next frame is not complete yet, nothing is discarded.
+    TEST_ASSERT_EQUAL (0U, re_ca_uart_resync (&data[2U + frame_len], 2U, &found_len, &stats));
+    TEST_ASSERT_EQUAL (0U, found_len);
+    TEST_ASSERT_EQUAL (2U, stats.bytes_discarded);
+    TEST_ASSERT_EQUAL (2U, re_ca_uart_resync (data, 2U, &found_len, &stats));
+    TEST_ASSERT_EQUAL (4U, stats.bytes_discarded);
+    TEST_ASSERT_EQUAL (5U, re_ca_uart_resync (NULL, 5U, NULL, &stats));
+    TEST_ASSERT_EQUAL (4U, stats.bytes_discarded);
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_stats_null_stats (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ca_uart_decode_stats (data, sizeof (data),
+                       &payload, NULL));
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_checked_ok (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ca_uart_decode_checked (data, sizeof (data), &payload));
+    TEST_ASSERT_EQUAL (RE_CA_UART_ADV_RPRT, payload.cmd);
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_checked_truncated (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        10U + CMD_IN_LEN,
+        RE_CA_UART_ADV_RPRT,
+        0xC9U, 0x44U, 0x54U, 0x29U, 0xE3U, 0x8DU, RE_CA_UART_FIELD_DELIMITER, //!< MAC
+        RE_CA_UART_FIELD_DELIMITER, //!< Data
+        0xD8U, RE_CA_UART_FIELD_DELIMITER, //RSSI
+        0x6AU, 0x89U,//crc16
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+
+    for (size_t len = 0; len < sizeof (data); len++)
+    {
+        TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_ca_uart_decode_checked (data, len, &payload));
+    }
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_checked_declared_len_too_long (void)
+{
+    uint8_t data[] =
+    {
+        RE_CA_UART_STX,
+        0xFFU,
+        RE_CA_UART_ADV_RPRT,
+        RE_CA_UART_ETX
+    };
+    re_ca_uart_payload_t payload = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE,
+                       re_ca_uart_decode_checked (data, sizeof (data), &payload));
+}
+
+void test_ruuvi_endpoint_ca_uart_decode_checked_null (void)
+{
+    uint8_t data[RE_CA_UART_FRAME_OVERHEAD] = {0};
+    re_ca_uart_payload_t payload = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_ca_uart_decode_checked (NULL, sizeof (data),
+                       &payload));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_ca_uart_decode_checked (data, sizeof (data), NULL));
+}
@@ -1,6 +1,7 @@
 ﻿#include "unity.h"
 
 #include "ruuvi_endpoint_e0.h"
+#include "ruuvi_endpoints.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -606,3 +607,46 @@ void test_re_6_data_invalid (void)
     TEST_ASSERT_EQUAL (data.measurement_count, measurement_cnt);
     TEST_ASSERT_EQUAL (data.address, radio_mac);
 }
+
+void test_ruuvi_endpoint_e0_decode_checked (void)
+{
+    // Payload of test_ruuvi_endpoint_e0_get_ok.
+    static const uint8_t raw_buf[RE_E0_RAW_MIN_LEN] =
+    {
+        0x2B, 0xFF, 0x99, 0x04,
+        0xE0,
+        5300U >> 8U, 5300U & 0xFFU, // Temperature
+        32200U >> 8U, 32200U & 0xFFU, // Humidity
+        51355U >> 8U, 51355U & 0xFFU, // Pressure
+        102U >> 8U, 102U & 0xFFU, // PM1.0
+        113U >> 8U, 113U & 0xFFU, // PM2.5
+        124U >> 8U, 124U & 0xFFU, // PM4.0
+        135U >> 8U, 135U & 0xFFU, // PM10.0
+        1129U >> 8U, 1129U & 0xFFU, // CO2
+        11U >> 8U, 11U & 0xFFU, // VOX
+        12U >> 8U, 12U & 0xFFU, // NOX
+        15123U >> 8U, 15123U & 0xFFU, // Luminosity
+        41, // Sound avg
+        42, // Sound peak
+        65533U >> 8U, 65533U & 0xFFU, // Measurement count
+        107, // Voltage
+        0x01, // Flags
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F
+    };
+    re_e0_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_e0_decode_checked (raw_buf,
+                       RE_E0_RAW_MIN_LEN - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_e0_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_e0_decode_checked (NULL, RE_E0_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_e0_decode_checked (raw_buf, RE_E0_RAW_MIN_LEN, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_e0_decode_checked (raw_buf, RE_E0_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (265, lrintf (decoded_data.temperature_c * 10.0f));
+    TEST_ASSERT_EQUAL (805, lrintf (decoded_data.humidity_rh * 10.0f));
+    TEST_ASSERT_EQUAL (1013550, lrintf (decoded_data.pressure_pa * 10.0f));
+    TEST_ASSERT_EQUAL (1129, decoded_data.co2);
+    TEST_ASSERT_EQUAL (65533, decoded_data.measurement_count);
+    TEST_ASSERT_EQUAL (0xCBB8334C884F, decoded_data.address);
+}
@@ -2360,3 +2360,30 @@ test_ruuvi_endpoint_e1_data_invalid (void)
     TEST_ASSERT_EQUAL (false, data.flags.flag_rtc_running_on_boot);
     TEST_ASSERT_EQUAL (data.address, radio_mac);
 }
+
+void test_ruuvi_endpoint_e1_decode_checked (void)
+{
+    // Payload of test_ruuvi_endpoint_e1_get_ok.
+    static const uint8_t raw_buf[RE_E1_RAW_MIN_LEN] =
+    {
+        RE_E1_BLE_PACKET_HEADER,
+        0xE1, 0x17, 0x0C, 0x56, 0x68, 0xC7, 0x9E, 0x00, 0x65, 0x00,
+        0x70, 0x04, 0xBD, 0x11, 0xCA, 0x00, 0xC9, 0x05, 0x01, 0x13,
+        0xE0, 0xAC, 0x3D, 0x4A, 0x9C, 0xDE, 0xCD, 0xEE, 0x00, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F
+    };
+    re_e1_data_t decoded_data = { 0 };
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_e1_decode_checked (raw_buf,
+                       RE_E1_RAW_MIN_LEN - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_e1_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_e1_decode_checked (NULL, RE_E1_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_e1_decode_checked (raw_buf, RE_E1_RAW_MIN_LEN, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_e1_decode_checked (raw_buf, RE_E1_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (295, lrintf (decoded_data.temperature_c * 10.0f));
+    TEST_ASSERT_EQUAL (553, lrintf (decoded_data.humidity_rh * 10.0f));
+    TEST_ASSERT_EQUAL (1011020, lrintf (decoded_data.pressure_pa * 10.0f));
+    TEST_ASSERT_EQUAL (0xDECDEE, decoded_data.seq_cnt);
+    TEST_ASSERT_EQUAL (0xCBB8334C884F, decoded_data.address);
+}
@@ -1,6 +1,7 @@
 ﻿#include "unity.h"
 
 #include "ruuvi_endpoint_f0.h"
+#include "ruuvi_endpoints.h"
 #include <string.h>
 #include <stdint.h>
 
@@ -536,3 +537,28 @@ void test_re_f0_data_invalid (void)
     TEST_ASSERT_EQUAL (measurement_cnt, data.flag_seq_cnt);
     TEST_ASSERT_EQUAL (radio_mac, data.address);
 }
+
+void test_ruuvi_endpoint_f0_decode_checked (void)
+{
+    // Payload of test_ruuvi_endpoint_f0_get_ok.
+    static const uint8_t raw_buf[RE_F0_RAW_MIN_LEN] =
+    {
+        0x02, 0x01, 0x06, 0x03, 0x03, 0x98, 0xFC, 0x17, 0xFF, 0x99, 0x04,
+        0xF0, 26, 161, 114, 89, 92, 95, 98, 169, 98, 102, 231, 41, 0x51,
+        0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F
+    };
+    re_f0_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_f0_decode_checked (raw_buf,
+                       RE_F0_RAW_MIN_LEN - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_f0_decode_checked (raw_buf, 0U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_f0_decode_checked (NULL, RE_F0_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_f0_decode_checked (raw_buf, RE_F0_RAW_MIN_LEN, NULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_f0_decode_checked (raw_buf, RE_F0_RAW_MIN_LEN,
+                       &decoded_data));
+    TEST_ASSERT_EQUAL (260 /* 26.5 */, lrintf (decoded_data.temperature_c * 10.0f));
+    TEST_ASSERT_EQUAL (805 /* 80.5 */, lrintf (decoded_data.humidity_rh * 10.0f));
+    TEST_ASSERT_EQUAL (101400 /* 101355 */, lrintf (decoded_data.pressure_pa));
+    TEST_ASSERT_EQUAL (5, decoded_data.flag_seq_cnt);
+    TEST_ASSERT_EQUAL (0xCBB8334C884F, decoded_data.address);
+}
@@ -100,4 +100,234 @@ void test_re_fa_encode_ok (void)
     TEST_ASSERT (!memcmp (buffer, TEST_DATA_OK, RE_FA_DATA_LENGTH));
 }
 
+static const uint8_t TEST_FRAME_PREFIX[RE_FA_OFFSET_PAYLOAD] =
+{
+    0x02, 0x01, 0x06, 0x1A, 0xFF, 0x99, 0x04
+};
+
+static const re_3_data_t TEST_RE_3_DATA =
+{
+    .humidity_rh = 20.5f,
+    .pressure_pa = 100000.0f,
+    .temperature_c = -1.25f,
+    .accelerationx_g = 1.0f,
+    .accelerationy_g = -1.0f,
+    .accelerationz_g = 0.5f,
+    .battery_v = 2.9f
+};
+
+static size_t m_fields_calls;
+static size_t m_batch_calls;
+
+static void test_frame_build (uint8_t * const p_frame)
+{
+    memcpy (p_frame, TEST_FRAME_PREFIX, sizeof (TEST_FRAME_PREFIX));
+    memcpy (&p_frame[RE_FA_OFFSET_PAYLOAD], TEST_DATA_OK, sizeof (TEST_DATA_OK));
+}
+
+/**
+ * Inverse of mock_encrypt.
+ */
+uint32_t mock_decrypt (const uint8_t * const ciphertext,
+                       uint8_t * const cleartext,
+                       const size_t data_size,
+                       const uint8_t * const key,
+                       const size_t key_size)
+{
+    uint32_t ret_code = 0;
+
+    if (memcmp (key, TEST_KEY, RE_FA_CIPHERTEXT_LENGTH))
+    {
+        // Wrong key decrypts to garbage.
+        memset (cleartext, 0xA5, data_size);
+    }
+    else if (memcmp (ciphertext, TEST_VECT_OUT, RE_FA_CIPHERTEXT_LENGTH))
+    {
+        ret_code = 2;
+    }
+    else
+    {
+        memcpy (cleartext, TEST_VECT_IN, RE_FA_CIPHERTEXT_LENGTH);
+    }
+
+    return ret_code;
+}
+
+uint32_t mock_decrypt_batch (re_cipher_block_t * const p_blocks,
+                             const size_t num_blocks,
+                             const size_t block_size)
+{
+    m_batch_calls++;
+
+    for (size_t ii = 0; ii < num_blocks; ii++)
+    {
+        p_blocks[ii].status = mock_decrypt (p_blocks[ii].p_input, p_blocks[ii].p_output,
+                                            block_size, p_blocks[ii].p_key,
+                                            p_blocks[ii].key_size);
+    }
+
+    return 0;
+}
+
+/**
+ * DF3 field decoder receives the decrypted payload with FA header.
+ */
+static void stub_re_3_decode_fields (const uint8_t * const p_payload,
+                                     re_3_data_t * const p_data,
+                                     int cmock_num_calls)
+{
+    (void) cmock_num_calls;
+    m_fields_calls++;
+    TEST_ASSERT_EQUAL_HEX8 (RE_FA_DESTINATION, p_payload[RE_FA_OFFSET_HEADER]);
+    TEST_ASSERT_EQUAL_MEMORY (TEST_VECT_IN, &p_payload[RE_FA_OFFSET_CIPHER],
+                              RE_FA_CIPHERTEXT_LENGTH);
+    *p_data = TEST_RE_3_DATA;
+}
+
+static void test_re_fa_check_data (const re_fa_data_t * const p_data)
+{
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.humidity_rh, &p_data->humidity_rh,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.pressure_pa, &p_data->pressure_pa,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.temperature_c, &p_data->temperature_c,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.accelerationx_g, &p_data->accelerationx_g,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.accelerationy_g, &p_data->accelerationy_g,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.accelerationz_g, &p_data->accelerationz_g,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL_MEMORY (&TEST_RE_3_DATA.battery_v, &p_data->battery_v,
+                              sizeof (float));
+    TEST_ASSERT_EQUAL (1, p_data->message_counter);
+    TEST_ASSERT (0xC000DEADBEEFU == p_data->address);
+}
+
+void test_re_fa_decode_ok (void)
+{
+    uint8_t frame[RE_FA_RAW_MIN_LEN];
+    re_fa_data_t data = {0};
+    test_frame_build (frame);
+    m_fields_calls = 0;
+    re_3_decode_fields_StubWithCallback (&stub_re_3_decode_fields);
+    TEST_ASSERT_TRUE (re_fa_check_format (frame));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_fa_decode (frame, &data, &mock_decrypt, TEST_KEY,
+                       RE_FA_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (1, m_fields_calls);
+    test_re_fa_check_data (&data);
+}
+
+void test_re_fa_decode_wrong_key (void)
+{
+    static const uint8_t wrong_key[RE_FA_CIPHERTEXT_LENGTH] = {0};
+    uint8_t frame[RE_FA_RAW_MIN_LEN];
+    re_fa_data_t data = {0};
+    test_frame_build (frame);
+    m_fields_calls = 0;
+    re_3_decode_fields_StubWithCallback (&stub_re_3_decode_fields);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_fa_decode (frame, &data, &mock_decrypt,
+                       wrong_key, sizeof (wrong_key)));
+    TEST_ASSERT_EQUAL (0, m_fields_calls);
+}
+
+void test_re_fa_decode_cipher_error (void)
+{
+    uint8_t frame[RE_FA_RAW_MIN_LEN];
+    re_fa_data_t data = {0};
+    test_frame_build (frame);
+    frame[RE_FA_OFFSET_PAYLOAD + RE_FA_OFFSET_CIPHER] ^= 0x01U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_fa_decode (frame, &data, &mock_decrypt,
+                       TEST_KEY, RE_FA_CIPHERTEXT_LENGTH));
+}
+
+void test_re_fa_decode_invalid (void)
+{
+    uint8_t frame[RE_FA_RAW_MIN_LEN];
+    re_fa_data_t data = {0};
+    test_frame_build (frame);
+    frame[RE_FA_OFFSET_PAYLOAD + RE_FA_OFFSET_HEADER] = 0x03U;
+    TEST_ASSERT_FALSE (re_fa_check_format (frame));
+    TEST_ASSERT_FALSE (re_fa_check_format (NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_fa_decode (frame, &data, &mock_decrypt,
+                       TEST_KEY, RE_FA_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_fa_decode (frame, &data, NULL, TEST_KEY,
+                       RE_FA_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_fa_decode_checked (NULL, sizeof (frame), &data,
+                       &mock_decrypt, TEST_KEY, RE_FA_CIPHERTEXT_LENGTH));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_fa_decode_checked (frame, sizeof (frame) - 1U,
+                       &data, &mock_decrypt, TEST_KEY, RE_FA_CIPHERTEXT_LENGTH));
+}
+
+void test_re_fa_decode_checked_ok (void)
+{
+    uint8_t frame[RE_FA_RAW_MIN_LEN];
+    re_fa_data_t data = {0};
+    test_frame_build (frame);
+    re_3_decode_fields_StubWithCallback (&stub_re_3_decode_fields);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_fa_decode_checked (frame, sizeof (frame), &data,
+                       &mock_decrypt, TEST_KEY, RE_FA_CIPHERTEXT_LENGTH));
+    test_re_fa_check_data (&data);
+}
+
+void test_re_fa_decode_batch (void)
+{
+    static const uint8_t wrong_key[RE_FA_CIPHERTEXT_LENGTH] = {0};
+    const size_t num_frames = RE_CIPHER_BATCH_BLOCKS + 3U;
+    uint8_t frames[RE_CIPHER_BATCH_BLOCKS + 3U][RE_FA_RAW_MIN_LEN];
+    const uint8_t * p_frames[RE_CIPHER_BATCH_BLOCKS + 3U];
+    const uint8_t * p_keys[RE_CIPHER_BATCH_BLOCKS + 3U];
+    re_fa_data_t data[RE_CIPHER_BATCH_BLOCKS + 3U];
+    re_status_t status[RE_CIPHER_BATCH_BLOCKS + 3U];
+
+    for (size_t ii = 0; ii < num_frames; ii++)
+    {
+        test_frame_build (frames[ii]);
+        p_frames[ii] = frames[ii];
+        p_keys[ii] = TEST_KEY;
+    }
+
+    frames[1][RE_FA_OFFSET_PAYLOAD + RE_FA_OFFSET_HEADER] = 0x03U;
+    p_keys[2] = NULL;
+    p_keys[RE_CIPHER_BATCH_BLOCKS + 1U] = wrong_key;
+    m_batch_calls = 0;
+    re_3_decode_fields_StubWithCallback (&stub_re_3_decode_fields);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM | RE_ERROR_NULL | RE_ERROR_DECODING,
+                       re_fa_decode_batch (p_frames, p_keys, RE_FA_CIPHERTEXT_LENGTH,
+                                           num_frames, data, status, &mock_decrypt_batch));
+    TEST_ASSERT_EQUAL (2, m_batch_calls);
+
+    for (size_t ii = 0; ii < num_frames; ii++)
+    {
+        if (1U == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, status[ii]);
+        }
+        else if (2U == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_NULL, status[ii]);
+        }
+        else if ( (RE_CIPHER_BATCH_BLOCKS + 1U) == ii)
+        {
+            TEST_ASSERT_EQUAL (RE_ERROR_DECODING, status[ii]);
+        }
+        else
+        {
+            TEST_ASSERT_EQUAL (RE_SUCCESS, status[ii]);
+            test_re_fa_check_data (&data[ii]);
+        }
+    }
+}
+
+void test_re_fa_decode_batch_null (void)
+{
+    const uint8_t * p_frames[1] = {NULL};
+    const uint8_t * p_keys[1] = {TEST_KEY};
+    re_fa_data_t data[1];
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_fa_decode_batch (p_frames, p_keys,
+                       RE_FA_CIPHERTEXT_LENGTH, 1U, data, NULL, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_fa_decode_batch (p_frames, p_keys,
+                       RE_FA_CIPHERTEXT_LENGTH, 1U, data, NULL, &mock_decrypt_batch));
+}
+
 #endif // TEST
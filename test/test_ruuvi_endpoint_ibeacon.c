@@ -1,6 +1,7 @@
 #include "unity.h"
 
 #include "ruuvi_endpoint_ibeacon.h"
+#include <string.h>
 
 static re_ibeacon_data_t m_ibeacon_data_ok =
 {
@@ -102,3 +103,76 @@ void test_ruuvi_endpoint_ibeacon_get_error_null_data (void)
     err_code = re_ibeacon_encode (p_test_buffer, p_ibeacon_data);
     TEST_ASSERT (RE_ERROR_NULL == err_code);
 }
+
+static const uint8_t m_ibeacon_raw_ok[RE_IBEACON_RAW_MIN_LEN] =
+{
+    0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x04, 0xD2, // Major
+    0x10, 0xE1, // Minor
+    0xD8 // TX power
+};
+
+void test_ruuvi_endpoint_ibeacon_encode_fields (void)
+{
+    re_ibeacon_data_t data = m_ibeacon_data_ok;
+    data.minor = 4321;
+    uint8_t raw_buf[RE_IBEACON_RAW_MIN_LEN] =
+    {
+        0x02, 0x01, 0x06, 0x1A, 0xFF, 0x4C, 0x00, 0x02, 0x15
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ibeacon_encode (&raw_buf[RE_IBEACON_OFFSET_PAYLOAD],
+                       &data));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_ibeacon_raw_ok, raw_buf, sizeof (raw_buf));
+}
+
+void test_ruuvi_endpoint_ibeacon_decode_ok (void)
+{
+    re_ibeacon_data_t decoded_data = {0};
+    TEST_ASSERT_TRUE (re_ibeacon_check_format (m_ibeacon_raw_ok));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ibeacon_decode (m_ibeacon_raw_ok, &decoded_data));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (m_ibeacon_data_ok.proximity_uuid,
+                                  decoded_data.proximity_uuid, RE_IBEACON_PROXIMITY_UUID_SIZE);
+    TEST_ASSERT_EQUAL (1234, decoded_data.major);
+    TEST_ASSERT_EQUAL (4321, decoded_data.minor);
+    TEST_ASSERT_EQUAL (-40, decoded_data.tx_power);
+}
+
+void test_ruuvi_endpoint_ibeacon_decode_not_ibeacon (void)
+{
+    uint8_t raw_buf[RE_IBEACON_RAW_MIN_LEN];
+    memcpy (raw_buf, m_ibeacon_raw_ok, sizeof (raw_buf));
+    raw_buf[8] = 0x14;
+    re_ibeacon_data_t decoded_data = {0};
+    TEST_ASSERT_FALSE (re_ibeacon_check_format (raw_buf));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_ibeacon_decode (raw_buf, &decoded_data));
+    memcpy (raw_buf, m_ibeacon_raw_ok, sizeof (raw_buf));
+    raw_buf[5] = 0x99;
+    raw_buf[6] = 0x04;
+    TEST_ASSERT_FALSE (re_ibeacon_check_format (raw_buf));
+    TEST_ASSERT_FALSE (re_ibeacon_check_format (NULL));
+}
+
+void test_ruuvi_endpoint_ibeacon_decode_checked (void)
+{
+    re_ibeacon_data_t decoded_data = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ibeacon_decode_checked (m_ibeacon_raw_ok,
+                       sizeof (m_ibeacon_raw_ok), &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_ibeacon_decode_checked (m_ibeacon_raw_ok,
+                       sizeof (m_ibeacon_raw_ok) - 1U, &decoded_data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_ibeacon_decode_checked (NULL,
+                       sizeof (m_ibeacon_raw_ok), &decoded_data));
+}
+
+void test_ruuvi_endpoint_ibeacon_decode_batch (void)
+{
+    const uint8_t * const frames[] = {m_ibeacon_raw_ok, m_ibeacon_raw_ok};
+    re_ibeacon_data_t decoded_data[2];
+    re_status_t status[2] = {RE_ERROR_NULL, RE_ERROR_NULL};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ibeacon_decode_batch (frames, 2U, decoded_data, status));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[0]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, status[1]);
+    TEST_ASSERT_EQUAL (4321, decoded_data[1].minor);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_ibeacon_decode_batch (NULL, 2U, decoded_data, NULL));
+}
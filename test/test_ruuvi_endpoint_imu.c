@@ -0,0 +1,148 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_imu.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_MTU_PAYLOAD (244U)  //!< ATT MTU 247 - 3.
+#define TEST_FIFO_LEN    (100U)  //!< One second at 100 Hz.
+
+static uint8_t m_msg[TEST_MTU_PAYLOAD];
+static re_float m_fifo[TEST_FIFO_LEN * 3U];
+static re_float m_x[RE_IMU_MAX_SAMPLES];
+static re_float m_y[RE_IMU_MAX_SAMPLES];
+static re_float m_z[RE_IMU_MAX_SAMPLES];
+
+void setUp (void)
+{
+    memset (m_msg, 0xA5, sizeof (m_msg));
+
+    for (size_t ii = 0; ii < TEST_FIFO_LEN; ii++)
+    {
+        m_fifo[ (3U * ii)] = 0.001F * (re_float) ii;
+        m_fifo[ (3U * ii) + 1U] = -0.002F * (re_float) ii;
+        m_fifo[ (3U * ii) + 2U] = 1.0F;
+    }
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_imu_stream_encode_header (void)
+{
+    static const uint8_t expected[] =
+    {
+        0x4A, 0x40,             // Source, op.
+        0x01, 0x02,             // Sequence.
+        0x00, 0x64,             // 100 Hz.
+        0x01,                   // Samples.
+        0x01, 0xF4,             // X 0.5 g.
+        0xFE, 0x0C,             // Y -0.5 g.
+        0x03, 0xE8              // Z 1 g.
+    };
+    const re_float sample[3] = {0.5F, -0.5F, 1.0F};
+    re_imu_stream_t stream = {.source = RE_ACC_XYZ, .sequence = 0x0102U, .sample_rate_hz = 100U};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                       sample, 1U));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (expected, &m_msg[RE_STANDARD_SOURCE_INDEX],
+                                  sizeof (expected));
+    TEST_ASSERT_EQUAL (1U, stream.num_samples);
+    TEST_ASSERT_EQUAL (0x0103U, stream.sequence);
+}
+
+void test_re_imu_stream_fifo_fills_mtu (void)
+{
+    re_imu_stream_t stream = {.source = RE_ACC_XYZ, .sample_rate_hz = 100U};
+    size_t consumed = 0;
+    size_t messages = 0;
+
+    while (consumed < TEST_FIFO_LEN)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                           &m_fifo[3U * consumed], TEST_FIFO_LEN - consumed));
+        consumed += stream.num_samples;
+        messages++;
+    }
+
+    // 39 + 39 + 22 samples, 3 notifications per second at 100 Hz.
+    TEST_ASSERT_EQUAL (3U, messages);
+    TEST_ASSERT_EQUAL (22U, stream.num_samples);
+    TEST_ASSERT_EQUAL (3U, stream.sequence);
+}
+
+void test_re_imu_stream_roundtrip (void)
+{
+    re_imu_stream_t stream = {.source = RE_ACC_XYZ, .sequence = 7U, .sample_rate_hz = 100U};
+    re_imu_stream_t decoded = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                       m_fifo, TEST_FIFO_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_decode (m_msg,
+                       RE_IMU_LENGTH (stream.num_samples), &decoded, m_x, m_y, m_z));
+    TEST_ASSERT_EQUAL (RE_ACC_XYZ, decoded.source);
+    TEST_ASSERT_EQUAL (7U, decoded.sequence);
+    TEST_ASSERT_EQUAL (100U, decoded.sample_rate_hz);
+    TEST_ASSERT_EQUAL (stream.num_samples, decoded.num_samples);
+
+    for (size_t ii = 0; ii < decoded.num_samples; ii++)
+    {
+        TEST_ASSERT_EQUAL (lrintf (m_fifo[3U * ii] * 1000.0F), lrintf (m_x[ii] * 1000.0F));
+        TEST_ASSERT_EQUAL (lrintf (m_fifo[ (3U * ii) + 1U] * 1000.0F),
+                           lrintf (m_y[ii] * 1000.0F));
+        TEST_ASSERT_EQUAL (1000, lrintf (m_z[ii] * 1000.0F));
+    }
+}
+
+void test_re_imu_stream_gyration_saturates (void)
+{
+    const re_float sample[3] = {3500.0F, -3500.0F, NAN};
+    re_imu_stream_t stream = {.source = RE_GYR_XYZ, .sample_rate_hz = 50U};
+    re_imu_stream_t decoded = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                       sample, 1U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_decode (m_msg, RE_IMU_LENGTH (1U),
+                       &decoded, m_x, m_y, m_z));
+    TEST_ASSERT_EQUAL (32767, lrintf (m_x[0] * RE_IMU_GYRATION_SF));
+    TEST_ASSERT_EQUAL (-32767, lrintf (m_y[0] * RE_IMU_GYRATION_SF));
+    TEST_ASSERT_TRUE (isnan (m_z[0]));
+}
+
+void test_re_imu_stream_encode_invalid (void)
+{
+    re_imu_stream_t stream = {.source = RE_ACC_X, .sample_rate_hz = 100U};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_imu_stream_encode (NULL, sizeof (m_msg), &stream,
+                       m_fifo, 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                       NULL, 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_imu_stream_encode (m_msg, sizeof (m_msg),
+                       &stream, m_fifo, 1U));
+    stream.source = RE_ACC_XYZ;
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_imu_stream_encode (m_msg, sizeof (m_msg),
+                       &stream, m_fifo, 0U));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_imu_stream_encode (m_msg,
+                       RE_IMU_LENGTH (1U) - 1U, &stream, m_fifo, 1U));
+    TEST_ASSERT_EQUAL (0U, stream.sequence);
+}
+
+void test_re_imu_stream_decode_invalid (void)
+{
+    re_imu_stream_t stream = {.source = RE_ACC_XYZ, .sample_rate_hz = 100U};
+    re_imu_stream_t decoded = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_imu_stream_encode (m_msg, sizeof (m_msg), &stream,
+                       m_fifo, 2U));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_imu_stream_decode (m_msg, RE_IMU_LENGTH (2U),
+                       &decoded, m_x, NULL, m_z));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_imu_stream_decode (m_msg,
+                       RE_IMU_HEADER_LEN - 1U, &decoded, m_x, m_y, m_z));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_imu_stream_decode (m_msg,
+                       RE_IMU_LENGTH (2U) - 1U, &decoded, m_x, m_y, m_z));
+    m_msg[RE_STANDARD_SOURCE_INDEX] = RE_ACC_X;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_imu_stream_decode (m_msg,
+                       RE_IMU_LENGTH (2U), &decoded, m_x, m_y, m_z));
+    m_msg[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_VALUE_WRITE;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CMD, re_imu_stream_decode (m_msg,
+                       RE_IMU_LENGTH (2U), &decoded, m_x, m_y, m_z));
+}
@@ -0,0 +1,296 @@
+#include "unity.h"
+
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_log_airq.h"
+
+#define TEST_RECORDS (3U)
+
+static const uint8_t valid_record[] =
+{
+    0x65, 0x4F, 0x1A, 0x00,            // Timestamp
+    0xE1,                              // Data format
+    0x17, 0x0C,                        // Temperature
+    0x56, 0x68,                        // Humidity
+    0xC7, 0x9E,                        // Pressure
+    0x00, 0x65,                        // PM1.0
+    0x00, 0x70,                        // PM2.5
+    0x04, 0xBD,                        // PM4.0
+    0x11, 0xCA,                        // PM10.0
+    0x00, 0xC9,                        // CO2
+    0x05,                              // VOC
+    0x01,                              // NOX
+    0x13, 0xE0, 0xAC,                  // Luminosity
+    0x3D,                              // Sound inst
+    0x4A,                              // Sound avg
+    0x9C,                              // Sound peak
+    0xDE, 0xCD, 0xEE,                  // Seq cnt
+    0x00,                              // Flags
+    0x12,                              // FW version
+    0xFF, 0xFF, 0xFF, 0xFF             // Reserved
+};
+
+static re_log_airq_record_t m_record;
+
+void
+setUp (void)
+{
+    static const re_e1_data_t data =
+    {
+        .temperature_c     = 29.5f,
+        .humidity_rh       = 55.3f,
+        .pressure_pa       = 101102.0f,
+        .pm1p0_ppm         = 10.1f,
+        .pm2p5_ppm         = 11.2f,
+        .pm4p0_ppm         = 121.3f,
+        .pm10p0_ppm        = 455.4f,
+        .co2               = 201,
+        .voc               = 10,
+        .nox               = 2,
+        .luminosity        = 13027,
+        .sound_inst_dba    = 42.4f,
+        .sound_avg_dba     = 47.6f,
+        .sound_peak_spl_db = 80.4f,
+        .seq_cnt           = 0xDECDEE,
+        .address           = 0,
+    };
+    memset (&m_record, 0, sizeof (m_record));
+    m_record.timestamp_s = 0x654F1A00U;
+    m_record.fw_version = 0x12U;
+    m_record.measurement = data;
+}
+
+void
+tearDown (void)
+{
+}
+
+void
+test_re_log_airq_encode_ok (void)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    _Static_assert (sizeof (valid_record) == RE_LOG_WRITE_AIRQ_RECORD_LEN, "record length");
+    memset (record, 0xA5, sizeof (record));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_encode (record, &m_record));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (valid_record, record, sizeof (valid_record));
+}
+
+void
+test_re_log_airq_payload_matches_e1 (void)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    uint8_t e1_payload[RE_E1_DATA_LENGTH];
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_encode (record, &m_record));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_e1_encode (e1_payload, &m_record.measurement));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (e1_payload, &record[RE_LOG_WRITE_AIRQ_PAYLOAD_OFS],
+                                  RE_LOG_WRITE_AIRQ_FW_VER_OFS - RE_LOG_WRITE_AIRQ_PAYLOAD_OFS);
+}
+
+void
+test_re_log_airq_decode_ok (void)
+{
+    re_log_airq_record_t decoded;
+    memset (&decoded, 0xA5, sizeof (decoded));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_decode (valid_record, &decoded));
+    TEST_ASSERT_EQUAL_UINT32 (0x654F1A00U, decoded.timestamp_s);
+    TEST_ASSERT_EQUAL_HEX8 (0x12U, decoded.fw_version);
+    TEST_ASSERT_EQUAL_FLOAT (29.5f, decoded.measurement.temperature_c);
+    TEST_ASSERT_EQUAL_FLOAT (55.3f, decoded.measurement.humidity_rh);
+    TEST_ASSERT_EQUAL_FLOAT (101102.0f, decoded.measurement.pressure_pa);
+    TEST_ASSERT_EQUAL_FLOAT (10.1f, decoded.measurement.pm1p0_ppm);
+    TEST_ASSERT_EQUAL_FLOAT (11.2f, decoded.measurement.pm2p5_ppm);
+    TEST_ASSERT_EQUAL_FLOAT (121.3f, decoded.measurement.pm4p0_ppm);
+    TEST_ASSERT_EQUAL_FLOAT (455.4f, decoded.measurement.pm10p0_ppm);
+    TEST_ASSERT_EQUAL_FLOAT (201.0f, decoded.measurement.co2);
+    TEST_ASSERT_EQUAL_FLOAT (10.0f, decoded.measurement.voc);
+    TEST_ASSERT_EQUAL_FLOAT (2.0f, decoded.measurement.nox);
+    TEST_ASSERT_EQUAL_FLOAT (13027.0f, decoded.measurement.luminosity);
+    TEST_ASSERT_EQUAL_FLOAT (42.4f, decoded.measurement.sound_inst_dba);
+    TEST_ASSERT_EQUAL_FLOAT (47.6f, decoded.measurement.sound_avg_dba);
+    TEST_ASSERT_EQUAL_FLOAT (80.4f, decoded.measurement.sound_peak_spl_db);
+    TEST_ASSERT_EQUAL_UINT32 (0xDECDEEU, decoded.measurement.seq_cnt);
+    TEST_ASSERT_FALSE (decoded.measurement.flags.flag_button_pressed);
+    TEST_ASSERT_EQUAL (0, decoded.measurement.address);
+}
+
+void
+test_re_log_airq_invalid_roundtrip (void)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    re_log_airq_record_t decoded;
+    m_record.measurement = re_e1_data_invalid (RE_E1_INVALID_SEQUENCE, 0);
+    m_record.measurement.flags.flag_button_pressed = true;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_encode (record, &m_record));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_decode (record, &decoded));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.temperature_c));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.pm10p0_ppm));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.voc));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.nox));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.luminosity));
+    TEST_ASSERT_TRUE (isnan (decoded.measurement.sound_peak_spl_db));
+    TEST_ASSERT_EQUAL_UINT32 (RE_E1_INVALID_SEQUENCE, decoded.measurement.seq_cnt);
+    TEST_ASSERT_TRUE (decoded.measurement.flags.flag_button_pressed);
+    TEST_ASSERT_FALSE (decoded.measurement.flags.flag_calibration_in_progress);
+}
+
+void
+test_re_log_airq_decode_wrong_format (void)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    re_log_airq_record_t decoded;
+    memcpy (record, valid_record, sizeof (record));
+    record[RE_LOG_WRITE_AIRQ_DATA_FORMAT_OFS] = 0x06U;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_airq_decode (record, &decoded));
+}
+
+void
+test_re_log_airq_null (void)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    re_log_airq_record_t decoded;
+    re_log_airq_columns_t columns = { 0 };
+    re_log_multi_t log = { 0 };
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_encode (NULL, &m_record));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_encode (record, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_decode (NULL, &decoded));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_decode (valid_record, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_decode_columns (NULL, &columns));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_decode_columns (&log, &columns));
+    log.p_records = valid_record;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_airq_decode_columns (&log, NULL));
+}
+
+/**
+ * @brief Build a LOG_MULTI message of TEST_RECORDS records, temperature
+ *        and sequence counter increase by record.
+ */
+static size_t
+build_message (uint8_t * const p_msg, const size_t msg_len)
+{
+    uint8_t record[RE_LOG_WRITE_AIRQ_RECORD_LEN];
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (p_msg, RE_ENV_AIRQ,
+                       RE_LOG_WRITE_AIRQ_RECORD_LEN));
+
+    for (size_t ii = 0; ii < TEST_RECORDS; ii++)
+    {
+        m_record.timestamp_s = 1000U + (60U * ii);
+        m_record.measurement.temperature_c = 20.0f + (re_float) ii;
+        m_record.measurement.seq_cnt = (re_e1_seq_cnt_t) ii;
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_encode (record, &m_record));
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_record (p_msg, msg_len, record));
+    }
+
+    return re_log_write_multi_length (p_msg);
+}
+
+void
+test_re_log_airq_decode_columns_ok (void)
+{
+    uint8_t msg[RE_LOG_WRITE_MULTI_HEADER_LEN + (TEST_RECORDS * RE_LOG_WRITE_AIRQ_RECORD_LEN)];
+    uint32_t timestamps[TEST_RECORDS];
+    re_float temperatures[TEST_RECORDS];
+    re_float co2[TEST_RECORDS];
+    re_float voc[TEST_RECORDS];
+    re_float luminosity[TEST_RECORDS];
+    re_e1_seq_cnt_t seq[TEST_RECORDS];
+    re_e1_flags_t flags[TEST_RECORDS];
+    re_log_airq_columns_t columns = { 0 };
+    re_log_multi_t log;
+    columns.p_timestamps_s = timestamps;
+    columns.p_temperature_c = temperatures;
+    columns.p_co2 = co2;
+    columns.p_voc = voc;
+    columns.p_luminosity = luminosity;
+    columns.p_seq_cnt = seq;
+    columns.p_flags = flags;
+    const size_t msg_len = build_message (msg, sizeof (msg));
+    TEST_ASSERT_EQUAL (sizeof (msg), msg_len);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (msg, msg_len, &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_decode_columns (&log, &columns));
+
+    for (size_t ii = 0; ii < TEST_RECORDS; ii++)
+    {
+        TEST_ASSERT_EQUAL_UINT32 (1000U + (60U * ii), timestamps[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (20.0f + (re_float) ii, temperatures[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (201.0f, co2[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (10.0f, voc[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (13027.0f, luminosity[ii]);
+        TEST_ASSERT_EQUAL_UINT32 (ii, seq[ii]);
+        TEST_ASSERT_FALSE (flags[ii].flag_rtc_running_on_boot);
+    }
+}
+
+void
+test_re_log_airq_decode_columns_matches_single (void)
+{
+    uint8_t msg[RE_LOG_WRITE_MULTI_HEADER_LEN + (TEST_RECORDS * RE_LOG_WRITE_AIRQ_RECORD_LEN)];
+    re_float humidity[TEST_RECORDS];
+    re_float pm2p5[TEST_RECORDS];
+    re_float nox[TEST_RECORDS];
+    re_float sound_avg[TEST_RECORDS];
+    re_log_airq_columns_t columns = { 0 };
+    re_log_multi_t log;
+    columns.p_humidity_rh = humidity;
+    columns.p_pm2p5_ppm = pm2p5;
+    columns.p_nox = nox;
+    columns.p_sound_avg_dba = sound_avg;
+    const size_t msg_len = build_message (msg, sizeof (msg));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (msg, msg_len, &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_airq_decode_columns (&log, &columns));
+
+    for (size_t ii = 0; ii < TEST_RECORDS; ii++)
+    {
+        re_log_airq_record_t decoded;
+        TEST_ASSERT_EQUAL (RE_SUCCESS,
+                           re_log_airq_decode (&log.p_records[ii * RE_LOG_WRITE_AIRQ_RECORD_LEN],
+                                               &decoded));
+        TEST_ASSERT_EQUAL_FLOAT (decoded.measurement.humidity_rh, humidity[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (decoded.measurement.pm2p5_ppm, pm2p5[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (decoded.measurement.nox, nox[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (decoded.measurement.sound_avg_dba, sound_avg[ii]);
+    }
+}
+
+void
+test_re_log_airq_decode_columns_bad_record (void)
+{
+    uint8_t msg[RE_LOG_WRITE_MULTI_HEADER_LEN + (TEST_RECORDS * RE_LOG_WRITE_AIRQ_RECORD_LEN)];
+    uint32_t timestamps[TEST_RECORDS];
+    re_float temperatures[TEST_RECORDS];
+    re_e1_seq_cnt_t seq[TEST_RECORDS];
+    re_log_airq_columns_t columns = { 0 };
+    re_log_multi_t log;
+    columns.p_timestamps_s = timestamps;
+    columns.p_temperature_c = temperatures;
+    columns.p_seq_cnt = seq;
+    const size_t msg_len = build_message (msg, sizeof (msg));
+    msg[RE_LOG_WRITE_MULTI_HEADER_LEN + RE_LOG_WRITE_AIRQ_RECORD_LEN
+        + RE_LOG_WRITE_AIRQ_DATA_FORMAT_OFS] = 0x06U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (msg, msg_len, &log));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_log_airq_decode_columns (&log, &columns));
+    TEST_ASSERT_EQUAL_FLOAT (20.0f, temperatures[0]);
+    TEST_ASSERT_EQUAL_UINT32 (1060U, timestamps[1]);
+    TEST_ASSERT_TRUE (isnan (temperatures[1]));
+    TEST_ASSERT_EQUAL_UINT32 (RE_E1_INVALID_SEQUENCE, seq[1]);
+    TEST_ASSERT_EQUAL_FLOAT (22.0f, temperatures[2]);
+}
+
+void
+test_re_log_airq_decode_columns_wrong_records (void)
+{
+    uint8_t msg[RE_LOG_WRITE_MULTI_HEADER_LEN + (TEST_RECORDS * RE_LOG_WRITE_AIRQ_RECORD_LEN)];
+    re_float temperatures[TEST_RECORDS];
+    re_log_airq_columns_t columns = { 0 };
+    re_log_multi_t log;
+    columns.p_temperature_c = temperatures;
+    const size_t msg_len = build_message (msg, sizeof (msg));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (msg, msg_len, &log));
+    log.source = RE_ENV_TEMP;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_airq_decode_columns (&log, &columns));
+    log.source = RE_ENV_AIRQ;
+    log.record_len = RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_airq_decode_columns (&log, &columns));
+}
@@ -0,0 +1,233 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_log_delta.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_MTU_PAYLOAD (244U)  //!< ATT MTU 247 - 3.
+#define TEST_T0_MS       (1700000000000ULL)
+#define TEST_INTERVAL_MS (300000ULL)
+
+static uint8_t m_msg[TEST_MTU_PAYLOAD];
+static re_log_delta_encoder_t m_enc;
+static re_log_delta_decoder_t m_dec;
+
+void setUp (void)
+{
+    memset (m_msg, 0xA5, sizeof (m_msg));
+    memset (&m_enc, 0, sizeof (m_enc));
+    memset (&m_dec, 0, sizeof (m_dec));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_log_delta_encode_header (void)
+{
+    static const uint8_t expected[] =
+    {
+        0x30, 0x30, 0x01,       // Source, op, samples.
+        0x65, 0x53, 0xF1, 0x00, // Timestamp 1700000000
+        0x00, 0x00, 0x08, 0xCF  // 22.55 C
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_LOG_DELTA_HEADER_LEN, m_enc.length);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS, 22.55F));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY (expected, &m_msg[RE_STANDARD_SOURCE_INDEX], sizeof (expected));
+    TEST_ASSERT_EQUAL (RE_LOG_DELTA_HEADER_LEN, m_enc.length);
+}
+
+void test_re_log_delta_fixed_interval_is_compact (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+
+    for (uint32_t ii = 0; ii < 10U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc,
+                           TEST_T0_MS + (ii * TEST_INTERVAL_MS), 21.0F + (0.01F * (re_float) ii)));
+    }
+
+    // Second sample sets the 300 s interval in a 2-byte varint, later ones
+    // have zero delta-of-delta and 1 byte of value delta.
+    TEST_ASSERT_EQUAL (RE_LOG_DELTA_HEADER_LEN + 3U + (8U * 2U), m_enc.length);
+    TEST_ASSERT_EQUAL (10U, m_msg[RE_LOG_DELTA_NUM_SAMPLES_IDX]);
+}
+
+void test_re_log_delta_roundtrip (void)
+{
+    static const re_float values[] = { -40.0F, -39.99F, 12.34F, 12.34F, 85.0F, -0.02F };
+    static const uint64_t offsets_ms[] = { 0U, 60000U, 120000U, 190000U, 7200000U, 7201000U };
+    uint32_t timestamp_s = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+
+    for (size_t ii = 0; ii < (sizeof (values) / sizeof (values[0])); ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc,
+                           TEST_T0_MS + offsets_ms[ii], values[ii]));
+    }
+
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_start (&m_dec, m_msg, m_enc.length));
+    TEST_ASSERT_EQUAL (6U, m_dec.remaining);
+
+    for (size_t ii = 0; ii < (sizeof (values) / sizeof (values[0])); ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+        TEST_ASSERT_EQUAL_UINT32 ( (uint32_t) ( (TEST_T0_MS + offsets_ms[ii]) / 1000U),
+                                   timestamp_s);
+        TEST_ASSERT_EQUAL_FLOAT (values[ii], value);
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_delta_decode_next (&m_dec, &timestamp_s,
+                       &value));
+}
+
+void test_re_log_delta_extreme_values_roundtrip (void)
+{
+    uint32_t timestamp_s = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_PRESSURE));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, 0U, -2.0e9F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, 0xFFFFFFFFULL * 1000U,
+                       2.0e9F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, 0U, -2.0e9F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_start (&m_dec, m_msg, m_enc.length));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL_UINT32 (0U, timestamp_s);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL_UINT32 (0xFFFFFFFFU, timestamp_s);
+    TEST_ASSERT_EQUAL_FLOAT (2.0e9F, value);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL_UINT32 (0U, timestamp_s);
+    TEST_ASSERT_EQUAL_FLOAT (-2.0e9F, value);
+}
+
+void test_re_log_delta_decode_invalid_is_nan (void)
+{
+    uint32_t timestamp_s = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS, 22.5F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS + 60000U,
+                       22.6F));
+    // First value logged as invalid, second one is still a delta of 0.1 from it.
+    memset (&m_msg[RE_LOG_DELTA_VALUE_MSB_IDX], 0xFF, 4U);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_start (&m_dec, m_msg, m_enc.length));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_TRUE (isnan (value));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL_FLOAT (0.09F, value);
+}
+
+void test_re_log_delta_message_full (void)
+{
+    size_t length = 0;
+    size_t samples = 0;
+    re_status_t err_code = RE_SUCCESS;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_HUMIDITY));
+
+    while (RE_SUCCESS == err_code)
+    {
+        length = m_enc.length;
+        // Large swings need multi-byte varints.
+        err_code = re_log_delta_encode_value (&m_enc, TEST_T0_MS + (samples * 1000U),
+                                              (0U == (samples & 1U)) ? 0.0F : 99.0F);
+        samples += (RE_SUCCESS == err_code) ? 1U : 0U;
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, err_code);
+    TEST_ASSERT_EQUAL (length, m_enc.length);
+    TEST_ASSERT_TRUE (m_enc.length <= sizeof (m_msg));
+    TEST_ASSERT_EQUAL (samples, m_msg[RE_LOG_DELTA_NUM_SAMPLES_IDX]);
+}
+
+void test_re_log_delta_max_samples (void)
+{
+    static uint8_t big[RE_LOG_DELTA_HEADER_LEN + (2U * RE_LOG_DELTA_MAX_SAMPLES)];
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, big, sizeof (big),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+
+    for (uint32_t ii = 0; ii < RE_LOG_DELTA_MAX_SAMPLES; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS, 20.0F));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_delta_encode_value (&m_enc, TEST_T0_MS,
+                       20.0F));
+}
+
+void test_re_log_delta_encode_errors (void)
+{
+    TEST_ASSERT_EQUAL (RE_ERROR_NOT_IMPLEMENTED, re_log_delta_encode_start (&m_enc, m_msg,
+                       sizeof (m_msg), RE_STANDARD_DESTINATION_ADC_BATTERY));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_delta_encode_start (&m_enc, m_msg,
+                       RE_LOG_DELTA_HEADER_LEN - 1U, RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_delta_encode_start (NULL, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_delta_encode_value (&m_enc, 0U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_delta_encode_value (&m_enc, 0U, NAN));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_delta_encode_value (&m_enc,
+                       0x100000000ULL * 1000U, 1.0F));
+    TEST_ASSERT_EQUAL (0U, m_msg[RE_LOG_DELTA_NUM_SAMPLES_IDX]);
+}
+
+void test_re_log_delta_decode_truncated (void)
+{
+    uint32_t timestamp_s = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS, 1.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc,
+                       TEST_T0_MS + TEST_INTERVAL_MS, 2.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_start (&m_dec, m_msg,
+                       m_enc.length - 1U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_log_delta_decode_next (&m_dec, &timestamp_s,
+                       &value));
+    TEST_ASSERT_EQUAL (0U, m_dec.remaining);
+}
+
+void test_re_log_delta_decode_overlong_varint (void)
+{
+    uint32_t timestamp_s = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_value (&m_enc, TEST_T0_MS, 1.0F));
+    m_msg[RE_LOG_DELTA_NUM_SAMPLES_IDX] = 2U;
+    memset (&m_msg[RE_LOG_DELTA_PAYLOAD_IDX], 0xFF, RE_LOG_DELTA_VARINT_MAX_LEN + 2U);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_start (&m_dec, m_msg, sizeof (m_msg)));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_decode_next (&m_dec, &timestamp_s, &value));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_log_delta_decode_next (&m_dec, &timestamp_s,
+                       &value));
+}
+
+void test_re_log_delta_decode_start_errors (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_delta_encode_start (&m_enc, m_msg, sizeof (m_msg),
+                       RE_STANDARD_DESTINATION_TEMPERATURE));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_log_delta_decode_start (&m_dec, m_msg,
+                       RE_LOG_DELTA_HEADER_LEN - 1U));
+    m_msg[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_MULTI_WRITE;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CMD, re_log_delta_decode_start (&m_dec, m_msg,
+                       sizeof (m_msg)));
+    m_msg[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_DELTA_WRITE;
+    m_msg[RE_STANDARD_SOURCE_INDEX] = RE_STANDARD_DESTINATION_RTC;
+    TEST_ASSERT_EQUAL (RE_ERROR_NOT_IMPLEMENTED, re_log_delta_decode_start (&m_dec, m_msg,
+                       sizeof (m_msg)));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_delta_decode_start (&m_dec, NULL, 0U));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_delta_decode_next (&m_dec, NULL, NULL));
+}
@@ -0,0 +1,245 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_log_reader.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_ROWS      (8U)
+#define TEST_MAX_MSGS  (32U)
+#define TEST_NOW_S     (1700000000U)
+#define TEST_TAG_NOW_S (1000000U)
+
+static uint32_t m_timestamps[TEST_ROWS];
+static re_float m_temperatures[TEST_ROWS];
+static re_float m_humidities[TEST_ROWS];
+static re_float m_pressures[TEST_ROWS];
+static re_log_reader_t m_reader;
+static uint8_t m_stream[TEST_MAX_MSGS * RE_STANDARD_MESSAGE_LENGTH];
+static size_t m_stream_len;
+
+static const uint8_t m_sources[] =
+{
+    RE_STANDARD_DESTINATION_TEMPERATURE,
+    RE_STANDARD_DESTINATION_HUMIDITY,
+    RE_STANDARD_DESTINATION_PRESSURE
+};
+
+static void make_request (uint8_t * const p_request, const uint32_t start_s)
+{
+    memset (p_request, 0, RE_STANDARD_MESSAGE_LENGTH);
+    p_request[RE_STANDARD_DESTINATION_INDEX] = RE_STANDARD_DESTINATION_ENVIRONMENTAL;
+    p_request[RE_STANDARD_SOURCE_INDEX] = RE_STANDARD_DESTINATION_ENVIRONMENTAL;
+    p_request[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_VALUE_READ;
+    p_request[RE_LOG_READ_CURRENT_MSB_IDX] = (uint8_t) (TEST_NOW_S >> 24U);
+    p_request[RE_LOG_READ_CURRENT_B2_IDX] = (uint8_t) (TEST_NOW_S >> 16U);
+    p_request[RE_LOG_READ_CURRENT_B3_IDX] = (uint8_t) (TEST_NOW_S >> 8U);
+    p_request[RE_LOG_READ_CURRENT_LSB_IDX] = (uint8_t) TEST_NOW_S;
+    p_request[RE_LOG_READ_START_MSB_IDX] = (uint8_t) (start_s >> 24U);
+    p_request[RE_LOG_READ_START_B2_IDX] = (uint8_t) (start_s >> 16U);
+    p_request[RE_LOG_READ_START_B3_IDX] = (uint8_t) (start_s >> 8U);
+    p_request[RE_LOG_READ_START_LSB_IDX] = (uint8_t) start_s;
+}
+
+/** @brief Append a log value as sent by the tag, timestamp in tag clock. */
+static void push_value (const uint8_t source, const uint32_t tag_ts_s, const re_float value)
+{
+    uint8_t * const p_msg = &m_stream[m_stream_len];
+    memset (p_msg, 0, RE_STANDARD_MESSAGE_LENGTH);
+    p_msg[RE_STANDARD_DESTINATION_INDEX] = RE_STANDARD_DESTINATION_ENVIRONMENTAL;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_header (p_msg, source));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_timestamp (p_msg, tag_ts_s * 1000ULL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_data (p_msg, value, source));
+    m_stream_len += RE_STANDARD_MESSAGE_LENGTH;
+}
+
+static void push_end (void)
+{
+    uint8_t * const p_msg = &m_stream[m_stream_len];
+    memset (p_msg, RE_LOG_READER_END_MARKER, RE_STANDARD_MESSAGE_LENGTH);
+    p_msg[RE_STANDARD_DESTINATION_INDEX] = RE_STANDARD_DESTINATION_ENVIRONMENTAL;
+    (void) re_log_write_header (p_msg, RE_STANDARD_DESTINATION_ENVIRONMENTAL);
+    m_stream_len += RE_STANDARD_MESSAGE_LENGTH;
+}
+
+static void start (const uint32_t start_s)
+{
+    uint8_t request[RE_STANDARD_MESSAGE_LENGTH];
+    make_request (request, start_s);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_start (&m_reader, request, TEST_TAG_NOW_S));
+}
+
+void setUp (void)
+{
+    re_log_reader_columns_t columns = { 0 };
+    columns.p_timestamps_s = m_timestamps;
+    columns.p_values[0] = m_temperatures;
+    columns.p_values[1] = m_humidities;
+    columns.p_values[2] = m_pressures;
+    columns.capacity = TEST_ROWS;
+    m_stream_len = 0;
+    memset (&m_reader, 0xA5, sizeof (m_reader));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_init (&m_reader, &columns, m_sources,
+                       sizeof (m_sources)));
+    start (0);
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_log_reader_interleaved (void)
+{
+    size_t consumed = 0;
+
+    for (uint32_t ii = 0; ii < 3U; ii++)
+    {
+        const uint32_t ts = TEST_TAG_NOW_S - 600U + (ii * 300U);
+        push_value (RE_STANDARD_DESTINATION_TEMPERATURE, ts, 20.0F + (re_float) ii);
+        push_value (RE_STANDARD_DESTINATION_HUMIDITY, ts, 40.0F + (re_float) ii);
+        push_value (RE_STANDARD_DESTINATION_PRESSURE, ts, 100000.0F + (re_float) ii);
+    }
+
+    push_end();
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, m_stream, m_stream_len,
+                       &consumed));
+    TEST_ASSERT_EQUAL (m_stream_len, consumed);
+    TEST_ASSERT_TRUE (m_reader.complete);
+    TEST_ASSERT_EQUAL (3, m_reader.num_rows);
+
+    for (uint32_t ii = 0; ii < 3U; ii++)
+    {
+        TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 600U + (ii * 300U), m_timestamps[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (20.0F + (re_float) ii, m_temperatures[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (40.0F + (re_float) ii, m_humidities[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (100000.0F + (re_float) ii, m_pressures[ii]);
+    }
+}
+
+void test_re_log_reader_source_by_source (void)
+{
+    const uint32_t ts0 = TEST_TAG_NOW_S - 900U;
+
+    for (uint32_t ii = 0; ii < 4U; ii++)
+    {
+        push_value (RE_STANDARD_DESTINATION_TEMPERATURE, ts0 + (ii * 300U), 21.0F);
+    }
+
+    // Humidity only for every other sample.
+    push_value (RE_STANDARD_DESTINATION_HUMIDITY, ts0, 51.0F);
+    push_value (RE_STANDARD_DESTINATION_HUMIDITY, ts0 + 600U, 53.0F);
+    // Pressure has a sample between temperature samples.
+    push_value (RE_STANDARD_DESTINATION_PRESSURE, ts0 + 150U, 99000.0F);
+    push_value (RE_STANDARD_DESTINATION_PRESSURE, ts0 + 900U, 99100.0F);
+    push_end();
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, m_stream, m_stream_len,
+                       NULL));
+    TEST_ASSERT_EQUAL (5, m_reader.num_rows);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 900U, m_timestamps[0]);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 750U, m_timestamps[1]);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 600U, m_timestamps[2]);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 300U, m_timestamps[3]);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S, m_timestamps[4]);
+    TEST_ASSERT_EQUAL_FLOAT (51.0F, m_humidities[0]);
+    TEST_ASSERT_TRUE (isnan (m_temperatures[1]));
+    TEST_ASSERT_TRUE (isnan (m_humidities[1]));
+    TEST_ASSERT_EQUAL_FLOAT (99000.0F, m_pressures[1]);
+    TEST_ASSERT_TRUE (isnan (m_humidities[2]));
+    TEST_ASSERT_EQUAL_FLOAT (53.0F, m_humidities[3]);
+    TEST_ASSERT_EQUAL_FLOAT (21.0F, m_temperatures[4]);
+    TEST_ASSERT_EQUAL_FLOAT (99100.0F, m_pressures[4]);
+    TEST_ASSERT_TRUE (isnan (m_pressures[0]));
+}
+
+void test_re_log_reader_split_batches (void)
+{
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S - 10U, 1.0F);
+    push_value (RE_STANDARD_DESTINATION_HUMIDITY, TEST_TAG_NOW_S - 10U, 2.0F);
+    push_end();
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, m_stream,
+                       RE_STANDARD_MESSAGE_LENGTH, NULL));
+    TEST_ASSERT_FALSE (m_reader.complete);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader,
+                       &m_stream[RE_STANDARD_MESSAGE_LENGTH],
+                       m_stream_len - RE_STANDARD_MESSAGE_LENGTH, NULL));
+    TEST_ASSERT_TRUE (m_reader.complete);
+    TEST_ASSERT_EQUAL (1, m_reader.num_rows);
+    TEST_ASSERT_EQUAL_FLOAT (2.0F, m_humidities[0]);
+}
+
+void test_re_log_reader_storage_full (void)
+{
+    size_t consumed = 0;
+
+    for (uint32_t ii = 0; ii < (TEST_ROWS + 2U); ii++)
+    {
+        push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S - 100U + ii,
+                    (re_float) ii);
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_reader_consume (&m_reader, m_stream,
+                       m_stream_len, &consumed));
+    TEST_ASSERT_EQUAL (TEST_ROWS * RE_STANDARD_MESSAGE_LENGTH, consumed);
+    TEST_ASSERT_EQUAL (TEST_ROWS, m_reader.num_rows);
+    re_log_reader_clear_rows (&m_reader);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, &m_stream[consumed],
+                       m_stream_len - consumed, &consumed));
+    TEST_ASSERT_EQUAL (2, m_reader.num_rows);
+    TEST_ASSERT_EQUAL_FLOAT ( (re_float) TEST_ROWS, m_temperatures[0]);
+    TEST_ASSERT_EQUAL_UINT32 (TEST_NOW_S - 100U + TEST_ROWS + 1U, m_timestamps[1]);
+}
+
+void test_re_log_reader_drops_old_and_unknown (void)
+{
+    start (TEST_NOW_S - 100U);
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S - 200U, 1.0F);
+    push_value (RE_STANDARD_DESTINATION_ACCELERATION_X, TEST_TAG_NOW_S - 50U, 1.0F);
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S - 50U, 2.0F);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, m_stream, m_stream_len,
+                       NULL));
+    TEST_ASSERT_EQUAL (2, m_reader.num_dropped);
+    TEST_ASSERT_EQUAL (1, m_reader.num_rows);
+    TEST_ASSERT_EQUAL_FLOAT (2.0F, m_temperatures[0]);
+}
+
+void test_re_log_reader_bad_messages (void)
+{
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S, 1.0F);
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S + 1U, 2.0F);
+    m_stream[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_VALUE_WRITE;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CMD | RE_ERROR_DECODING_LEN,
+                       re_log_reader_consume (&m_reader, m_stream, m_stream_len - 1U, NULL));
+    TEST_ASSERT_EQUAL (0, m_reader.num_rows);
+}
+
+void test_re_log_reader_ignores_after_end (void)
+{
+    push_end();
+    push_value (RE_STANDARD_DESTINATION_TEMPERATURE, TEST_TAG_NOW_S, 1.0F);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_reader_consume (&m_reader, m_stream, m_stream_len,
+                       NULL));
+    TEST_ASSERT_TRUE (m_reader.complete);
+    TEST_ASSERT_EQUAL (0, m_reader.num_rows);
+}
+
+void test_re_log_reader_invalid_params (void)
+{
+    re_log_reader_columns_t columns = { 0 };
+    uint8_t request[RE_STANDARD_MESSAGE_LENGTH];
+    columns.p_timestamps_s = m_timestamps;
+    columns.p_values[0] = m_temperatures;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_reader_init (&m_reader, &columns, m_sources, 2U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_reader_init (&m_reader, &columns,
+                       m_sources, 0U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_reader_init (&m_reader, &columns,
+                       m_sources, RE_LOG_READER_MAX_SOURCES + 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_reader_init (NULL, &columns, m_sources, 1U));
+    make_request (request, 0);
+    request[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_VALUE_WRITE;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_reader_start (&m_reader, request, 0));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_reader_start (&m_reader, NULL, 0));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_reader_consume (&m_reader, NULL, 0, NULL));
+    re_log_reader_clear_rows (NULL);
+}
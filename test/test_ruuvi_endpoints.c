@@ -1,6 +1,8 @@
 #include "unity.h"
 
 #include "ruuvi_endpoints.h"
+#include <math.h>
+#include <string.h>
 
 void setUp (void)
 {
@@ -302,4 +304,440 @@ void test_log_write_data_gyrz_positive_round_up (void)
     TEST_ASSERT (0x00U == buffer[RE_LOG_WRITE_VALUE_B2_IDX]);
     TEST_ASSERT (0x06U == buffer[RE_LOG_WRITE_VALUE_B3_IDX]);
     TEST_ASSERT (0x0BU == buffer[RE_LOG_WRITE_VALUE_LSB_IDX]);
-}
\ No newline at end of file
+}
+void test_re_log_write_multi_header_ok (void)
+{
+    uint8_t buffer[RE_LOG_WRITE_MULTI_HEADER_LEN] = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_ENV_TEMP, buffer[RE_STANDARD_SOURCE_INDEX]);
+    TEST_ASSERT_EQUAL (RE_STANDARD_LOG_MULTI_WRITE, buffer[RE_STANDARD_OPERATION_INDEX]);
+    TEST_ASSERT_EQUAL (0, buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]);
+    TEST_ASSERT_EQUAL (RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN,
+                       buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX]);
+    TEST_ASSERT_EQUAL (RE_LOG_WRITE_MULTI_HEADER_LEN, re_log_write_multi_length (buffer));
+}
+
+void test_re_log_write_multi_header_invalid (void)
+{
+    uint8_t buffer[RE_LOG_WRITE_MULTI_HEADER_LEN] = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_multi_header (NULL, RE_ENV_TEMP, 8U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_multi_header (buffer,
+                       RE_ENV_TEMP, 0U));
+    TEST_ASSERT_EQUAL (0, re_log_write_multi_length (NULL));
+}
+
+void test_re_log_write_multi_value_fills_mtu (void)
+{
+    // Default ATT MTU 23 leaves 20 bytes of notification payload: 5 + 8 + 8 - 1.
+    uint8_t buffer[20U] = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value (buffer, sizeof (buffer),
+                       1000U, 22.554F));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_value (buffer,
+                       sizeof (buffer), 2000U, 22.554F));
+    TEST_ASSERT_EQUAL (1, buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]);
+    TEST_ASSERT_EQUAL (13, re_log_write_multi_length (buffer));
+    // Same bytes as in test_log_write_data_temperature_positive_round_down.
+    const uint8_t expected[RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN] =
+    {
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x08, 0xCF
+    };
+    TEST_ASSERT_EQUAL_MEMORY (expected, &buffer[RE_LOG_WRITE_MULTI_PAYLOAD_IDX],
+                              sizeof (expected));
+}
+
+void test_re_log_write_multi_value_errors_not_appended (void)
+{
+    uint8_t buffer[64U] = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_multi_value (NULL, sizeof (buffer),
+                       1000U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_multi_value (buffer,
+                       sizeof (buffer), 1000U, NAN));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_multi_value (buffer,
+                       sizeof (buffer), 0x100000000000U, 1.0F));
+    TEST_ASSERT_EQUAL (0, buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP, 4U));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_value (buffer,
+                       sizeof (buffer), 1000U, 1.0F));
+}
+
+void test_re_log_write_multi_record_max_records (void)
+{
+    static uint8_t buffer[RE_LOG_WRITE_MULTI_HEADER_LEN + RE_LOG_WRITE_MULTI_MAX_RECORDS + 1U];
+    const uint8_t record = 0xA5U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_AIRQ, 1U));
+
+    for (size_t ii = 0; ii < RE_LOG_WRITE_MULTI_MAX_RECORDS; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_record (buffer, sizeof (buffer),
+                           &record));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_record (buffer,
+                       sizeof (buffer), &record));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_multi_record (buffer, sizeof (buffer),
+                       NULL));
+}
+
+void test_re_log_multi_roundtrip (void)
+{
+    // ATT MTU 247 fits 29 value records.
+    uint8_t buffer[244U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamps[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    re_float values[RE_LOG_WRITE_MULTI_MAX_RECORDS];
+    size_t num_written = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_HUMI,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+
+    while (RE_SUCCESS == re_log_write_multi_value (buffer, sizeof (buffer),
+            (1600000000U + num_written * 300U) * 1000U, 40.0F - (re_float) num_written))
+    {
+        num_written++;
+    }
+
+    TEST_ASSERT_EQUAL (29, num_written);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer,
+                       re_log_write_multi_length (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_ENV_HUMI, log.source);
+    TEST_ASSERT_EQUAL (29, log.num_records);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_values (&log, timestamps, values));
+
+    for (size_t ii = 0; ii < num_written; ii++)
+    {
+        TEST_ASSERT_EQUAL (1600000000U + ii * 300U, timestamps[ii]);
+        TEST_ASSERT_EQUAL (lrintf ( (40.0F - (re_float) ii) * 100.0F),
+                           lrintf (values[ii] * 100.0F));
+    }
+}
+
+void test_re_log_multi_decode_negative_value (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamp = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value (buffer, sizeof (buffer),
+                       5000U, -12.34F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_values (&log, &timestamp, &value));
+    TEST_ASSERT_EQUAL (5, timestamp);
+    TEST_ASSERT_EQUAL (-1234, lrintf (value * 100.0F));
+}
+
+void test_re_log_multi_decode_invalid_value_is_nan (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamp = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value (buffer, sizeof (buffer),
+                       5000U, 22.5F));
+    memset (&buffer[RE_LOG_WRITE_MULTI_PAYLOAD_IDX + RE_LOG_WRITE_MULTI_VALUE_MSB_OFS],
+            0xFF, 4U);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_values (&log, &timestamp, &value));
+    TEST_ASSERT_TRUE (isnan (value));
+}
+
+void test_re_log_multi_decode_invalid (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamp = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_multi_decode (NULL, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_log_multi_decode (buffer,
+                       RE_LOG_WRITE_MULTI_HEADER_LEN - 1U, &log));
+    buffer[RE_STANDARD_OPERATION_INDEX] = RE_STANDARD_LOG_VALUE_WRITE;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CMD, re_log_multi_decode (buffer,
+                       sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX] = 4U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_log_multi_decode (buffer,
+                       sizeof (buffer), &log));
+    buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX] = 1U;
+    buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX] = 0U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_log_multi_decode (buffer,
+                       sizeof (buffer), &log));
+    buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX] = 4U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_multi_decode_values (&log,
+                       &timestamp, &value));
+    buffer[RE_STANDARD_SOURCE_INDEX] = RE_ENV_AIRQ;
+    buffer[RE_LOG_WRITE_MULTI_RECORD_LEN_IDX] = RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_ERROR_NOT_IMPLEMENTED, re_log_multi_decode_values (&log,
+                       &timestamp, &value));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_multi_decode_values (&log, NULL, &value));
+}
+
+void test_re_log_write_env_record_ok (void)
+{
+    uint8_t record[RE_LOG_WRITE_ENV_RECORD_LEN] = {0};
+    const re_log_env_t env =
+    {
+        .temperature_c = 22.554F,
+        .humidity_rh = 45.67F,
+        .pressure_pa = 100325.0F
+    };
+    const uint8_t expected[RE_LOG_WRITE_ENV_RECORD_LEN] =
+    {
+        0x00, 0x00, 0x00, 0x01, 0x08, 0xCF, 0x11, 0xD7, 0xC4, 0x95
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_env_record (record, 1000U, &env));
+    TEST_ASSERT_EQUAL_MEMORY (expected, record, sizeof (expected));
+}
+
+void test_re_log_write_multi_env_fills_mtu (void)
+{
+    // One notification of 20 bytes replaces three 11-byte value messages.
+    uint8_t buffer[20U] = {0};
+    const re_log_env_t env = {.temperature_c = 1.0F, .humidity_rh = 2.0F, .pressure_pa = 3.0F};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_ALL,
+                       RE_LOG_WRITE_ENV_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_env (buffer, sizeof (buffer),
+                       1000U, &env));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_env (buffer,
+                       sizeof (buffer), 2000U, &env));
+    TEST_ASSERT_EQUAL (15, re_log_write_multi_length (buffer));
+}
+
+void test_re_log_multi_env_roundtrip (void)
+{
+    uint8_t buffer[244U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamps[3];
+    re_log_env_t decoded[3];
+    const re_log_env_t env[3] =
+    {
+        {.temperature_c = -12.34F, .humidity_rh = 0.0F, .pressure_pa = 50000.0F},
+        {.temperature_c = NAN, .humidity_rh = NAN, .pressure_pa = NAN},
+        {.temperature_c = -400.0F, .humidity_rh = 700.0F, .pressure_pa = 200000.0F}
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_ALL,
+                       RE_LOG_WRITE_ENV_RECORD_LEN));
+
+    for (size_t ii = 0; ii < 3U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_env (buffer, sizeof (buffer),
+                           (1600000000U + ii * 300U) * 1000U, &env[ii]));
+    }
+
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer,
+                       re_log_write_multi_length (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_env (&log, timestamps, decoded));
+    TEST_ASSERT_EQUAL (1600000300U, timestamps[1]);
+    TEST_ASSERT_EQUAL (-1234, lrintf (decoded[0].temperature_c * 100.0F));
+    TEST_ASSERT_EQUAL (0, lrintf (decoded[0].humidity_rh * 100.0F));
+    TEST_ASSERT_EQUAL (50000, lrintf (decoded[0].pressure_pa));
+    TEST_ASSERT_TRUE (isnan (decoded[1].temperature_c));
+    TEST_ASSERT_TRUE (isnan (decoded[1].humidity_rh));
+    TEST_ASSERT_TRUE (isnan (decoded[1].pressure_pa));
+    TEST_ASSERT_EQUAL (-32767, lrintf (decoded[2].temperature_c * 100.0F));
+    TEST_ASSERT_EQUAL (65534, lrintf (decoded[2].humidity_rh * 100.0F));
+    TEST_ASSERT_EQUAL (115534, lrintf (decoded[2].pressure_pa));
+}
+
+void test_re_log_multi_env_invalid (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint32_t timestamp = 0;
+    re_log_env_t env = {0};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_env_record (buffer, 1000U, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_env_record (buffer,
+                       0x100000000000U, &env));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_TEMP,
+                       RE_LOG_WRITE_ENV_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_env (buffer,
+                       sizeof (buffer), 1000U, &env));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_ALL,
+                       RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_env (buffer,
+                       sizeof (buffer), 1000U, &env));
+    TEST_ASSERT_EQUAL (0, buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]);
+    TEST_ASSERT_EQUAL (RE_ERROR_NOT_IMPLEMENTED, re_log_write_data (buffer, 1.0F,
+                       RE_ENV_ALL));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ENV_ALL,
+                       RE_LOG_WRITE_ENV_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode (buffer, sizeof (buffer), &log));
+    log.source = RE_ENV_TEMP;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_multi_decode_env (&log, &timestamp,
+                       &env));
+    log.source = RE_ENV_ALL;
+    log.record_len = RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_multi_decode_env (&log, &timestamp,
+                       &env));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_multi_decode_env (&log, NULL, &env));
+}
+
+void test_re_log_multi_ms_roundtrip (void)
+{
+    // Accelerometer events 10 ms apart keep their order.
+    uint8_t buffer[64U] = {0};
+    re_log_multi_t log = {0};
+    uint64_t timestamps[5];
+    re_float values[5];
+    const uint64_t start_ms = 1600000000123U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_ms_header (buffer, RE_ACC_X));
+    TEST_ASSERT_EQUAL (RE_STANDARD_LOG_MULTI_MS_WRITE, buffer[RE_STANDARD_OPERATION_INDEX]);
+
+    for (size_t ii = 0; ii < 5U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value_ms (buffer, sizeof (buffer),
+                           start_ms + ii * 10U, -1.5F + (re_float) ii));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_value_ms (buffer,
+                       sizeof (buffer), start_ms, 1.0F));
+    TEST_ASSERT_EQUAL (55, re_log_write_multi_length (buffer));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_CMD, re_log_multi_decode (buffer,
+                       sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_ms_decode (buffer,
+                       re_log_write_multi_length (buffer), &log));
+    TEST_ASSERT_EQUAL (5, log.num_records);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_values_ms (&log, timestamps, values));
+
+    for (size_t ii = 0; ii < 5U; ii++)
+    {
+        TEST_ASSERT_TRUE ( (start_ms + ii * 10U) == timestamps[ii]);
+        TEST_ASSERT_EQUAL (lrintf ( (-1.5F + (re_float) ii) * 1000.0F),
+                           lrintf (values[ii] * 1000.0F));
+    }
+}
+
+void test_re_log_multi_ms_record_bytes (void)
+{
+    uint8_t buffer[32U] = {0};
+    const uint8_t expected[RE_LOG_WRITE_MULTI_MS_RECORD_LEN] =
+    {
+        0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0x00, 0x00, 0x08, 0xCF
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_ms_header (buffer, RE_ENV_TEMP));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value_ms (buffer, sizeof (buffer),
+                       0x0123456789ABU, 22.554F));
+    TEST_ASSERT_EQUAL_MEMORY (expected, &buffer[RE_LOG_WRITE_MULTI_PAYLOAD_IDX],
+                              sizeof (expected));
+}
+
+void test_re_log_multi_ms_invalid_value_is_nan (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint64_t timestamp = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_ms_header (buffer, RE_ENV_TEMP));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_value_ms (buffer, sizeof (buffer),
+                       5000U, 22.5F));
+    memset (&buffer[RE_LOG_WRITE_MULTI_PAYLOAD_IDX + RE_LOG_WRITE_MULTI_MS_VALUE_MSB_OFS],
+            0xFF, 4U);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_ms_decode (buffer, sizeof (buffer), &log));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_decode_values_ms (&log, &timestamp,
+                       &value));
+    TEST_ASSERT_TRUE (isnan (value));
+}
+
+void test_re_log_multi_ms_invalid (void)
+{
+    uint8_t buffer[32U] = {0};
+    re_log_multi_t log = {0};
+    uint64_t timestamp = 0;
+    re_float value = 0;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_multi_ms_header (NULL, RE_ACC_X));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_multi_value_ms (NULL, sizeof (buffer),
+                       0U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_header (buffer, RE_ACC_X,
+                       RE_LOG_WRITE_MULTI_MS_RECORD_LEN));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_log_write_multi_value_ms (buffer,
+                       sizeof (buffer), 0U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_multi_ms_header (buffer, RE_ACC_X));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_multi_value_ms (buffer,
+                       sizeof (buffer), RE_LOG_WRITE_MULTI_MS_TS_MAX + 1U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_write_multi_value_ms (buffer,
+                       sizeof (buffer), 0U, NAN));
+    TEST_ASSERT_EQUAL (0, buffer[RE_LOG_WRITE_MULTI_NUM_RECORDS_IDX]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_multi_ms_decode (buffer, sizeof (buffer), &log));
+    log.record_len = RE_LOG_WRITE_MULTI_VALUE_RECORD_LEN;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_log_multi_decode_values_ms (&log,
+                       &timestamp, &value));
+    log.record_len = RE_LOG_WRITE_MULTI_MS_RECORD_LEN;
+    log.source = RE_ENV_ALL;
+    TEST_ASSERT_EQUAL (RE_ERROR_NOT_IMPLEMENTED, re_log_multi_decode_values_ms (&log,
+                       &timestamp, &value));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_multi_decode_values_ms (&log, NULL, &value));
+}
+
+static void test_batch_matches_scalar (const re_float * const p_data, const size_t num_values,
+                                       const uint8_t source)
+{
+    static uint8_t batch[64U * RE_STANDARD_MESSAGE_LENGTH];
+    static uint8_t scalar[64U * RE_STANDARD_MESSAGE_LENGTH];
+    re_status_t scalar_status = RE_SUCCESS;
+    TEST_ASSERT_TRUE (num_values <= 64U);
+    memset (batch, 0xA5, sizeof (batch));
+    memset (scalar, 0xA5, sizeof (scalar));
+
+    for (size_t ii = 0; ii < num_values; ii++)
+    {
+        scalar_status |= re_log_write_data (&scalar[ii * RE_STANDARD_MESSAGE_LENGTH],
+                                            p_data[ii], source);
+    }
+
+    TEST_ASSERT_EQUAL (scalar_status, re_log_write_data_batch (batch, p_data, num_values,
+                       source));
+    TEST_ASSERT_EQUAL_MEMORY (scalar, batch, sizeof (batch));
+}
+
+void test_re_log_write_data_batch_matches_scalar_edges (void)
+{
+    const re_float data[] =
+    {
+        0.0F, -0.0F, 0.004F, 0.005F, -0.005F, 0.015F, -22.554F, 22.555F,
+        8388607.5F, 8388609.0F, -8388609.0F, 16777217.0F, 21474836.0F, -21474836.0F,
+        21474837.0F, -21474837.0F, 1.0e30F, -1.0e30F, 3.4e38F, -3.4e38F
+    };
+    test_batch_matches_scalar (data, sizeof (data) / sizeof (data[0]), RE_ENV_TEMP);
+    test_batch_matches_scalar (data, sizeof (data) / sizeof (data[0]), RE_ENV_PRES);
+    test_batch_matches_scalar (data, sizeof (data) / sizeof (data[0]), RE_ACC_X);
+}
+
+void test_re_log_write_data_batch_matches_scalar_sweep (void)
+{
+    re_float data[64U];
+    uint32_t state = 12345U;
+
+    for (size_t round = 0; round < 200U; round++)
+    {
+        for (size_t ii = 0; ii < 64U; ii++)
+        {
+            // Random bit patterns cover every exponent, including NAN and inf.
+            state = (state * 1103515245U) + 12345U;
+            const uint32_t bits = state ^ (state >> 7U);
+            memcpy (&data[ii], &bits, sizeof (data[ii]));
+        }
+
+        test_batch_matches_scalar (data, 64U, RE_ENV_HUMI);
+    }
+}
+
+void test_re_log_write_data_batch_invalid (void)
+{
+    uint8_t messages[3U * RE_STANDARD_MESSAGE_LENGTH] = {0};
+    const re_float data[3] = {1.0F, NAN, -INFINITY};
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_data_batch (NULL, data, 3U, RE_ENV_TEMP));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_log_write_data_batch (messages, NULL, 3U,
+                       RE_ENV_TEMP));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_log_write_data_batch (messages, data, 0U, RE_ENV_TEMP));
+    test_batch_matches_scalar (data, 3U, RE_ENV_TEMP);
+    test_batch_matches_scalar (data, 3U, RE_ENV_ALL);
+}
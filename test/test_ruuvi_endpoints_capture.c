@@ -0,0 +1,190 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_endpoints_capture.h"
+
+#include <string.h>
+
+#define TEST_SEGMENT_LEN  (32768U)
+#define TEST_FRAME_MAX    (64U)
+#define TEST_NUM_RECORDS  (1000U)
+#define TEST_FRAME_LEN    RE_CA_UART_TX_BUF_LEN (RE_CA_UART_TX_DATA_LEN_CMD_FLTR_ID())
+#define TEST_READ_MAX     (16U)
+
+static uint8_t m_segment[TEST_SEGMENT_LEN];
+static re_capture_writer_t m_writer;
+static re_capture_reader_t m_reader;
+static const uint8_t * m_frames[TEST_READ_MAX];
+static size_t m_lens[TEST_READ_MAX];
+static uint64_t m_times[TEST_READ_MAX];
+
+/** @brief Encode a filter ID command with given manufacturer ID. */
+static uint8_t test_frame (uint8_t * const p_frame, const uint16_t manufacturer_id)
+{
+    re_ca_uart_payload_t payload = {0};
+    uint8_t frame_len = TEST_FRAME_MAX;
+    payload.cmd = RE_CA_UART_SET_FLTR_ID;
+    payload.params.fltr_id_param.id = manufacturer_id;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ca_uart_encode (p_frame, &frame_len, &payload));
+    return frame_len;
+}
+
+static void test_append (const uint64_t time, const uint16_t manufacturer_id)
+{
+    uint8_t frame[TEST_FRAME_MAX] = {0};
+    const uint8_t frame_len = test_frame (frame, manufacturer_id);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_append (&m_writer, time, frame, frame_len));
+}
+
+static uint16_t test_manufacturer_id (const uint8_t * const p_frame, const size_t len)
+{
+    re_ca_uart_payload_t payload = {0};
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_ca_uart_decode_checked (p_frame, len, &payload));
+    return payload.params.fltr_id_param.id;
+}
+
+void setUp (void)
+{
+    memset (m_segment, 0xA5, sizeof (m_segment));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_create (&m_writer, m_segment,
+                       sizeof (m_segment)));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_capture_create_invalid (void)
+{
+    re_capture_writer_t writer;
+    size_t num_records = 0;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_capture_create (NULL, m_segment,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_capture_create (&writer, NULL,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_capture_create (&writer, m_segment,
+                       RE_CAPTURE_HEADER_LEN + RE_CAPTURE_INDEX_ENTRY_LEN));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_capture_open (NULL, m_segment,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_capture_read (&m_reader, NULL, NULL, NULL,
+                       TEST_READ_MAX, &num_records));
+}
+
+void test_re_capture_round_trip_zero_copy (void)
+{
+    uint8_t frame[TEST_FRAME_MAX] = {0};
+    size_t num_records = 0;
+    const uint8_t frame_len = test_frame (frame, 0x0499U);
+    // Bytes received after ETX are not stored.
+    frame[frame_len] = 0xFFU;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_append (&m_writer, 100U, frame,
+                       frame_len + 1U));
+    test_append (100U, 0x0001U);
+    test_append (250U, 0x0002U);
+    TEST_ASSERT_EQUAL (3U, m_writer.num_records);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_open (&m_reader, m_segment,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, m_lens, m_times,
+                       TEST_READ_MAX, &num_records));
+    TEST_ASSERT_EQUAL (3U, num_records);
+    TEST_ASSERT_EQUAL (TEST_FRAME_LEN, m_lens[0]);
+    TEST_ASSERT_EQUAL_MEMORY (frame, m_frames[0], frame_len);
+    TEST_ASSERT_TRUE ( (m_frames[0] > m_segment)
+                       && (m_frames[0] < &m_segment[sizeof (m_segment)]));
+    TEST_ASSERT_EQUAL (0x0499U, test_manufacturer_id (m_frames[0], m_lens[0]));
+    TEST_ASSERT_EQUAL (0x0001U, test_manufacturer_id (m_frames[1], m_lens[1]));
+    TEST_ASSERT_EQUAL (0x0002U, test_manufacturer_id (m_frames[2], m_lens[2]));
+    TEST_ASSERT_EQUAL_UINT64 (100U, m_times[1]);
+    TEST_ASSERT_EQUAL_UINT64 (250U, m_times[2]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, NULL, NULL,
+                       TEST_READ_MAX, &num_records));
+    TEST_ASSERT_EQUAL (0U, num_records);
+}
+
+void test_re_capture_append_rejects (void)
+{
+    uint8_t frame[TEST_FRAME_MAX] = {0};
+    uint8_t small[RE_CAPTURE_HEADER_LEN + (2U * RE_CAPTURE_INDEX_ENTRY_LEN)
+                  + RE_CAPTURE_RECORD_HEADER_LEN + TEST_FRAME_LEN];
+    re_capture_writer_t writer;
+    const uint8_t frame_len = test_frame (frame, 0x0499U);
+    test_append (1000U, 0x0001U);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_capture_append (&m_writer, 999U, frame,
+                       frame_len));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_capture_append (&m_writer, 1000U, frame,
+                       frame_len - 1U));
+    frame[RE_CA_UART_HEADER_SIZE] ^= 0x01U;
+    TEST_ASSERT (RE_SUCCESS != re_capture_append (&m_writer, 1000U, frame, frame_len));
+    TEST_ASSERT_EQUAL (1U, m_writer.num_records);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_create (&writer, small, sizeof (small)));
+    frame[RE_CA_UART_HEADER_SIZE] ^= 0x01U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_append (&writer, 1U, frame, frame_len));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_capture_append (&writer, 2U, frame,
+                       frame_len));
+    TEST_ASSERT_EQUAL (1U, writer.num_records);
+}
+
+void test_re_capture_seek_by_index (void)
+{
+    size_t num_records = 0;
+
+    for (uint32_t ii = 0; ii < TEST_NUM_RECORDS; ii++)
+    {
+        // Pairs of records share a receive time.
+        test_append (10U * (ii / 2U), (uint16_t) ii);
+    }
+
+    // One entry per stride of records.
+    TEST_ASSERT_EQUAL ( ( (TEST_NUM_RECORDS * (RE_CAPTURE_RECORD_HEADER_LEN + TEST_FRAME_LEN))
+                          + RE_CAPTURE_INDEX_STRIDE - 1U) / RE_CAPTURE_INDEX_STRIDE,
+                        m_writer.num_index);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_open (&m_reader, m_segment,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_seek (&m_reader, 3000U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, m_lens, m_times,
+                       2U, &num_records));
+    TEST_ASSERT_EQUAL (2U, num_records);
+    TEST_ASSERT_EQUAL_UINT64 (3000U, m_times[0]);
+    TEST_ASSERT_EQUAL (600U, test_manufacturer_id (m_frames[0], m_lens[0]));
+    TEST_ASSERT_EQUAL (601U, test_manufacturer_id (m_frames[1], m_lens[1]));
+    // Between records, next one.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_seek (&m_reader, 1234U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, m_lens, m_times,
+                       1U, &num_records));
+    TEST_ASSERT_EQUAL_UINT64 (1240U, m_times[0]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_seek (&m_reader, 0U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, m_lens, m_times,
+                       1U, &num_records));
+    TEST_ASSERT_EQUAL (0U, test_manufacturer_id (m_frames[0], m_lens[0]));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_seek (&m_reader, 10U * TEST_NUM_RECORDS));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_read (&m_reader, m_frames, m_lens, m_times,
+                       1U, &num_records));
+    TEST_ASSERT_EQUAL (0U, num_records);
+}
+
+void test_re_capture_open_corrupt (void)
+{
+    uint8_t header[RE_CAPTURE_HEADER_LEN];
+    size_t num_records = 0;
+    test_append (1U, 0x0001U);
+    test_append (2U, 0x0002U);
+    memcpy (header, m_segment, sizeof (header));
+    m_segment[0] = 'X';
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_capture_open (&m_reader, m_segment,
+                       sizeof (m_segment)));
+    m_segment[0] = header[0];
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING, re_capture_open (&m_reader, m_segment,
+                       RE_CAPTURE_HEADER_LEN - 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_capture_open (&m_reader, m_segment,
+                       m_writer.data_start + m_writer.data_len - 1U));
+    // Record cut short, e.g. by a crash while copying: earlier records are read.
+    m_segment[RE_CAPTURE_HEADER_LEN - 5U] -= 1U; // LSB of bytes of records.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_capture_open (&m_reader, m_segment,
+                       sizeof (m_segment)));
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_capture_read (&m_reader, m_frames, m_lens,
+                       m_times, TEST_READ_MAX, &num_records));
+    TEST_ASSERT_EQUAL (1U, num_records);
+    TEST_ASSERT_EQUAL_UINT64 (1U, m_times[0]);
+}
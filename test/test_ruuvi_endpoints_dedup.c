@@ -0,0 +1,267 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_dedup.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+
+#include <string.h>
+
+#define TEST_CAPACITY  (8U)
+#define TEST_WINDOW_MS (100U)
+#define TEST_MAX_RELEASED (8U)
+
+static const uint8_t m_df5_header[] = {0x02, 0x01, 0x04, 0x1B, 0xFF, 0x99, 0x04, 0x05};
+static const uint8_t m_df6_header[] =
+{
+    0x02, 0x01, 0x06, 0x03, 0x03, 0x98, 0xFC, 0x17, 0xFF, 0x99, 0x04, 0x06
+};
+static const uint8_t m_df7_header[] = {0x02, 0x01, 0x04, 0x17, 0xFF, 0x99, 0x04, 0x07};
+static const uint8_t m_e1_header[] = {0x2B, 0xFF, 0x99, 0x04, 0xE1};
+static const uint8_t m_mac[RE_CA_UART_MAC_BYTES] = {0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F};
+
+static re_dedup_entry_t m_entries[TEST_CAPACITY];
+static re_dedup_t m_dedup;
+static re_ca_uart_ble_adv_t m_released[TEST_MAX_RELEASED];
+static size_t m_num_released;
+
+static void release (const re_ca_uart_ble_adv_t * const p_adv, void * const p_context)
+{
+    TEST_ASSERT_EQUAL_PTR (&m_num_released, p_context);
+
+    if (m_num_released < TEST_MAX_RELEASED)
+    {
+        memcpy (&m_released[m_num_released], p_adv, sizeof (re_ca_uart_ble_adv_t));
+    }
+
+    m_num_released++;
+}
+
+static void make_df5 (re_ca_uart_ble_adv_t * const p_adv, const uint16_t sequence,
+                      const int8_t rssi_db)
+{
+    memset (p_adv, 0, sizeof (re_ca_uart_ble_adv_t));
+    memcpy (p_adv->mac, m_mac, sizeof (m_mac));
+    memcpy (p_adv->adv, m_df5_header, sizeof (m_df5_header));
+    p_adv->adv[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_MSB] = (uint8_t) (sequence >> 8U);
+    p_adv->adv[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_LSB] = (uint8_t) sequence;
+    p_adv->adv_len = RE_5_RAW_MIN_LEN;
+    p_adv->rssi_db = rssi_db;
+}
+
+void setUp (void)
+{
+    m_num_released = 0;
+    memset (m_released, 0, sizeof (m_released));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_init (&m_dedup, m_entries, TEST_CAPACITY,
+                       TEST_WINDOW_MS, &release, &m_num_released));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_dedup_init_invalid (void)
+{
+    re_dedup_t dedup;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_init (NULL, m_entries, TEST_CAPACITY,
+                       TEST_WINDOW_MS, &release, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_init (&dedup, NULL, TEST_CAPACITY,
+                       TEST_WINDOW_MS, &release, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_init (&dedup, m_entries, TEST_CAPACITY,
+                       TEST_WINDOW_MS, NULL, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_init (&dedup, m_entries, 6U,
+                       TEST_WINDOW_MS, &release, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_init (&dedup, m_entries, 0U,
+                       TEST_WINDOW_MS, &release, NULL));
+}
+
+void test_re_dedup_counter_read_formats (void)
+{
+    uint8_t raw[RE_E1_RAW_MIN_LEN] = {0};
+    uint8_t data_format = 0;
+    uint32_t counter = 0;
+    memcpy (raw, m_df5_header, sizeof (m_df5_header));
+    raw[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_MSB] = 0x12U;
+    raw[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_LSB] = 0x34U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_counter_read (raw, RE_5_RAW_MIN_LEN,
+                       &data_format, &counter));
+    TEST_ASSERT_EQUAL (RE_5_DESTINATION, data_format);
+    TEST_ASSERT_EQUAL (0x1234U, counter);
+    memset (raw, 0, sizeof (raw));
+    memcpy (raw, m_df6_header, sizeof (m_df6_header));
+    raw[RE_6_OFFSET_PAYLOAD + RE_6_OFFSET_SEQ_CNT2] = 0xFFU;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_counter_read (raw, RE_6_RAW_BUF_SIZE,
+                       &data_format, &counter));
+    TEST_ASSERT_EQUAL (RE_6_DESTINATION, data_format);
+    TEST_ASSERT_EQUAL (0xFFU, counter);
+    memset (raw, 0, sizeof (raw));
+    memcpy (raw, m_df7_header, sizeof (m_df7_header));
+    raw[RE_7_OFFSET_PAYLOAD + RE_7_OFFSET_SEQ] = 0x42U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_counter_read (raw, RE_7_RAW_MIN_LEN,
+                       &data_format, &counter));
+    TEST_ASSERT_EQUAL (RE_7_DESTINATION, data_format);
+    TEST_ASSERT_EQUAL (0x42U, counter);
+    memset (raw, 0, sizeof (raw));
+    memcpy (raw, m_e1_header, sizeof (m_e1_header));
+    raw[RE_E1_OFFSET_PAYLOAD + RE_E1_OFFSET_SEQ_CNT_MSB] = 0xABU;
+    raw[RE_E1_OFFSET_PAYLOAD + RE_E1_OFFSET_SEQ_CNT_MID] = 0xCDU;
+    raw[RE_E1_OFFSET_PAYLOAD + RE_E1_OFFSET_SEQ_CNT_LSB] = 0xEFU;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_counter_read (raw, RE_E1_RAW_MIN_LEN,
+                       &data_format, &counter));
+    TEST_ASSERT_EQUAL (RE_E1_DESTINATION, data_format);
+    TEST_ASSERT_EQUAL (0xABCDEFU, counter);
+}
+
+void test_re_dedup_counter_read_invalid (void)
+{
+    uint8_t raw[RE_E1_RAW_MIN_LEN] = {0};
+    uint8_t data_format = 0;
+    uint32_t counter = 0;
+    memcpy (raw, m_df5_header, sizeof (m_df5_header));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_counter_read (NULL, RE_5_RAW_MIN_LEN,
+                       &data_format, &counter));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_counter_read (raw, RE_5_RAW_MIN_LEN,
+                       NULL, &counter));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_counter_read (raw, RE_5_RAW_MIN_LEN,
+                       &data_format, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_counter_read (raw,
+                       RE_5_RAW_MIN_LEN - 1U, &data_format, &counter));
+    raw[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_MSB] = 0xFFU;
+    raw[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_LSB] = 0xFFU;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_counter_read (raw,
+                       RE_5_RAW_MIN_LEN, &data_format, &counter));
+    memset (raw, 0, sizeof (raw));
+    memcpy (raw, m_df7_header, sizeof (m_df7_header));
+    raw[RE_7_OFFSET_PAYLOAD + RE_7_OFFSET_SEQ] = RE_7_INVALID_SEQUENCE;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_counter_read (raw,
+                       RE_7_RAW_MIN_LEN, &data_format, &counter));
+    memset (raw, 0, sizeof (raw));
+    memcpy (raw, m_e1_header, sizeof (m_e1_header));
+    memset (&raw[RE_E1_OFFSET_PAYLOAD + RE_E1_OFFSET_SEQ_CNT_MSB], 0xFF, 3U);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_counter_read (raw,
+                       RE_E1_RAW_MIN_LEN, &data_format, &counter));
+    // iBeacon and other formats have no counter.
+    memset (raw, 0, sizeof (raw));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_dedup_counter_read (raw, sizeof (raw),
+                       &data_format, &counter));
+}
+
+void test_re_dedup_keeps_best_rssi (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    re_dedup_action_t action = RE_DEDUP_PASSED;
+    make_df5 (&adv, 100U, -80);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1000U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_HELD, action);
+    adv.rssi_db = -60;
+    adv.ch_index = 38U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1010U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_REPLACED, action);
+    adv.rssi_db = -70;
+    adv.ch_index = 39U;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1020U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_DROPPED, action);
+    TEST_ASSERT_EQUAL (0U, m_num_released);
+    TEST_ASSERT_EQUAL (0U, re_dedup_flush (&m_dedup, 1099U));
+    TEST_ASSERT_EQUAL (1U, re_dedup_flush (&m_dedup, 1100U));
+    TEST_ASSERT_EQUAL (1U, m_num_released);
+    TEST_ASSERT_EQUAL (-60, m_released[0].rssi_db);
+    TEST_ASSERT_EQUAL (38U, m_released[0].ch_index);
+    TEST_ASSERT_EQUAL (2U, m_dedup.num_dropped);
+    // Late repeat of the released measurement.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1200U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_DROPPED, action);
+    TEST_ASSERT_EQUAL (0U, re_dedup_flush_all (&m_dedup));
+    TEST_ASSERT_EQUAL (1U, m_num_released);
+}
+
+void test_re_dedup_new_measurement_releases_held (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    re_dedup_action_t action = RE_DEDUP_PASSED;
+    make_df5 (&adv, 100U, -80);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1000U, &action));
+    make_df5 (&adv, 101U, -90);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1050U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_HELD, action);
+    TEST_ASSERT_EQUAL (1U, m_num_released);
+    TEST_ASSERT_EQUAL (100U, m_released[0].adv[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_LSB]);
+    TEST_ASSERT_EQUAL (1U, re_dedup_flush_all (&m_dedup));
+    TEST_ASSERT_EQUAL (2U, m_num_released);
+    TEST_ASSERT_EQUAL (101U, m_released[1].adv[RE_5_OFFSET_PAYLOAD + RE_5_OFFSET_SEQCTR_LSB]);
+}
+
+void test_re_dedup_passes_unknown (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    re_dedup_action_t action = RE_DEDUP_HELD;
+    make_df5 (&adv, RE_5_INVALID_SEQUENCE, -80);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1000U, &action));
+    TEST_ASSERT_EQUAL (RE_DEDUP_PASSED, action);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 1000U, NULL));
+    TEST_ASSERT_EQUAL (2U, m_num_released);
+    TEST_ASSERT_EQUAL (0U, m_dedup.num_dropped);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_push (NULL, &adv, 1000U, &action));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_dedup_push (&m_dedup, NULL, 1000U, &action));
+    TEST_ASSERT_EQUAL (0U, re_dedup_flush (NULL, 1000U));
+    TEST_ASSERT_EQUAL (0U, re_dedup_flush_all (NULL));
+}
+
+void test_re_dedup_flush_wraps (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    make_df5 (&adv, 7U, -80);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, 0xFFFFFFF0U, NULL));
+    TEST_ASSERT_EQUAL (0U, re_dedup_flush (&m_dedup, 0x10U));
+    TEST_ASSERT_EQUAL (1U, re_dedup_flush (&m_dedup, 0x60U));
+    TEST_ASSERT_EQUAL (1U, m_num_released);
+}
+
+void test_re_dedup_colliding_tags (void)
+{
+    re_dedup_entry_t entries[4U];
+    re_ca_uart_ble_adv_t adv_a;
+    re_ca_uart_ble_adv_t adv_b;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_init (&m_dedup, entries, 4U, TEST_WINDOW_MS,
+                       &release, &m_num_released));
+    // Both MACs have home slot 0 in a table of 4 entries.
+    make_df5 (&adv_a, 10U, -70);
+    make_df5 (&adv_b, 20U, -70);
+    adv_a.mac[RE_CA_UART_MAC_BYTES - 1U] = 0x00U;
+    adv_b.mac[RE_CA_UART_MAC_BYTES - 1U] = 0x05U;
+
+    for (uint32_t channel = 0; channel < 3U; channel++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv_a, channel, NULL));
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv_b, channel, NULL));
+    }
+
+    TEST_ASSERT_EQUAL (0U, m_num_released);
+    TEST_ASSERT_EQUAL (4U, m_dedup.num_dropped);
+    TEST_ASSERT_EQUAL (2U, re_dedup_flush_all (&m_dedup));
+    TEST_ASSERT_EQUAL (2U, m_num_released);
+}
+
+void test_re_dedup_full_bucket_releases_oldest (void)
+{
+    re_dedup_entry_t entries[RE_DEDUP_WAYS];
+    re_ca_uart_ble_adv_t adv;
+    re_dedup_action_t action = RE_DEDUP_PASSED;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_init (&m_dedup, entries, RE_DEDUP_WAYS,
+                       TEST_WINDOW_MS, &release, &m_num_released));
+    make_df5 (&adv, 10U, -70);
+
+    for (uint8_t tag = 0; tag <= RE_DEDUP_WAYS; tag++)
+    {
+        adv.mac[RE_CA_UART_MAC_BYTES - 1U] = tag;
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_dedup_push (&m_dedup, &adv, tag, &action));
+        TEST_ASSERT_EQUAL (RE_DEDUP_HELD, action);
+    }
+
+    TEST_ASSERT_EQUAL (1U, m_num_released);
+    TEST_ASSERT_EQUAL (0x00U, m_released[0].mac[RE_CA_UART_MAC_BYTES - 1U]);
+}
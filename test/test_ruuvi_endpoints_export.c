@@ -0,0 +1,211 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_export.h"
+#include "ruuvi_endpoints_text.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_e1.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_MAC (0xCBB8334C884FU)
+#define TEST_TIME_NS (1700000000000000000U)
+
+static const char m_df5_line[] =
+    "ruuvi,mac=CB:B8:33:4C:88:4F,dataFormat=5 temperature=24.3,humidity=53.49,"
+    "pressure=100044,accelX=0.004,accelY=-0.004,accelZ=1.036,voltage=2.977,txPower=4i,"
+    "movementCounter=66i,measurementSequenceNumber=205i 1700000000000000000\n";
+
+static re_export_prefix_t m_prefix;
+
+static re_5_data_t df5_data (void)
+{
+    re_5_data_t data =
+    {
+        .humidity_rh = 53.49F,
+        .pressure_pa = 100044.0F,
+        .temperature_c = 24.3F,
+        .accelerationx_g = 0.004F,
+        .accelerationy_g = -0.004F,
+        .accelerationz_g = 1.036F,
+        .battery_v = 2.977F,
+        .tx_power = 4,
+        .measurement_count = 205,
+        .movement_count = 66,
+        .address = TEST_MAC
+    };
+    return data;
+}
+
+void setUp (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_line_prefix (&m_prefix, "ruuvi",
+                       RE_5_DESTINATION, TEST_MAC));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_export_line_prefix (void)
+{
+    re_export_prefix_t prefix;
+    char name[RE_EXPORT_PREFIX_MAX_LEN];
+    TEST_ASSERT_EQUAL_STRING ("ruuvi,mac=CB:B8:33:4C:88:4F,dataFormat=5 ", m_prefix.text);
+    TEST_ASSERT_EQUAL (strlen (m_prefix.text), m_prefix.len);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM,
+                       re_export_line_prefix (&prefix, "", RE_5_DESTINATION, TEST_MAC));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM,
+                       re_export_line_prefix (&prefix, "ru uvi", RE_5_DESTINATION, TEST_MAC));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM,
+                       re_export_line_prefix (&prefix, "ru,uvi", RE_5_DESTINATION, TEST_MAC));
+    memset (name, 'a', sizeof (name) - 1U);
+    name[sizeof (name) - 1U] = '\0';
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE,
+                       re_export_line_prefix (&prefix, name, RE_5_DESTINATION, TEST_MAC));
+    TEST_ASSERT_EQUAL (0U, prefix.len);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL,
+                       re_export_line_prefix (NULL, "ruuvi", RE_5_DESTINATION, TEST_MAC));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL,
+                       re_export_line_prefix (&prefix, NULL, RE_5_DESTINATION, TEST_MAC));
+}
+
+void test_re_export_write_line_5 (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    size_t num_written = 0;
+    const re_5_data_t data = df5_data ();
+    const re_export_prefix_t * const p_prefix = &m_prefix;
+    const uint64_t timestamp = TEST_TIME_NS;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_line (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, &data, &p_prefix, &timestamp, 1U, &num_written));
+    TEST_ASSERT_EQUAL (1U, num_written);
+    TEST_ASSERT_EQUAL_STRING (m_df5_line, buf);
+    TEST_ASSERT_EQUAL (strlen (m_df5_line), offset);
+}
+
+void test_re_export_write_line_invalid_fields (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    size_t num_written = 0;
+    re_5_data_t data[2] = { df5_data (), df5_data () };
+    const re_export_prefix_t * const prefixes[2] = { &m_prefix, &m_prefix };
+    data[0].temperature_c = NAN;
+    data[0].humidity_rh = NAN;
+    data[0].pressure_pa = NAN;
+    data[0].accelerationx_g = NAN;
+    data[0].accelerationy_g = NAN;
+    data[0].accelerationz_g = NAN;
+    data[0].battery_v = NAN;
+    data[0].tx_power = RE_5_INVALID_POWER;
+    data[0].movement_count = RE_5_INVALID_MOVEMENT;
+    data[0].measurement_count = RE_5_INVALID_SEQUENCE;
+    data[1].humidity_rh = NAN;
+    data[1].tx_power = RE_5_INVALID_POWER;
+    data[1].measurement_count = RE_5_INVALID_SEQUENCE;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_line (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, prefixes, NULL, 2U, &num_written));
+    TEST_ASSERT_EQUAL (2U, num_written);
+    TEST_ASSERT_EQUAL_STRING ("ruuvi,mac=CB:B8:33:4C:88:4F,dataFormat=5 temperature=24.3,"
+                              "pressure=100044,accelX=0.004,accelY=-0.004,accelZ=1.036,"
+                              "voltage=2.977,movementCounter=66i\n", buf);
+}
+
+void test_re_export_write_line_full (void)
+{
+    char buf[ (2U * sizeof (m_df5_line)) - 1U];
+    size_t offset = 0;
+    size_t num_written = 0;
+    const re_5_data_t data[3] = { df5_data (), df5_data (), df5_data () };
+    const re_export_prefix_t * const prefixes[3] = { &m_prefix, &m_prefix, &m_prefix };
+    const uint64_t timestamps[3] = { TEST_TIME_NS, TEST_TIME_NS, TEST_TIME_NS };
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_export_write_line (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, prefixes, timestamps, 3U, &num_written));
+    TEST_ASSERT_EQUAL (2U, num_written);
+    TEST_ASSERT_EQUAL (sizeof (buf) - 1U, offset);
+    TEST_ASSERT_EQUAL ('\n', buf[offset - 1U]);
+    TEST_ASSERT_EQUAL ('\0', buf[offset]);
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_export_write_line (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, prefixes, timestamps, 3U, &num_written));
+    TEST_ASSERT_EQUAL (0U, num_written);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_export_write_line (buf, sizeof (buf),
+                       &offset, 0x03U, data, prefixes, timestamps, 3U, &num_written));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_export_write_line (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, NULL, timestamps, 3U, &num_written));
+}
+
+void test_re_export_write_csv_5 (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    size_t num_written = 0;
+    re_5_data_t data[2] = { df5_data (), df5_data () };
+    const uint64_t macs[2] = { TEST_MAC, 0xCBB8334C8850U };
+    const uint64_t timestamps[2] = { 1700000000U, 1700000001U };
+    data[1].temperature_c = NAN;
+    data[1].tx_power = RE_5_INVALID_POWER;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_csv_header (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_csv (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, macs, timestamps, 2U, &num_written));
+    TEST_ASSERT_EQUAL (2U, num_written);
+    TEST_ASSERT_EQUAL_STRING ("time,mac,dataFormat,temperature,humidity,pressure,accelX,"
+                              "accelY,accelZ,voltage,txPower,movementCounter,"
+                              "measurementSequenceNumber\n"
+                              "1700000000,CB:B8:33:4C:88:4F,5,24.3,53.49,100044,0.004,"
+                              "-0.004,1.036,2.977,4,66,205\n"
+                              "1700000001,CB:B8:33:4C:88:50,5,,53.49,100044,0.004,"
+                              "-0.004,1.036,2.977,,66,205\n", buf);
+    offset = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_csv (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, NULL, NULL, 1U, &num_written));
+    TEST_ASSERT_EQUAL_STRING (",,5,24.3,53.49,100044,0.004,-0.004,1.036,2.977,4,66,205\n",
+                              buf);
+}
+
+void test_re_export_write_csv_e1 (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    size_t num_written = 0;
+    const uint64_t timestamp = 1700000000U;
+    const re_e1_data_t data =
+    {
+        .temperature_c = 29.5F,
+        .humidity_rh = 55.3F,
+        .pressure_pa = 101102.0F,
+        .pm1p0_ppm = 10.1F,
+        .pm2p5_ppm = 11.2F,
+        .pm4p0_ppm = 121.3F,
+        .pm10p0_ppm = 455.4F,
+        .co2 = 201.0F,
+        .voc = 10.0F,
+        .nox = 2.0F,
+        .luminosity = 13027.0F,
+        .sound_inst_dba = NAN,
+        .sound_avg_dba = 47.6F,
+        .sound_peak_spl_db = NAN,
+        .seq_cnt = 14601710U,
+        .address = TEST_MAC
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_csv_header (buf, sizeof (buf), &offset,
+                       RE_E1_DESTINATION));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_export_write_csv (buf, sizeof (buf), &offset,
+                       RE_E1_DESTINATION, &data, &data.address, &timestamp, 1U,
+                       &num_written));
+    TEST_ASSERT_EQUAL_STRING ("time,mac,dataFormat,temperature,humidity,pressure,pm1p0,"
+                              "pm2p5,pm4p0,pm10p0,co2,voc,nox,luminosity,soundInstant,"
+                              "soundAverage,soundPeak,measurementSequenceNumber\n"
+                              "1700000000,CB:B8:33:4C:88:4F,225,29.5,55.3,101102,10.1,"
+                              "11.2,121.3,455.4,201,10,2,13027,,47.6,,14601710\n", buf);
+    offset = sizeof (buf) - 8U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_export_write_csv_header (buf, sizeof (buf),
+                       &offset, RE_E1_DESTINATION));
+    TEST_ASSERT_EQUAL (sizeof (buf) - 8U, offset);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_export_write_csv_header (buf, sizeof (buf),
+                       &offset, 0x03U));
+}
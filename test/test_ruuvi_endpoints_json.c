@@ -0,0 +1,224 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_json.h"
+#include "ruuvi_endpoints_text.h"
+#include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+
+#include <math.h>
+#include <string.h>
+
+static const char m_df5_json[] =
+    "{\"dataFormat\":5,\"temperature\":24.3,\"humidity\":53.49,\"pressure\":100044,"
+    "\"accelX\":0.004,\"accelY\":-0.004,\"accelZ\":1.036,\"voltage\":2.977,\"txPower\":4,"
+    "\"movementCounter\":66,\"measurementSequenceNumber\":205,\"mac\":\"CB:B8:33:4C:88:4F\"}";
+
+static re_5_data_t df5_data (void)
+{
+    re_5_data_t data =
+    {
+        .humidity_rh = 53.49F,
+        .pressure_pa = 100044.0F,
+        .temperature_c = 24.3F,
+        .accelerationx_g = 0.004F,
+        .accelerationy_g = -0.004F,
+        .accelerationz_g = 1.036F,
+        .battery_v = 2.977F,
+        .tx_power = 4,
+        .measurement_count = 205,
+        .movement_count = 66,
+        .address = 0xCBB8334C884FU
+    };
+    return data;
+}
+
+void setUp (void)
+{
+    // No action needed.
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_json_write_5_ok (void)
+{
+    char buf[256];
+    size_t offset = 0;
+    const re_5_data_t data = df5_data ();
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_5 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL_STRING (m_df5_json, buf);
+    TEST_ASSERT_EQUAL (strlen (m_df5_json), offset);
+}
+
+void test_re_json_write_5_invalid_fields_skipped (void)
+{
+    char buf[256];
+    size_t offset = 0;
+    re_5_data_t data = df5_data ();
+    data.temperature_c = NAN;
+    data.humidity_rh = -0.0001F;
+    data.accelerationx_g = NAN;
+    data.tx_power = RE_5_INVALID_POWER;
+    data.movement_count = RE_5_INVALID_MOVEMENT;
+    data.measurement_count = RE_5_INVALID_SEQUENCE;
+    data.address = RE_5_INVALID_MAC;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_5 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL_STRING ("{\"dataFormat\":5,\"humidity\":-0.0001,\"pressure\":100044,"
+                              "\"accelY\":-0.004,\"accelZ\":1.036,\"voltage\":2.977}", buf);
+}
+
+void test_re_json_write_5_overflow (void)
+{
+    char buf[sizeof (m_df5_json) + 4U];
+    size_t offset = 4U;
+    const re_5_data_t data = df5_data ();
+    memcpy (buf, "abc,", 4U);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_5 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL (sizeof (buf) - 1U, offset);
+    TEST_ASSERT_EQUAL (0, strncmp (&buf[4], m_df5_json, sizeof (m_df5_json)));
+    offset = 4U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE,
+                       re_json_write_5 (buf, sizeof (buf) - 1U, &offset, &data));
+    TEST_ASSERT_EQUAL (4U, offset);
+    TEST_ASSERT_EQUAL_STRING ("abc,", buf);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_json_write_5 (NULL, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_json_write_5 (buf, sizeof (buf), NULL, &data));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_json_write_5 (buf, sizeof (buf), &offset, NULL));
+}
+
+void test_re_json_write_6_ok (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    re_6_data_t data =
+    {
+        .temperature_c = 29.5F,
+        .humidity_rh = 55.3F,
+        .pressure_pa = 101102.0F,
+        .pm2p5_ppm = 11.2F,
+        .co2 = 201.0F,
+        .voc = 10.0F,
+        .nox = 2.0F,
+        .luminosity = NAN,
+        .sound_avg_dba = 47.6F,
+        .seq_cnt2 = 205,
+        .flags = { .flag_calibration_in_progress = false, .flag_button_pressed = true,
+                   .flag_rtc_running_on_boot = false },
+        .mac_addr_24 = { .byte3 = 0x4C, .byte4 = 0x88, .byte5 = 0x4F }
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_6 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL_STRING ("{\"dataFormat\":6,\"temperature\":29.5,\"humidity\":55.3,"
+                              "\"pressure\":101102,\"pm2p5\":11.2,\"co2\":201,\"voc\":10,"
+                              "\"nox\":2,\"soundAverage\":47.6,"
+                              "\"measurementSequenceNumber\":205,"
+                              "\"calibrationInProgress\":false,\"buttonPressed\":true,"
+                              "\"rtcRunningOnBoot\":false,\"mac\":\"4C:88:4F\"}", buf);
+}
+
+void test_re_json_write_7_ok (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    re_7_data_t data =
+    {
+        .temperature_c = -12.345F,
+        .humidity_rh = 100.0F,
+        .pressure_pa = 50000.0F,
+        .tilt_x_deg = 45.25F,
+        .tilt_y_deg = -0.004F,
+        .luminosity_lux = 120.0F,
+        .color_temp_k = NAN,
+        .battery_v = 3.0F,
+        .motion_intensity = RE_7_INVALID_MOTION_INT,
+        .motion_count = 3,
+        .sequence_counter = 254,
+        .motion_detected = true,
+        .presence_detected = false,
+        .address = 0x4C884FU
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_7 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL_STRING ("{\"dataFormat\":7,\"temperature\":-12.345,\"humidity\":100,"
+                              "\"pressure\":50000,\"tiltX\":45.25,\"tiltY\":0,"
+                              "\"luminosity\":120,\"voltage\":3,\"movementCounter\":3,"
+                              "\"measurementSequenceNumber\":254,\"motionDetected\":true,"
+                              "\"presenceDetected\":false,\"mac\":\"4C:88:4F\"}", buf);
+}
+
+void test_re_json_write_e1_ok (void)
+{
+    char buf[512];
+    size_t offset = 0;
+    re_e1_data_t data =
+    {
+        .temperature_c = 29.5F,
+        .humidity_rh = 55.3F,
+        .pressure_pa = 101102.0F,
+        .pm1p0_ppm = 10.1F,
+        .pm2p5_ppm = 11.2F,
+        .pm4p0_ppm = 121.3F,
+        .pm10p0_ppm = 455.4F,
+        .co2 = 201.0F,
+        .voc = 10.0F,
+        .nox = 2.0F,
+        .luminosity = 13027.0F,
+        .sound_inst_dba = NAN,
+        .sound_avg_dba = 47.6F,
+        .sound_peak_spl_db = NAN,
+        .seq_cnt = 14601710U,
+        .flags = { .flag_calibration_in_progress = true, .flag_button_pressed = false,
+                   .flag_rtc_running_on_boot = true },
+        .address = 0xCBB8334C884FU
+    };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_e1 (buf, sizeof (buf), &offset, &data));
+    TEST_ASSERT_EQUAL_STRING ("{\"dataFormat\":225,\"temperature\":29.5,\"humidity\":55.3,"
+                              "\"pressure\":101102,\"pm1p0\":10.1,\"pm2p5\":11.2,"
+                              "\"pm4p0\":121.3,\"pm10p0\":455.4,\"co2\":201,\"voc\":10,"
+                              "\"nox\":2,\"luminosity\":13027,\"soundAverage\":47.6,"
+                              "\"measurementSequenceNumber\":14601710,"
+                              "\"mac\":\"CB:B8:33:4C:88:4F\","
+                              "\"calibrationInProgress\":true,\"buttonPressed\":false,"
+                              "\"rtcRunningOnBoot\":true}", buf);
+}
+
+void test_re_json_write_array (void)
+{
+    char buf[ (2U * sizeof (m_df5_json)) + 2U];
+    char expected[sizeof (buf)];
+    size_t offset = 0;
+    size_t num_written = 0;
+    re_5_data_t data[3] = { df5_data (), df5_data (), df5_data () };
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_array (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, 2U, &num_written));
+    TEST_ASSERT_EQUAL (2U, num_written);
+    strcpy (expected, "[");
+    strcat (expected, m_df5_json);
+    strcat (expected, ",");
+    strcat (expected, m_df5_json);
+    strcat (expected, "]");
+    TEST_ASSERT_EQUAL_STRING (expected, buf);
+    TEST_ASSERT_EQUAL (sizeof (buf) - 1U, offset);
+    // Third record does not fit, array is still closed.
+    offset = 0;
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_json_write_array (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, 3U, &num_written));
+    TEST_ASSERT_EQUAL (2U, num_written);
+    TEST_ASSERT_EQUAL_STRING (expected, buf);
+    offset = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_json_write_array (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, 0U, &num_written));
+    TEST_ASSERT_EQUAL_STRING ("[]", buf);
+    offset = sizeof (buf) - 2U;
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_json_write_array (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, data, 0U, &num_written));
+    TEST_ASSERT_EQUAL (sizeof (buf) - 2U, offset);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_json_write_array (buf, sizeof (buf),
+                       &offset, RE_3_DESTINATION, data, 1U, &num_written));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_json_write_array (buf, sizeof (buf), &offset,
+                       RE_5_DESTINATION, NULL, 1U, &num_written));
+}
@@ -0,0 +1,244 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_keystore.h"
+
+#include <string.h>
+
+#define TEST_CAPACITY (16U)
+
+static uint64_t m_macs[TEST_CAPACITY];
+static re_keystore_entry_t m_entries[TEST_CAPACITY];
+static re_keystore_t m_store;
+static size_t m_expand_calls;
+static uint32_t m_expand_ret;
+
+static const uint8_t TEST_KEY[RE_KEYSTORE_KEY_SIZE] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+
+/** Fake key schedule: key repeated, each round XORed with round index. */
+static uint32_t mock_expand (const uint8_t * const p_key, const size_t key_size,
+                             uint8_t * const p_schedule, const size_t schedule_size)
+{
+    m_expand_calls++;
+
+    for (size_t ii = 0; ii < schedule_size; ii++)
+    {
+        p_schedule[ii] = p_key[ii % key_size] ^ (uint8_t) (ii / key_size);
+    }
+
+    return m_expand_ret;
+}
+
+static void test_key_build (uint8_t * const p_key, const uint8_t seed)
+{
+    for (size_t ii = 0; ii < RE_KEYSTORE_KEY_SIZE; ii++)
+    {
+        p_key[ii] = TEST_KEY[ii] ^ seed;
+    }
+}
+
+void setUp (void)
+{
+    m_expand_calls = 0;
+    m_expand_ret = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_init (&m_store, m_macs, m_entries,
+                       TEST_CAPACITY, &mock_expand));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_keystore_init_invalid (void)
+{
+    re_keystore_t store;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_init (NULL, m_macs, m_entries,
+                       TEST_CAPACITY, &mock_expand));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_init (&store, NULL, m_entries,
+                       TEST_CAPACITY, &mock_expand));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_init (&store, m_macs, m_entries,
+                       TEST_CAPACITY, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_init (&store, m_macs, m_entries,
+                       12U, &mock_expand));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_init (&store, m_macs, m_entries,
+                       2U, &mock_expand));
+}
+
+void test_re_keystore_put_find (void)
+{
+    uint8_t schedule[RE_KEYSTORE_SCHEDULE_SIZE];
+    const uint64_t mac = 0xCBB8334C884FU;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    const re_keystore_entry_t * const p_entry = re_keystore_find (&m_store, mac);
+    TEST_ASSERT_NOT_NULL (p_entry);
+    (void) mock_expand (TEST_KEY, sizeof (TEST_KEY), schedule, sizeof (schedule));
+    TEST_ASSERT_EQUAL_MEMORY (TEST_KEY, p_entry->key, sizeof (TEST_KEY));
+    TEST_ASSERT_EQUAL_MEMORY (schedule, p_entry->schedule, sizeof (schedule));
+    TEST_ASSERT_EQUAL (1, m_store.count);
+    TEST_ASSERT_NULL (re_keystore_find (&m_store, mac + 1U));
+    TEST_ASSERT_NULL (re_keystore_find (NULL, mac));
+}
+
+void test_re_keystore_put_replace (void)
+{
+    uint8_t key[RE_KEYSTORE_KEY_SIZE];
+    const uint64_t mac = 0x112233445566U;
+    test_key_build (key, 0x5AU);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, key, sizeof (key)));
+    TEST_ASSERT_EQUAL (1, m_store.count);
+    TEST_ASSERT_EQUAL_MEMORY (key, re_keystore_find (&m_store, mac)->key, sizeof (key));
+}
+
+void test_re_keystore_put_new_key_resets_replay (void)
+{
+    uint8_t key[RE_KEYSTORE_KEY_SIZE];
+    const uint64_t mac = 0x112233445566U;
+    test_key_build (key, 0x5AU);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    re_keystore_entry_t * const p_entry = re_keystore_find (&m_store, mac);
+    TEST_ASSERT_EQUAL (0, p_entry->replay.seen);
+    p_entry->replay.seen = 1U;
+    p_entry->replay.newest = 100U;
+    // Same key again keeps the window.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (1U, p_entry->replay.seen);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, key, sizeof (key)));
+    TEST_ASSERT_EQUAL (0, p_entry->replay.seen);
+}
+
+void test_re_keystore_put_expand_fails_keeps_old_key (void)
+{
+    uint8_t key[RE_KEYSTORE_KEY_SIZE];
+    const uint64_t mac = 0x112233445566U;
+    test_key_build (key, 0x5AU);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, mac, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    m_expand_ret = 1;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_put (&m_store, mac, key,
+                       sizeof (key)));
+    TEST_ASSERT_EQUAL_MEMORY (TEST_KEY, re_keystore_find (&m_store, mac)->key,
+                              sizeof (TEST_KEY));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_put (&m_store, mac + 1U, key,
+                       sizeof (key)));
+    TEST_ASSERT_NULL (re_keystore_find (&m_store, mac + 1U));
+    TEST_ASSERT_EQUAL (1, m_store.count);
+}
+
+void test_re_keystore_put_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_put (NULL, 1U, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_put (&m_store, 1U, NULL,
+                       sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_put (&m_store, 1U, TEST_KEY,
+                       sizeof (TEST_KEY) - 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_put (&m_store,
+                       RE_KEYSTORE_MAC_MASK + 1U, TEST_KEY, sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (0, m_expand_calls);
+}
+
+void test_re_keystore_full (void)
+{
+    const size_t max_count = TEST_CAPACITY - (TEST_CAPACITY / 4U);
+
+    for (size_t ii = 0; ii < max_count; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, 0xC0FFEE000000U + ii,
+                           TEST_KEY, sizeof (TEST_KEY)));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_keystore_put (&m_store, 0xC0FFEE0000FFU,
+                       TEST_KEY, sizeof (TEST_KEY)));
+    // Replacing an existing key is allowed in a full store.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, 0xC0FFEE000000U,
+                       TEST_KEY, sizeof (TEST_KEY)));
+    TEST_ASSERT_NULL (re_keystore_find (&m_store, 0xC0FFEE0000FFU));
+}
+
+void test_re_keystore_remove_keeps_cluster_reachable (void)
+{
+    const size_t max_count = TEST_CAPACITY - (TEST_CAPACITY / 4U);
+    uint8_t key[RE_KEYSTORE_KEY_SIZE];
+    uint32_t state = 0x12345678U;
+    uint64_t macs[TEST_CAPACITY - (TEST_CAPACITY / 4U)];
+
+    for (size_t ii = 0; ii < max_count; ii++)
+    {
+        macs[ii] = 0xAABBCC000000U + ii;
+        test_key_build (key, (uint8_t) ii);
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, macs[ii], key, sizeof (key)));
+    }
+
+    // Remove in pseudo-random order, every remaining key must stay reachable.
+    for (size_t removed = 0; removed < max_count; removed++)
+    {
+        size_t victim;
+
+        do
+        {
+            state = state * 1103515245U + 12345U;
+            victim = (state >> 16U) % max_count;
+        } while (0U == macs[victim]);
+
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_remove (&m_store, macs[victim]));
+        TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_remove (&m_store,
+                           macs[victim]));
+        macs[victim] = 0;
+
+        for (size_t ii = 0; ii < max_count; ii++)
+        {
+            if (0U != macs[ii])
+            {
+                const re_keystore_entry_t * const p_entry = re_keystore_find (&m_store, macs[ii]);
+                test_key_build (key, (uint8_t) ii);
+                TEST_ASSERT_NOT_NULL (p_entry);
+                TEST_ASSERT_EQUAL_MEMORY (key, p_entry->key, sizeof (key));
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL (0, m_store.count);
+}
+
+void test_re_keystore_remove_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_remove (NULL, 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_remove (&m_store, 1U));
+}
+
+void test_re_keystore_mac_read (void)
+{
+    const uint8_t address[RE_KEYSTORE_MAC_BYTES] = {0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F};
+    TEST_ASSERT_EQUAL_UINT64 (0xCBB8334C884FU, re_keystore_mac_read (address));
+}
+
+void test_re_keystore_find_batch (void)
+{
+    // Address at offset 2 of each frame.
+    const uint8_t frame_known[8] = {0x08, 0x00, 0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x4F};
+    const uint8_t frame_unknown[8] = {0x08, 0x00, 0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x50};
+    const uint8_t * frames[3] = {frame_known, frame_unknown, NULL};
+    const uint8_t * schedules[3];
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_put (&m_store, 0xCBB8334C884FU, TEST_KEY,
+                       sizeof (TEST_KEY)));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_keystore_find_batch (&m_store, frames, 2U,
+                       3U, schedules));
+    TEST_ASSERT_EQUAL_PTR (re_keystore_find (&m_store, 0xCBB8334C884FU)->schedule,
+                           schedules[0]);
+    TEST_ASSERT_NULL (schedules[1]);
+    TEST_ASSERT_NULL (schedules[2]);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_keystore_find_batch (&m_store, frames, 2U, 1U,
+                       schedules));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_keystore_find_batch (&m_store, NULL, 2U, 1U,
+                       schedules));
+}
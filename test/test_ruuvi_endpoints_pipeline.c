@@ -0,0 +1,201 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_pipeline.h"
+#include "ruuvi_endpoints_dedup.h"
+#include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_c5.h"
+#include "ruuvi_endpoint_e0.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_f0.h"
+
+#include <string.h>
+
+#define TEST_SHARDS    (4U)
+#define TEST_QUEUE_LEN (4U)
+#define TEST_DEDUP_LEN (8U)
+#define TEST_OUTPUT_LEN (4U)
+#define TEST_WINDOW_MS (100U)
+
+static const uint8_t m_df5_header[] = {0x02, 0x01, 0x04, 0x1B, 0xFF, 0x99, 0x04};
+
+static re_pipeline_shard_t m_shards[TEST_SHARDS];
+static re_pipeline_cell_t m_cells[TEST_SHARDS * TEST_QUEUE_LEN];
+static re_dedup_entry_t m_entries[TEST_SHARDS * TEST_DEDUP_LEN];
+static re_pipeline_record_t m_records[TEST_SHARDS * TEST_OUTPUT_LEN];
+static re_pipeline_t m_pipeline;
+
+static re_pipeline_config_t config (void)
+{
+    re_pipeline_config_t cfg =
+    {
+        .p_shards = m_shards,
+        .num_shards = TEST_SHARDS,
+        .p_cells = m_cells,
+        .queue_len = TEST_QUEUE_LEN,
+        .p_entries = m_entries,
+        .dedup_len = TEST_DEDUP_LEN,
+        .p_records = m_records,
+        .output_len = TEST_OUTPUT_LEN,
+        .window_ms = TEST_WINDOW_MS
+    };
+    return cfg;
+}
+
+static void make_df5 (re_ca_uart_ble_adv_t * const p_adv, const uint8_t mac_lsb,
+                      const uint16_t sequence, const int8_t rssi_db)
+{
+    re_5_data_t data =
+    {
+        .humidity_rh = 53.49F,
+        .pressure_pa = 100044.0F,
+        .temperature_c = 24.3F,
+        .accelerationx_g = 0.004F,
+        .accelerationy_g = -0.004F,
+        .accelerationz_g = 1.036F,
+        .battery_v = 2.977F,
+        .tx_power = 4,
+        .measurement_count = sequence,
+        .movement_count = 66,
+        .address = 0xCBB8334C884FU
+    };
+    memset (p_adv, 0, sizeof (re_ca_uart_ble_adv_t));
+    p_adv->mac[0] = 0xCBU;
+    p_adv->mac[RE_CA_UART_MAC_BYTES - 1U] = mac_lsb;
+    memcpy (p_adv->adv, m_df5_header, sizeof (m_df5_header));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_5_encode (&p_adv->adv[RE_5_OFFSET_PAYLOAD], &data));
+    p_adv->adv_len = RE_5_RAW_MIN_LEN;
+    p_adv->rssi_db = rssi_db;
+}
+
+void setUp (void)
+{
+    const re_pipeline_config_t cfg = config ();
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_init (&m_pipeline, &cfg));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_pipeline_init_invalid (void)
+{
+    re_pipeline_config_t cfg = config ();
+    re_pipeline_t pipeline;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_pipeline_init (NULL, &cfg));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_pipeline_init (&pipeline, NULL));
+    cfg.p_records = NULL;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_pipeline_init (&pipeline, &cfg));
+    cfg = config ();
+    cfg.num_shards = 3U;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_pipeline_init (&pipeline, &cfg));
+    cfg = config ();
+    cfg.num_shards = 2U * RE_PIPELINE_MAX_SHARDS;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_pipeline_init (&pipeline, &cfg));
+    cfg = config ();
+    cfg.output_len = 0U;
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_pipeline_init (&pipeline, &cfg));
+}
+
+void test_re_pipeline_dedup_and_decode (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    re_pipeline_record_t record;
+    make_df5 (&adv, 0x4FU, 205U, -80);
+    const size_t shard = re_pipeline_shard_of (&m_pipeline, adv.mac);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 1000U));
+    adv.rssi_db = -60;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 1001U));
+    adv.rssi_db = -70;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 1002U));
+    TEST_ASSERT_EQUAL (3U, re_pipeline_shard_run (&m_pipeline, shard, 1002U, 16U));
+    TEST_ASSERT_FALSE (re_pipeline_read (&m_pipeline, shard, &record));
+    TEST_ASSERT_EQUAL (0U, re_pipeline_shard_run (&m_pipeline, shard, 1100U, 16U));
+    TEST_ASSERT_TRUE (re_pipeline_read (&m_pipeline, shard, &record));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, record.status);
+    TEST_ASSERT_EQUAL (RE_5_DESTINATION, record.data_format);
+    TEST_ASSERT_EQUAL (-60, record.adv.rssi_db);
+    TEST_ASSERT_EQUAL (205U, record.data.df5.measurement_count);
+    TEST_ASSERT_EQUAL_FLOAT (24.3F, record.data.df5.temperature_c);
+    TEST_ASSERT_FALSE (re_pipeline_read (&m_pipeline, shard, &record));
+    TEST_ASSERT_EQUAL (1U, m_shards[shard].num_decoded);
+    TEST_ASSERT_EQUAL (1U, m_shards[shard].stats.format_ok[RE_5_DESTINATION]);
+    TEST_ASSERT_EQUAL (2U, m_shards[shard].dedup.num_dropped);
+}
+
+void test_re_pipeline_unknown_passes (void)
+{
+    re_ca_uart_ble_adv_t adv = {0};
+    re_pipeline_record_t record;
+    adv.adv[0] = 0x02U;
+    adv.adv_len = 3U;
+    const size_t shard = re_pipeline_shard_of (&m_pipeline, adv.mac);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 0U));
+    TEST_ASSERT_EQUAL (1U, re_pipeline_shard_run (&m_pipeline, shard, 0U, 16U));
+    TEST_ASSERT_TRUE (re_pipeline_read (&m_pipeline, shard, &record));
+    TEST_ASSERT_EQUAL (0U, record.data_format);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, record.status);
+    TEST_ASSERT_EQUAL (1U, m_shards[shard].num_failed);
+    TEST_ASSERT_EQUAL (0U, m_shards[shard].stats.format_failed[0]);
+}
+
+void test_re_pipeline_queues_full (void)
+{
+    re_ca_uart_ble_adv_t adv;
+    re_pipeline_record_t record;
+    make_df5 (&adv, 0x4FU, 0U, -80);
+    const size_t shard = re_pipeline_shard_of (&m_pipeline, adv.mac);
+
+    for (uint16_t ii = 0; ii < TEST_QUEUE_LEN; ii++)
+    {
+        make_df5 (&adv, 0x4FU, ii, -80);
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 0U));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_pipeline_submit (&m_pipeline, &adv, 0U));
+    TEST_ASSERT_EQUAL (1U, atomic_load (&m_shards[shard].num_rejected));
+    TEST_ASSERT_EQUAL (2U, re_pipeline_shard_run (&m_pipeline, shard, 0U, 2U));
+    TEST_ASSERT_EQUAL (2U, re_pipeline_shard_run (&m_pipeline, shard, 0U, 16U));
+
+    // Input queue wraps around.
+    for (uint16_t ii = TEST_QUEUE_LEN; ii < (2U * TEST_QUEUE_LEN); ii++)
+    {
+        make_df5 (&adv, 0x4FU, ii, -80);
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_pipeline_submit (&m_pipeline, &adv, 0U));
+    }
+
+    // 7 measurements released, 4 fit in output ring.
+    TEST_ASSERT_EQUAL (TEST_QUEUE_LEN, re_pipeline_shard_run (&m_pipeline, shard, 0U, 16U));
+    TEST_ASSERT_EQUAL (3U, m_shards[shard].num_overflow);
+
+    for (uint16_t ii = 0; ii < TEST_OUTPUT_LEN; ii++)
+    {
+        TEST_ASSERT_TRUE (re_pipeline_read (&m_pipeline, shard, &record));
+        TEST_ASSERT_EQUAL (ii, record.data.df5.measurement_count);
+    }
+
+    TEST_ASSERT_FALSE (re_pipeline_read (&m_pipeline, shard, &record));
+    TEST_ASSERT_EQUAL (0U, re_pipeline_shard_run (&m_pipeline, TEST_SHARDS, 0U, 16U));
+    TEST_ASSERT_FALSE (re_pipeline_read (&m_pipeline, TEST_SHARDS, &record));
+}
+
+void test_re_pipeline_shards_spread (void)
+{
+    uint8_t mac[RE_CA_UART_MAC_BYTES] = {0xCB, 0xB8, 0x33, 0x4C, 0x88, 0x00};
+    size_t per_shard[TEST_SHARDS] = {0};
+
+    for (uint16_t ii = 0; ii < 256U; ii++)
+    {
+        mac[RE_CA_UART_MAC_BYTES - 1U] = (uint8_t) ii;
+        per_shard[re_pipeline_shard_of (&m_pipeline, mac)]++;
+    }
+
+    for (size_t ii = 0; ii < TEST_SHARDS; ii++)
+    {
+        TEST_ASSERT_TRUE (per_shard[ii] > 32U);
+    }
+}
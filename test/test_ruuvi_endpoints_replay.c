@@ -0,0 +1,111 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_replay.h"
+
+#include <string.h>
+
+static re_replay_window_t m_window;
+
+void setUp (void)
+{
+    memset (&m_window, 0xA5, sizeof (m_window));
+    re_replay_reset (&m_window);
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_replay_first_counter_accepted (void)
+{
+    TEST_ASSERT_TRUE (re_replay_check (&m_window, 1234U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 1234U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_EQUAL (1234U, m_window.newest);
+}
+
+void test_re_replay_duplicate_rejected (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 10U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 10U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 10U, RE_REPLAY_MODULUS_8));
+}
+
+void test_re_replay_check_does_not_update (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 10U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_check (&m_window, 11U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_check (&m_window, 11U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_EQUAL (10U, m_window.newest);
+}
+
+void test_re_replay_out_of_order_inside_window (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 100U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 98U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 101U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 99U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 98U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 99U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 100U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_EQUAL (101U, m_window.newest);
+}
+
+void test_re_replay_older_than_window_rejected (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 1000U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_check (&m_window, 1000U - RE_REPLAY_WINDOW + 1U,
+                                       RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 1000U - RE_REPLAY_WINDOW,
+                                        RE_REPLAY_MODULUS_8));
+}
+
+void test_re_replay_large_jump_clears_window (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 1000U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 1000U + RE_REPLAY_WINDOW, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 1000U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 1001U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_EQUAL (1000U + RE_REPLAY_WINDOW, m_window.newest);
+}
+
+void test_re_replay_df8_wraparound (void)
+{
+    // DF8 counter runs to 0xFFFE and wraps to 0.
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0xFFFDU, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0x0001U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_EQUAL (1U, m_window.newest);
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0xFFFEU, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0x0000U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 0xFFFDU, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 0xFFFEU, RE_REPLAY_MODULUS_8));
+    // 0xFFFF is the N/A value of DF8.
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 0xFFFFU, RE_REPLAY_MODULUS_8));
+}
+
+void test_re_replay_fa_wraparound (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0xFEU, RE_REPLAY_MODULUS_FA));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0x02U, RE_REPLAY_MODULUS_FA));
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0xFFU, RE_REPLAY_MODULUS_FA));
+    TEST_ASSERT_FALSE (re_replay_accept (&m_window, 0xFEU, RE_REPLAY_MODULUS_FA));
+    TEST_ASSERT_EQUAL (2U, m_window.newest);
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 0x100U, RE_REPLAY_MODULUS_FA));
+}
+
+void test_re_replay_half_range_behind_is_old (void)
+{
+    TEST_ASSERT_TRUE (re_replay_accept (&m_window, 0x80U, RE_REPLAY_MODULUS_FA));
+    // Exactly half of the range ahead is treated as new.
+    TEST_ASSERT_TRUE (re_replay_check (&m_window, 0x00U, RE_REPLAY_MODULUS_FA));
+    // More than half ahead is too old.
+    TEST_ASSERT_FALSE (re_replay_check (&m_window, 0x01U, RE_REPLAY_MODULUS_FA));
+}
+
+void test_re_replay_null (void)
+{
+    re_replay_reset (NULL);
+    TEST_ASSERT_FALSE (re_replay_check (NULL, 1U, RE_REPLAY_MODULUS_8));
+    TEST_ASSERT_FALSE (re_replay_accept (NULL, 1U, RE_REPLAY_MODULUS_8));
+}
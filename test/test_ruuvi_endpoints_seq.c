@@ -0,0 +1,110 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_seq.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_e1.h"
+
+#include <string.h>
+
+static re_seq_t m_seq;
+
+void setUp (void)
+{
+    memset (&m_seq, 0, sizeof (m_seq));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+static re_seq_event_t update (const uint32_t counter)
+{
+    re_seq_event_t event = RE_SEQ_RESTART;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_update (&m_seq, counter, &event));
+    return event;
+}
+
+void test_re_seq_period (void)
+{
+    TEST_ASSERT_EQUAL (65535U, re_seq_period (0x05U));
+    TEST_ASSERT_EQUAL (256U, re_seq_period (0x06U));
+    TEST_ASSERT_EQUAL (255U, re_seq_period (0x07U));
+    TEST_ASSERT_EQUAL (0xFFFFFFU, re_seq_period (0xE1U));
+    TEST_ASSERT_EQUAL (16U, re_seq_period (0xF0U));
+    TEST_ASSERT_EQUAL (0U, re_seq_period (0x03U));
+}
+
+void test_re_seq_init_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_seq_init (NULL, 256U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_seq_init (&m_seq, 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_seq_init (&m_seq, re_seq_period (0x03U)));
+}
+
+void test_re_seq_df5_wraps_below_invalid (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_init (&m_seq, re_seq_period (RE_5_DESTINATION)));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (RE_5_SEQCTR_MAX - 1U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (RE_5_SEQCTR_MAX));
+    // 0xFFFF is never sent, 0 follows the maximum.
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (0U));
+    TEST_ASSERT_EQUAL (RE_SEQ_GAP, update (3U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_seq_update (&m_seq, RE_5_INVALID_SEQUENCE,
+                       NULL));
+    TEST_ASSERT_EQUAL (4U, m_seq.received);
+    TEST_ASSERT_EQUAL (2U, m_seq.lost);
+}
+
+void test_re_seq_e1_gap_across_wrap (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_init (&m_seq, re_seq_period (RE_E1_DESTINATION)));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (0xFFFFFDU));
+    TEST_ASSERT_EQUAL (RE_SEQ_GAP, update (1U));
+    TEST_ASSERT_EQUAL (2U, m_seq.lost);
+    TEST_ASSERT_EQUAL (RE_SEQ_REORDERED, update (0xFFFFFEU));
+    TEST_ASSERT_EQUAL (RE_SEQ_REORDERED, update (0U));
+    TEST_ASSERT_EQUAL (RE_SEQ_DUPLICATE, update (0U));
+    TEST_ASSERT_EQUAL (0U, m_seq.lost);
+    TEST_ASSERT_EQUAL (4U, m_seq.received);
+    TEST_ASSERT_EQUAL (2U, m_seq.reordered);
+    TEST_ASSERT_EQUAL (1U, m_seq.duplicates);
+}
+
+void test_re_seq_df6_duplicates (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_init (&m_seq, 256U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (254U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (255U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (0U));
+    TEST_ASSERT_EQUAL (RE_SEQ_DUPLICATE, update (0U));
+    TEST_ASSERT_EQUAL (RE_SEQ_DUPLICATE, update (254U));
+    TEST_ASSERT_EQUAL (3U, m_seq.received);
+    TEST_ASSERT_EQUAL (2U, m_seq.duplicates);
+    TEST_ASSERT_EQUAL (0U, m_seq.lost);
+}
+
+void test_re_seq_f0_short_counter (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_init (&m_seq, re_seq_period (0xF0U)));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (14U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (15U));
+    TEST_ASSERT_EQUAL (RE_SEQ_GAP, update (7U));
+    TEST_ASSERT_EQUAL (7U, m_seq.lost);
+    TEST_ASSERT_EQUAL (RE_SEQ_REORDERED, update (3U));
+    TEST_ASSERT_EQUAL (6U, m_seq.lost);
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_seq_update (&m_seq, 16U, NULL));
+}
+
+void test_re_seq_restart (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_seq_init (&m_seq, re_seq_period (RE_5_DESTINATION)));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (1000U));
+    TEST_ASSERT_EQUAL (RE_SEQ_RESTART, update (0U));
+    TEST_ASSERT_EQUAL (RE_SEQ_IN_ORDER, update (1U));
+    TEST_ASSERT_EQUAL (3U, m_seq.received);
+    TEST_ASSERT_EQUAL (1U, m_seq.restarts);
+    TEST_ASSERT_EQUAL (0U, m_seq.lost);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_seq_update (NULL, 0U, NULL));
+}
@@ -0,0 +1,177 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_series.h"
+
+#include <math.h>
+#include <string.h>
+
+#define TEST_BLOCK_LEN   (256U)
+#define TEST_RESOLUTION  (0.005F)
+#define TEST_NUM_SAMPLES (200U)
+
+static uint8_t m_block[TEST_BLOCK_LEN];
+static re_series_encoder_t m_enc;
+static uint32_t m_timestamps[TEST_NUM_SAMPLES];
+static re_float m_values[TEST_NUM_SAMPLES];
+
+void setUp (void)
+{
+    memset (m_block, 0xA5, sizeof (m_block));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_start (&m_enc, m_block,
+                       sizeof (m_block), TEST_RESOLUTION));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_series_encode_start_invalid (void)
+{
+    re_series_encoder_t enc;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_series_encode_start (NULL, m_block,
+                       sizeof (m_block), TEST_RESOLUTION));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_series_encode_start (&enc, NULL,
+                       sizeof (m_block), TEST_RESOLUTION));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_series_encode_start (&enc, m_block,
+                       sizeof (m_block), 0.0F));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_series_encode_start (&enc, m_block,
+                       sizeof (m_block), NAN));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_series_encode_start (&enc, m_block,
+                       RE_SERIES_HEADER_LEN - 1U, TEST_RESOLUTION));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_series_encode_value (NULL, 0U, 1.0F));
+    TEST_ASSERT_EQUAL (RE_ERROR_ENCODING, re_series_encode_value (&m_enc, 0U, 1e9F));
+}
+
+void test_re_series_steady_samples_take_two_bits (void)
+{
+    size_t num_samples = 0;
+
+    for (uint32_t ii = 0; ii < 9U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_value (&m_enc, 1000U + (60U * ii),
+                           24.3F));
+    }
+
+    // Second sample takes 2 + 7 bits for interval of 60 and 1 bit for value,
+    // following samples 2 bits each.
+    TEST_ASSERT_EQUAL (RE_SERIES_HEADER_LEN + 3U, m_enc.length);
+    TEST_ASSERT_EQUAL (9U, re_series_num_samples (m_block, m_enc.length));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_decode (m_block, m_enc.length, m_timestamps,
+                       m_values, TEST_NUM_SAMPLES, &num_samples));
+    TEST_ASSERT_EQUAL (9U, num_samples);
+
+    for (uint32_t ii = 0; ii < 9U; ii++)
+    {
+        TEST_ASSERT_EQUAL (1000U + (60U * ii), m_timestamps[ii]);
+        TEST_ASSERT_EQUAL_FLOAT (24.3F, m_values[ii]);
+    }
+}
+
+void test_re_series_round_trip (void)
+{
+    const re_float values[] =
+    {
+        24.3F, 24.305F, 24.29F, NAN, 23.0F, -40.0F, 85.0F, NAN, NAN, 85.0F, 0.0F, 163.835F
+    };
+    const uint32_t timestamps[] =
+    {
+        0U, 1U, 2U, 3U, 5U, 6U, 1006U, 1007U, 0xFFFFFFFFU, 0U, 100000U, 100000U
+    };
+    const size_t count = sizeof (values) / sizeof (values[0]);
+    size_t num_samples = 0;
+
+    for (size_t ii = 0; ii < count; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_value (&m_enc, timestamps[ii],
+                           values[ii]));
+    }
+
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_decode (m_block, m_enc.length, m_timestamps,
+                       m_values, TEST_NUM_SAMPLES, &num_samples));
+    TEST_ASSERT_EQUAL (count, num_samples);
+
+    for (size_t ii = 0; ii < count; ii++)
+    {
+        TEST_ASSERT_EQUAL (timestamps[ii], m_timestamps[ii]);
+
+        if (isnan (values[ii]))
+        {
+            TEST_ASSERT_TRUE (isnan (m_values[ii]));
+        }
+        else
+        {
+            TEST_ASSERT_FLOAT_WITHIN (TEST_RESOLUTION / 2.0F, values[ii], m_values[ii]);
+        }
+    }
+}
+
+void test_re_series_invalid_first_value (void)
+{
+    size_t num_samples = 0;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_coded (&m_enc, 10U, RE_SERIES_INVALID));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_coded (&m_enc, 20U, -3));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_coded (&m_enc, 30U, INT32_MAX));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_coded (&m_enc, 40U, INT32_MIN + 1));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_decode (m_block, m_enc.length, m_timestamps,
+                       m_values, TEST_NUM_SAMPLES, &num_samples));
+    TEST_ASSERT_EQUAL (4U, num_samples);
+    TEST_ASSERT_TRUE (isnan (m_values[0]));
+    TEST_ASSERT_EQUAL_FLOAT (-0.015F, m_values[1]);
+    TEST_ASSERT_EQUAL_FLOAT ( (re_float) INT32_MAX * TEST_RESOLUTION, m_values[2]);
+    TEST_ASSERT_EQUAL_FLOAT ( (re_float) (INT32_MIN + 1) * TEST_RESOLUTION, m_values[3]);
+    TEST_ASSERT_EQUAL (40U, m_timestamps[3]);
+}
+
+void test_re_series_block_full (void)
+{
+    size_t count = 0;
+    size_t length = 0;
+    size_t num_samples = 0;
+    re_status_t status = RE_SUCCESS;
+
+    while (RE_SUCCESS == status)
+    {
+        length = m_enc.length;
+        // Changing interval and value force long codes.
+        status = re_series_encode_value (&m_enc, (uint32_t) (count * count * 1000U),
+                                         (re_float) (count % 2U) * 100.0F);
+        count++;
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, status);
+    TEST_ASSERT_EQUAL (length, m_enc.length);
+    TEST_ASSERT_TRUE (m_enc.length <= TEST_BLOCK_LEN);
+    TEST_ASSERT_EQUAL (count - 1U, m_enc.num_samples);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_decode (m_block, m_enc.length, m_timestamps,
+                       m_values, TEST_NUM_SAMPLES, &num_samples));
+    TEST_ASSERT_EQUAL (count - 1U, num_samples);
+    TEST_ASSERT_EQUAL ( (count - 2U) * (count - 2U) * 1000U, m_timestamps[count - 2U]);
+}
+
+void test_re_series_decode_errors (void)
+{
+    size_t num_samples = 0;
+
+    for (uint32_t ii = 0; ii < 20U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_series_encode_value (&m_enc, ii * ii,
+                           (re_float) ii));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_series_decode (m_block, m_enc.length,
+                       m_timestamps, m_values, 5U, &num_samples));
+    TEST_ASSERT_EQUAL (5U, num_samples);
+    TEST_ASSERT_EQUAL (16U, m_timestamps[4]);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_series_decode (m_block, m_enc.length - 4U,
+                       m_timestamps, m_values, TEST_NUM_SAMPLES, &num_samples));
+    TEST_ASSERT_TRUE (num_samples < 20U);
+    TEST_ASSERT_EQUAL_FLOAT ( (re_float) (num_samples - 1U), m_values[num_samples - 1U]);
+    TEST_ASSERT_EQUAL (RE_ERROR_DECODING_LEN, re_series_decode (m_block,
+                       RE_SERIES_HEADER_LEN - 1U, m_timestamps, m_values, TEST_NUM_SAMPLES,
+                       &num_samples));
+    TEST_ASSERT_EQUAL (0U, num_samples);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_series_decode (NULL, m_enc.length, m_timestamps,
+                       m_values, TEST_NUM_SAMPLES, &num_samples));
+}
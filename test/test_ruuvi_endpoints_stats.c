@@ -0,0 +1,87 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_stats.h"
+
+#include <string.h>
+
+static re_stats_t m_stats;
+
+void setUp (void)
+{
+    memset (&m_stats, 0xA5, sizeof (m_stats));
+    re_stats_init (&m_stats);
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_stats_init_clears_counters (void)
+{
+    re_stats_t zero = {0};
+    TEST_ASSERT_EQUAL_MEMORY (&zero, &m_stats, sizeof (zero));
+}
+
+void test_re_stats_null_context_is_ignored (void)
+{
+    re_stats_init (NULL);
+    re_stats_record_error (NULL, RE_ERROR_DECODING);
+    re_stats_record_frame (NULL, 0x10U, RE_SUCCESS);
+    re_stats_record_format (NULL, 0x05U, RE_ERROR_DECODING);
+    re_stats_record_discarded (NULL, 10U);
+}
+
+void test_re_stats_record_frame_ok (void)
+{
+    re_stats_record_frame (&m_stats, 0x10U, RE_SUCCESS);
+    re_stats_record_frame (&m_stats, 0x10U, RE_SUCCESS);
+    TEST_ASSERT_EQUAL (2, m_stats.frames_ok);
+    TEST_ASSERT_EQUAL (0, m_stats.frames_failed);
+    TEST_ASSERT_EQUAL (2, m_stats.cmd_ok[0x10U]);
+    TEST_ASSERT_EQUAL (0, m_stats.cmd_failed[0x10U]);
+}
+
+void test_re_stats_record_frame_failed_counts_error_bits (void)
+{
+    re_stats_record_frame (&m_stats, 0x12U,
+                           RE_ERROR_DECODING_CRC | RE_ERROR_DECODING_LEN);
+    re_stats_record_frame (&m_stats, 0x12U, RE_ERROR_DECODING_CRC);
+    TEST_ASSERT_EQUAL (0, m_stats.frames_ok);
+    TEST_ASSERT_EQUAL (2, m_stats.frames_failed);
+    TEST_ASSERT_EQUAL (2, m_stats.cmd_failed[0x12U]);
+    TEST_ASSERT_EQUAL (2, m_stats.error_bits[18]);
+    TEST_ASSERT_EQUAL (1, m_stats.error_bits[14]);
+    TEST_ASSERT_EQUAL (0, m_stats.error_bits[13]);
+}
+
+void test_re_stats_record_error_top_bit (void)
+{
+    re_stats_record_error (&m_stats, 0x80000000U);
+    TEST_ASSERT_EQUAL (1, m_stats.error_bits[RE_STATS_ERROR_BITS - 1U]);
+}
+
+void test_re_stats_record_frame_unknown_cmd_last_slot (void)
+{
+    re_stats_record_frame (&m_stats, 0xFFU, RE_ERROR_DECODING_CMD);
+    TEST_ASSERT_EQUAL (1, m_stats.cmd_failed[RE_STATS_CMD_SLOTS - 1U]);
+}
+
+void test_re_stats_record_format (void)
+{
+    re_stats_record_format (&m_stats, 0x05U, RE_SUCCESS);
+    re_stats_record_format (&m_stats, 0xE1U, RE_ERROR_INVALID_PARAM);
+    TEST_ASSERT_EQUAL (1, m_stats.format_ok[0x05U]);
+    TEST_ASSERT_EQUAL (0, m_stats.format_failed[0x05U]);
+    TEST_ASSERT_EQUAL (1, m_stats.format_failed[0xE1U]);
+    TEST_ASSERT_EQUAL (1, m_stats.error_bits[4]);
+    TEST_ASSERT_EQUAL (0, m_stats.frames_failed);
+}
+
+void test_re_stats_record_discarded (void)
+{
+    re_stats_record_discarded (&m_stats, 3U);
+    re_stats_record_discarded (&m_stats, 4U);
+    TEST_ASSERT_EQUAL (7, m_stats.bytes_discarded);
+}
@@ -0,0 +1,216 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_tag_table.h"
+
+#include <string.h>
+
+#define TEST_CAPACITY (16U)
+#define TEST_MAC      (0xCBB8334C884FU)
+
+static re_tag_table_slot_t m_slots[TEST_CAPACITY];
+static re_tag_table_t m_table;
+
+void setUp (void)
+{
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_init (&m_table, m_slots, TEST_CAPACITY));
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+void test_re_tag_table_slot_is_cache_line (void)
+{
+    TEST_ASSERT_EQUAL (RE_TAG_TABLE_SLOT_SIZE, sizeof (re_tag_table_slot_t));
+}
+
+void test_re_tag_table_init_invalid (void)
+{
+    re_tag_table_t table;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_init (NULL, m_slots, TEST_CAPACITY));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_init (&table, NULL, TEST_CAPACITY));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_tag_table_init (&table, m_slots, 12U));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_tag_table_init (&table, m_slots, 2U));
+}
+
+void test_re_tag_table_upsert_find (void)
+{
+    static const uint8_t payload[] = {0x05, 0x12, 0xFC, 0x53, 0x94, 0xC3, 0x7C};
+    re_tag_table_slot_t * p_slot = NULL;
+    bool is_new = false;
+    TEST_ASSERT_NULL (re_tag_table_find (&m_table, TEST_MAC));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC, 100U, &p_slot,
+                       &is_new));
+    TEST_ASSERT_TRUE (is_new);
+    TEST_ASSERT_EQUAL (TEST_MAC, p_slot->mac);
+    TEST_ASSERT_EQUAL (100U, p_slot->last_seen);
+    TEST_ASSERT_EQUAL (0U, p_slot->payload_len);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_store_payload (p_slot, payload,
+                       sizeof (payload)));
+    p_slot->sequence = 205U;
+    p_slot->rssi = -70;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC, 101U, &p_slot,
+                       &is_new));
+    TEST_ASSERT_FALSE (is_new);
+    TEST_ASSERT_EQUAL (101U, p_slot->last_seen);
+    TEST_ASSERT_EQUAL (205U, p_slot->sequence);
+    TEST_ASSERT_EQUAL (-70, p_slot->rssi);
+    TEST_ASSERT_EQUAL (0x05U, p_slot->data_format);
+    TEST_ASSERT_EQUAL_MEMORY (payload, p_slot->payload, sizeof (payload));
+    TEST_ASSERT_EQUAL_PTR (p_slot, re_tag_table_find (&m_table, TEST_MAC));
+    TEST_ASSERT_EQUAL (1U, m_table.count);
+}
+
+void test_re_tag_table_full (void)
+{
+    re_tag_table_slot_t * p_slot = NULL;
+    bool is_new = true;
+
+    // 3/4 of 16 slots.
+    for (uint64_t ii = 0; ii < 12U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC + ii, 0U,
+                           &p_slot, NULL));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_tag_table_upsert (&m_table, TEST_MAC + 12U, 0U,
+                       &p_slot, &is_new));
+    TEST_ASSERT_FALSE (is_new);
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC + 11U, 1U,
+                       &p_slot, NULL));
+    TEST_ASSERT_EQUAL (12U, m_table.count);
+}
+
+void test_re_tag_table_remove_keeps_clusters (void)
+{
+    re_tag_table_slot_t * p_slot = NULL;
+
+    for (uint64_t ii = 0; ii < 12U; ii++)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC + ii,
+                           (uint32_t) ii, &p_slot, NULL));
+    }
+
+    for (uint64_t ii = 0; ii < 12U; ii += 2U)
+    {
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_remove (&m_table, TEST_MAC + ii));
+    }
+
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_tag_table_remove (&m_table, TEST_MAC));
+    TEST_ASSERT_EQUAL (6U, m_table.count);
+
+    for (uint64_t ii = 0; ii < 12U; ii++)
+    {
+        p_slot = re_tag_table_find (&m_table, TEST_MAC + ii);
+
+        if (0U == (ii % 2U))
+        {
+            TEST_ASSERT_NULL (p_slot);
+        }
+        else
+        {
+            TEST_ASSERT_NOT_NULL (p_slot);
+            TEST_ASSERT_EQUAL ( (uint32_t) ii, p_slot->last_seen);
+        }
+    }
+}
+
+void test_re_tag_table_evict (void)
+{
+    re_tag_table_slot_t * p_slot = NULL;
+
+    for (uint64_t ii = 0; ii < 12U; ii++)
+    {
+        // Times wrap around during the run.
+        TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC + ii,
+                           0xFFFFFFFAU + (uint32_t) ii, &p_slot, NULL));
+    }
+
+    TEST_ASSERT_EQUAL (8U, re_tag_table_evict (&m_table, 2U));
+    TEST_ASSERT_EQUAL (4U, m_table.count);
+
+    for (uint64_t ii = 0; ii < 12U; ii++)
+    {
+        p_slot = re_tag_table_find (&m_table, TEST_MAC + ii);
+
+        if (ii < 8U)
+        {
+            TEST_ASSERT_NULL (p_slot);
+        }
+        else
+        {
+            TEST_ASSERT_NOT_NULL (p_slot);
+        }
+    }
+
+    TEST_ASSERT_EQUAL (0U, re_tag_table_evict (&m_table, 2U));
+    TEST_ASSERT_EQUAL (0U, re_tag_table_evict (NULL, 2U));
+}
+
+void test_re_tag_table_invalid (void)
+{
+    static const uint8_t payload[RE_TAG_TABLE_PAYLOAD_SIZE + 1U] = {0};
+    re_tag_table_slot_t * p_slot = NULL;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_upsert (NULL, TEST_MAC, 0U, &p_slot, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_upsert (&m_table, TEST_MAC, 0U, NULL,
+                       NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_tag_table_upsert (&m_table,
+                       0x1000000000000U, 0U, &p_slot, NULL));
+    TEST_ASSERT_NULL (re_tag_table_find (&m_table, 0x1000000000000U));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_upsert (&m_table, TEST_MAC, 0U, &p_slot,
+                       NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_tag_table_store_payload (p_slot, payload,
+                       sizeof (payload)));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_tag_table_store_payload (p_slot, payload, 0U));
+    TEST_ASSERT_EQUAL (0U, p_slot->payload_len);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_store_payload (NULL, payload, 1U));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_remove (NULL, TEST_MAC));
+}
+
+void test_re_tag_table_observe_skips_repeats (void)
+{
+    uint8_t payload[] = {0x05, 0x12, 0xFC, 0x53, 0x94, 0xC3, 0x7C};
+    re_tag_table_slot_t * p_slot = NULL;
+    bool changed = false;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_observe (&m_table, TEST_MAC, 1U, payload,
+                       sizeof (payload), -70, &p_slot, &changed));
+    TEST_ASSERT_TRUE (changed);
+    TEST_ASSERT_EQUAL_MEMORY (payload, p_slot->payload, sizeof (payload));
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_observe (&m_table, TEST_MAC, 2U, payload,
+                       sizeof (payload), -60, &p_slot, &changed));
+    TEST_ASSERT_FALSE (changed);
+    TEST_ASSERT_EQUAL (-60, p_slot->rssi);
+    TEST_ASSERT_EQUAL (2U, p_slot->last_seen);
+    // Same prefix, different length.
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_observe (&m_table, TEST_MAC, 3U, payload,
+                       sizeof (payload) - 1U, -60, &p_slot, &changed));
+    TEST_ASSERT_TRUE (changed);
+    TEST_ASSERT_EQUAL (sizeof (payload) - 1U, p_slot->payload_len);
+    payload[sizeof (payload) - 2U]++;
+    TEST_ASSERT_EQUAL (RE_SUCCESS, re_tag_table_observe (&m_table, TEST_MAC, 4U, payload,
+                       sizeof (payload) - 1U, -60, &p_slot, &changed));
+    TEST_ASSERT_TRUE (changed);
+    TEST_ASSERT_EQUAL_MEMORY (payload, p_slot->payload, sizeof (payload) - 1U);
+    TEST_ASSERT_EQUAL (1U, m_table.count);
+}
+
+void test_re_tag_table_observe_invalid (void)
+{
+    static const uint8_t payload[RE_TAG_TABLE_PAYLOAD_SIZE + 1U] = {0x05};
+    re_tag_table_slot_t * p_slot = NULL;
+    bool changed = true;
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_observe (NULL, TEST_MAC, 0U, payload, 1U,
+                       0, &p_slot, &changed));
+    TEST_ASSERT_FALSE (changed);
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_observe (&m_table, TEST_MAC, 0U, NULL, 1U,
+                       0, &p_slot, &changed));
+    TEST_ASSERT_EQUAL (RE_ERROR_NULL, re_tag_table_observe (&m_table, TEST_MAC, 0U, payload,
+                       1U, 0, &p_slot, NULL));
+    TEST_ASSERT_EQUAL (RE_ERROR_DATA_SIZE, re_tag_table_observe (&m_table, TEST_MAC, 0U,
+                       payload, sizeof (payload), 0, &p_slot, &changed));
+    TEST_ASSERT_EQUAL (RE_ERROR_INVALID_PARAM, re_tag_table_observe (&m_table,
+                       0x1000000000000U, 0U, payload, 1U, 0, &p_slot, &changed));
+    TEST_ASSERT_EQUAL (0U, m_table.count);
+}
@@ -0,0 +1,106 @@
+#include "unity.h"
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoints_text.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_e1.h"
+
+#include <math.h>
+#include <string.h>
+
+static char m_buf[128];
+static re_text_out_t m_out;
+
+static const re_text_field_t m_float_3 =
+{
+    "f", 1U, RE_TEXT_FLOAT, 3U, 0U, 0U
+};
+
+void setUp (void)
+{
+    memset (m_buf, 0, sizeof (m_buf));
+    m_out.p_buf = m_buf;
+    m_out.size = sizeof (m_buf);
+    m_out.pos = 0;
+    m_out.overflow = false;
+}
+
+void tearDown (void)
+{
+    // No action needed.
+}
+
+static const char * put_float (const re_float value)
+{
+    setUp ();
+    (void) re_text_put_value (&m_out, &m_float_3, &value);
+    m_buf[m_out.pos] = '\0';
+    return m_buf;
+}
+
+void test_re_text_put_value_fixed_point (void)
+{
+    TEST_ASSERT_EQUAL_STRING ("0", put_float (0.0F));
+    TEST_ASSERT_EQUAL_STRING ("0", put_float (-0.0004F));
+    TEST_ASSERT_EQUAL_STRING ("-0.001", put_float (-0.0006F));
+    TEST_ASSERT_EQUAL_STRING ("1.05", put_float (1.05F));
+    TEST_ASSERT_EQUAL_STRING ("12", put_float (11.9999F));
+    TEST_ASSERT_EQUAL_STRING ("0.007", put_float (0.007F));
+    TEST_ASSERT_EQUAL_STRING ("-163.835", put_float (-163.835F));
+    TEST_ASSERT_EQUAL_STRING ("", put_float (NAN));
+    TEST_ASSERT_EQUAL_STRING ("", put_float (INFINITY));
+    TEST_ASSERT_EQUAL_STRING ("", put_float (1e13F));
+}
+
+void test_re_text_put_integers (void)
+{
+    re_text_put_uint (&m_out, 0U, 1U);
+    re_text_put_char (&m_out, ' ');
+    re_text_put_uint (&m_out, UINT64_MAX, 1U);
+    re_text_put_char (&m_out, ' ');
+    re_text_put_uint (&m_out, 42U, 4U);
+    re_text_put_char (&m_out, ' ');
+    re_text_put_int (&m_out, INT64_MIN);
+    re_text_put_char (&m_out, ' ');
+    re_text_put_mac (&m_out, 0xCBB8334C884FU, RE_TEXT_MAC48_BYTES);
+    re_text_put_char (&m_out, ' ');
+    re_text_put_mac (&m_out, 0xCBB8334C884FU, RE_TEXT_MAC24_BYTES);
+    m_buf[m_out.pos] = '\0';
+    TEST_ASSERT_FALSE (m_out.overflow);
+    TEST_ASSERT_EQUAL_STRING ("0 18446744073709551615 0042 -9223372036854775808 "
+                              "CB:B8:33:4C:88:4F 4C:88:4F", m_buf);
+}
+
+void test_re_text_put_overflow (void)
+{
+    m_out.size = 4U;
+    re_text_put (&m_out, "abc", 3U);
+    TEST_ASSERT_FALSE (m_out.overflow);
+    re_text_put_char (&m_out, 'd');
+    TEST_ASSERT_TRUE (m_out.overflow);
+    TEST_ASSERT_EQUAL (3U, m_out.pos);
+    // Nothing is written after overflow.
+    m_out.size = sizeof (m_buf);
+    re_text_put_char (&m_out, 'd');
+    TEST_ASSERT_EQUAL (3U, m_out.pos);
+}
+
+void test_re_text_fields (void)
+{
+    size_t num_fields = 1U;
+    size_t record_size = 1U;
+    TEST_ASSERT_NOT_NULL (re_text_fields (RE_5_DESTINATION, &num_fields, &record_size));
+    TEST_ASSERT_EQUAL (11U, num_fields);
+    TEST_ASSERT_EQUAL (sizeof (re_5_data_t), record_size);
+    TEST_ASSERT_NOT_NULL (re_text_fields (RE_6_DESTINATION, NULL, &record_size));
+    TEST_ASSERT_EQUAL (sizeof (re_6_data_t), record_size);
+    TEST_ASSERT_NOT_NULL (re_text_fields (RE_7_DESTINATION, NULL, &record_size));
+    TEST_ASSERT_EQUAL (sizeof (re_7_data_t), record_size);
+    TEST_ASSERT_NOT_NULL (re_text_fields (RE_E1_DESTINATION, NULL, &record_size));
+    TEST_ASSERT_EQUAL (sizeof (re_e1_data_t), record_size);
+    TEST_ASSERT_NULL (re_text_fields (0x03U, &num_fields, &record_size));
+    TEST_ASSERT_EQUAL (0U, num_fields);
+    TEST_ASSERT_EQUAL (0U, record_size);
+}
@@ -0,0 +1,896 @@
+/**
+ * Replay and decode tool for captured Ruuvi traffic.
+ *
+ * Reads capture segments of ruuvi_endpoints_capture.h or hex dumps, runs
+ * them through the CA UART frame decoder, data format classification and
+ * payload decoders, and prints either the decoded records or throughput
+ * statistics. Meant for reproducing production load offline and comparing
+ * library changes against real traffic mixes.
+ *
+ * Build and run:
+ *     make tools && ./build_tools/re_decode capture.seg
+ *     ./build_tools/re_decode -s -n 20 capture.seg
+ *
+ * Inputs starting with the capture magic are mapped and read without copies.
+ * Other inputs are hex dumps, one CA UART stream per line or, with -a, one
+ * raw advertisement per line. Hex bytes may be separated by spaces, ':' or
+ * '-', text after '#' is a comment.
+ *
+ * Options:
+ *     -a       Hex dump lines are raw advertisements, not CA UART frames.
+ *     -s       Print statistics instead of records.
+ *     -n N     Run decoding N times, for stable timings with -s.
+ *     -o FILE  Write all valid CA UART frames into a new capture segment.
+ *
+ * Host only, uses POSIX mmap and clock_gettime.
+ *
+ * License: BSD-3
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ruuvi_endpoints.h"
+#include "ruuvi_endpoint_3.h"
+#include "ruuvi_endpoint_5.h"
+#include "ruuvi_endpoint_6.h"
+#include "ruuvi_endpoint_7.h"
+#include "ruuvi_endpoint_c5.h"
+#include "ruuvi_endpoint_ca_uart.h"
+#include "ruuvi_endpoint_e0.h"
+#include "ruuvi_endpoint_e1.h"
+#include "ruuvi_endpoint_f0.h"
+#include "ruuvi_endpoint_ibeacon.h"
+#include "ruuvi_endpoints_capture.h"
+#include "ruuvi_endpoints_json.h"
+#include "ruuvi_endpoints_stats.h"
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TOOL_JSON_MAX        (512U)                  //!< Longest printed record.
+#define TOOL_READ_BATCH      (256U)                  //!< Records per capture read.
+#define TOOL_NS_PER_S        (1000000000ULL)
+#define TOOL_SEGMENT_LEN     (64UL * 1024UL * 1024UL) //!< Size of written segment before trim.
+#define TOOL_UNKNOWN         (0xFFU)                 //!< Format index of unknown payloads.
+#define TOOL_UNKNOWN_CMD     (0xFFU)                 //!< Command of frames too short to have one.
+#define TOOL_NIBBLE_BITS     (4U)
+
+typedef re_status_t (*tool_decode_fp) (const uint8_t * const p_buffer, const size_t buf_len,
+                                       void * const p_data);
+typedef re_status_t (*tool_json_fp) (char * const p_buf, const size_t buf_size,
+                                     size_t * const p_offset, const void * const p_data);
+
+/** @brief Decoder of one data format. */
+typedef struct
+{
+    const char * p_name;                         //!< Printed name.
+    uint8_t data_format;                         //!< Header byte, 0 for iBeacon.
+    size_t min_len;                              //!< Shortest decodable advertisement.
+    bool (*check_format) (const uint8_t * const p_buffer); //!< Classifier.
+    tool_decode_fp decode;                       //!< Length-checked decoder.
+    tool_json_fp json;                           //!< JSON writer, NULL if none.
+} tool_format_t;
+
+/** @brief Decoded data of any supported format. */
+typedef union
+{
+    re_3_data_t df3;
+    re_5_data_t df5;
+    re_6_data_t df6;
+    re_7_data_t df7;
+    re_c5_data_t dfc5;
+    re_e0_data_t dfe0;
+    re_e1_data_t dfe1;
+    re_f0_data_t dff0;
+    re_ibeacon_data_t ibeacon;
+} tool_data_t;
+
+/** @brief A CA UART frame of the input. */
+typedef struct
+{
+    const uint8_t * p_frame; //!< Frame, in a mapped capture or a hex buffer.
+    size_t len;              //!< Length of frame.
+    uint64_t time;           //!< Receive time, 0 for hex dumps.
+} tool_frame_t;
+
+/** @brief An advertisement, raw from input or decoded from a frame. */
+typedef struct
+{
+    re_ca_uart_ble_adv_t adv; //!< Advertisement and MAC.
+    uint64_t time;            //!< Receive time.
+    uint8_t format;           //!< Index in m_formats or TOOL_UNKNOWN.
+} tool_adv_t;
+
+/** @brief Memory to release at exit. */
+typedef struct
+{
+    void * p_mem;   //!< Mapping or heap buffer.
+    size_t len;     //!< Length of mapping, 0 for heap buffer.
+} tool_buffer_t;
+
+/** @brief All inputs of a run. */
+typedef struct
+{
+    tool_frame_t * p_frames; //!< CA UART frames.
+    size_t num_frames;
+    size_t cap_frames;
+    tool_adv_t * p_advs;     //!< Raw advertisements, then advertisements of frames.
+    size_t num_raw;
+    size_t num_advs;
+    size_t cap_advs;
+    tool_buffer_t * p_buffers;
+    size_t num_buffers;
+} tool_input_t;
+
+#define TOOL_DECODER(df)                                                              \
+    static re_status_t tool_decode_##df (const uint8_t * const p_buffer,              \
+                                         const size_t buf_len, void * const p_data)   \
+    {                                                                                 \
+        return re_##df##_decode_checked (p_buffer, buf_len, (re_##df##_data_t *) p_data); \
+    }
+
+#define TOOL_JSON(df)                                                                 \
+    static re_status_t tool_json_##df (char * const p_buf, const size_t buf_size,     \
+                                       size_t * const p_offset, const void * const p_data) \
+    {                                                                                 \
+        return re_json_write_##df (p_buf, buf_size, p_offset,                         \
+                                   (const re_##df##_data_t *) p_data);                \
+    }
+
+TOOL_DECODER (3)
+TOOL_DECODER (5)
+TOOL_DECODER (6)
+TOOL_DECODER (7)
+TOOL_DECODER (c5)
+TOOL_DECODER (e0)
+TOOL_DECODER (e1)
+TOOL_DECODER (f0)
+TOOL_DECODER (ibeacon)
+TOOL_JSON (5)
+TOOL_JSON (6)
+TOOL_JSON (7)
+TOOL_JSON (e1)
+
+/** @brief Supported formats in order of classification, as in the pipeline. */
+static const tool_format_t m_formats[] =
+{
+    { "5", RE_5_DESTINATION, RE_5_RAW_MIN_LEN, &re_5_check_format, &tool_decode_5, &tool_json_5 },
+    { "6", RE_6_DESTINATION, RE_6_RAW_BUF_SIZE, &re_6_check_format, &tool_decode_6, &tool_json_6 },
+    { "e1", RE_E1_DESTINATION, RE_E1_RAW_MIN_LEN, &re_e1_check_format, &tool_decode_e1, &tool_json_e1 },
+    { "7", RE_7_DESTINATION, RE_7_RAW_MIN_LEN, &re_7_check_format, &tool_decode_7, &tool_json_7 },
+    { "c5", RE_C5_DESTINATION, RE_C5_RAW_MIN_LEN, &re_c5_check_format, &tool_decode_c5, NULL },
+    { "3", RE_3_DESTINATION, RE_3_RAW_MIN_LEN, &re_3_check_format, &tool_decode_3, NULL },
+    { "e0", RE_E0_DESTINATION, RE_E0_RAW_MIN_LEN, &re_e0_check_format, &tool_decode_e0, NULL },
+    { "f0", RE_F0_DESTINATION, RE_F0_RAW_MIN_LEN, &re_f0_check_format, &tool_decode_f0, NULL },
+    { "ibeacon", 0U, RE_IBEACON_RAW_MIN_LEN, &re_ibeacon_check_format, &tool_decode_ibeacon, NULL }
+};
+
+#define TOOL_NUM_FORMATS (sizeof (m_formats) / sizeof (m_formats[0]))
+
+/** @brief Per-format results of a run. */
+typedef struct
+{
+    uint64_t ns[TOOL_NUM_FORMATS];     //!< Time spent in decoder.
+    size_t count[TOOL_NUM_FORMATS];    //!< Payloads decoded, all rounds.
+    size_t failed[TOOL_NUM_FORMATS];   //!< Payloads rejected, all rounds.
+    size_t unknown;                    //!< Advertisements of no supported format, all rounds.
+    uint64_t parse_ns;                 //!< Time spent in CA UART decoder.
+    uint64_t classify_ns;              //!< Time spent in classification.
+    uint64_t total_ns;                 //!< Time of all stages.
+} tool_timing_t;
+
+static uint64_t tool_now_ns (void)
+{
+    struct timespec now;
+    (void) clock_gettime (CLOCK_MONOTONIC, &now);
+    return ( (uint64_t) now.tv_sec * TOOL_NS_PER_S) + (uint64_t) now.tv_nsec;
+}
+
+/** @brief Grow an array to hold at least one more element. */
+static void * tool_grow (void * const p_array, size_t * const p_cap, const size_t num,
+                         const size_t element_size)
+{
+    void * p_grown = p_array;
+
+    if (num == *p_cap)
+    {
+        const size_t cap = (0U == *p_cap) ? 1024U : (2U * *p_cap);
+        p_grown = realloc (p_array, cap * element_size);
+
+        if (NULL == p_grown)
+        {
+            fprintf (stderr, "out of memory\n");
+            exit (EXIT_FAILURE);
+        }
+
+        *p_cap = cap;
+    }
+
+    return p_grown;
+}
+
+static void tool_add_frame (tool_input_t * const p_input, const uint8_t * const p_frame,
+                            const size_t len, const uint64_t time)
+{
+    p_input->p_frames = tool_grow (p_input->p_frames, &p_input->cap_frames,
+                                   p_input->num_frames, sizeof (tool_frame_t));
+    p_input->p_frames[p_input->num_frames].p_frame = p_frame;
+    p_input->p_frames[p_input->num_frames].len = len;
+    p_input->p_frames[p_input->num_frames].time = time;
+    p_input->num_frames++;
+}
+
+static void tool_add_buffer (tool_input_t * const p_input, void * const p_mem,
+                             const size_t len)
+{
+    size_t cap = p_input->num_buffers;
+    // Buffers are few, grow one at a time.
+    p_input->p_buffers = realloc (p_input->p_buffers, (cap + 1U) * sizeof (tool_buffer_t));
+
+    if (NULL == p_input->p_buffers)
+    {
+        fprintf (stderr, "out of memory\n");
+        exit (EXIT_FAILURE);
+    }
+
+    p_input->p_buffers[cap].p_mem = p_mem;
+    p_input->p_buffers[cap].len = len;
+    p_input->num_buffers++;
+}
+
+static int tool_hex_value (const char c)
+{
+    int value = -1;
+
+    if ( (c >= '0') && (c <= '9'))
+    {
+        value = c - '0';
+    }
+    else if ( (c >= 'a') && (c <= 'f'))
+    {
+        value = c - 'a' + 10;
+    }
+    else if ( (c >= 'A') && (c <= 'F'))
+    {
+        value = c - 'A' + 10;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Split a hex dump line of CA UART stream into frames.
+ *
+ * Bytes before STX or of a frame cut by end of line are discarded, as a
+ * receiver would while resynchronizing.
+ */
+static void tool_split_stream (tool_input_t * const p_input, const uint8_t * const p_line,
+                               const size_t line_len, re_stats_t * const p_stats)
+{
+    size_t pos = 0;
+
+    while (pos < line_len)
+    {
+        size_t frame_len = 0;
+        pos += re_ca_uart_resync (&p_line[pos], line_len - pos, &frame_len, p_stats);
+
+        if (0U != frame_len)
+        {
+            tool_add_frame (p_input, &p_line[pos], frame_len, 0U);
+            pos += frame_len;
+        }
+        else if (pos < line_len)
+        {
+            // No more bytes of the line will arrive, skip STX of the cut frame.
+            re_stats_record_discarded (p_stats, 1U);
+            pos++;
+        }
+        else
+        {
+            // Rest of line was discarded.
+        }
+    }
+}
+
+static void tool_add_raw_adv (tool_input_t * const p_input, const uint8_t * const p_line,
+                              const size_t line_len, re_stats_t * const p_stats)
+{
+    if (line_len > RE_CA_UART_ADV_BYTES)
+    {
+        fprintf (stderr, "skipping advertisement of %zu bytes, longer than %u\n",
+                 line_len, (unsigned) RE_CA_UART_ADV_BYTES);
+        re_stats_record_discarded (p_stats, line_len);
+    }
+    else
+    {
+        tool_adv_t * p_adv;
+        p_input->p_advs = tool_grow (p_input->p_advs, &p_input->cap_advs, p_input->num_advs,
+                                     sizeof (tool_adv_t));
+        p_adv = &p_input->p_advs[p_input->num_advs];
+        memset (p_adv, 0, sizeof (*p_adv));
+        memcpy (p_adv->adv.adv, p_line, line_len);
+        p_adv->adv.adv_len = (uint8_t) line_len;
+        p_adv->format = TOOL_UNKNOWN;
+        p_input->num_advs++;
+        p_input->num_raw++;
+    }
+}
+
+/** @brief Parse a hex dump into a buffer that lives until exit. */
+static bool tool_load_hex (tool_input_t * const p_input, const char * const p_path,
+                           const char * const p_text, const size_t text_len,
+                           const bool raw_adv, re_stats_t * const p_stats)
+{
+    bool ok = true;
+    uint8_t * const p_bytes = malloc ( (text_len / 2U) + 1U);
+    size_t num_bytes = 0;
+    size_t pos = 0;
+    size_t line = 1;
+
+    if (NULL == p_bytes)
+    {
+        fprintf (stderr, "out of memory\n");
+        exit (EXIT_FAILURE);
+    }
+
+    tool_add_buffer (p_input, p_bytes, 0U);
+
+    while (ok && (pos < text_len))
+    {
+        const size_t line_start = num_bytes;
+        int high = -1;
+
+        while (ok && (pos < text_len) && ('\n' != p_text[pos]))
+        {
+            const char c = p_text[pos];
+            const int value = tool_hex_value (c);
+
+            if ('#' == c)
+            {
+                while ( ( (pos + 1U) < text_len) && ('\n' != p_text[pos + 1U]))
+                {
+                    pos++;
+                }
+            }
+            else if (value >= 0)
+            {
+                if (high < 0)
+                {
+                    high = value;
+                }
+                else
+                {
+                    p_bytes[num_bytes] = (uint8_t) ( ( (unsigned) high << TOOL_NIBBLE_BITS)
+                                                     | (unsigned) value);
+                    num_bytes++;
+                    high = -1;
+                }
+            }
+            else if ( (' ' != c) && ('\t' != c) && ('\r' != c) && (':' != c) && ('-' != c))
+            {
+                fprintf (stderr, "%s:%zu: not a hex digit '%c'\n", p_path, line, c);
+                ok = false;
+            }
+
+            pos++;
+        }
+
+        if (high >= 0)
+        {
+            fprintf (stderr, "%s:%zu: odd number of hex digits\n", p_path, line);
+            ok = false;
+        }
+        else if (num_bytes == line_start)
+        {
+            // Blank or comment line.
+        }
+        else if (raw_adv)
+        {
+            tool_add_raw_adv (p_input, &p_bytes[line_start], num_bytes - line_start, p_stats);
+        }
+        else
+        {
+            tool_split_stream (p_input, &p_bytes[line_start], num_bytes - line_start, p_stats);
+        }
+
+        pos++;
+        line++;
+    }
+
+    return ok;
+}
+
+/** @brief Add frames of a mapped capture segment without copying them. */
+static bool tool_load_capture (tool_input_t * const p_input, const char * const p_path,
+                               const uint8_t * const p_segment, const size_t segment_len)
+{
+    re_capture_reader_t reader;
+    const uint8_t * frames[TOOL_READ_BATCH];
+    size_t lens[TOOL_READ_BATCH];
+    uint64_t times[TOOL_READ_BATCH];
+    size_t num_read = 0;
+    re_status_t status = re_capture_open (&reader, p_segment, segment_len);
+
+    do
+    {
+        if (RE_SUCCESS == status)
+        {
+            status = re_capture_read (&reader, frames, lens, times, TOOL_READ_BATCH, &num_read);
+        }
+
+        for (size_t ii = 0; (RE_SUCCESS == status) && (ii < num_read); ii++)
+        {
+            tool_add_frame (p_input, frames[ii], lens[ii], times[ii]);
+        }
+    } while ( (RE_SUCCESS == status) && (0U != num_read));
+
+    if (RE_SUCCESS != status)
+    {
+        fprintf (stderr, "%s: corrupt capture segment, error 0x%08X\n", p_path,
+                 (unsigned) status);
+    }
+
+    return (RE_SUCCESS == status);
+}
+
+static bool tool_load (tool_input_t * const p_input, const char * const p_path,
+                       const bool raw_adv, re_stats_t * const p_stats)
+{
+    bool ok = false;
+    struct stat st;
+    const int fd = open (p_path, O_RDONLY);
+
+    if ( (fd < 0) || (0 != fstat (fd, &st)))
+    {
+        perror (p_path);
+    }
+    else if (0 == st.st_size)
+    {
+        ok = true;
+    }
+    else
+    {
+        const size_t len = (size_t) st.st_size;
+        void * const p_map = mmap (NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (MAP_FAILED == p_map)
+        {
+            perror (p_path);
+        }
+        else
+        {
+            tool_add_buffer (p_input, p_map, len);
+
+            if ( (len >= RE_CAPTURE_HEADER_LEN) && (0 == memcmp (p_map, "RECP", 4U)))
+            {
+                ok = tool_load_capture (p_input, p_path, p_map, len);
+            }
+            else
+            {
+                ok = tool_load_hex (p_input, p_path, p_map, len, raw_adv, p_stats);
+            }
+        }
+    }
+
+    if (fd >= 0)
+    {
+        (void) close (fd);
+    }
+
+    return ok;
+}
+
+/** @brief Write all valid frames into a new capture segment. */
+static bool tool_write_capture (const tool_input_t * const p_input, const char * const p_path)
+{
+    bool ok = false;
+    const int fd = open (p_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if ( (fd < 0) || (0 != ftruncate (fd, (off_t) TOOL_SEGMENT_LEN)))
+    {
+        perror (p_path);
+    }
+    else
+    {
+        uint8_t * const p_segment = mmap (NULL, TOOL_SEGMENT_LEN, PROT_READ | PROT_WRITE,
+                                          MAP_SHARED, fd, 0);
+        re_capture_writer_t writer;
+
+        if (MAP_FAILED == p_segment)
+        {
+            perror (p_path);
+        }
+        else if (RE_SUCCESS == re_capture_create (&writer, p_segment, TOOL_SEGMENT_LEN))
+        {
+            re_status_t status = RE_SUCCESS;
+            uint64_t time = 0;
+            size_t skipped = 0;
+
+            for (size_t ii = 0; (ii < p_input->num_frames) && (RE_ERROR_DATA_SIZE != status);
+                    ii++)
+            {
+                // Hex dumps have no receive time, keep them in input order.
+                time = (0U != p_input->p_frames[ii].time) ? p_input->p_frames[ii].time : time;
+                status = re_capture_append (&writer, time, p_input->p_frames[ii].p_frame,
+                                            p_input->p_frames[ii].len);
+                skipped += (RE_SUCCESS != status) ? 1U : 0U;
+            }
+
+            if (RE_ERROR_DATA_SIZE == status)
+            {
+                fprintf (stderr, "%s: segment full, last frames not written\n", p_path);
+            }
+
+            fprintf (stderr, "%s: %u frames written, %zu skipped\n", p_path,
+                     (unsigned) writer.num_records, skipped);
+            (void) munmap (p_segment, TOOL_SEGMENT_LEN);
+            ok = (0 == ftruncate (fd, (off_t) (writer.data_start + writer.data_len)));
+        }
+        else
+        {
+            (void) munmap (p_segment, TOOL_SEGMENT_LEN);
+        }
+    }
+
+    if (fd >= 0)
+    {
+        (void) close (fd);
+    }
+
+    return ok;
+}
+
+static uint8_t tool_classify (const re_ca_uart_ble_adv_t * const p_adv)
+{
+    uint8_t format = TOOL_UNKNOWN;
+
+    for (size_t ii = 0; (TOOL_UNKNOWN == format) && (ii < TOOL_NUM_FORMATS); ii++)
+    {
+        if ( (p_adv->adv_len >= m_formats[ii].min_len) && m_formats[ii].check_format (p_adv->adv))
+        {
+            format = (uint8_t) ii;
+        }
+    }
+
+    return format;
+}
+
+/** @brief Decode CA UART frames into advertisements, after raw advertisements. */
+static void tool_parse (tool_input_t * const p_input, re_stats_t * const p_stats)
+{
+    re_ca_uart_payload_t payload;
+    p_input->num_advs = p_input->num_raw;
+
+    for (size_t ii = 0; ii < p_input->num_frames; ii++)
+    {
+        const tool_frame_t * const p_frame = &p_input->p_frames[ii];
+        const re_status_t status = re_ca_uart_decode_checked (p_frame->p_frame, p_frame->len,
+                                   &payload);
+        uint8_t cmd = TOOL_UNKNOWN_CMD;
+
+        if (RE_SUCCESS == status)
+        {
+            cmd = (uint8_t) payload.cmd;
+        }
+        else if (p_frame->len >= RE_CA_UART_HEADER_SIZE)
+        {
+            cmd = p_frame->p_frame[RE_CA_UART_HEADER_SIZE - 1U];
+        }
+        else
+        {
+            // Too short to have a command, e.g. a corrupt capture record.
+        }
+
+        re_stats_record_frame (p_stats, cmd, status);
+
+        if ( (RE_SUCCESS == status) && ( (RE_CA_UART_ADV_RPRT == payload.cmd)
+                                         || (RE_CA_UART_ADV_RPRT2 == payload.cmd)))
+        {
+            tool_adv_t * p_adv;
+            p_input->p_advs = tool_grow (p_input->p_advs, &p_input->cap_advs, p_input->num_advs,
+                                         sizeof (tool_adv_t));
+            p_adv = &p_input->p_advs[p_input->num_advs];
+            p_adv->adv = payload.params.adv;
+            p_adv->time = p_frame->time;
+            p_input->num_advs++;
+        }
+    }
+}
+
+static void tool_print_mac (const uint8_t * const p_mac)
+{
+    for (size_t ii = 0; ii < RE_CA_UART_MAC_BYTES; ii++)
+    {
+        printf ( (0U == ii) ? "%02X" : ":%02X", p_mac[ii]);
+    }
+}
+
+/** @brief Decode and print advertisements in input order. */
+static void tool_print (tool_input_t * const p_input, re_stats_t * const p_stats)
+{
+    char json[TOOL_JSON_MAX];
+    tool_data_t data;
+    tool_parse (p_input, p_stats);
+
+    for (size_t ii = 0; ii < p_input->num_advs; ii++)
+    {
+        const tool_adv_t * const p_adv = &p_input->p_advs[ii];
+        const uint8_t format = tool_classify (&p_adv->adv);
+        printf ("%llu ", (unsigned long long) p_adv->time);
+        tool_print_mac (p_adv->adv.mac);
+
+        if (TOOL_UNKNOWN == format)
+        {
+            printf (" unknown -\n");
+        }
+        else
+        {
+            const tool_format_t * const p_format = &m_formats[format];
+            const re_status_t status = p_format->decode (p_adv->adv.adv, p_adv->adv.adv_len,
+                                       &data);
+            size_t offset = 0;
+            re_stats_record_format (p_stats, p_format->data_format, status);
+
+            if (RE_SUCCESS != status)
+            {
+                printf (" %s error 0x%08X\n", p_format->p_name, (unsigned) status);
+            }
+            else if ( (NULL != p_format->json)
+                      && (RE_SUCCESS == p_format->json (json, sizeof (json), &offset, &data)))
+            {
+                printf (" %s %s\n", p_format->p_name, json);
+            }
+            else
+            {
+                printf (" %s -\n", p_format->p_name);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Run all stages once, timing each.
+ *
+ * Advertisements are bucketed by format before decoding, so that each
+ * decoder runs over its own batch as a batch decoder would.
+ */
+static void tool_run (tool_input_t * const p_input, const uint8_t ** const pp_buckets,
+                      size_t * const p_lens, re_stats_t * const p_stats,
+                      tool_timing_t * const p_timing)
+{
+    size_t starts[TOOL_NUM_FORMATS + 1U] = {0};
+    size_t fill[TOOL_NUM_FORMATS] = {0};
+    tool_data_t data;
+    const uint64_t t_start = tool_now_ns ();
+    uint64_t t_classified;
+    tool_parse (p_input, p_stats);
+    const uint64_t t_parsed = tool_now_ns ();
+
+    for (size_t ii = 0; ii < p_input->num_advs; ii++)
+    {
+        p_input->p_advs[ii].format = tool_classify (&p_input->p_advs[ii].adv);
+
+        if (TOOL_UNKNOWN == p_input->p_advs[ii].format)
+        {
+            p_timing->unknown++;
+        }
+        else
+        {
+            starts[p_input->p_advs[ii].format + 1U]++;
+        }
+    }
+
+    for (size_t ff = 0; ff < TOOL_NUM_FORMATS; ff++)
+    {
+        starts[ff + 1U] += starts[ff];
+        fill[ff] = starts[ff];
+    }
+
+    for (size_t ii = 0; ii < p_input->num_advs; ii++)
+    {
+        const uint8_t format = p_input->p_advs[ii].format;
+
+        if (TOOL_UNKNOWN != format)
+        {
+            pp_buckets[fill[format]] = p_input->p_advs[ii].adv.adv;
+            p_lens[fill[format]] = p_input->p_advs[ii].adv.adv_len;
+            fill[format]++;
+        }
+    }
+
+    t_classified = tool_now_ns ();
+
+    for (size_t ff = 0; ff < TOOL_NUM_FORMATS; ff++)
+    {
+        const tool_format_t * const p_format = &m_formats[ff];
+        const uint64_t t_format = tool_now_ns ();
+
+        for (size_t ii = starts[ff]; ii < starts[ff + 1U]; ii++)
+        {
+            const re_status_t status = p_format->decode (pp_buckets[ii], p_lens[ii], &data);
+            p_timing->failed[ff] += (RE_SUCCESS != status) ? 1U : 0U;
+            re_stats_record_format (p_stats, p_format->data_format, status);
+        }
+
+        p_timing->ns[ff] += tool_now_ns () - t_format;
+        p_timing->count[ff] += starts[ff + 1U] - starts[ff];
+    }
+
+    p_timing->parse_ns += t_parsed - t_start;
+    p_timing->classify_ns += t_classified - t_parsed;
+    p_timing->total_ns += tool_now_ns () - t_start;
+}
+
+static double tool_ns_per_op (const uint64_t ns, const size_t count)
+{
+    return (0U == count) ? 0.0 : ( (double) ns / (double) count);
+}
+
+static void tool_print_stats (const tool_input_t * const p_input,
+                              const re_stats_t * const p_stats,
+                              const tool_timing_t * const p_timing, const size_t rounds)
+{
+    const double seconds = (double) p_timing->total_ns / (double) TOOL_NS_PER_S;
+    const size_t frames = p_input->num_frames * rounds;
+    const size_t advs = p_input->num_advs * rounds;
+    printf ("frames          %zu (ok %u, failed %u, discarded bytes %u)\n",
+            p_input->num_frames, (unsigned) p_stats->frames_ok,
+            (unsigned) p_stats->frames_failed, (unsigned) p_stats->bytes_discarded);
+    printf ("advertisements  %zu (unknown format %zu)\n", p_input->num_advs,
+            p_timing->unknown / rounds);
+    printf ("rounds          %zu in %.3f s\n", rounds, seconds);
+
+    if (p_timing->total_ns > 0U)
+    {
+        printf ("throughput      %.0f frames/s, %.0f advertisements/s\n",
+                (double) frames / seconds, (double) advs / seconds);
+    }
+
+    printf ("stage           ns/op\n");
+    printf ("uart decode     %.1f\n", tool_ns_per_op (p_timing->parse_ns, frames));
+    printf ("classify        %.1f\n", tool_ns_per_op (p_timing->classify_ns, advs));
+    printf ("format          count     failed    ns/op\n");
+
+    for (size_t ff = 0; ff < TOOL_NUM_FORMATS; ff++)
+    {
+        if (0U != p_timing->count[ff])
+        {
+            printf ("%-15s %-9zu %-9zu %.1f\n", m_formats[ff].p_name,
+                    p_timing->count[ff] / rounds, p_timing->failed[ff] / rounds,
+                    tool_ns_per_op (p_timing->ns[ff], p_timing->count[ff]));
+        }
+    }
+
+    for (size_t bit = 0; bit < RE_STATS_ERROR_BITS; bit++)
+    {
+        if (0U != p_stats->error_bits[bit])
+        {
+            printf ("error 0x%08lX  %u\n", 1UL << bit, (unsigned) p_stats->error_bits[bit]);
+        }
+    }
+}
+
+static void tool_usage (const char * const p_name)
+{
+    fprintf (stderr, "usage: %s [-a] [-s] [-n rounds] [-o capture] file...\n"
+             "  -a  hex dump lines are raw advertisements, not CA UART frames\n"
+             "  -s  print statistics instead of records\n"
+             "  -n  run decoding given number of times\n"
+             "  -o  write valid CA UART frames into a new capture segment\n", p_name);
+}
+
+int main (int argc, char ** argv)
+{
+    tool_input_t input;
+    re_stats_t stats;
+    bool raw_adv = false;
+    bool print_stats = false;
+    size_t rounds = 1;
+    const char * p_output = NULL;
+    bool ok = true;
+    int opt;
+    memset (&input, 0, sizeof (input));
+    re_stats_init (&stats);
+
+    while (-1 != (opt = getopt (argc, argv, "asn:o:h")))
+    {
+        switch (opt)
+        {
+            case 'a':
+                raw_adv = true;
+                break;
+
+            case 's':
+                print_stats = true;
+                break;
+
+            case 'n':
+                rounds = strtoul (optarg, NULL, 10);
+                break;
+
+            case 'o':
+                p_output = optarg;
+                break;
+
+            default:
+                ok = false;
+                break;
+        }
+    }
+
+    if ( (!ok) || (optind >= argc) || (0U == rounds))
+    {
+        tool_usage (argv[0]);
+        ok = false;
+    }
+
+    for (int ii = optind; ok && (ii < argc); ii++)
+    {
+        ok = tool_load (&input, argv[ii], raw_adv, &stats);
+    }
+
+    if (ok && (NULL != p_output))
+    {
+        ok = tool_write_capture (&input, p_output);
+    }
+    else if (ok && print_stats)
+    {
+        tool_timing_t timing;
+        const uint8_t ** pp_buckets = NULL;
+        size_t * p_lens = NULL;
+        memset (&timing, 0, sizeof (timing));
+        // Parse once to size the buckets.
+        tool_parse (&input, NULL);
+        pp_buckets = malloc ( (input.num_advs + 1U) * sizeof (*pp_buckets));
+        p_lens = malloc ( (input.num_advs + 1U) * sizeof (*p_lens));
+
+        if ( (NULL == pp_buckets) || (NULL == p_lens))
+        {
+            fprintf (stderr, "out of memory\n");
+            ok = false;
+        }
+
+        for (size_t round = 0; ok && (round < rounds); round++)
+        {
+            // Count frames and errors of one round only.
+            tool_run (&input, pp_buckets, p_lens, (0U == round) ? &stats : NULL, &timing);
+        }
+
+        if (ok)
+        {
+            tool_print_stats (&input, &stats, &timing, rounds);
+        }
+
+        free (pp_buckets);
+        free (p_lens);
+    }
+    else if (ok)
+    {
+        tool_print (&input, &stats);
+    }
+
+    for (size_t ii = 0; ii < input.num_buffers; ii++)
+    {
+        if (0U != input.p_buffers[ii].len)
+        {
+            (void) munmap (input.p_buffers[ii].p_mem, input.p_buffers[ii].len);
+        }
+        else
+        {
+            free (input.p_buffers[ii].p_mem);
+        }
+    }
+
+    free (input.p_buffers);
+    free (input.p_frames);
+    free (input.p_advs);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}